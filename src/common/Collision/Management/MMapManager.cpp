@@ -119,6 +119,27 @@ namespace MMAP
         if (!loadMapData(mapId))
             return false;
 
+        // check if we already have this tile loaded
+        if (loadedMMaps[mapId]->loadedTileRefs.find(packTileID(x, y)) != loadedMMaps[mapId]->loadedTileRefs.end())
+            return false;
+
+        unsigned char* data = nullptr;
+        uint32 dataSize = 0;
+        if (!readMapTile(mapId, x, y, data, dataSize))
+            return false;
+
+        return loadMap(mapId, x, y, data, dataSize);
+    }
+
+    bool MMapManager::loadMap(uint32 mapId, int32 x, int32 y, unsigned char* data, uint32 dataSize)
+    {
+        // make sure the mmap is loaded and ready to load tiles
+        if (!loadMapData(mapId))
+        {
+            dtFree(data);
+            return false;
+        }
+
         // get this mmap data
         MMapData* mmap = loadedMMaps[mapId];
         ASSERT(mmap->navMesh);
@@ -126,8 +147,38 @@ namespace MMAP
         // check if we already have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
         if (mmap->loadedTileRefs.find(packedGridPos) != mmap->loadedTileRefs.end())
+        {
+            dtFree(data);
             return false;
+        }
 
+        dtMeshHeader* header = (dtMeshHeader*)data;
+        dtTileRef tileRef = 0;
+
+        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
+        dtStatus status;
+        {
+            std::unique_lock<std::shared_mutex> lock(mmap->tileLock);
+            status = mmap->navMesh->addTile(data, dataSize, DT_TILE_FREE_DATA, 0, &tileRef);
+        }
+
+        if (dtStatusSucceed(status))
+        {
+            mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+            ++loadedTiles;
+            TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile %04i[%02i, %02i] into %04i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
+            return true;
+        }
+        else
+        {
+            TC_LOG_ERROR("maps", "MMAP:loadMap: Could not load %04u_%02i_%02i.mmtile into navmesh", mapId, x, y);
+            dtFree(data);
+            return false;
+        }
+    }
+
+    bool MMapManager::readMapTile(uint32 mapId, int32 x, int32 y, unsigned char*& data, uint32& dataSize) const
+    {
         // load this tile :: mmaps/MMMXXYY.mmtile
         std::string fileName = Trinity::StringFormat(TILE_FILE_NAME_FORMAT, sConfigMgr->GetStringDefault("DataDir", ".").c_str(), mapId, x, y);
         FILE* file = fopen(fileName.c_str(), "rb");
@@ -165,7 +216,7 @@ namespace MMAP
 
         fseek(file, pos, SEEK_SET);
 
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
+        data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
         ASSERT(data);
 
         size_t result = fread(data, fileHeader.size, 1, file);
@@ -173,28 +224,14 @@ namespace MMAP
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: Bad header or data in mmap %04u_%02i_%02i.mmtile", mapId, x, y);
             fclose(file);
+            dtFree(data);
+            data = nullptr;
             return false;
         }
 
         fclose(file);
-
-        dtMeshHeader* header = (dtMeshHeader*)data;
-        dtTileRef tileRef = 0;
-
-        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
-        {
-            mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
-            ++loadedTiles;
-            TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile %04i[%02i, %02i] into %04i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
-            return true;
-        }
-        else
-        {
-            TC_LOG_ERROR("maps", "MMAP:loadMap: Could not load %04u_%02i_%02i.mmtile into navmesh", mapId, x, y);
-            dtFree(data);
-            return false;
-        }
+        dataSize = fileHeader.size;
+        return true;
     }
 
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
@@ -222,7 +259,13 @@ namespace MMAP
         dtTileRef tileRef = mmap->loadedTileRefs[packedGridPos];
 
         // unload, and mark as non loaded
-        if (dtStatusFailed(mmap->navMesh->removeTile(tileRef, nullptr, nullptr)))
+        dtStatus status;
+        {
+            std::unique_lock<std::shared_mutex> lock(mmap->tileLock);
+            status = mmap->navMesh->removeTile(tileRef, nullptr, nullptr);
+        }
+
+        if (dtStatusFailed(status))
         {
             // this is technically a memory leak
             // if the grid is later reloaded, dtNavMesh::addTile will return error but no extra memory is used
@@ -253,6 +296,7 @@ namespace MMAP
 
         // unload all tiles from given map
         MMapData* mmap = itr->second;
+        std::unique_lock<std::shared_mutex> lock(mmap->tileLock);
         for (MMapTileSet::iterator i = mmap->loadedTileRefs.begin(); i != mmap->loadedTileRefs.end(); ++i)
         {
             uint32 x = (i->first >> 16);
@@ -266,6 +310,7 @@ namespace MMAP
             }
         }
 
+        lock.unlock();
         delete mmap;
         itr->second = nullptr;
         TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded %04i.mmap", mapId);
@@ -334,4 +379,55 @@ namespace MMAP
 
         return mmap->navMeshQueries[instanceId];
     }
+
+    dtNavMeshQuery const* MMapManager::GetThreadNavMeshQuery(uint32 mapId)
+    {
+        // queries keep no tile data, so one stays usable when the navmesh of its map is loaded again
+        struct ThreadQueries
+        {
+            ~ThreadQueries()
+            {
+                for (auto const& query : Queries)
+                    dtFreeNavMeshQuery(query.second.second);
+            }
+
+            std::unordered_map<uint32, std::pair<dtNavMesh const*, dtNavMeshQuery*>> Queries;   // mapId to mesh the query was initialized for
+        };
+
+        static thread_local ThreadQueries threadQueries;
+
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        dtNavMesh const* navMesh = itr->second->navMesh;
+        std::pair<dtNavMesh const*, dtNavMeshQuery*>& query = threadQueries.Queries[mapId];
+        if (query.second && query.first == navMesh)
+            return query.second;
+
+        if (!query.second)
+        {
+            query.second = dtAllocNavMeshQuery();
+            ASSERT(query.second);
+        }
+
+        query.first = nullptr;
+        if (dtStatusFailed(query.second->init(navMesh, 1024)))
+        {
+            TC_LOG_ERROR("maps", "MMAP:GetThreadNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %04u", mapId);
+            return nullptr;
+        }
+
+        query.first = navMesh;
+        return query.second;
+    }
+
+    std::shared_mutex* MMapManager::GetTileLock(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        return &itr->second->tileLock;
+    }
 }
@@ -21,6 +21,7 @@
 #include "Define.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -49,6 +50,7 @@ namespace MMAP
 
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
+        std::shared_mutex tileLock;        // exclusive while tiles are added or removed, shared by pathfinding workers
     };
 
 
@@ -64,6 +66,10 @@ namespace MMAP
 
             void InitializeThreadUnsafe(const std::vector<uint32>& mapIds);
             bool loadMap(uint32 mapId, int32 x, int32 y);
+            // links a tile read by readMapTile, takes ownership of data
+            bool loadMap(uint32 mapId, int32 x, int32 y, unsigned char* data, uint32 dataSize);
+            // only reads the tile file, safe to call from any thread
+            bool readMapTile(uint32 mapId, int32 x, int32 y, unsigned char*& data, uint32& dataSize) const;
             bool unloadMap(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId);
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
@@ -72,6 +78,11 @@ namespace MMAP
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
+            // for threads other than the map threads: a query owned by the calling thread,
+            // to be used while holding GetTileLock shared
+            dtNavMeshQuery const* GetThreadNavMeshQuery(uint32 mapId);
+            std::shared_mutex* GetTileLock(uint32 mapId);
+
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return uint32(loadedMMaps.size()); }
         private:
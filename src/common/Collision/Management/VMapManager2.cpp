@@ -338,6 +338,12 @@ namespace VMAP
         return model->second.getModel();
     }
 
+    void VMapManager2::acquireMapTileModels(const char* basePath, unsigned int mapId, int x, int y, std::vector<std::string>& models)
+    {
+        if (isMapLoadingEnabled())
+            StaticMapTree::AcquireMapTileModels(basePath, mapId, x, y, this, models);
+    }
+
     void VMapManager2::releaseModelInstance(const std::string &filename)
     {
         //! Critical section, thread safe access to iLoadedModelFiles
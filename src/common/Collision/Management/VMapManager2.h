@@ -22,6 +22,7 @@
 #include "Define.h"
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 //===========================================================
 
@@ -120,6 +121,8 @@ namespace VMAP
 
             WorldModel* acquireModelInstance(const std::string& basepath, const std::string& filename, uint32 flags = 0);
             void releaseModelInstance(const std::string& filename);
+            // loads the models of a tile ahead of loadMap, safe to call from any thread. Release them once the tile is loaded
+            void acquireMapTileModels(const char* basePath, unsigned int mapId, int x, int y, std::vector<std::string>& models);
 
             // what's the use of this? o.O
             virtual std::string getDirFileName(unsigned int mapId, int /*x*/, int /*y*/) const override
@@ -420,6 +420,38 @@ namespace VMAP
 
     //=========================================================
 
+    void StaticMapTree::AcquireMapTileModels(std::string basePath, uint32 mapID, uint32 tileX, uint32 tileY, VMapManager2* vm, std::vector<std::string>& models)
+    {
+        if (basePath.length() > 0 && basePath[basePath.length()-1] != '/' && basePath[basePath.length()-1] != '\\')
+            basePath.push_back('/');
+
+        // untiled maps and empty tiles have no tile file, their models come with the map file
+        std::string tilefile = basePath + getTileFileName(mapID, tileX, tileY);
+        FILE* tf = fopen(tilefile.c_str(), "rb");
+        if (!tf)
+            return;
+
+        char chunk[8];
+        uint32 numSpawns = 0;
+        if (readChunk(tf, chunk, VMAP_MAGIC, 8) && fread(&numSpawns, sizeof(uint32), 1, tf) == 1)
+        {
+            for (uint32 i = 0; i < numSpawns; ++i)
+            {
+                ModelSpawn spawn;
+                uint32 referencedVal;
+                if (!ModelSpawn::readFromFile(tf, spawn) || fread(&referencedVal, sizeof(uint32), 1, tf) != 1)
+                    break;
+
+                if (vm->acquireModelInstance(basePath, spawn.name, spawn.flags))
+                    models.push_back(spawn.name);
+            }
+        }
+
+        fclose(tf);
+    }
+
+    //=========================================================
+
     void StaticMapTree::UnloadMapTile(uint32 tileX, uint32 tileY, VMapManager2* vm)
     {
         uint32 tileID = packTileID(tileX, tileY);
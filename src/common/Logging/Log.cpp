@@ -30,7 +30,7 @@
 #include <chrono>
 #include <sstream>
 
-Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr)
+Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr), _handles(nullptr)
 {
     m_logsTimestamp = "_" + GetTimestampStr();
     RegisterAppender<AppenderConsole>();
@@ -291,6 +291,8 @@ bool Log::SetLogLevel(std::string const& name, int32 newLeveli, bool isLogger /*
 
         if (newLevel != LOG_LEVEL_DISABLED && newLevel < lowestLogLevel)
             lowestLogLevel = newLevel;
+
+        RefreshHandles();
     }
     else
     {
@@ -332,13 +334,12 @@ void Log::Close()
 {
     loggers.clear();
     appenders.clear();
+    RefreshHandles();
 }
 
 bool Log::ShouldLog(std::string const& type, LogLevel level) const
 {
-    // TODO: Use cache to store "Type.sub1.sub2": "Type" equivalence, should
-    // Speed up in cases where requesting "Type.sub1.sub2" but only configured
-    // Logger "Type"
+    // Call sites logging to a literal type resolve it once through LogHandle
 
     // Don't even look for a logger if the LogLevel is lower than lowest log levels across all loggers
     if (level < lowestLogLevel)
@@ -352,6 +353,43 @@ bool Log::ShouldLog(std::string const& type, LogLevel level) const
     return logLevel != LOG_LEVEL_DISABLED && logLevel <= level;
 }
 
+bool Log::ShouldLog(LogHandle& handle, char const* type, LogLevel level)
+{
+    uint8 minLevel;
+    {
+        std::lock_guard<std::mutex> lock(_handlesLock);
+        minLevel = handle._minLevel.load(std::memory_order_relaxed);
+        if (!minLevel)
+        {
+            // first call of this call site, keep it so the level follows config reloads
+            handle._type = type;
+            handle._next = _handles;
+            _handles = &handle;
+
+            minLevel = GetHandleLevel(type);
+            handle._minLevel.store(minLevel, std::memory_order_release);
+        }
+    }
+
+    return level >= minLevel;
+}
+
+uint8 Log::GetHandleLevel(char const* type) const
+{
+    Logger const* logger = GetLoggerByType(type);
+    if (!logger || logger->getLogLevel() == LOG_LEVEL_DISABLED)
+        return LOG_LEVEL_INVALID;
+
+    return std::max<uint8>(logger->getLogLevel(), lowestLogLevel);
+}
+
+void Log::RefreshHandles()
+{
+    std::lock_guard<std::mutex> lock(_handlesLock);
+    for (LogHandle* handle = _handles; handle; handle = handle->_next)
+        handle->_minLevel.store(GetHandleLevel(handle->_type), std::memory_order_release);
+}
+
 Log* Log::instance()
 {
     static Log instance;
@@ -389,4 +427,5 @@ void Log::LoadFromConfig()
 
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+    RefreshHandles();
 }
@@ -23,12 +23,15 @@
 #include "LogCommon.h"
 #include "StringFormat.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 class Appender;
 class Logger;
+class LogHandle;
 struct LogMessage;
 
 namespace Trinity
@@ -69,6 +72,7 @@ class TC_COMMON_API Log
         void LoadFromConfig();
         void Close();
         bool ShouldLog(std::string const& type, LogLevel level) const;
+        bool ShouldLog(LogHandle& handle, char const* type, LogLevel level);
         bool SetLogLevel(std::string const& name, int32 level, bool isLogger = true);
 
         template<typename Format, typename... Args>
@@ -104,6 +108,8 @@ class TC_COMMON_API Log
         void write(std::unique_ptr<LogMessage>&& msg) const;
 
         Logger const* GetLoggerByType(std::string const& type) const;
+        uint8 GetHandleLevel(char const* type) const;
+        void RefreshHandles();
         Appender* GetAppenderByName(std::string_view name);
         uint8 NextAppenderId();
         void CreateAppenderFromConfig(std::string const& name);
@@ -125,10 +131,43 @@ class TC_COMMON_API Log
 
         Trinity::Asio::IoContext* _ioContext;
         Trinity::Asio::Strand* _strand;
+
+        LogHandle* _handles;                                // resolved call sites, refreshed whenever loggers change
+        std::mutex _handlesLock;
 };
 
 #define sLog Log::instance()
 
+// Logger level of a single TC_LOG_* call site, a disabled level costs one load and compare once resolved
+class LogHandle
+{
+    friend class Log;
+
+    public:
+        constexpr LogHandle() : _minLevel(LOG_LEVEL_DISABLED), _type(nullptr), _next(nullptr) { }
+
+        // Only string literals always name the same logger, other types are looked up every time
+        template<std::size_t N>
+        bool ShouldLog(char const (&type)[N], LogLevel level)
+        {
+            if (uint8 minLevel = _minLevel.load(std::memory_order_acquire))
+                return level >= minLevel;
+
+            return sLog->ShouldLog(*this, type, level);
+        }
+
+        template<typename T>
+        bool ShouldLog(T const& type, LogLevel level)
+        {
+            return sLog->ShouldLog(type, level);
+        }
+
+    private:
+        std::atomic<uint8> _minLevel;                       // LOG_LEVEL_DISABLED until resolved, LOG_LEVEL_INVALID if nothing is written
+        char const* _type;
+        LogHandle* _next;
+};
+
 #define LOG_EXCEPTION_FREE(filterType__, level__, ...) \
     { \
         try \
@@ -151,7 +190,8 @@ void check_args(std::string const&, ...);
 // This will catch format errors on build time
 #define TC_LOG_MESSAGE_BODY(filterType__, level__, ...)                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static LogHandle logHandle__;                               \
+            if (logHandle__.ShouldLog(filterType__, level__))           \
             {                                                           \
                 if (false)                                              \
                     check_args(__VA_ARGS__);                            \
@@ -164,7 +204,8 @@ void check_args(std::string const&, ...);
         __pragma(warning(push))                                         \
         __pragma(warning(disable:4127))                                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static LogHandle logHandle__;                               \
+            if (logHandle__.ShouldLog(filterType__, level__))           \
                 LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__); \
         } while (0)                                                     \
         __pragma(warning(pop))
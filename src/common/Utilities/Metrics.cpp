@@ -0,0 +1,245 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Metrics.h"
+#include "Config.h"
+#include "Log.h"
+#include "Errors.h"
+#include <algorithm>
+#include <fstream>
+
+uint64 GetHistogramPercentile(uint64 const* histogram, std::size_t size, uint32 percent, uint64 max)
+{
+    uint64 total = 0;
+    for (std::size_t i = 0; i < size; ++i)
+        total += histogram[i];
+
+    uint64 rank = (total * percent + 99) / 100;
+    uint64 seen = 0;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        seen += histogram[i];
+        if (seen && seen >= rank)
+            return i + 1 < size ? std::min((UI64LIT(1) << i) - 1, max) : max;
+    }
+
+    return 0;
+}
+
+uint64 MetricValue::GetPercentile(uint32 percent) const
+{
+    return GetHistogramPercentile(Histogram.data(), Histogram.size(), percent, Max);
+}
+
+Metrics::ThreadBlock::~ThreadBlock()
+{
+    for (std::atomic<Chunk*>& chunk : Chunks)
+        delete chunk.load();
+}
+
+Metrics::Slot& Metrics::ThreadBlock::GetSlot(uint32 id)
+{
+    std::atomic<Chunk*>& chunkPtr = Chunks[id / CHUNK_SIZE];
+    Chunk* chunk = chunkPtr.load(std::memory_order_relaxed);
+    if (!chunk)
+    {
+        chunk = new Chunk();
+        chunkPtr.store(chunk, std::memory_order_release);
+    }
+
+    return (*chunk)[id % CHUNK_SIZE];
+}
+
+Metrics::Metrics() : _enabled(false), _exportInterval(10), _stopExport(false)
+{
+    _metrics.reserve(CHUNK_SIZE * MAX_CHUNKS);
+}
+
+Metrics::~Metrics()
+{
+    Shutdown();
+}
+
+Metrics* Metrics::instance()
+{
+    static Metrics instance;
+    return &instance;
+}
+
+void Metrics::LoadFromConfig()
+{
+    Shutdown();
+
+    _enabled = sConfigMgr->GetBoolDefault("Metrics.Enable", false);
+    _exportFile = sConfigMgr->GetStringDefault("Metrics.File", "");
+    _exportInterval = std::max(sConfigMgr->GetIntDefault("Metrics.Interval", 10), 1);
+
+    if (_enabled && !_exportFile.empty())
+    {
+        _stopExport = false;
+        _exportThread = std::thread(&Metrics::ExportLoop, this);
+    }
+}
+
+void Metrics::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _stopExport = true;
+    }
+
+    _exportCondition.notify_all();
+    if (_exportThread.joinable())
+        _exportThread.join();
+}
+
+uint32 Metrics::Register(std::string const& name, MetricType type)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    auto itr = _ids.find(name);
+    if (itr != _ids.end())
+        return itr->second;
+
+    ASSERT(_metrics.size() < CHUNK_SIZE * MAX_CHUNKS, "Too many metrics registered, %s is one too many", name.c_str());
+
+    uint32 id = uint32(_metrics.size());
+    _metrics.emplace_back(name, type);
+    _ids[name] = id;
+    return id;
+}
+
+Metrics::ThreadBlock& Metrics::GetThreadBlock()
+{
+    thread_local ThreadBlock* block = nullptr;
+    if (!block)
+    {
+        // owned by the registry, values of finished threads stay in the totals
+        std::lock_guard<std::mutex> lock(_lock);
+        _threadBlocks.push_back(std::make_unique<ThreadBlock>());
+        block = _threadBlocks.back().get();
+    }
+
+    return *block;
+}
+
+void Metrics::Add(uint32 id, uint64 value /*= 1*/)
+{
+    if (!IsEnabled())
+        return;
+
+    // single writer, no read-modify-write needed
+    Slot& slot = GetThreadBlock().GetSlot(id);
+    slot.Count.store(slot.Count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    slot.Sum.store(slot.Sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void Metrics::Record(uint32 id, uint64 value)
+{
+    if (!IsEnabled())
+        return;
+
+    Slot& slot = GetThreadBlock().GetSlot(id);
+    slot.Count.store(slot.Count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    slot.Sum.store(slot.Sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    if (value > slot.Max.load(std::memory_order_relaxed))
+        slot.Max.store(value, std::memory_order_relaxed);
+
+    std::size_t bucket = 0;
+    for (uint64 rest = value; rest && bucket + 1 < METRIC_HISTOGRAM_SIZE; rest >>= 1)
+        ++bucket;
+
+    std::atomic<uint64>& count = slot.Histogram[bucket];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+std::vector<MetricValue> Metrics::Snapshot() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    std::vector<MetricValue> values(_metrics.size());
+    for (std::size_t i = 0; i < _metrics.size(); ++i)
+    {
+        MetricValue& value = values[i];
+        value.Name = _metrics[i].first;
+        value.Type = _metrics[i].second;
+        value.Count = 0;
+        value.Sum = 0;
+        value.Max = 0;
+        value.Histogram.fill(0);
+    }
+
+    for (std::unique_ptr<ThreadBlock> const& block : _threadBlocks)
+    {
+        for (uint32 c = 0; c < MAX_CHUNKS; ++c)
+        {
+            Chunk const* chunk = block->Chunks[c].load(std::memory_order_acquire);
+            if (!chunk)
+                continue;
+
+            for (uint32 s = 0; s < CHUNK_SIZE && c * CHUNK_SIZE + s < values.size(); ++s)
+            {
+                Slot const& slot = (*chunk)[s];
+                MetricValue& value = values[c * CHUNK_SIZE + s];
+                value.Count += slot.Count.load(std::memory_order_relaxed);
+                value.Sum += slot.Sum.load(std::memory_order_relaxed);
+                value.Max = std::max(value.Max, slot.Max.load(std::memory_order_relaxed));
+                for (std::size_t h = 0; h < METRIC_HISTOGRAM_SIZE; ++h)
+                    value.Histogram[h] += slot.Histogram[h].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    return values;
+}
+
+void Metrics::ExportLoop()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    while (!_stopExport)
+    {
+        _exportCondition.wait_for(lock, std::chrono::seconds(_exportInterval));
+        if (_stopExport)
+            break;
+
+        lock.unlock();
+        Export();
+        lock.lock();
+    }
+}
+
+// Appends the totals in InfluxDB line protocol, the file may as well be a named pipe read by a local agent
+void Metrics::Export()
+{
+    std::ofstream file(_exportFile, std::ios::app);
+    if (!file)
+    {
+        TC_LOG_ERROR("server", "Metrics: could not open %s for writing", _exportFile.c_str());
+        return;
+    }
+
+    uint64 timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    for (MetricValue const& value : Snapshot())
+    {
+        if (!value.Count)
+            continue;
+
+        file << value.Name << " count=" << value.Count << "i,sum=" << value.Sum << 'i';
+        if (value.Type == METRIC_TIMER)
+            file << ",max=" << value.Max << "i,p50=" << value.GetPercentile(50) << "i,p95=" << value.GetPercentile(95) << "i,p99=" << value.GetPercentile(99) << 'i';
+        file << ' ' << timestamp << '\n';
+    }
+}
@@ -0,0 +1,160 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRINITYCORE_METRICS_H
+#define TRINITYCORE_METRICS_H
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum MetricType : uint8
+{
+    METRIC_COUNTER,                                         // only count and sum
+    METRIC_TIMER                                            // microseconds, with a histogram for percentiles
+};
+
+#define METRIC_HISTOGRAM_SIZE 24                            // [0] = 0 us, [i] = 2^(i-1) to 2^i - 1 us, the last one also everything above
+
+// Upper bound of the log2 bucket holding the percentile of a histogram laid out like MetricValue::Histogram, at most max
+TC_COMMON_API uint64 GetHistogramPercentile(uint64 const* histogram, std::size_t size, uint32 percent, uint64 max);
+
+struct MetricValue
+{
+    std::string Name;                                       // line protocol measurement and tags, "map_update,map=571"
+    MetricType Type;
+    uint64 Count;
+    uint64 Sum;
+    uint64 Max;
+    std::array<uint64, METRIC_HISTOGRAM_SIZE> Histogram;
+
+    uint64 GetPercentile(uint32 percent) const;
+};
+
+// Counters and timers recorded per thread without locks or shared cache lines,
+// only Snapshot merges them (.server metrics and the export thread)
+class TC_COMMON_API Metrics
+{
+    public:
+        static constexpr uint32 CHUNK_SIZE = 64;
+        static constexpr uint32 MAX_CHUNKS = 128;           // 8192 metrics
+
+    private:
+        struct Slot
+        {
+            std::atomic<uint64> Count{ 0 };
+            std::atomic<uint64> Sum{ 0 };
+            std::atomic<uint64> Max{ 0 };
+            std::array<std::atomic<uint64>, METRIC_HISTOGRAM_SIZE> Histogram{ };
+        };
+
+        typedef std::array<Slot, CHUNK_SIZE> Chunk;
+
+        // Only written by its thread, chunks are allocated on first use of one of their metrics
+        struct ThreadBlock
+        {
+            std::array<std::atomic<Chunk*>, MAX_CHUNKS> Chunks{ };
+
+            ~ThreadBlock();
+            Slot& GetSlot(uint32 id);
+        };
+
+        Metrics();
+        ~Metrics();
+
+    public:
+        Metrics(Metrics const&) = delete;
+        Metrics& operator=(Metrics const&) = delete;
+
+        static Metrics* instance();
+
+        void LoadFromConfig();
+        void Shutdown();
+
+        bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+        // Same id for the same name, safe to cache in a static
+        uint32 Register(std::string const& name, MetricType type);
+
+        void Add(uint32 id, uint64 value = 1);
+        void Record(uint32 id, uint64 value);
+
+        std::vector<MetricValue> Snapshot() const;
+
+    private:
+        ThreadBlock& GetThreadBlock();
+        void ExportLoop();
+        void Export();
+
+        std::atomic<bool> _enabled;
+
+        mutable std::mutex _lock;                           // guards everything below
+        std::unordered_map<std::string, uint32> _ids;
+        std::vector<std::pair<std::string, MetricType>> _metrics;
+        std::vector<std::unique_ptr<ThreadBlock>> _threadBlocks;
+
+        std::string _exportFile;
+        uint32 _exportInterval;                             // seconds
+        std::thread _exportThread;
+        std::condition_variable _exportCondition;
+        bool _stopExport;
+};
+
+#define sMetrics Metrics::instance()
+
+// Records the time until the end of the scope into a METRIC_TIMER
+class MetricScopedTimer
+{
+    public:
+        explicit MetricScopedTimer(uint32 id) : _id(id), _enabled(sMetrics->IsEnabled())
+        {
+            if (_enabled)
+                _start = std::chrono::steady_clock::now();
+        }
+
+        ~MetricScopedTimer()
+        {
+            if (_enabled)
+                sMetrics->Record(_id, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count());
+        }
+
+        MetricScopedTimer(MetricScopedTimer const&) = delete;
+        MetricScopedTimer& operator=(MetricScopedTimer const&) = delete;
+
+    private:
+        uint32 _id;
+        bool _enabled;
+        std::chrono::steady_clock::time_point _start;
+};
+
+#define TC_METRIC_CONCAT_(a, b) a##b
+#define TC_METRIC_CONCAT(a, b) TC_METRIC_CONCAT_(a, b)
+
+// Times the rest of the scope, the name has to be constant for the call site
+#define TC_METRIC_TIMER(name) \
+    static uint32 const TC_METRIC_CONCAT(metricId, __LINE__) = sMetrics->Register(name, METRIC_TIMER); \
+    MetricScopedTimer TC_METRIC_CONCAT(metricTimer, __LINE__)(TC_METRIC_CONCAT(metricId, __LINE__))
+
+#endif
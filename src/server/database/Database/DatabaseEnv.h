@@ -29,6 +29,7 @@
 #include "PreparedStatement.h"
 #include "QueryCallback.h"
 #include "QueryResult.h"
+#include "QuerySnapshot.h"
 #include "Transaction.h"
 
 /// Accessor to the world database
@@ -37,5 +38,7 @@ TC_DATABASE_API extern DatabaseWorkerPool<WorldDatabaseConnection> WorldDatabase
 TC_DATABASE_API extern DatabaseWorkerPool<CharacterDatabaseConnection> CharacterDatabase;
 /// Accessor to the realm/login database
 TC_DATABASE_API extern DatabaseWorkerPool<LoginDatabaseConnection> LoginDatabase;
+/// Stored results of the large world table queries, only open during startup
+TC_DATABASE_API extern QuerySnapshot WorldDatabaseSnapshot;
 
 #endif
@@ -84,6 +84,15 @@ using WorldDatabaseQueryHolder = SQLQueryHolder<WorldDatabaseConnection>;
 
 class SQLQueryHolderCallback;
 
+// Async work of a database pool is queued per priority, the workers split their time by the configured shares
+enum DatabasePriority
+{
+    DATABASE_PRIORITY_INTERACTIVE,                          // queries and query holders somebody waits for (logins, lookups)
+    DATABASE_PRIORITY_GAMEPLAY,                             // one-way statements and transactions of the game state
+    DATABASE_PRIORITY_BACKGROUND,                           // logs and other bulk writes nobody waits for
+    MAX_DATABASE_PRIORITY
+};
+
 // mysql
 struct MySQLHandle;
 struct MySQLResult;
@@ -20,6 +20,7 @@
 #include "DatabaseEnv.h"
 #include "DBUpdater.h"
 #include "Log.h"
+#include "Util.h"
 
 #include <mysqld_error.h>
 
@@ -54,6 +55,18 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
         uint8 const synchThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.SynchThreads", 1));
 
         pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
+
+        std::array<uint32, MAX_DATABASE_PRIORITY> shares = { { 6, 3, 1 } };
+        Tokenizer sharesTokens(sConfigMgr->GetStringDefault(name + "Database.PriorityShares", "6 3 1"), ' ');
+        if (sharesTokens.size() == MAX_DATABASE_PRIORITY)
+        {
+            for (uint8 i = 0; i < MAX_DATABASE_PRIORITY; ++i)
+                shares[i] = std::max(uint32(atoi(sharesTokens[i])), 1u);
+        }
+        else
+            TC_LOG_ERROR(_logger, "%s database: invalid priority shares specified, expected %u numbers. Using the defaults.", name.c_str(), uint32(MAX_DATABASE_PRIORITY));
+
+        pool.SetPriorityShares(shares);
         if (uint32 error = pool.Open())
         {
             // Database does not exist
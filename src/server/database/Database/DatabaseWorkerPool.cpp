@@ -19,21 +19,27 @@
 #include "AdhocStatement.h"
 #include "Common.h"
 #include "Errors.h"
+#include "Field.h"
 #include "IoContext.h"
 #include "Implementation/LoginDatabase.h"
 #include "Implementation/WorldDatabase.h"
 #include "Implementation/CharacterDatabase.h"
 #include "Log.h"
+#include "Metrics.h"
 #include "MySQLPreparedStatement.h"
 #include "PreparedStatement.h"
 #include "ProducerConsumerQueue.h"
 #include "QueryCallback.h"
 #include "QueryHolder.h"
 #include "QueryResult.h"
+#include "StringFormat.h"
+#include "Timer.h"
 #include "Transaction.h"
 #include "MySQLWorkaround.h"
-#include <boost/asio/use_future.hpp>
 #include <mysqld_error.h>
+#include <algorithm>
+#include <cctype>
+#include <limits>
 #ifdef TRINITY_DEBUG
 #include <sstream>
 #include <boost/stacktrace.hpp>
@@ -49,59 +55,58 @@
 #define MIN_MARIADB_CLIENT_VERSION 30003u
 #define MIN_MARIADB_CLIENT_VERSION_STRING "3.0.3"
 
-template<typename T>
-struct DatabaseWorkerPool<T>::QueueSizeTracker
+// One-way statements queued back to back are executed in one transaction, at most this many
+#define MAX_EXECUTE_BATCH 32
+
+namespace
 {
-    explicit QueueSizeTracker(DatabaseWorkerPool* pool) : _pool(pool)
+    std::string ToLowerAscii(std::string str)
     {
-        ++_pool->_queueSize;
+        std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+        return str;
     }
 
-    QueueSizeTracker(QueueSizeTracker const& other) : _pool(other._pool) { ++_pool->_queueSize; }
-    QueueSizeTracker(QueueSizeTracker&& other) noexcept : _pool(std::exchange(other._pool, nullptr)) { }
-
-    QueueSizeTracker& operator=(QueueSizeTracker const& other)
+    bool IsIdentifierChar(char c)
     {
-        if (this != &other)
-        {
-            if (_pool != other._pool)
-            {
-                if (_pool)
-                    --_pool->_queueSize;
-                if (other._pool)
-                    ++other._pool->_queueSize;
-            }
-            _pool = other._pool;
-        }
-        return *this;
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
     }
-    QueueSizeTracker& operator=(QueueSizeTracker&& other) noexcept
+
+    // A batch is rolled back and its statements run again one by one when one of them fails,
+    // only plain row changes on transactional tables can be undone and replayed like that.
+    // Anything else (DDL commits implicitly, MyISAM/MEMORY tables ignore the rollback) runs alone.
+    bool IsReplayableStatement(std::string const& sql, std::vector<std::string> const& nonTransactionalTables)
     {
-        if (this != &other)
+        std::string const query = ToLowerAscii(sql);
+        std::size_t const begin = query.find_first_not_of(" \t\r\n(");
+        if (begin == std::string::npos)
+            return false;
+
+        std::size_t end = begin;
+        while (end < query.size() && IsIdentifierChar(query[end]))
+            ++end;
+
+        std::string const verb = query.substr(begin, end - begin);
+        if (verb != "insert" && verb != "replace" && verb != "update" && verb != "delete")
+            return false;
+
+        for (std::string const& table : nonTransactionalTables)
         {
-            if (_pool != other._pool)
+            for (std::size_t pos = query.find(table); pos != std::string::npos; pos = query.find(table, pos + 1))
             {
-                if (_pool)
-                    --_pool->_queueSize;
+                bool const startsWord = pos == 0 || !IsIdentifierChar(query[pos - 1]);
+                bool const endsWord = pos + table.size() == query.size() || !IsIdentifierChar(query[pos + table.size()]);
+                if (startsWord && endsWord)
+                    return false;
             }
-            _pool = std::exchange(other._pool, nullptr);
         }
-        return *this;
-    }
 
-    ~QueueSizeTracker()
-    {
-        if (_pool)
-            --_pool->_queueSize;
+        return true;
     }
-
-private:
-    DatabaseWorkerPool* _pool;
-};
+}
 
 template <class T>
 DatabaseWorkerPool<T>::DatabaseWorkerPool()
-    : _async_threads(0), _synch_threads(0)
+    : _stalledHandlers(0), _running(0), _hasWriteObserver(false), _async_threads(0), _synch_threads(0)
 {
     WPFatal(mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
 
@@ -129,6 +134,14 @@ void DatabaseWorkerPool<T>::SetConnectionInfo(std::string const& infoString,
     _synch_threads = synchThreads;
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::SetPriorityShares(std::array<uint32, MAX_DATABASE_PRIORITY> const& shares)
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+    for (uint8 i = 0; i < MAX_DATABASE_PRIORITY; ++i)
+        _queues[i].Share = std::max<uint32>(shares[i], 1);
+}
+
 template <class T>
 uint32 DatabaseWorkerPool<T>::Open()
 {
@@ -140,6 +153,14 @@ uint32 DatabaseWorkerPool<T>::Open()
 
     _ioContext = std::make_unique<Trinity::Asio::IoContext>(_async_threads);
 
+    static char const* const priorityNames[MAX_DATABASE_PRIORITY] = { "interactive", "gameplay", "background" };
+    for (uint8 i = 0; i < MAX_DATABASE_PRIORITY; ++i)
+    {
+        std::string tags = Trinity::StringFormat(",db=%s,queue=%s", GetDatabaseName(), priorityNames[i]);
+        _queues[i].WaitMetric = sMetrics->Register("db_wait" + tags, METRIC_TIMER);
+        _queues[i].ExecuteMetric = sMetrics->Register("db_execute" + tags, METRIC_TIMER);
+    }
+
     uint32 error = OpenConnections(IDX_ASYNC, _async_threads);
 
     if (error)
@@ -173,6 +194,10 @@ void DatabaseWorkerPool<T>::Close()
 
     _ioContext.reset();
 
+    //! Work the stopped workers did not get to, its promises are broken
+    for (PriorityQueue& queue : _queues)
+        queue.Tasks.clear();
+
     TC_LOG_INFO("sql.driver", "Asynchronous connections on DatabasePool '%s' terminated. "
                 "Proceeding with synchronous connections.",
         GetDatabaseName());
@@ -189,6 +214,15 @@ void DatabaseWorkerPool<T>::Close()
 template <class T>
 bool DatabaseWorkerPool<T>::PrepareStatements()
 {
+    std::vector<std::string> nonTransactionalTables;
+    if (QueryResult result = Query("SELECT TABLE_NAME FROM information_schema.TABLES WHERE TABLE_SCHEMA = DATABASE() AND (ENGINE IS NULL OR ENGINE <> 'InnoDB')"))
+    {
+        do
+        {
+            nonTransactionalTables.push_back(ToLowerAscii((*result)[0].GetString()));
+        } while (result->NextRow());
+    }
+
     for (auto& connections : _connections)
     {
         for (auto& connection : connections)
@@ -205,7 +239,11 @@ bool DatabaseWorkerPool<T>::PrepareStatements()
 
             size_t const preparedSize = connection->m_stmts.size();
             if (_preparedStatementSize.size() < preparedSize)
+            {
                 _preparedStatementSize.resize(preparedSize);
+                _replayableStatements.resize(preparedSize);
+                _preparedStatementQueries.resize(preparedSize);
+            }
 
             for (size_t i = 0; i < preparedSize; ++i)
             {
@@ -222,6 +260,8 @@ bool DatabaseWorkerPool<T>::PrepareStatements()
                     ASSERT(paramCount < std::numeric_limits<uint8>::max());
 
                     _preparedStatementSize[i] = static_cast<uint8>(paramCount);
+                    _replayableStatements[i] = IsReplayableStatement(stmt->GetRawQueryString(), nonTransactionalTables);
+                    _preparedStatementQueries[i] = stmt->GetRawQueryString();
                 }
             }
         }
@@ -256,35 +296,42 @@ PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
 }
 
 template <class T>
-QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql)
+QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql, DatabasePriority priority /*= DATABASE_PRIORITY_INTERACTIVE*/)
 {
-    QueryResultFuture result = boost::asio::post(_ioContext->get_executor(), boost::asio::use_future([this, sql = std::string(sql), tracker = QueueSizeTracker(this)]
+    std::shared_ptr<QueryResultPromise> promise = std::make_shared<QueryResultPromise>();
+    QueryResultFuture result = promise->get_future();
+    Post(priority, [sql = std::string(sql), promise](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
-        return BasicStatementTask::Query(conn, sql.c_str());
-    }));
+        promise->set_value(BasicStatementTask::Query(conn, sql.c_str()));
+        return true;
+    }, false);
     return QueryCallback(std::move(result));
 }
 
 template <class T>
-QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
+QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt, DatabasePriority priority /*= DATABASE_PRIORITY_INTERACTIVE*/)
 {
-    PreparedQueryResultFuture result = boost::asio::post(_ioContext->get_executor(), boost::asio::use_future([this, stmt = std::unique_ptr<PreparedStatement<T>>(stmt), tracker = QueueSizeTracker(this)]
+    std::shared_ptr<PreparedQueryResultPromise> promise = std::make_shared<PreparedQueryResultPromise>();
+    PreparedQueryResultFuture result = promise->get_future();
+    Post(priority, [stmt = std::shared_ptr<PreparedStatement<T>>(stmt), promise](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
-        return PreparedStatementTask::Query(conn, stmt.get());
-    }));
+        promise->set_value(PreparedStatementTask::Query(conn, stmt.get()));
+        return true;
+    }, false);
     return QueryCallback(std::move(result));
 }
 
 template <class T>
-SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder)
+SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, DatabasePriority priority /*= DATABASE_PRIORITY_INTERACTIVE*/)
 {
-    QueryResultHolderFuture result = boost::asio::post(_ioContext->get_executor(), boost::asio::use_future([this, holder, tracker = QueueSizeTracker(this)]
+    std::shared_ptr<QueryResultHolderPromise> promise = std::make_shared<QueryResultHolderPromise>();
+    QueryResultHolderFuture result = promise->get_future();
+    Post(priority, [holder, promise](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
         SQLQueryHolderTask::Execute(conn, holder.get());
-    }));
+        promise->set_value();
+        return true;
+    }, false);
     return { std::move(holder), std::move(result) };
 }
 
@@ -295,8 +342,9 @@ SQLTransaction<T> DatabaseWorkerPool<T>::BeginTransaction()
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
+void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction, DatabasePriority priority /*= DATABASE_PRIORITY_GAMEPLAY*/)
 {
+    NotifyWrite();
 #ifdef TRINITY_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
     //! Ideally we catch the faults in Debug mode and then correct them,
@@ -314,16 +362,16 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
     }
 #endif // TRINITY_DEBUG
 
-    boost::asio::post(_ioContext->get_executor(), [this, transaction, tracker = QueueSizeTracker(this)]
+    Post(priority, [transaction](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
-        TransactionTask::Execute(conn, transaction);
-    });
+        return TransactionTask::Execute(conn, transaction);
+    }, false);
 }
 
 template <class T>
-TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction<T> transaction)
+TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction<T> transaction, DatabasePriority priority /*= DATABASE_PRIORITY_GAMEPLAY*/)
 {
+    NotifyWrite();
 #ifdef TRINITY_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
     //! Ideally we catch the faults in Debug mode and then correct them,
@@ -341,17 +389,21 @@ TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction
     }
 #endif // TRINITY_DEBUG
 
-    TransactionFuture result = boost::asio::post(_ioContext->get_executor(), boost::asio::use_future([this, transaction, tracker = QueueSizeTracker(this)]
+    std::shared_ptr<TransactionPromise> promise = std::make_shared<TransactionPromise>();
+    TransactionFuture result = promise->get_future();
+    Post(priority, [transaction, promise](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
-        return TransactionTask::Execute(conn, transaction);
-    }));
+        bool success = TransactionTask::Execute(conn, transaction);
+        promise->set_value(success);
+        return success;
+    }, false);
     return TransactionCallback(std::move(result));
 }
 
 template <class T>
 void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction<T>& transaction)
 {
+    NotifyWrite();
     T* connection = GetFreeConnection();
     int errorCode = connection->ExecuteTransaction(transaction);
     if (!errorCode)
@@ -416,7 +468,7 @@ void DatabaseWorkerPool<T>::KeepAlive()
     auto const count = _connections[IDX_ASYNC].size();
     for (uint8 i = 0; i < count; ++i)
     {
-        boost::asio::post(_ioContext->get_executor(), [this, tracker = QueueSizeTracker(this)]
+        boost::asio::post(_ioContext->get_executor(), [this]
         {
             T* conn = GetAsyncConnectionForCurrentThread();
             conn->Ping();
@@ -476,7 +528,207 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, un
 template <class T>
 size_t DatabaseWorkerPool<T>::QueueSize() const
 {
-    return _queueSize;
+    std::lock_guard<std::mutex> lock(_queueLock);
+    std::size_t size = _running;
+    for (PriorityQueue const& queue : _queues)
+        size += queue.Tasks.size();
+    return size;
+}
+
+template <class T>
+DatabaseQueueStats DatabaseWorkerPool<T>::GetQueueStats(DatabasePriority priority) const
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+    PriorityQueue const& queue = _queues[priority];
+
+    DatabaseQueueStats stats;
+    stats.Depth = queue.Tasks.size();
+    stats.Posted = queue.Posted;
+    stats.Executed = queue.Executed;
+    stats.Batched = queue.Batched;
+
+    auto percentile = [&](uint32 percent) -> uint32
+    {
+        return uint32(GetHistogramPercentile(queue.WaitHistogram.data(), WAIT_HISTOGRAM_SIZE, percent, std::numeric_limits<uint32>::max()));
+    };
+
+    stats.WaitP50 = percentile(50);
+    stats.WaitP95 = percentile(95);
+    stats.WaitP99 = percentile(99);
+    return stats;
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::Post(DatabasePriority priority, std::function<bool(T*)> work, bool oneWay)
+{
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        // everything outside the gameplay queue sees the gameplay writes posted before it, like the single FIFO did
+        // (a character enum after its create, a login after its logout save), only later writes are overtaken.
+        // The fence can only grow along a queue, a fenced task never holds back one that could run before it.
+        uint64 const writeFence = priority != DATABASE_PRIORITY_GAMEPLAY ? _queues[DATABASE_PRIORITY_GAMEPLAY].Posted : 0;
+
+        PriorityQueue& queue = _queues[priority];
+        queue.Tasks.push_back({ std::move(work), ++queue.Posted, writeFence, getMSTime(), oneWay });
+    }
+
+    boost::asio::post(_ioContext->get_executor(), [this] { ProcessTask(); });
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::ObserveNextWrite(std::function<void()> observer)
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+    _writeObserver = std::move(observer);
+    _hasWriteObserver = bool(_writeObserver);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::NotifyWrite()
+{
+    if (!_hasWriteObserver.load(std::memory_order_relaxed))
+        return;
+
+    std::function<void()> observer;
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        observer = std::move(_writeObserver);
+        _writeObserver = nullptr;
+        _hasWriteObserver = false;
+    }
+
+    if (observer)
+        observer();
+}
+
+template <class T>
+bool DatabaseWorkerPool<T>::IsFenceReached(uint64 writeFence) const
+{
+    // gameplay tasks start in order, all up to the fence have to be started and none of them still running
+    return _queues[DATABASE_PRIORITY_GAMEPLAY].Started >= writeFence
+        && (_runningWrites.empty() || *_runningWrites.begin() > writeFence);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::ProcessTask()
+{
+    std::vector<Task> tasks;
+    uint8 picked = MAX_DATABASE_PRIORITY;
+
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+
+        uint32 shares = 0;
+        for (uint8 i = 0; i < MAX_DATABASE_PRIORITY; ++i)
+        {
+            PriorityQueue& queue = _queues[i];
+            if (queue.Tasks.empty() || !IsFenceReached(queue.Tasks.front().WriteFence))
+                continue;
+
+            queue.Credit += queue.Share;
+            shares += queue.Share;
+            if (picked == MAX_DATABASE_PRIORITY || queue.Credit > _queues[picked].Credit)
+                picked = i;
+        }
+
+        if (picked == MAX_DATABASE_PRIORITY)
+        {
+            // batches take several tasks per handler, only fenced tasks need this handler again later
+            for (PriorityQueue const& queue : _queues)
+            {
+                if (!queue.Tasks.empty())
+                {
+                    ++_stalledHandlers;
+                    break;
+                }
+            }
+            return;
+        }
+
+        PriorityQueue& queue = _queues[picked];
+        queue.Credit -= shares;
+
+        uint32 now = getMSTime();
+        do
+        {
+            Task& task = queue.Tasks.front();
+            uint32 wait = getMSTimeDiff(task.PostTime, now);
+            sMetrics->Record(queue.WaitMetric, uint64(wait) * IN_MILLISECONDS);
+            std::size_t bucket = 0;
+            while (wait && bucket + 1 < WAIT_HISTOGRAM_SIZE)
+            {
+                wait >>= 1;
+                ++bucket;
+            }
+            ++queue.WaitHistogram[bucket];
+
+            ++queue.Started;
+            if (picked == DATABASE_PRIORITY_GAMEPLAY)
+                _runningWrites.insert(task.Sequence);
+
+            tasks.push_back(std::move(task));
+            queue.Tasks.pop_front();
+        } while (tasks.back().OneWay && tasks.size() < MAX_EXECUTE_BATCH && !queue.Tasks.empty()
+            && queue.Tasks.front().OneWay && IsFenceReached(queue.Tasks.front().WriteFence));
+
+        queue.Batched += tasks.size() - 1;
+        _running += tasks.size();
+    }
+
+    T* conn = GetAsyncConnectionForCurrentThread();
+    {
+        MetricScopedTimer executeTimer(_queues[picked].ExecuteMetric);
+        if (tasks.size() == 1)
+            tasks.front().Work(conn);
+        else
+            ExecuteBatch(conn, tasks);
+    }
+
+    uint32 stalled = 0;
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        PriorityQueue& queue = _queues[picked];
+        queue.Executed += tasks.size();
+        _running -= tasks.size();
+        if (picked == DATABASE_PRIORITY_GAMEPLAY)
+            for (Task const& task : tasks)
+                _runningWrites.erase(task.Sequence);
+
+        stalled = std::exchange(_stalledHandlers, 0);
+    }
+
+    for (uint32 i = 0; i < stalled; ++i)
+        boost::asio::post(_ioContext->get_executor(), [this] { ProcessTask(); });
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::ExecuteBatch(T* connection, std::vector<Task>& tasks)
+{
+    // one commit for the whole batch instead of one per statement,
+    // only replayable statements get here (see IsReplayableStatement)
+    if (connection->BeginTransaction())
+    {
+        bool failed = false;
+        for (Task& task : tasks)
+        {
+            if (!task.Work(connection))
+            {
+                failed = true;
+                break;
+            }
+        }
+
+        if (!failed && connection->CommitTransaction())
+            return;
+
+        // a failed statement may have taken the others down with it (deadlock, lost connection),
+        // run them one by one like they would have been without the batch
+        if (!connection->RollbackTransaction())
+            TC_LOG_ERROR("sql.driver", "DatabasePool %s: rollback of a batch of %u statements failed, running them one by one.", GetDatabaseName(), uint32(tasks.size()));
+    }
+
+    for (Task& task : tasks)
+        task.Work(connection);
 }
 
 template <class T>
@@ -524,26 +776,30 @@ char const* DatabaseWorkerPool<T>::GetDatabaseName() const
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Execute(char const* sql)
+void DatabaseWorkerPool<T>::Execute(char const* sql, DatabasePriority priority /*= DATABASE_PRIORITY_GAMEPLAY*/)
 {
     if (!sql)
         return;
 
-    boost::asio::post(_ioContext->get_executor(), [this, sql = std::string(sql), tracker = QueueSizeTracker(this)]
+    NotifyWrite();
+
+    Post(priority, [sql = std::string(sql)](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
-        BasicStatementTask::Execute(conn, sql.c_str());
-    });
+        return BasicStatementTask::Execute(conn, sql.c_str());
+    }, false);
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt)
+void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt, DatabasePriority priority /*= DATABASE_PRIORITY_GAMEPLAY*/)
 {
-    boost::asio::post(_ioContext->get_executor(), [this, stmt = std::unique_ptr<PreparedStatement<T>>(stmt), tracker = QueueSizeTracker(this)]
+    NotifyWrite();
+
+    // ad-hoc SQL above is never batched, its text is not known before it runs
+    bool const replayable = stmt->GetIndex() < _replayableStatements.size() && _replayableStatements[stmt->GetIndex()];
+    Post(priority, [stmt = std::shared_ptr<PreparedStatement<T>>(stmt)](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
-        PreparedStatementTask::Execute(conn, stmt.get());
-    });
+        return PreparedStatementTask::Execute(conn, stmt.get());
+    }, replayable);
 }
 
 template <class T>
@@ -552,6 +808,8 @@ void DatabaseWorkerPool<T>::DirectExecute(char const* sql)
     if (!sql)
         return;
 
+    NotifyWrite();
+
     T* connection = GetFreeConnection();
     BasicStatementTask::Execute(connection, sql);
     connection->Unlock();
@@ -560,6 +818,7 @@ void DatabaseWorkerPool<T>::DirectExecute(char const* sql)
 template <class T>
 void DatabaseWorkerPool<T>::DirectExecute(PreparedStatement<T>* stmt)
 {
+    NotifyWrite();
     T* connection = GetFreeConnection();
     PreparedStatementTask::Execute(connection, stmt);
     connection->Unlock();
@@ -23,11 +23,27 @@
 #include "DatabaseEnvFwd.h"
 #include "StringFormat.h"
 #include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
 struct MySQLConnectionInfo;
 
+struct DatabaseQueueStats
+{
+    std::size_t Depth;                                      // queued, not started yet
+    uint64 Posted;
+    uint64 Executed;
+    uint64 Batched;                                         // one-way statements that joined the transaction of the one before them
+    uint32 WaitP50;                                         // ms from posting to start, upper bound of the histogram bucket
+    uint32 WaitP95;
+    uint32 WaitP99;
+};
+
 template <class T>
 class DatabaseWorkerPool
 {
@@ -47,6 +63,9 @@ class DatabaseWorkerPool
 
         void SetConnectionInfo(std::string const& infoString, uint8 const asyncThreads, uint8 const synchThreads);
 
+        //! Relative share of the async workers each priority gets while several of them have queued work.
+        void SetPriorityShares(std::array<uint32, MAX_DATABASE_PRIORITY> const& shares);
+
         uint32 Open();
 
         void Close();
@@ -65,7 +84,7 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in string format that will be executed asynchronously.
         //! This method should only be used for queries that are only executed once, e.g during startup.
-        void Execute(char const* sql);
+        void Execute(char const* sql, DatabasePriority priority = DATABASE_PRIORITY_GAMEPLAY);
 
         //! Enqueues a one-way SQL operation in string format -with variable args- that will be executed asynchronously.
         //! This method should only be used for queries that are only executed once, e.g during startup.
@@ -80,7 +99,7 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        void Execute(PreparedStatement<T>* stmt);
+        void Execute(PreparedStatement<T>* stmt, DatabasePriority priority = DATABASE_PRIORITY_GAMEPLAY);
 
         /**
             Direct synchronous one-way statement methods.
@@ -146,18 +165,19 @@ class DatabaseWorkerPool
 
         //! Enqueues a query in string format that will set the value of the QueryResultFuture return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
-        QueryCallback AsyncQuery(char const* sql);
+        QueryCallback AsyncQuery(char const* sql, DatabasePriority priority = DATABASE_PRIORITY_INTERACTIVE);
 
         //! Enqueues a query in prepared format that will set the value of the PreparedQueryResultFuture return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        QueryCallback AsyncQuery(PreparedStatement<T>* stmt);
+        QueryCallback AsyncQuery(PreparedStatement<T>* stmt, DatabasePriority priority = DATABASE_PRIORITY_INTERACTIVE);
 
         //! Enqueues a vector of SQL operations (can be both adhoc and prepared) that will set the value of the QueryResultHolderFuture
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder);
+        //! Like AsyncQuery, the holder does not start before the gameplay writes posted ahead of it are done.
+        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, DatabasePriority priority = DATABASE_PRIORITY_INTERACTIVE);
 
         /**
             Transaction context methods.
@@ -168,11 +188,11 @@ class DatabaseWorkerPool
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
-        void CommitTransaction(SQLTransaction<T> transaction);
+        void CommitTransaction(SQLTransaction<T> transaction, DatabasePriority priority = DATABASE_PRIORITY_GAMEPLAY);
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
-        TransactionCallback AsyncCommitTransaction(SQLTransaction<T> transaction);
+        TransactionCallback AsyncCommitTransaction(SQLTransaction<T> transaction, DatabasePriority priority = DATABASE_PRIORITY_GAMEPLAY);
 
         //! Directly executes a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
@@ -212,7 +232,46 @@ class DatabaseWorkerPool
 
         size_t QueueSize() const;
 
+        DatabaseQueueStats GetQueueStats(DatabasePriority priority) const;
+
+        //! SQL of a prepared statement, with ? for its parameters.
+        std::string const& GetPreparedStatementQuery(uint32 index) const { return _preparedStatementQueries[index]; }
+
+        //! Calls observer once, on the next write posted or executed through this pool (statements and transactions).
+        void ObserveNextWrite(std::function<void()> observer);
+
     private:
+        static constexpr std::size_t WAIT_HISTOGRAM_SIZE = 24;  // [0] = 0 ms, [i] = 2^(i-1) to 2^i - 1 ms
+
+        struct Task
+        {
+            std::function<bool(T*)> Work;
+            uint64 Sequence;                                // in its queue
+            uint64 WriteFence;                              // gameplay writes that have to be done before the start
+            uint32 PostTime;
+            bool OneWay;                                    // replayable one-way statement, may share a transaction with the ones next to it
+        };
+
+        struct PriorityQueue
+        {
+            std::deque<Task> Tasks;
+            uint32 Share = 1;
+            int64 Credit = 0;                               // smooth weighted round robin between the queues
+            uint64 Posted = 0;
+            uint64 Started = 0;
+            uint64 Executed = 0;
+            uint64 Batched = 0;
+            std::array<uint64, WAIT_HISTOGRAM_SIZE> WaitHistogram = { };
+            uint32 WaitMetric = 0;                          // db_wait timer
+            uint32 ExecuteMetric = 0;                       // db_execute timer, per task or batch
+        };
+
+        void Post(DatabasePriority priority, std::function<bool(T*)> work, bool oneWay);
+        void ProcessTask();
+        bool IsFenceReached(uint64 writeFence) const;
+        void ExecuteBatch(T* connection, std::vector<Task>& tasks);
+        void NotifyWrite();
+
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
         unsigned long EscapeString(char* to, char const* from, unsigned long length);
@@ -225,15 +284,21 @@ class DatabaseWorkerPool
 
         char const* GetDatabaseName() const;
 
-        struct QueueSizeTracker;
-        friend QueueSizeTracker;
-
-        //! Queue shared by async worker threads.
+        //! Wakes the async worker threads, one handler per posted task.
         std::unique_ptr<Trinity::Asio::IoContext> _ioContext;
-        std::atomic<size_t> _queueSize;
+        //! Work of the async worker threads, a handler runs the next task of the queue picked by the shares.
+        std::array<PriorityQueue, MAX_DATABASE_PRIORITY> _queues;
+        std::set<uint64> _runningWrites;                    // sequences of started, unfinished gameplay tasks
+        uint32 _stalledHandlers;                            // handlers that found only fenced tasks
+        std::size_t _running;
+        mutable std::mutex _queueLock;
         std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
         std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
         std::vector<uint8> _preparedStatementSize;
+        std::vector<bool> _replayableStatements;            // prepared statements that may share a transaction (ExecuteBatch)
+        std::vector<std::string> _preparedStatementQueries;
+        std::function<void()> _writeObserver;               // guarded by _queueLock
+        std::atomic<bool> _hasWriteObserver;
         uint8 _async_threads, _synch_threads;
 #ifdef TRINITY_DEBUG
         static inline thread_local bool _warnSyncQueries = false;
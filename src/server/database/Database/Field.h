@@ -84,6 +84,7 @@ class TC_DATABASE_API Field
 {
     friend class ResultSet;
     friend class PreparedResultSet;
+    friend class QuerySnapshot;
 
     public:
         Field();
@@ -366,19 +366,19 @@ bool MySQLConnection::_Query(const char* sql, MySQLResult** pResult, MySQLField*
     return true;
 }
 
-void MySQLConnection::BeginTransaction()
+bool MySQLConnection::BeginTransaction()
 {
-    Execute("START TRANSACTION");
+    return Execute("START TRANSACTION");
 }
 
-void MySQLConnection::RollbackTransaction()
+bool MySQLConnection::RollbackTransaction()
 {
-    Execute("ROLLBACK");
+    return Execute("ROLLBACK");
 }
 
-void MySQLConnection::CommitTransaction()
+bool MySQLConnection::CommitTransaction()
 {
-    Execute("COMMIT");
+    return Execute("COMMIT");
 }
 
 int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transaction)
@@ -42,6 +42,7 @@ class TC_DATABASE_API MySQLPreparedStatement
         void BindParameters(PreparedStatementBase* stmt);
 
         uint32 GetParameterCount() const { return m_paramCount; }
+        std::string const& GetRawQueryString() const { return m_queryString; }
 
     protected:
         void SetParameter(uint8 index, std::nullptr_t);
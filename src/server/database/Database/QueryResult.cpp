@@ -21,6 +21,7 @@
 #include "Log.h"
 #include "MySQLHacks.h"
 #include "MySQLWorkaround.h"
+#include "QuerySnapshot.h"
 
 namespace
 {
@@ -168,7 +169,9 @@ ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, u
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_snapshotRow(nullptr),
+_snapshotRowsLeft(0)
 {
     _fieldMetadata.resize(_fieldCount);
     _currentRow = new Field[_fieldCount];
@@ -179,6 +182,21 @@ _fields(fields)
     }
 }
 
+ResultSet::ResultSet(std::vector<QueryResultFieldMetadata> const& fieldMetadata, uint64 rowCount, char const* rows, std::shared_ptr<void const> storage) :
+_fieldMetadata(fieldMetadata),
+_rowCount(rowCount),
+_fieldCount(fieldMetadata.size()),
+_result(nullptr),
+_fields(nullptr),
+_snapshotRow(rows),
+_snapshotRowsLeft(rowCount),
+_snapshotStorage(std::move(storage))
+{
+    _currentRow = new Field[_fieldCount];
+    for (uint32 i = 0; i < _fieldCount; i++)
+        _currentRow[i].SetMetadata(&_fieldMetadata[i]);
+}
+
 PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount) :
 m_rowCount(rowCount),
 m_rowPosition(0),
@@ -311,6 +329,31 @@ m_metadataResult(result)
     mysql_stmt_free_result(m_stmt);
 }
 
+PreparedResultSet::PreparedResultSet(std::vector<QueryResultFieldMetadata> const& fieldMetadata, uint64 rowCount, char const* rows, std::shared_ptr<void const> storage) :
+m_fieldMetadata(fieldMetadata),
+m_rowCount(rowCount),
+m_rowPosition(0),
+m_fieldCount(fieldMetadata.size()),
+m_rBind(nullptr),
+m_stmt(nullptr),
+m_metadataResult(nullptr),
+m_snapshotStorage(std::move(storage))
+{
+    m_rows.resize(uint32(m_rowCount) * m_fieldCount);
+    for (uint32 row = 0; row < m_rowCount; ++row)
+    {
+        for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
+        {
+            char const* value;
+            uint32 length;
+            rows = QuerySnapshot::ReadValue(rows, value, length);
+
+            m_rows[row * m_fieldCount + fIndex].SetMetadata(&m_fieldMetadata[fIndex]);
+            m_rows[row * m_fieldCount + fIndex].SetByteValue(value, length);
+        }
+    }
+}
+
 ResultSet::~ResultSet()
 {
     CleanUp();
@@ -323,6 +366,26 @@ PreparedResultSet::~PreparedResultSet()
 
 bool ResultSet::NextRow()
 {
+    if (_snapshotStorage)
+    {
+        if (!_snapshotRowsLeft)
+        {
+            CleanUp();
+            return false;
+        }
+
+        for (uint32 i = 0; i < _fieldCount; i++)
+        {
+            char const* value;
+            uint32 length;
+            _snapshotRow = QuerySnapshot::ReadValue(_snapshotRow, value, length);
+            _currentRow[i].SetStructuredValue(value, length);
+        }
+
+        --_snapshotRowsLeft;
+        return true;
+    }
+
     MYSQL_ROW row;
 
     if (!_result)
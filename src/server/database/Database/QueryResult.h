@@ -20,12 +20,17 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <memory>
 #include <vector>
 
 class TC_DATABASE_API ResultSet
 {
+    friend class QuerySnapshot;
+
     public:
         ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount);
+        /// Rows stored by QuerySnapshot, storage keeps them alive
+        ResultSet(std::vector<QueryResultFieldMetadata> const& fieldMetadata, uint64 rowCount, char const* rows, std::shared_ptr<void const> storage);
         ~ResultSet();
 
         bool NextRow();
@@ -46,14 +51,22 @@ class TC_DATABASE_API ResultSet
         MySQLResult* _result;
         MySQLField* _fields;
 
+        char const* _snapshotRow;                           // next row of a stored result
+        uint64 _snapshotRowsLeft;
+        std::shared_ptr<void const> _snapshotStorage;
+
         ResultSet(ResultSet const& right) = delete;
         ResultSet& operator=(ResultSet const& right) = delete;
 };
 
 class TC_DATABASE_API PreparedResultSet
 {
+    friend class QuerySnapshot;
+
     public:
         PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount);
+        /// Rows stored by QuerySnapshot, storage keeps them alive
+        PreparedResultSet(std::vector<QueryResultFieldMetadata> const& fieldMetadata, uint64 rowCount, char const* rows, std::shared_ptr<void const> storage);
         ~PreparedResultSet();
 
         bool NextRow();
@@ -74,6 +87,7 @@ class TC_DATABASE_API PreparedResultSet
         MySQLBind* m_rBind;
         MySQLStmt* m_stmt;
         MySQLResult* m_metadataResult;    ///< Field metadata, returned by mysql_stmt_result_metadata
+        std::shared_ptr<void const> m_snapshotStorage;
 
         void CleanUp();
         bool _NextRow();
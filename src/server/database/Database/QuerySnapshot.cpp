@@ -0,0 +1,467 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "QuerySnapshot.h"
+#include "CryptoHash.h"
+#include "Errors.h"
+#include "Log.h"
+#include "QueryResult.h"
+#include "StringFormat.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    // File: magic, version, key, checksum of the entries, entry count, entries
+    // Entry: query (prepared: # SQL, then per parameter its type index and length-prefixed value), prepared flag, field metadata, row count, size of the rows, rows
+    // Row: per field the length (NULL_LENGTH for NULL) and the value followed by a terminating 0
+    char const SnapshotMagic[4] = { 'Q', 'S', 'N', 'P' };
+    uint32 const SnapshotVersion = 2;
+    uint32 const NULL_LENGTH = 0xFFFFFFFF;
+
+    template<class T>
+    void Write(std::vector<char>& buffer, T value)
+    {
+        char const* bytes = reinterpret_cast<char const*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void WriteString(std::vector<char>& buffer, char const* string, uint32 length)
+    {
+        Write<uint32>(buffer, length);
+        buffer.insert(buffer.end(), string, string + length);
+        buffer.push_back('\0');
+    }
+
+    void WriteString(std::vector<char>& buffer, char const* string)
+    {
+        WriteString(buffer, string ? string : "", string ? strlen(string) : 0);
+    }
+
+    // Reads from a file that may be truncated or damaged, so every read checks the end
+    class Reader
+    {
+        public:
+            Reader(char const* pos, char const* end) : _pos(pos), _end(end) { }
+
+            template<class T>
+            bool Read(T& value)
+            {
+                if (std::size_t(_end - _pos) < sizeof(T))
+                    return false;
+
+                memcpy(&value, _pos, sizeof(T));
+                _pos += sizeof(T);
+                return true;
+            }
+
+            bool ReadString(char const*& string, uint32& length)
+            {
+                if (!Read(length) || std::size_t(_end - _pos) <= length || _pos[length] != '\0')
+                    return false;
+
+                string = _pos;
+                _pos += length + 1;
+                return true;
+            }
+
+            bool Skip(uint64 size)
+            {
+                if (uint64(_end - _pos) < size)
+                    return false;
+
+                _pos += size;
+                return true;
+            }
+
+            char const* GetPos() const { return _pos; }
+
+        private:
+            char const* _pos;
+            char const* _end;
+    };
+}
+
+QuerySnapshot::QuerySnapshot() : _open(false), _changed(false), _discarded(false)
+{
+}
+
+QuerySnapshot::~QuerySnapshot()
+{
+    Close();
+}
+
+void QuerySnapshot::Open(std::string const& fileName, std::string const& key)
+{
+    Close();
+
+    _fileName = fileName;
+    _key = key;
+    _open = true;
+    _discarded = false;
+
+    std::shared_ptr<boost::interprocess::mapped_region> mapping;
+    try
+    {
+        boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+        mapping = std::make_shared<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const&)
+    {
+        TC_LOG_INFO("sql.sql", "Query snapshot %s not found, startup queries will be stored in a new one", fileName.c_str());
+        return;
+    }
+
+    char const* data = static_cast<char const*>(mapping->get_address());
+    Reader reader(data, data + mapping->get_size());
+
+    char magic[4];
+    uint32 version;
+    char const* fileKey;
+    uint32 fileKeyLength;
+    Trinity::Crypto::SHA1::Digest checksum;
+    if (!reader.Read(magic) || memcmp(magic, SnapshotMagic, sizeof(magic)) || !reader.Read(version) || version != SnapshotVersion
+        || !reader.ReadString(fileKey, fileKeyLength) || key != std::string(fileKey, fileKeyLength) || !reader.Read(checksum))
+    {
+        TC_LOG_INFO("sql.sql", "Query snapshot %s is outdated, startup queries will be stored in a new one", fileName.c_str());
+        return;
+    }
+
+    char const* entries = reader.GetPos();
+    std::size_t entriesSize = data + mapping->get_size() - entries;
+    if (Trinity::Crypto::SHA1::GetDigestOf(reinterpret_cast<uint8 const*>(entries), entriesSize) != checksum)
+    {
+        TC_LOG_ERROR("sql.sql", "Query snapshot %s is damaged, startup queries will be stored in a new one", fileName.c_str());
+        return;
+    }
+
+    _mapping = mapping;
+    if (!ReadEntries(entries, entriesSize))
+    {
+        TC_LOG_ERROR("sql.sql", "Query snapshot %s is damaged, startup queries will be stored in a new one", fileName.c_str());
+        _entries.clear();
+        _mapping.reset();
+        return;
+    }
+
+    TC_LOG_INFO("sql.sql", "Using query snapshot %s with %u stored results", fileName.c_str(), uint32(_entries.size()));
+}
+
+bool QuerySnapshot::ReadEntries(char const* data, std::size_t size)
+{
+    Reader reader(data, data + size);
+
+    uint32 entryCount;
+    if (!reader.Read(entryCount))
+        return false;
+
+    for (uint32 i = 0; i < entryCount; ++i)
+    {
+        Entry entry;
+        entry.Data = reader.GetPos();
+        entry.Storage = _mapping;
+
+        char const* key;
+        uint32 keyLength;
+        uint32 fieldCount;
+        if (!reader.ReadString(key, keyLength) || !reader.Read(entry.Prepared) || !reader.Read(fieldCount))
+            return false;
+
+        entry.Fields.resize(fieldCount);
+        for (uint32 f = 0; f < fieldCount; ++f)
+        {
+            QueryResultFieldMetadata& meta = entry.Fields[f];
+            uint32 length;
+            if (!reader.Read(meta.Type) || !reader.ReadString(meta.TableName, length) || !reader.ReadString(meta.Name, length) || !reader.ReadString(meta.TypeName, length))
+                return false;
+
+            meta.TableAlias = meta.TableName;
+            meta.Alias = meta.Name;
+            meta.Index = f;
+        }
+
+        uint64 rowsSize;
+        if (!reader.Read(entry.RowCount) || !reader.Read(rowsSize))
+            return false;
+
+        entry.Rows = reader.GetPos();
+        if (!reader.Skip(rowsSize))
+            return false;
+
+        entry.Size = reader.GetPos() - entry.Data;
+        _entries[std::string(key, keyLength)] = std::move(entry);
+    }
+
+    return true;
+}
+
+void QuerySnapshot::Close()
+{
+    if (!_open)
+        return;
+
+    if (_changed && !_discarded)
+    {
+        std::vector<char> body;
+        Write<uint32>(body, _entries.size());
+        for (auto const& itr : _entries)
+            body.insert(body.end(), itr.second.Data, itr.second.Data + itr.second.Size);
+
+        std::vector<char> header;
+        header.insert(header.end(), SnapshotMagic, SnapshotMagic + sizeof(SnapshotMagic));
+        Write<uint32>(header, SnapshotVersion);
+        WriteString(header, _key.c_str(), _key.length());
+        Write(header, Trinity::Crypto::SHA1::GetDigestOf(reinterpret_cast<uint8 const*>(body.data()), body.size()));
+
+        // the mapped file may still be in use, write next to it and replace it once complete
+        std::string tempFileName = _fileName + ".tmp";
+        bool written = false;
+        if (FILE* file = fopen(tempFileName.c_str(), "wb"))
+        {
+            written = fwrite(header.data(), 1, header.size(), file) == header.size()
+                && fwrite(body.data(), 1, body.size(), file) == body.size();
+            written = fclose(file) == 0 && written;
+        }
+
+        if (written && !std::rename(tempFileName.c_str(), _fileName.c_str()))
+        {
+            TC_LOG_INFO("sql.sql", "Query snapshot %s written, " SZFMTD " bytes", _fileName.c_str(), header.size() + body.size());
+
+            // a write posted while the file was written
+            if (_discarded)
+                std::remove(_fileName.c_str());
+        }
+        else
+        {
+            std::remove(tempFileName.c_str());
+            TC_LOG_ERROR("sql.sql", "Could not write query snapshot %s", _fileName.c_str());
+        }
+    }
+
+    _entries.clear();
+    _mapping.reset();
+    _open = false;
+    _changed = false;
+}
+
+void QuerySnapshot::Discard()
+{
+    if (_fileName.empty())
+        return;
+
+    _discarded = true;
+    if (!std::remove(_fileName.c_str()))
+        TC_LOG_INFO("sql.sql", "Query snapshot %s discarded, the database was changed after it was written", _fileName.c_str());
+}
+
+bool QuerySnapshot::GetStatementKey(std::string const& sql, std::vector<PreparedStatementData> const& parameters, std::string& key)
+{
+    key = "#" + sql;
+    for (PreparedStatementData const& parameter : parameters)
+    {
+        if (std::holds_alternative<std::vector<uint8>>(parameter.data))
+            return false;
+
+        std::string value = std::visit([](auto&& data) { return PreparedStatementData::ToString(data); }, parameter.data);
+        key += Trinity::StringFormat("\n%u:%u:", uint32(parameter.data.index()), uint32(value.length()));
+        key += value;
+    }
+
+    return true;
+}
+
+QuerySnapshot::Entry* QuerySnapshot::FindEntry(std::string const& key, bool prepared)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    auto itr = _entries.find(key);
+    if (itr == _entries.end() || itr->second.Prepared != prepared)
+        return nullptr;
+
+    return &itr->second;
+}
+
+QuerySnapshot::Entry* QuerySnapshot::AddEntry(std::string const& key, std::shared_ptr<std::vector<char>> buffer)
+{
+    Entry entry;
+    entry.Data = buffer->data();
+    entry.Size = buffer->size();
+    entry.Storage = buffer;
+
+    // the buffer was written by us, parsing it again only sets the pointers
+    Reader reader(entry.Data, entry.Data + entry.Size);
+    char const* string;
+    uint32 length;
+    uint32 fieldCount;
+    reader.ReadString(string, length);
+    reader.Read(entry.Prepared);
+    reader.Read(fieldCount);
+
+    entry.Fields.resize(fieldCount);
+    for (uint32 f = 0; f < fieldCount; ++f)
+    {
+        QueryResultFieldMetadata& meta = entry.Fields[f];
+        reader.Read(meta.Type);
+        reader.ReadString(meta.TableName, length);
+        reader.ReadString(meta.Name, length);
+        reader.ReadString(meta.TypeName, length);
+        meta.TableAlias = meta.TableName;
+        meta.Alias = meta.Name;
+        meta.Index = f;
+    }
+
+    uint64 rowsSize;
+    reader.Read(entry.RowCount);
+    reader.Read(rowsSize);
+    entry.Rows = reader.GetPos();
+
+    std::lock_guard<std::mutex> lock(_lock);
+    Entry& stored = _entries[key];
+    stored = std::move(entry);
+    _changed = true;
+    return &stored;
+}
+
+bool QuerySnapshot::FindResult(std::string const& key, QueryResult& result)
+{
+    Entry* entry = FindEntry(key, false);
+    if (!entry)
+        return false;
+
+    if (entry->RowCount)
+    {
+        result = std::make_shared<ResultSet>(entry->Fields, entry->RowCount, entry->Rows, entry->Storage);
+        result->NextRow();
+    }
+
+    return true;
+}
+
+bool QuerySnapshot::FindResult(std::string const& key, PreparedQueryResult& result)
+{
+    Entry* entry = FindEntry(key, true);
+    if (!entry)
+        return false;
+
+    if (entry->RowCount)
+        result = std::make_shared<PreparedResultSet>(entry->Fields, entry->RowCount, entry->Rows, entry->Storage);
+
+    return true;
+}
+
+void QuerySnapshot::WriteHeader(std::vector<char>& buffer, std::string const& key, bool prepared, std::vector<QueryResultFieldMetadata> const& fields, uint64 rowCount)
+{
+    WriteString(buffer, key.c_str(), key.length());
+    Write<bool>(buffer, prepared);
+    Write<uint32>(buffer, fields.size());
+    for (QueryResultFieldMetadata const& meta : fields)
+    {
+        Write(buffer, meta.Type);
+        WriteString(buffer, meta.TableName);
+        WriteString(buffer, meta.Name);
+        WriteString(buffer, meta.TypeName);
+    }
+
+    Write<uint64>(buffer, rowCount);
+    Write<uint64>(buffer, 0);                               // size of the rows, set once they are written
+}
+
+void QuerySnapshot::WriteValue(std::vector<char>& buffer, Field const& field)
+{
+    if (!field.data.value)
+        Write<uint32>(buffer, NULL_LENGTH);
+    else
+        WriteString(buffer, field.data.value, field.data.length);
+}
+
+char const* QuerySnapshot::ReadValue(char const* pos, char const*& value, uint32& length)
+{
+    memcpy(&length, pos, sizeof(length));
+    pos += sizeof(length);
+    if (length == NULL_LENGTH)
+    {
+        value = nullptr;
+        length = 0;
+        return pos;
+    }
+
+    value = pos;
+    return pos + length + 1;
+}
+
+QueryResult QuerySnapshot::RecordResult(std::string const& key, QueryResult result)
+{
+    std::shared_ptr<std::vector<char>> buffer = std::make_shared<std::vector<char>>();
+    std::vector<QueryResultFieldMetadata> fields;
+    if (result)
+        fields = result->_fieldMetadata;
+
+    WriteHeader(*buffer, key, false, fields, result ? result->GetRowCount() : 0);
+    std::size_t rowsStart = buffer->size();
+    if (result)
+    {
+        do
+        {
+            Field* row = result->Fetch();
+            for (uint32 i = 0; i < fields.size(); ++i)
+                WriteValue(*buffer, row[i]);
+        } while (result->NextRow());
+    }
+
+    uint64 rowsSize = buffer->size() - rowsStart;
+    memcpy(buffer->data() + rowsStart - sizeof(rowsSize), &rowsSize, sizeof(rowsSize));
+
+    QueryResult stored;
+    Entry* entry = AddEntry(key, buffer);
+    if (entry->RowCount)
+    {
+        stored = std::make_shared<ResultSet>(entry->Fields, entry->RowCount, entry->Rows, entry->Storage);
+        stored->NextRow();
+    }
+
+    return stored;
+}
+
+PreparedQueryResult QuerySnapshot::RecordResult(std::string const& key, PreparedQueryResult result)
+{
+    std::shared_ptr<std::vector<char>> buffer = std::make_shared<std::vector<char>>();
+    std::vector<QueryResultFieldMetadata> fields;
+    if (result)
+        fields = result->m_fieldMetadata;
+
+    WriteHeader(*buffer, key, true, fields, result ? result->GetRowCount() : 0);
+    std::size_t rowsStart = buffer->size();
+    if (result)
+    {
+        do
+        {
+            Field* row = result->Fetch();
+            for (uint32 i = 0; i < fields.size(); ++i)
+                WriteValue(*buffer, row[i]);
+        } while (result->NextRow());
+    }
+
+    uint64 rowsSize = buffer->size() - rowsStart;
+    memcpy(buffer->data() + rowsStart - sizeof(rowsSize), &rowsSize, sizeof(rowsSize));
+
+    Entry* entry = AddEntry(key, buffer);
+    if (!entry->RowCount)
+        return nullptr;
+
+    return std::make_shared<PreparedResultSet>(entry->Fields, entry->RowCount, entry->Rows, entry->Storage);
+}
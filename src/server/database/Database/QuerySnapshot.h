@@ -0,0 +1,133 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QUERYSNAPSHOT_H
+#define QUERYSNAPSHOT_H
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include "DatabaseWorkerPool.h"
+#include "Field.h"
+#include "PreparedStatement.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace boost
+{
+    namespace interprocess
+    {
+        class mapped_region;
+    }
+}
+
+/**
+    @class QuerySnapshot
+    @brief Stores results of startup queries in a file, later startups read them from it instead of querying
+
+    The file is written for a key, usually a hash of the applied database updates, and only used while
+    the key matches. Results are keyed on their query and its parameters, so queries changed by a core
+    update are just queried again and added to the file. Writes to the database once the snapshot was
+    opened have to Discard it, even those done before it is written.
+*/
+class TC_DATABASE_API QuerySnapshot
+{
+    public:
+        QuerySnapshot();
+        ~QuerySnapshot();
+
+        /// Maps the snapshot file if it was written for key, otherwise results are recorded for a new file
+        void Open(std::string const& fileName, std::string const& key);
+        /// Writes the file if results were recorded and releases the mapped one
+        void Close();
+        bool IsOpen() const { return _open; }
+        /// Removes the written file and keeps Close from writing it, the next Open stores the results again
+        void Discard();
+
+        template<class T>
+        QueryResult Query(DatabaseWorkerPool<T>& database, char const* sql)
+        {
+            if (!_open)
+                return database.Query(sql);
+
+            QueryResult result;
+            if (!FindResult(sql, result))
+                result = RecordResult(sql, database.Query(sql));
+
+            return result;
+        }
+
+        /// Statements are identified by their SQL and parameter values, statements with binary parameters are not stored
+        template<class T>
+        PreparedQueryResult Query(DatabaseWorkerPool<T>& database, PreparedStatement<T>* stmt)
+        {
+            std::string key;
+            if (!_open || !GetStatementKey(database.GetPreparedStatementQuery(stmt->GetIndex()), stmt->GetParameters(), key))
+                return database.Query(stmt);
+
+            PreparedQueryResult result;
+            if (FindResult(key, result))
+            {
+                delete stmt;
+                return result;
+            }
+
+            return RecordResult(key, database.Query(stmt));
+        }
+
+        /// Reads one value of a stored row, nullptr values are NULL
+        static char const* ReadValue(char const* pos, char const*& value, uint32& length);
+
+    private:
+        struct Entry
+        {
+            bool Prepared;
+            std::vector<QueryResultFieldMetadata> Fields;
+            uint64 RowCount;
+            char const* Rows;
+            char const* Data;                               // whole serialized entry, copied when the file is written
+            std::size_t Size;
+            std::shared_ptr<void const> Storage;            // mapped file or recorded buffer
+        };
+
+        static bool GetStatementKey(std::string const& sql, std::vector<PreparedStatementData> const& parameters, std::string& key);
+        bool FindResult(std::string const& key, QueryResult& result);
+        bool FindResult(std::string const& key, PreparedQueryResult& result);
+        QueryResult RecordResult(std::string const& key, QueryResult result);
+        PreparedQueryResult RecordResult(std::string const& key, PreparedQueryResult result);
+
+        Entry* FindEntry(std::string const& key, bool prepared);
+        Entry* AddEntry(std::string const& key, std::shared_ptr<std::vector<char>> buffer);
+        bool ReadEntries(char const* data, std::size_t size);
+        static void WriteHeader(std::vector<char>& buffer, std::string const& key, bool prepared, std::vector<QueryResultFieldMetadata> const& fields, uint64 rowCount);
+        static void WriteValue(std::vector<char>& buffer, Field const& field);
+
+        std::string _fileName;
+        std::string _key;
+        bool _open;
+        bool _changed;
+        std::atomic<bool> _discarded;                       // set by Discard from whichever thread wrote to the database
+
+        std::shared_ptr<boost::interprocess::mapped_region> _mapping;
+        std::unordered_map<std::string, Entry> _entries;
+        std::mutex _lock;                                   // guards _entries, loaders may query concurrently
+};
+
+#endif
@@ -43,6 +43,86 @@ void TransactionBase::AppendPreparedStatement(PreparedStatementBase* stmt)
     m_queries.emplace_back(std::in_place_type<std::unique_ptr<PreparedStatementBase>>, stmt);
 }
 
+namespace
+{
+    // FNV-1a
+    void HashBytes(uint64& hash, void const* data, std::size_t size)
+    {
+        uint8 const* bytes = static_cast<uint8 const*>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= UI64LIT(0x100000001B3);
+        }
+    }
+
+    struct QueryHasher
+    {
+        uint64& Hash;
+
+        void operator()(std::unique_ptr<PreparedStatementBase> const& stmt) const
+        {
+            uint32 index = stmt->GetIndex();
+            HashBytes(Hash, &index, sizeof(index));
+            for (PreparedStatementData const& param : stmt->GetParameters())
+            {
+                std::size_t type = param.data.index();
+                HashBytes(Hash, &type, sizeof(type));
+                std::visit([this](auto const& value) { HashValue(value); }, param.data);
+            }
+        }
+
+        void operator()(std::string const& sql) const { HashBytes(Hash, sql.data(), sql.size()); }
+
+        template<typename T>
+        void HashValue(T const& value) const { HashBytes(Hash, &value, sizeof(value)); }
+        void HashValue(std::string const& value) const { HashBytes(Hash, value.data(), value.size()); }
+        void HashValue(std::vector<uint8> const& value) const { HashBytes(Hash, value.data(), value.size()); }
+        void HashValue(std::nullptr_t) const { }
+    };
+
+    struct QueryPayload
+    {
+        std::size_t operator()(std::unique_ptr<PreparedStatementBase> const& stmt) const
+        {
+            std::size_t size = 0;
+            for (PreparedStatementData const& param : stmt->GetParameters())
+                size += std::visit([this](auto const& value) { return ValueSize(value); }, param.data);
+            return size;
+        }
+
+        std::size_t operator()(std::string const& sql) const { return sql.size(); }
+
+        template<typename T>
+        std::size_t ValueSize(T const&) const { return sizeof(T); }
+        std::size_t ValueSize(std::string const& value) const { return value.size(); }
+        std::size_t ValueSize(std::vector<uint8> const& value) const { return value.size(); }
+        std::size_t ValueSize(std::nullptr_t) const { return 0; }
+    };
+}
+
+uint64 TransactionBase::GetQueriesHash(std::size_t from) const
+{
+    uint64 hash = UI64LIT(0xCBF29CE484222325);
+    for (std::size_t i = from; i < m_queries.size(); ++i)
+        std::visit(QueryHasher{ hash }, m_queries[i].query);
+    return hash;
+}
+
+std::size_t TransactionBase::GetQueriesPayload(std::size_t from) const
+{
+    std::size_t size = 0;
+    for (std::size_t i = from; i < m_queries.size(); ++i)
+        size += std::visit(QueryPayload(), m_queries[i].query);
+    return size;
+}
+
+void TransactionBase::Truncate(std::size_t size)
+{
+    if (size < m_queries.size())
+        m_queries.erase(m_queries.begin() + size, m_queries.end());
+}
+
 void TransactionBase::Cleanup()
 {
     // This might be called by explicit calls to Cleanup or by the auto-destructor
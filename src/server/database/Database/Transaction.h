@@ -64,6 +64,12 @@ class TC_DATABASE_API TransactionBase
 
         std::size_t GetSize() const { return m_queries.size(); }
 
+        //- Fingerprint and estimated payload in bytes of the queries appended at or after 'from'
+        uint64 GetQueriesHash(std::size_t from) const;
+        std::size_t GetQueriesPayload(std::size_t from) const;
+        //- Drops the queries appended at or after 'size'
+        void Truncate(std::size_t size);
+
     protected:
         void AppendPreparedStatement(PreparedStatementBase* statement);
         void Cleanup();
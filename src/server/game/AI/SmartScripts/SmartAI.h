@@ -66,7 +66,7 @@ class TC_GAME_API SmartAI : public CreatureAI
         void StopFollow(bool complete);
         void SetUnfollow();
 
-        void SetScript9(SmartScriptHolder& e, uint32 entry, Unit* invoker);
+        void SetScript9(SmartScriptHolder const& e, uint32 entry, Unit* invoker);
         SmartScript* GetScript() { return &mScript; }
         bool IsEscortInvokerInRange();
 
@@ -285,7 +285,7 @@ class TC_GAME_API SmartGameObjectAI : public GameObjectAI
         Optional<QuestGiverStatus> GetDialogStatus(Player* /*player*/) override;
         void Destroyed(Player* player, uint32 eventId) override;
         void SetData(uint32 id, uint32 value) override;
-        void SetScript9(SmartScriptHolder& e, uint32 entry, Unit* invoker);
+        void SetScript9(SmartScriptHolder const& e, uint32 entry, Unit* invoker);
         void OnGameEvent(bool start, uint16 eventId) override;
         void OnStateChanged(uint32 state, Unit* unit) override;
         void EventInform(uint32 eventId) override;
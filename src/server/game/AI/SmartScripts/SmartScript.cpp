@@ -46,6 +46,7 @@ SmartScript::SmartScript()
     trigger = NULL;
     mEventPhase = 0;
     mPathId = 0;
+    mDifficultyMask = 0;
     mTargetStorage = new GuidListMap();
     mTextTimer = 0;
     mLastTextID = 0;
@@ -68,12 +69,23 @@ void SmartScript::OnReset()
 {
     SetPhase(0);
     ResetBaseObject();
+    if (mScript)
+    {
+        for (uint32 i = 0; i < mScript->Events.size(); ++i)
+        {
+            if (!(mScript->Events[i].event.event_flags & SMART_EVENT_FLAG_DONT_RESET))
+            {
+                InitTimer(mScript->Events[i], mScriptStates[i]);
+                mScriptStates[i].runOnce = false;
+            }
+        }
+    }
     for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
     {
         if (!((*i).event.event_flags & SMART_EVENT_FLAG_DONT_RESET))
         {
-            InitTimer((*i));
-            (*i).runOnce = false;
+            InitTimer((*i), i->state);
+            (*i).state.runOnce = false;
         }
     }
     ProcessEventsFor(SMART_EVENT_RESET);
@@ -83,21 +95,66 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-    {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+    if (e == SMART_EVENT_LINK || uint32(e) >= SMART_EVENT_END)//special handling
+        return;
 
-        if (eventType == e/* && (!(*i).event.event_phase_mask || IsInPhase((*i).event.event_phase_mask)) && !((*i).event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE && (*i).runOnce)*/)
+    // keep the script alive and stop if an action reinitialized it
+    if (std::shared_ptr<SmartAIScript const> script = mScript)
+    {
+        for (uint32 i = script->TypeOffsets[e]; i < script->TypeOffsets[e + 1] && script == mScript; ++i)
         {
-            if (sConditionMgr->IsObjectMeetingSmartEventConditions(i->entryOrGuid, i->event_id, i->source_type, unit, GetBaseObject()))
-                ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
+            uint32 index = script->EventsByType[i];
+            SmartScriptHolder const& holder = script->Events[index];
+            if (!IsEventEnabled(holder))
+                continue;
+
+            if (IsMeetingConditions(holder, unit))
+                ProcessEvent(holder, mScriptStates[index], unit, var0, var1, bvar, spell, gob);
         }
     }
+
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+    {
+        if (SMART_EVENT(mEvents[i].GetEventType()) != e)
+            continue;
+
+        if (IsMeetingConditions(mEvents[i], unit))
+            ProcessEvent(mEvents[i], mEvents[i].state, unit, var0, var1, bvar, spell, gob);
+    }
+}
+
+bool SmartScript::IsEventEnabled(SmartScriptHolder const& e) const
+{
+#ifndef TRINITY_DEBUG
+    if (e.event.event_flags & SMART_EVENT_FLAG_DEBUG_ONLY)
+        return false;
+#endif
+
+    //if has instance flag process only if in it
+    if (e.event.event_flags & SMART_EVENT_FLAG_DIFFICULTY_ALL)
+        return (e.event.event_flags & mDifficultyMask) != 0;
+
+    return true;//NOTE: 'world(0)' events still get processed in ANY instance mode
+}
+
+bool SmartScript::IsMeetingConditions(SmartScriptHolder const& e, Unit* unit)
+{
+    // events of the shared script have their conditions looked up at load, unless conditions were reloaded since
+    if (mScript && &e >= mScript->Events.data() && &e < mScript->Events.data() + mScript->Events.size()
+        && mScript->ConditionGeneration == sConditionMgr->GetGeneration())
+    {
+        ConditionContainer const* conditions = mScript->Conditions[&e - mScript->Events.data()];
+        if (!conditions)
+            return true;
+
+        ConditionSourceInfo sourceInfo(unit, GetBaseObject());
+        return sConditionMgr->IsObjectMeetToConditions(sourceInfo, *conditions);
+    }
+
+    return sConditionMgr->IsObjectMeetingSmartEventConditions(e.entryOrGuid, e.event_id, e.source_type, unit, GetBaseObject());
 }
 
-void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
+void SmartScript::ProcessAction(SmartScriptHolder const& e, SmartEventState& state, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
     //calc random
     if (e.GetEventType() != SMART_EVENT_LINK && e.event.event_chance < 100 && e.event.event_chance)
@@ -106,7 +163,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         if (e.event.event_chance <= rnd)
             return;
     }
-    e.runOnce = true;//used for repeat check
+    state.runOnce = true;//used for repeat check
 
     if (unit)
         mLastInvoker = unit->GetGUID();
@@ -1524,7 +1581,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             ev.event_id = e.action.timeEvent.id;
             ev.target = e.target;
             ev.action = ac;
-            InitTimer(ev);
+            InitTimer(ev, ev.state);
             mStoredEvents.push_back(ev);
             break;
         }
@@ -2520,20 +2577,23 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
     if (e.link && e.link != e.event_id)
     {
-        SmartScriptHolder linked = FindLinkedEvent(e.link);
-        if (linked.GetActionType() && linked.GetEventType() == SMART_EVENT_LINK)
-            ProcessEvent(linked, unit, var0, var1, bvar, spell, gob);
+        SmartScriptHolder const* linked = FindLinkedEvent(e.link);
+        if (linked && linked->GetActionType() && linked->GetEventType() == SMART_EVENT_LINK)
+        {
+            SmartEventState linkedState;
+            ProcessEvent(*linked, linkedState, unit, var0, var1, bvar, spell, gob);
+        }
         else
             TC_LOG_ERROR("sql.sql", "SmartScript::ProcessAction: Entry %d SourceType %u, Event %u, Link Event %u not found or invalid, skipped.", e.entryOrGuid, e.GetScriptType(), e.event_id, e.link);
     }
 }
 
-void SmartScript::ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
+void SmartScript::ProcessTimedAction(SmartScriptHolder const& e, SmartEventState& state, uint32 const& min, uint32 const& max, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    if (sConditionMgr->IsObjectMeetingSmartEventConditions(e.entryOrGuid, e.event_id, e.source_type, unit, GetBaseObject()))
-        ProcessAction(e, unit, var0, var1, bvar, spell, gob);
+    if (IsMeetingConditions(e, unit))
+        ProcessAction(e, state, unit, var0, var1, bvar, spell, gob);
 
-    RecalcTimer(e, min, max);
+    RecalcTimer(state, min, max);
 }
 
 void SmartScript::InstallTemplate(SmartScriptHolder const& e)
@@ -2643,7 +2703,7 @@ SmartScriptHolder SmartScript::CreateEvent(SMART_EVENT e, uint32 event_flags, ui
     //script.target.raw.param4 = target_param4;
 
     script.source_type = SMART_SCRIPT_TYPE_CREATURE;
-    InitTimer(script);
+    InitTimer(script, script.state);
     return script;
 }
 
@@ -2979,32 +3039,32 @@ ObjectList* SmartScript::GetWorldObjectsInDist(float dist)
     return targets;
 }
 
-void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
+void SmartScript::ProcessEvent(SmartScriptHolder const& e, SmartEventState& state, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    if (!e.active && e.GetEventType() != SMART_EVENT_LINK)
+    if (!state.active && e.GetEventType() != SMART_EVENT_LINK)
         return;
 
-    if ((e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask)) || ((e.event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE) && e.runOnce))
+    if ((e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask)) || ((e.event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE) && state.runOnce))
         return;
 
     switch (e.GetEventType())
     {
         case SMART_EVENT_LINK://special handling
-            ProcessAction(e, unit, var0, var1, bvar, spell, gob);
+            ProcessAction(e, state, unit, var0, var1, bvar, spell, gob);
             break;
         //called from Update tick
         case SMART_EVENT_UPDATE:
-            ProcessTimedAction(e, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
+            ProcessTimedAction(e, state, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
             break;
         case SMART_EVENT_UPDATE_OOC:
             if (me && me->IsInCombat())
                 return;
-            ProcessTimedAction(e, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
+            ProcessTimedAction(e, state, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
             break;
         case SMART_EVENT_UPDATE_IC:
             if (!me || !me->IsInCombat())
                 return;
-            ProcessTimedAction(e, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
+            ProcessTimedAction(e, state, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
             break;
         case SMART_EVENT_HEALTH_PCT:
         {
@@ -3013,7 +3073,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             uint32 perc = (uint32)me->GetHealthPct();
             if (perc > e.event.minMaxRepeat.max || perc < e.event.minMaxRepeat.min)
                 return;
-            ProcessTimedAction(e, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
+            ProcessTimedAction(e, state, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
             break;
         }
         case SMART_EVENT_TARGET_HEALTH_PCT:
@@ -3023,7 +3083,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             uint32 perc = (uint32)me->GetVictim()->GetHealthPct();
             if (perc > e.event.minMaxRepeat.max || perc < e.event.minMaxRepeat.min)
                 return;
-            ProcessTimedAction(e, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax, me->GetVictim());
+            ProcessTimedAction(e, state, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax, me->GetVictim());
             break;
         }
         case SMART_EVENT_MANA_PCT:
@@ -3033,7 +3093,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             uint32 perc = uint32(100.0f * me->GetPower(POWER_MANA) / me->GetMaxPower(POWER_MANA));
             if (perc > e.event.minMaxRepeat.max || perc < e.event.minMaxRepeat.min)
                 return;
-            ProcessTimedAction(e, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
+            ProcessTimedAction(e, state, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
             break;
         }
         case SMART_EVENT_TARGET_MANA_PCT:
@@ -3043,7 +3103,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             uint32 perc = uint32(100.0f * me->GetVictim()->GetPower(POWER_MANA) / me->GetVictim()->GetMaxPower(POWER_MANA));
             if (perc > e.event.minMaxRepeat.max || perc < e.event.minMaxRepeat.min)
                 return;
-            ProcessTimedAction(e, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax, me->GetVictim());
+            ProcessTimedAction(e, state, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax, me->GetVictim());
             break;
         }
         case SMART_EVENT_RANGE:
@@ -3052,7 +3112,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 return;
 
             if (me->IsInRange(me->GetVictim(), (float)e.event.minMaxRepeat.min, (float)e.event.minMaxRepeat.max))
-                ProcessTimedAction(e, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax, me->GetVictim());
+                ProcessTimedAction(e, state, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax, me->GetVictim());
             break;
         }
         case SMART_EVENT_VICTIM_CASTING:
@@ -3070,7 +3130,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                     if (currSpell->m_spellInfo->Id != e.event.targetCasting.spellId)
                         return;
 
-            ProcessTimedAction(e, e.event.targetCasting.repeatMin, e.event.targetCasting.repeatMax, me->GetVictim());
+            ProcessTimedAction(e, state, e.event.targetCasting.repeatMin, e.event.targetCasting.repeatMax, me->GetVictim());
             break;
         }
         case SMART_EVENT_FRIENDLY_HEALTH:
@@ -3081,7 +3141,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             Unit* target = DoSelectLowestHpFriendly((float)e.event.friendlyHealth.radius, e.event.friendlyHealth.hpDeficit);
             if (!target || !target->IsInCombat())
                 return;
-            ProcessTimedAction(e, e.event.friendlyHealth.repeatMin, e.event.friendlyHealth.repeatMax, target);
+            ProcessTimedAction(e, state, e.event.friendlyHealth.repeatMin, e.event.friendlyHealth.repeatMax, target);
             break;
         }
         case SMART_EVENT_FRIENDLY_IS_CC:
@@ -3093,7 +3153,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             DoFindFriendlyCC(pList, (float)e.event.friendlyCC.radius);
             if (pList.empty())
                 return;
-            ProcessTimedAction(e, e.event.friendlyCC.repeatMin, e.event.friendlyCC.repeatMax, *pList.begin());
+            ProcessTimedAction(e, state, e.event.friendlyCC.repeatMin, e.event.friendlyCC.repeatMax, *pList.begin());
             break;
         }
         case SMART_EVENT_FRIENDLY_MISSING_BUFF:
@@ -3104,7 +3164,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             if (pList.empty())
                 return;
 
-            ProcessTimedAction(e, e.event.missingBuff.repeatMin, e.event.missingBuff.repeatMax, *pList.begin());
+            ProcessTimedAction(e, state, e.event.missingBuff.repeatMin, e.event.missingBuff.repeatMax, *pList.begin());
             break;
         }
         case SMART_EVENT_HAS_AURA:
@@ -3113,7 +3173,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 return;
             uint32 count = me->GetAuraCount(e.event.aura.spell);
             if ((!e.event.aura.count && !count) || (e.event.aura.count && count >= e.event.aura.count))
-                ProcessTimedAction(e, e.event.aura.repeatMin, e.event.aura.repeatMax);
+                ProcessTimedAction(e, state, e.event.aura.repeatMin, e.event.aura.repeatMax);
             break;
         }
         case SMART_EVENT_TARGET_BUFFED:
@@ -3123,7 +3183,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             uint32 count = me->GetVictim()->GetAuraCount(e.event.aura.spell);
             if (count < e.event.aura.count)
                 return;
-            ProcessTimedAction(e, e.event.aura.repeatMin, e.event.aura.repeatMax);
+            ProcessTimedAction(e, state, e.event.aura.repeatMin, e.event.aura.repeatMax);
             break;
         }
         //no params
@@ -3166,11 +3226,11 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                     break;
             }
 
-            ProcessAction(e, unit, var0, var1, bvar, spell, gob);       
+            ProcessAction(e, state, unit, var0, var1, bvar, spell, gob);       
         case SMART_EVENT_FOLLOW_COMPLETED:
         case SMART_EVENT_ON_SPELLCLICK:
         case SMART_EVENT_ON_GO_REPORT_USE:
-            ProcessAction(e, unit, var0, var1, bvar, spell, gob);
+            ProcessAction(e, state, unit, var0, var1, bvar, spell, gob);
             break;
         case SMART_EVENT_IS_BEHIND_TARGET:
             {
@@ -3180,15 +3240,15 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 if (Unit* victim = me->GetVictim())
                 {
                     if (!victim->HasInArc(static_cast<float>(M_PI), me))
-                        ProcessTimedAction(e, e.event.behindTarget.cooldownMin, e.event.behindTarget.cooldownMax, victim);
+                        ProcessTimedAction(e, state, e.event.behindTarget.cooldownMin, e.event.behindTarget.cooldownMax, victim);
                 }
                 break;
             }
         case SMART_EVENT_RECEIVE_EMOTE:
             if (e.event.emote.emote == var0)
             {
-                ProcessAction(e, unit);
-                RecalcTimer(e, e.event.emote.cooldownMin, e.event.emote.cooldownMax);
+                ProcessAction(e, state, unit);
+                RecalcTimer(state, e.event.emote.cooldownMin, e.event.emote.cooldownMax);
             }
             break;
         case SMART_EVENT_KILL:
@@ -3199,8 +3259,8 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 return;
             if (e.event.kill.creature && unit->GetEntry() != e.event.kill.creature)
                 return;
-            ProcessAction(e, unit);
-            RecalcTimer(e, e.event.kill.cooldownMin, e.event.kill.cooldownMax);
+            ProcessAction(e, state, unit);
+            RecalcTimer(state, e.event.kill.cooldownMin, e.event.kill.cooldownMax);
             break;
         }
         case SMART_EVENT_SPELLHIT_TARGET:
@@ -3211,8 +3271,8 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             if ((!e.event.spellHit.spell || spell->Id == e.event.spellHit.spell) &&
                 (!e.event.spellHit.school || (spell->SchoolMask & e.event.spellHit.school)))
                 {
-                    ProcessAction(e, unit, 0, 0, bvar, spell);
-                    RecalcTimer(e, e.event.spellHit.cooldownMin, e.event.spellHit.cooldownMax);
+                    ProcessAction(e, state, unit, 0, 0, bvar, spell);
+                    RecalcTimer(state, e.event.spellHit.cooldownMin, e.event.spellHit.cooldownMax);
                 }
             break;
         }
@@ -3234,8 +3294,8 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                         return;
                     if (e.event.los.playerOnly && unit->GetTypeId() != TypeID::TYPEID_PLAYER)
                         return;
-                    RecalcTimer(e, e.event.los.cooldownMin, e.event.los.cooldownMax);
-                    ProcessAction(e, unit);
+                    RecalcTimer(state, e.event.los.cooldownMin, e.event.los.cooldownMax);
+                    ProcessAction(e, state, unit);
                 }
             }
             break;
@@ -3258,8 +3318,8 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                         return;
                     if (e.event.los.playerOnly && unit->GetTypeId() != TypeID::TYPEID_PLAYER)
                         return;
-                    RecalcTimer(e, e.event.los.cooldownMin, e.event.los.cooldownMax);
-                    ProcessAction(e, unit);
+                    RecalcTimer(state, e.event.los.cooldownMin, e.event.los.cooldownMax);
+                    ProcessAction(e, state, unit);
                 }
             }
             break;
@@ -3272,7 +3332,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 return;
             if (e.event.respawn.type == SMART_SCRIPT_RESPAWN_CONDITION_AREA && GetBaseObject()->GetZoneId() != e.event.respawn.area)
                 return;
-            ProcessAction(e);
+            ProcessAction(e, state);
             break;
         }
         case SMART_EVENT_SUMMONED_UNIT:
@@ -3281,8 +3341,8 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 return;
             if (e.event.summoned.creature && unit->GetEntry() != e.event.summoned.creature)
                 return;
-            ProcessAction(e, unit);
-            RecalcTimer(e, e.event.summoned.cooldownMin, e.event.summoned.cooldownMax);
+            ProcessAction(e, state, unit);
+            RecalcTimer(state, e.event.summoned.cooldownMin, e.event.summoned.cooldownMax);
             break;
         }
         case SMART_EVENT_RECEIVE_HEAL:
@@ -3291,15 +3351,15 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
         {
             if (var0 > e.event.minMaxRepeat.max || var0 < e.event.minMaxRepeat.min)
                 return;
-            ProcessAction(e, unit);
-            RecalcTimer(e, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
+            ProcessAction(e, state, unit);
+            RecalcTimer(state, e.event.minMaxRepeat.repeatMin, e.event.minMaxRepeat.repeatMax);
             break;
         }
         case SMART_EVENT_MOVEMENTINFORM:
         {
             if ((e.event.movementInform.type && var0 != e.event.movementInform.type) || (e.event.movementInform.id && var1 != e.event.movementInform.id))
                 return;
-            ProcessAction(e, unit, var0, var1);
+            ProcessAction(e, state, unit, var0, var1);
             break;
         }
         case SMART_EVENT_TRANSPORT_RELOCATE:
@@ -3307,7 +3367,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
         {
             if (e.event.waypoint.pathID && var0 != e.event.waypoint.pathID)
                 return;
-            ProcessAction(e, unit, var0);
+            ProcessAction(e, state, unit, var0);
             break;
         }
         case SMART_EVENT_WAYPOINT_REACHED:
@@ -3318,23 +3378,23 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
         {
             if (!me || (e.event.waypoint.pointID && var0 != e.event.waypoint.pointID) || (e.event.waypoint.pathID && GetPathId() != e.event.waypoint.pathID))
                 return;
-            ProcessAction(e, unit);
+            ProcessAction(e, state, unit);
             break;
         }
         case SMART_EVENT_SUMMON_DESPAWNED:
         {
             if (e.event.summoned.creature && e.event.summoned.creature != var0)
                 return;
-            RecalcTimer(e, e.event.summoned.cooldownMin, e.event.summoned.cooldownMax);
-            ProcessAction(e, unit, var0);
+            RecalcTimer(state, e.event.summoned.cooldownMin, e.event.summoned.cooldownMax);
+            ProcessAction(e, state, unit, var0);
             break;            
         }
         case SMART_EVENT_INSTANCE_PLAYER_ENTER:
         {
             if (e.event.instancePlayerEnter.team && var0 != e.event.instancePlayerEnter.team)
                 return;
-            ProcessAction(e, unit, var0);
-            RecalcTimer(e, e.event.instancePlayerEnter.cooldownMin, e.event.instancePlayerEnter.cooldownMax);
+            ProcessAction(e, state, unit, var0);
+            RecalcTimer(state, e.event.instancePlayerEnter.cooldownMin, e.event.instancePlayerEnter.cooldownMax);
             break;
         }
         case SMART_EVENT_ACCEPTED_QUEST:
@@ -3342,37 +3402,37 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
         {
             if (e.event.quest.quest && var0 != e.event.quest.quest)
                 return;
-            RecalcTimer(e, e.event.quest.cooldownMin, e.event.quest.cooldownMax);
-            ProcessAction(e, unit, var0);
+            RecalcTimer(state, e.event.quest.cooldownMin, e.event.quest.cooldownMax);
+            ProcessAction(e, state, unit, var0);
             break;
         }
         case SMART_EVENT_TRANSPORT_ADDCREATURE:
         {
             if (e.event.transportAddCreature.creature && var0 != e.event.transportAddCreature.creature)
                 return;
-            ProcessAction(e, unit, var0);
+            ProcessAction(e, state, unit, var0);
             break;
         }
         case SMART_EVENT_AREATRIGGER_ONTRIGGER:
         {
             if (e.event.areatrigger.id && var0 != e.event.areatrigger.id)
                 return;
-            ProcessAction(e, unit, var0);
+            ProcessAction(e, state, unit, var0);
             break;
         }
         case SMART_EVENT_TEXT_OVER:
         {
             if (var0 != e.event.textOver.textGroupID || (e.event.textOver.creatureEntry && e.event.textOver.creatureEntry != var1))
                 return;
-            ProcessAction(e, unit, var0);
+            ProcessAction(e, state, unit, var0);
             break;
         }
         case SMART_EVENT_DATA_SET:
         {
             if (e.event.dataSet.id != var0 || e.event.dataSet.value != var1)
                 return;
-            ProcessAction(e, unit, var0, var1);
-            RecalcTimer(e, e.event.dataSet.cooldownMin, e.event.dataSet.cooldownMax);
+            ProcessAction(e, state, unit, var0, var1);
+            RecalcTimer(state, e.event.dataSet.cooldownMin, e.event.dataSet.cooldownMax);
             break;
         }
         case SMART_EVENT_PASSENGER_REMOVED:
@@ -3380,14 +3440,14 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
         {
             if (!unit)
                 return;
-            ProcessAction(e, unit);
-            RecalcTimer(e, e.event.minMax.repeatMin, e.event.minMax.repeatMax);
+            ProcessAction(e, state, unit);
+            RecalcTimer(state, e.event.minMax.repeatMin, e.event.minMax.repeatMax);
             break;
         }
         case SMART_EVENT_TIMED_EVENT_TRIGGERED:
         {
             if (e.event.timedEvent.id == var0)
-                ProcessAction(e, unit);
+                ProcessAction(e, state, unit);
             break;
         }
         case SMART_EVENT_GOSSIP_SELECT:
@@ -3395,14 +3455,14 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             TC_LOG_DEBUG("scripts.ai", "SmartScript: Gossip Select:  menu %u action %u", var0, var1);//little help for scripters
             if (e.event.gossip.sender != var0 || e.event.gossip.action != var1)
                 return;
-            ProcessAction(e, unit, var0, var1);
+            ProcessAction(e, state, unit, var0, var1);
             break;
         }
         case SMART_EVENT_DUMMY_EFFECT:
         {
             if (e.event.dummy.spell != var0 || e.event.dummy.effIndex != var1)
                 return;
-            ProcessAction(e, unit, var0, var1);
+            ProcessAction(e, state, unit, var0, var1);
             break;
         }
         case SMART_EVENT_GAME_EVENT_START:
@@ -3410,28 +3470,28 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
         {
             if (e.event.gameEvent.gameEventId != var0)
                 return;
-            ProcessAction(e, NULL, var0);
+            ProcessAction(e, state, NULL, var0);
             break;
         }
         case SMART_EVENT_GO_STATE_CHANGED:
         {
             if (e.event.goStateChanged.state != var0)
                 return;
-            ProcessAction(e, unit, var0, var1);
+            ProcessAction(e, state, unit, var0, var1);
             break;
         }
         case SMART_EVENT_GO_EVENT_INFORM:
         {
             if (e.event.eventInform.eventId != var0)
                 return;
-            ProcessAction(e, NULL, var0);
+            ProcessAction(e, state, NULL, var0);
             break;
         }
         case SMART_EVENT_ACTION_DONE:
         {
             if (e.event.doAction.eventId != var0)
                 return;
-            ProcessAction(e, unit, var0);
+            ProcessAction(e, state, unit, var0);
             break;
         }
         case SMART_EVENT_FRIENDLY_HEALTH_PCT:
@@ -3480,7 +3540,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             if (!target)
                 return;
 
-            ProcessTimedAction(e, e.event.friendlyHealthPct.repeatMin, e.event.friendlyHealthPct.repeatMax, target);
+            ProcessTimedAction(e, state, e.event.friendlyHealthPct.repeatMin, e.event.friendlyHealthPct.repeatMax, target);
             break;
         }
         case SMART_EVENT_DISTANCE_CREATURE:
@@ -3510,7 +3570,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             }
 
             if (creature)
-                ProcessTimedAction(e, e.event.distance.repeat, e.event.distance.repeat);
+                ProcessTimedAction(e, state, e.event.distance.repeat, e.event.distance.repeat);
 
             break;
         }
@@ -3541,13 +3601,13 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             }
 
             if (gameobject)
-                ProcessTimedAction(e, e.event.distance.repeat, e.event.distance.repeat);
+                ProcessTimedAction(e, state, e.event.distance.repeat, e.event.distance.repeat);
 
             break;
         }
         case SMART_EVENT_COUNTER_SET:
             if (GetCounterId(e.event.counter.id) != 0 && GetCounterValue(e.event.counter.id) == e.event.counter.value)
-                ProcessTimedAction(e, e.event.counter.cooldownMax, e.event.counter.cooldownMax);
+                ProcessTimedAction(e, state, e.event.counter.cooldownMax, e.event.counter.cooldownMax);
             break;
         default:
             TC_LOG_ERROR("sql.sql", "SmartScript::ProcessEvent: Unhandled Event type %u", e.GetEventType());
@@ -3555,7 +3615,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
     }
 }
 
-void SmartScript::InitTimer(SmartScriptHolder& e)
+void SmartScript::InitTimer(SmartScriptHolder const& e, SmartEventState& state)
 {
     switch (e.GetEventType())
     {
@@ -3563,25 +3623,25 @@ void SmartScript::InitTimer(SmartScriptHolder& e)
         case SMART_EVENT_UPDATE:
         case SMART_EVENT_UPDATE_IC:
         case SMART_EVENT_UPDATE_OOC:
-            RecalcTimer(e, e.event.minMaxRepeat.min, e.event.minMaxRepeat.max);
+            RecalcTimer(state, e.event.minMaxRepeat.min, e.event.minMaxRepeat.max);
             break;
         case SMART_EVENT_DISTANCE_CREATURE:
         case SMART_EVENT_DISTANCE_GAMEOBJECT:
-            RecalcTimer(e, e.event.distance.repeat, e.event.distance.repeat);
+            RecalcTimer(state, e.event.distance.repeat, e.event.distance.repeat);
             break;
         default:
-            e.active = true;
+            state.active = true;
             break;
     }
 }
-void SmartScript::RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max)
+void SmartScript::RecalcTimer(SmartEventState& state, uint32 min, uint32 max)
 {
     // min/max was checked at loading!
-    e.timer = urand(uint32(min), uint32(max));
-    e.active = e.timer ? false : true;
+    state.timer = urand(uint32(min), uint32(max));
+    state.active = state.timer ? false : true;
 }
 
-void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
+void SmartScript::UpdateTimer(SmartScriptHolder const& e, SmartEventState& state, uint32 const diff)
 {
     if (e.GetEventType() == SMART_EVENT_LINK)
         return;
@@ -3595,7 +3655,7 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
     if (e.GetEventType() == SMART_EVENT_UPDATE_OOC && (me && me->IsInCombat()))//can be used with me=NULL (go script)
         return;
 
-    if (e.timer < diff)
+    if (state.timer < diff)
     {
         // delay spell cast event if another spell is being casted
         if (e.GetActionType() == SMART_ACTION_CAST || e.GetActionType() == SMART_ACTION_CAST_RANDOM_SPELL)
@@ -3604,13 +3664,13 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
             {
                 if (me && me->HasUnitState(UNIT_STATE_CASTING))
                 {
-                    e.timer = 1;
+                    state.timer = 1;
                     return;
                 }
             }
         }
 
-        e.active = true;//activate events with cooldown
+        state.active = true;//activate events with cooldown
         switch (e.GetEventType())//process ONLY timed events
         {
             case SMART_EVENT_UPDATE:
@@ -3632,16 +3692,16 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
             case SMART_EVENT_DISTANCE_CREATURE:
             case SMART_EVENT_DISTANCE_GAMEOBJECT:
             {
-                ProcessEvent(e);
+                ProcessEvent(e, state);
                 if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
                 {
-                    e.enableTimed = false;//disable event if it is in an ActionList and was processed once
+                    state.enableTimed = false;//disable event if it is in an ActionList and was processed once
                     for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
                     {
                         //find the first event which is not the current one and enable it
                         if (i->event_id > e.event_id)
                         {
-                            i->enableTimed = true;
+                            i->state.enableTimed = true;
                             break;
                         }
                     }
@@ -3651,12 +3711,12 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
         }
     }
     else
-        e.timer -= diff;
+        state.timer -= diff;
 }
 
-bool SmartScript::CheckTimer(SmartScriptHolder const& e) const
+bool SmartScript::CheckTimer(SmartEventState const& state) const
 {
-    return e.active;
+    return state.active;
 }
 
 void SmartScript::InstallEvents()
@@ -3677,21 +3737,26 @@ void SmartScript::OnUpdate(uint32 const diff)
 
     InstallEvents();//before UpdateTimers
 
+    if (std::shared_ptr<SmartAIScript const> script = mScript)
+        for (uint32 i = 0; i < script->Events.size() && script == mScript; ++i)
+            if (IsEventEnabled(script->Events[i]))
+                UpdateTimer(script->Events[i], mScriptStates[i], diff);
+
     for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-        UpdateTimer(*i, diff);
+        UpdateTimer(*i, i->state, diff);
 
     if (!mStoredEvents.empty())
         for (SmartAIEventList::iterator i = mStoredEvents.begin(); i != mStoredEvents.end(); ++i)
-             UpdateTimer(*i, diff);
+             UpdateTimer(*i, i->state, diff);
 
     bool needCleanup = true;
     if (!mTimedActionList.empty())
     {
         for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
         {
-            if ((*i).enableTimed)
+            if ((*i).state.enableTimed)
             {
-                UpdateTimer(*i, diff);
+                UpdateTimer(*i, i->state, diff);
                 needCleanup = false;
             }
         }
@@ -3721,9 +3786,9 @@ void SmartScript::OnUpdate(uint32 const diff)
     }
 }
 
-void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at)
+void SmartScript::FillScript(std::shared_ptr<SmartAIScript const> script, WorldObject* obj, AreaTriggerEntry const* at)
 {
-    if (e.empty())
+    if (!script)
     {
         if (obj)
             TC_LOG_DEBUG("scripts.ai", "SmartScript: EventMap for Entry %u is empty but is using SmartScript.", obj->GetEntry());
@@ -3731,53 +3796,42 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
             TC_LOG_DEBUG("scripts.ai", "SmartScript: EventMap for AreaTrigger %u is empty but is using SmartScript.", at->ID);
         return;
     }
-    for (SmartAIEventList::iterator i = e.begin(); i != e.end(); ++i)
-    {
-        #ifndef TRINITY_DEBUG
-            if ((*i).event.event_flags & SMART_EVENT_FLAG_DEBUG_ONLY)
-                continue;
-        #endif
 
-        if ((*i).event.event_flags & SMART_EVENT_FLAG_DIFFICULTY_ALL)//if has instance flag add only if in it
-        {
-            if (obj && obj->GetMap()->IsDungeon())
-            {
-                if ((1 << (obj->GetMap()->GetSpawnMode())) & (*i).event.event_flags)
-                {
-                    mEvents.push_back((*i));
-                }
-            }
-            continue;
-        }
-        mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
+    // the events are shared, only their state is kept per script
+    mScript = std::move(script);
+    mScriptStates.assign(mScript->Events.size(), SmartEventState());
+    mDifficultyMask = obj && obj->GetMap()->IsDungeon() ? 1 << obj->GetMap()->GetSpawnMode() : 0;
+
+    if (std::none_of(mScript->Events.begin(), mScript->Events.end(), [this](SmartScriptHolder const& e) { return IsEventEnabled(e); }))
+    {
+        if (obj)
+            TC_LOG_ERROR("sql.sql", "SmartScript: Entry %u has events but no events added to list because of instance flags.", obj->GetEntry());
+        if (at)
+            TC_LOG_ERROR("sql.sql", "SmartScript: AreaTrigger %u has events but no events added to list because of instance flags. NOTE: triggers can not handle any instance flags.", at->ID);
     }
-    if (mEvents.empty() && obj)
-        TC_LOG_ERROR("sql.sql", "SmartScript: Entry %u has events but no events added to list because of instance flags.", obj->GetEntry());
-    if (mEvents.empty() && at)
-        TC_LOG_ERROR("sql.sql", "SmartScript: AreaTrigger %u has events but no events added to list because of instance flags. NOTE: triggers can not handle any instance flags.", at->ID);
 }
 
 void SmartScript::GetScript()
 {
-    SmartAIEventList e;
+    std::shared_ptr<SmartAIScript const> script;
     if (me)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)me->GetDBTableGUIDLow()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
-        FillScript(e, me, NULL);
+        script = sSmartScriptMgr->GetScript(-((int32)me->GetDBTableGUIDLow()), mScriptType);
+        if (!script)
+            script = sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
+        FillScript(std::move(script), me, NULL);
     }
     else if (go)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)go->GetDBTableGUIDLow()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
-        FillScript(e, go, NULL);
+        script = sSmartScriptMgr->GetScript(-((int32)go->GetDBTableGUIDLow()), mScriptType);
+        if (!script)
+            script = sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
+        FillScript(std::move(script), go, NULL);
     }
     else if (trigger)
     {
-        e = sSmartScriptMgr->GetScript((int32)trigger->ID, mScriptType);
-        FillScript(e, NULL, trigger);
+        script = sSmartScriptMgr->GetScript((int32)trigger->ID, mScriptType);
+        FillScript(std::move(script), NULL, trigger);
     }
 }
 
@@ -3813,10 +3867,13 @@ void SmartScript::OnInitialize(WorldObject* obj, AreaTriggerEntry const* at)
         return;
     }
 
-    GetScript();//load copy of script
+    GetScript();//load shared script
 
+    if (mScript)
+        for (uint32 i = 0; i < mScript->Events.size(); ++i)
+            InitTimer(mScript->Events[i], mScriptStates[i]);//calculate timers for first time use
     for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-        InitTimer((*i));//calculate timers for first time use
+        InitTimer((*i), i->state);
 
     ProcessEventsFor(SMART_EVENT_AI_INIT);
     InstallEvents();
@@ -3955,15 +4012,17 @@ ObjectList* SmartScript::GetTargetList(uint32 id, WorldObject const* scriptTrigg
     return nullptr;
 }
 
-void SmartScript::SetScript9(SmartScriptHolder& e, uint32 entry)
+void SmartScript::SetScript9(SmartScriptHolder const& e, uint32 entry)
 {
     mTimedActionList.clear();
-    mTimedActionList = sSmartScriptMgr->GetScript(entry, SMART_SCRIPT_TYPE_TIMED_ACTIONLIST);
+    // copied, the event types are changed for this list
+    if (std::shared_ptr<SmartAIScript const> script = sSmartScriptMgr->GetScript(entry, SMART_SCRIPT_TYPE_TIMED_ACTIONLIST))
+        mTimedActionList = script->Events;
     if (mTimedActionList.empty())
         return;
     for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
     {
-        i->enableTimed = i == mTimedActionList.begin();//enable processing only for the first action
+        i->state.enableTimed = i == mTimedActionList.begin();//enable processing only for the first action
 
         if (e.action.timedActionList.timerType == 0)
             i->event.type = SMART_EVENT_UPDATE_OOC;
@@ -3972,7 +4031,7 @@ void SmartScript::SetScript9(SmartScriptHolder& e, uint32 entry)
         else if (e.action.timedActionList.timerType > 1)
             i->event.type = SMART_EVENT_UPDATE;
 
-        InitTimer((*i));
+        InitTimer((*i), i->state);
     }
 }
 
@@ -36,16 +36,16 @@ class SmartScript
 
         void OnInitialize(WorldObject* obj, AreaTriggerEntry const* at = NULL);
         void GetScript();
-        void FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at);
+        void FillScript(std::shared_ptr<SmartAIScript const> script, WorldObject* obj, AreaTriggerEntry const* at);
 
         void ProcessEventsFor(SMART_EVENT e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
-        void ProcessEvent(SmartScriptHolder& e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
-        bool CheckTimer(SmartScriptHolder const& e) const;
-        void RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max);
-        void UpdateTimer(SmartScriptHolder& e, uint32 const diff);
-        void InitTimer(SmartScriptHolder& e);
-        void ProcessAction(SmartScriptHolder& e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
-        void ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
+        void ProcessEvent(SmartScriptHolder const& e, SmartEventState& state, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
+        bool CheckTimer(SmartEventState const& state) const;
+        void RecalcTimer(SmartEventState& state, uint32 min, uint32 max);
+        void UpdateTimer(SmartScriptHolder const& e, SmartEventState& state, uint32 const diff);
+        void InitTimer(SmartScriptHolder const& e, SmartEventState& state);
+        void ProcessAction(SmartScriptHolder const& e, SmartEventState& state, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
+        void ProcessTimedAction(SmartScriptHolder const& e, SmartEventState& state, uint32 const& min, uint32 const& max, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
         ObjectList* GetTargets(SmartScriptHolder const& e, Unit* invoker = NULL);
         ObjectList* GetWorldObjectsInDist(float dist);
         void InstallTemplate(SmartScriptHolder const& e);
@@ -222,7 +222,7 @@ class SmartScript
         uint32 GetPhase() { return mEventPhase; }
 
         //TIMED_ACTIONLIST (script type 9 aka script9)
-        void SetScript9(SmartScriptHolder& e, uint32 entry);
+        void SetScript9(SmartScriptHolder const& e, uint32 entry);
         Unit* GetLastInvoker(Unit* invoker = nullptr);
         ObjectGuid mLastInvoker;
         typedef std::unordered_map<uint32, uint32> CounterMap;
@@ -241,7 +241,13 @@ class SmartScript
         bool IsInPhase(uint32 p) const { return (1 << (mEventPhase - 1)) & p; }
         void SetPhase(uint32 p = 0) { mEventPhase = p; }
 
-        SmartAIEventList mEvents;
+        bool IsEventEnabled(SmartScriptHolder const& e) const;
+        bool IsMeetingConditions(SmartScriptHolder const& e, Unit* unit);
+
+        std::shared_ptr<SmartAIScript const> mScript;       // events from the DB, shared by all objects running the same script
+        std::vector<SmartEventState> mScriptStates;         // state of each event of mScript
+        uint32 mDifficultyMask;                             // spawn mode bit tested against the difficulty flags of events
+        SmartAIEventList mEvents;                           // events installed at runtime by AI templates
         SmartAIEventList mInstallEvents;
         SmartAIEventList mTimedActionList;
         Creature* me;
@@ -278,20 +284,18 @@ class SmartScript
                 }
             }
         }
-        SmartScriptHolder FindLinkedEvent (uint32 link)
+        SmartScriptHolder const* FindLinkedEvent (uint32 link) const
         {
-            if (!mEvents.empty())
-            {
-                for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-                {
-                    if (i->event_id == link)
-                    {
-                        return (*i);
-                    }
-                }
-            }
-            SmartScriptHolder s;
-            return s;
+            if (mScript)
+                for (SmartScriptHolder const& e : mScript->Events)
+                    if (e.event_id == link && IsEventEnabled(e))
+                        return &e;
+
+            for (SmartScriptHolder const& e : mEvents)
+                if (e.event_id == link)
+                    return &e;
+
+            return nullptr;
         }
 };
 
@@ -146,7 +146,7 @@ void SmartAIMgr::LoadSmartAIFromDB()
         mEventMap[i].clear();  //Drop Existing SmartAI List
 
     WorldDatabasePreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_SMART_SCRIPTS);
-    PreparedQueryResult result = WorldDatabase.Query(stmt);
+    PreparedQueryResult result = WorldDatabaseSnapshot.Query(WorldDatabase, stmt);
 
     if (!result)
     {
@@ -186,6 +186,7 @@ void SmartAIMgr::LoadSmartAIFromDB()
     }
 
     uint32 count = 0;
+    std::unordered_map<int32, SmartAIEventList> eventLists[SMART_SCRIPT_TYPE_MAX];
 
     do
     {
@@ -294,22 +295,49 @@ void SmartAIMgr::LoadSmartAIFromDB()
             continue;
 
         // creature entry / guid not found in storage, create empty event list for it and increase counters
-        auto& eventmap = mEventMap[source_type];
-        if (eventmap.find(temp.entryOrGuid) == eventmap.end())
-        {
+        SmartAIEventList& eventList = eventLists[source_type][temp.entryOrGuid];
+        if (eventList.empty())
             ++count;
-            SmartAIEventList eventList;
-            eventmap[temp.entryOrGuid] = eventList;
-        }
+
         // store the new event
-        eventmap[temp.entryOrGuid].push_back(temp);
+        eventList.push_back(temp);
     }
     while (result->NextRow());
 
+    for (uint8 i = 0; i < SMART_SCRIPT_TYPE_MAX; i++)
+        for (auto&& eventList : eventLists[i])
+            mEventMap[i][eventList.first] = CompileScript(std::move(eventList.second));
+
     TC_LOG_INFO("server.loading", ">> Loaded %u SmartAI scripts in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 
 }
 
+std::shared_ptr<SmartAIScript const> SmartAIMgr::CompileScript(SmartAIEventList&& events) const
+{
+    std::shared_ptr<SmartAIScript> script = std::make_shared<SmartAIScript>();
+    script->Events = std::move(events);
+    script->Conditions.reserve(script->Events.size());
+    script->ConditionGeneration = sConditionMgr->GetGeneration();
+
+    // counting sort of the event indexes by type, event types were validated by IsEventValid
+    std::fill(std::begin(script->TypeOffsets), std::end(script->TypeOffsets), 0);
+    for (SmartScriptHolder const& e : script->Events)
+        ++script->TypeOffsets[e.GetEventType() + 1];
+    for (uint32 type = 0; type < SMART_EVENT_END; ++type)
+        script->TypeOffsets[type + 1] += script->TypeOffsets[type];
+
+    std::vector<uint32> next(script->TypeOffsets, script->TypeOffsets + SMART_EVENT_END);
+    script->EventsByType.resize(script->Events.size());
+    for (uint32 i = 0; i < script->Events.size(); ++i)
+    {
+        SmartScriptHolder const& e = script->Events[i];
+        script->EventsByType[next[e.GetEventType()]++] = i;
+        script->Conditions.push_back(sConditionMgr->GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type));
+    }
+
+    return script;
+}
+
 bool SmartAIMgr::IsTargetValid(SmartScriptHolder const& e)
 {
     if (e.GetActionType() == SMART_ACTION_INSTALL_AI_TEMPLATE)
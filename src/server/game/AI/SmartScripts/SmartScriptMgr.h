@@ -19,6 +19,7 @@
 #define TRINITY_SMARTSCRIPTMGR_H
 
 #include "Common.h"
+#include "ConditionMgr.h"
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "Unit.h"
@@ -1452,11 +1453,22 @@ enum SmartCastFlags
     SMARTCAST_DEST                   = 0x80,                     // Cast in dest position
 };
 
+// timers of an event in one running script
+struct SmartEventState
+{
+    SmartEventState() : timer(0), active(false), runOnce(false), enableTimed(false) { }
+
+    uint32 timer;
+    bool active;
+    bool runOnce;
+    bool enableTimed;
+};
+
 // one line in DB is one event
 struct SmartScriptHolder
 {
     SmartScriptHolder() : entryOrGuid(0), source_type(SMART_SCRIPT_TYPE_CREATURE),
-        event_id(0), link(0), event(), action(), target(), timer(0), active(false), runOnce(false), enableTimed(false) { }
+        event_id(0), link(0), event(), action(), target() { }
 
     int32 entryOrGuid;
     SmartScriptType source_type;
@@ -1473,10 +1485,7 @@ struct SmartScriptHolder
         uint32 GetActionType() const { return (uint32)action.type; }
         uint32 GetTargetType() const { return (uint32)target.type; }
 
-    uint32 timer;
-    bool active;
-    bool runOnce;
-    bool enableTimed;
+    SmartEventState state;                                  // only used by events created by a script, shared events keep it in SmartScript
 };
 
 typedef std::unordered_map<uint32, WayPoint*> WPPath;
@@ -1506,8 +1515,18 @@ class SmartWaypointMgr
 // all events for a single entry
 typedef std::vector<SmartScriptHolder> SmartAIEventList;
 
+// events of a single entry / guid, shared by every object running them
+struct SmartAIScript
+{
+    SmartAIEventList Events;
+    std::vector<uint32> EventsByType;                       // indexes into Events grouped by event type, in DB order within a type
+    uint32 TypeOffsets[SMART_EVENT_END + 1];                // events of type t are EventsByType[TypeOffsets[t], TypeOffsets[t + 1])
+    std::vector<ConditionContainer const*> Conditions;      // of each event, valid while ConditionGeneration is current
+    uint32 ConditionGeneration;
+};
+
 // all events for all entries / guids
-typedef std::unordered_map<int32, SmartAIEventList> SmartAIEventMap;
+typedef std::unordered_map<int32, std::shared_ptr<SmartAIScript const>> SmartAIEventMap;
 
 class SmartAIMgr
 {
@@ -1518,23 +1537,22 @@ class SmartAIMgr
         static SmartAIMgr* instance();
         void LoadSmartAIFromDB();
 
-        SmartAIEventList GetScript(int32 entry, SmartScriptType type)
+        std::shared_ptr<SmartAIScript const> GetScript(int32 entry, SmartScriptType type) const
         {
-            SmartAIEventList temp;
-            if (mEventMap[uint32(type)].find(entry) != mEventMap[uint32(type)].end())
-                return mEventMap[uint32(type)][entry];
-            else
-            {
-                if (entry > 0)//first search is for guid (negative), do not drop error if not found
-                    TC_LOG_DEBUG("scripts.ai", "SmartAIMgr::GetScript: Could not load Script for Entry %d ScriptType %u.", entry, uint32(type));
-                return temp;
-            }
+            auto itr = mEventMap[uint32(type)].find(entry);
+            if (itr != mEventMap[uint32(type)].end())
+                return itr->second;
+
+            if (entry > 0)//first search is for guid (negative), do not drop error if not found
+                TC_LOG_DEBUG("scripts.ai", "SmartAIMgr::GetScript: Could not load Script for Entry %d ScriptType %u.", entry, uint32(type));
+            return nullptr;
         }
 
     private:
         //event stores
         SmartAIEventMap mEventMap[SMART_SCRIPT_TYPE_MAX];
 
+        std::shared_ptr<SmartAIScript const> CompileScript(SmartAIEventList&& events) const;
         bool IsEventValid(SmartScriptHolder& e);
         bool IsTargetValid(SmartScriptHolder const& e);
 
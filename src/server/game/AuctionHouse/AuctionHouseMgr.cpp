@@ -42,9 +42,7 @@ enum eAuctionHouse
 AuctionQueryContext::~AuctionQueryContext()
 {
     if (Player* player = ObjectAccessor::FindPlayer(playerGuid))
-    {
-        player->m_activeAuctionQueries.erase(this);
-    }
+        sAuctionMgr->RemoveActiveQuery(player, this);
 }
 
 int AuctionQueryContext::call()
@@ -79,25 +77,12 @@ int AuctionQueryContext::call()
     return 0;
 }
 
-AuctionHouseMgr::AuctionHouseMgr()
-{
-    searchThread = std::thread([this]()
-    {
-        while (true)
-        {
-            AuctionQueryContext* request = nullptr;
-            searchQueries.WaitAndPop(request);
-            if (!request)
-                break;
-
-            request->call();
-            delete request;
-        }
-    });
-}
+AuctionHouseMgr::AuctionHouseMgr() { }
 
 AuctionHouseMgr::~AuctionHouseMgr()
 {
+    Unload();
+
     for (ItemMap::iterator itr = mAitems.begin(); itr != mAitems.end(); ++itr)
         delete itr->second;
 }
@@ -111,8 +96,47 @@ AuctionHouseMgr* AuctionHouseMgr::instance()
 void AuctionHouseMgr::Unload()
 {
     searchQueries.Cancel();
-    if (searchThread.joinable())
-        searchThread.join();
+    for (std::thread& thread : searchThreads)
+        if (thread.joinable())
+            thread.join();
+
+    searchThreads.clear();
+}
+
+void AuctionHouseMgr::StartSearchWorkers(uint32 count)
+{
+    // Searches only read the auction houses, any number of them can run at once
+    for (uint32 i = searchThreads.size(); i < std::max(count, 1u); ++i)
+    {
+        searchThreads.emplace_back([this]()
+        {
+            while (true)
+            {
+                AuctionQueryContext* request = nullptr;
+                searchQueries.WaitAndPop(request);
+                if (!request)
+                    break;
+
+                request->call();
+                delete request;
+            }
+        });
+    }
+}
+
+void AuctionHouseMgr::WaitForActiveQueries(Player* player)
+{
+    std::unique_lock<std::mutex> lock(activeQueriesLock);
+    activeQueriesDone.wait(lock, [player] { return player->m_activeAuctionQueries.empty(); });
+}
+
+void AuctionHouseMgr::RemoveActiveQuery(Player* player, AuctionQueryContext* context)
+{
+    {
+        std::lock_guard<std::mutex> lock(activeQueriesLock);
+        player->m_activeAuctionQueries.erase(context);
+    }
+    activeQueriesDone.notify_all();
 }
 
 AuctionHouseObject* AuctionHouseMgr::GetAuctionsMap(uint32 factionTemplateId)
@@ -449,12 +473,14 @@ void AuctionHouseMgr::LoadAuctions()
 void AuctionHouseMgr::AddAItem(Item* it)
 {
     ASSERT(it);
+    std::unique_lock<std::shared_mutex> lock(mAitemsLock);
     ASSERT(mAitems.find(it->GetGUID().GetCounter()) == mAitems.end());
     mAitems[it->GetGUID().GetCounter()] = it;
 }
 
 bool AuctionHouseMgr::RemoveAItem(uint32 id)
 {
+    std::unique_lock<std::shared_mutex> lock(mAitemsLock);
     ItemMap::iterator i = mAitems.find(id);
     if (i == mAitems.end())
         return false;
@@ -490,7 +516,7 @@ struct AuctionEntryForSorting
 {
     AuctionEntry* Entry;
     ItemTemplate const* Template;
-    std::wstring const* Name;       // Don't delete, pooled in AuctionHouseObject::BuildListAuctionItems
+    std::wstring const* Name;       // Don't delete, points to storage in AuctionHouseObject::_searchNames
     std::string const* Owner;       // Don't delete, points to storage in sWorld
     uint32 Bid;
 
@@ -503,6 +529,58 @@ template<> inline int32 AuctionCompare<std::string const*>(bool reverse, std::st
 template<> inline int32 AuctionCompare<std::wstring const*>(bool reverse, std::wstring const* const& a, std::wstring const* const& b) { int32 comp = a->compare(*b); return reverse ? -comp : comp; }
 template<class T> inline int32 AuctionCompare(bool reverse, T const& a1, T const& b1, T const& a2, T const& b2) { return a1 != b1 ? AuctionCompare(reverse, a1, b1) : AuctionCompare(reverse, a2, b2); }
 
+class AuctionSortPredicate
+{
+    public:
+        AuctionSortPredicate(uint64 playerGuid, std::vector<int8> const& sortOrder) : _playerGuid(playerGuid), _sortOrder(sortOrder) { }
+
+        bool operator()(AuctionEntryForSorting const& a, AuctionEntryForSorting const& b) const
+        {
+            for (auto&& order : _sortOrder)
+            {
+                int32 result = 0;
+                bool reverse = order < 0;
+                switch ((AuctionSortColumnIndex)(abs(order) - 1))
+                {
+                    case SORT_COLUMN_LEVEL:         result = AuctionCompare(reverse, std::max(1u, a.Template->RequiredLevel), std::max(1u, b.Template->RequiredLevel)); break;
+                    case SORT_COLUMN_QUALITY:       result = AuctionCompare(!reverse, a.Template->Quality, b.Template->Quality); break;
+                    case SORT_COLUMN_BUYOUTTHENBID: result = AuctionCompare(reverse, a.Entry->buyout ? a.Entry->buyout : a.Bid, b.Entry->buyout ? b.Entry->buyout : b.Bid, a.Bid, b.Bid); break;
+                    case SORT_COLUMN_DURATION:      result = AuctionCompare(reverse, a.Entry->expire_time, b.Entry->expire_time); break;
+                    case SORT_COLUMN_STATUS:        result = AuctionCompare(!reverse, _playerGuid == a.Entry->bidder ? 2 : a.Entry->buyout ? 1 : 0, _playerGuid == b.Entry->bidder ? 2 : b.Entry->buyout ? 1 : 0); break;
+                    case SORT_COLUMN_NAME:          result = AuctionCompare(reverse, a.Name, b.Name); break;
+                    case SORT_COLUMN_MINBIDBUYOUT:  result = AuctionCompare(reverse, a.Entry->buyout ? a.Entry->buyout : a.Bid, b.Entry->buyout ? b.Entry->buyout : b.Bid); break;
+                    case SORT_COLUMN_SELLER:        result = a.Owner && b.Owner ?
+                        AuctionCompare(reverse, a.Owner, b.Owner) :
+                        AuctionCompare(reverse, a.Entry->owner, b.Entry->owner); break;
+                    case SORT_COLUMN_BID:           result = AuctionCompare(reverse, a.Bid, b.Bid); break;
+                    case SORT_COLUMN_QUANTITY:      result = AuctionCompare(reverse, a.Entry->itemCount, b.Entry->itemCount); break;
+                    case SORT_COLUMN_BUYOUT:        result = AuctionCompare(reverse, a.Entry->buyout, b.Entry->buyout); break;
+                    default:                        result = 0; break;
+                }
+
+                if (result)
+                    return result < 0;
+            }
+            return false;
+        }
+
+    private:
+        uint64 _playerGuid;
+        std::vector<int8> const& _sortOrder;
+};
+
+template<class Index, class Key>
+static void EraseFromAuctionIndex(Index& index, Key key, uint32 auctionId)
+{
+    auto itr = index.find(key);
+    if (itr == index.end())
+        return;
+
+    itr->second.erase(auctionId);
+    if (itr->second.empty())
+        index.erase(itr);
+}
+
 void AuctionHouseMgr::QueryAuctionItems(uint32 auctioneerFaction, Player* player,
     std::string const& searchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
     uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
@@ -552,6 +630,7 @@ void AuctionHouseMgr::QueryAuctionItems(uint32 auctioneerFaction, Player* player
         context->sortOrder = sortOrder;
 
         {
+            std::lock_guard<std::mutex> lock(activeQueriesLock);
             player->m_activeAuctionQueries.insert(context);
         }
         searchQueries.Push(context);
@@ -602,13 +681,32 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction, bool skipLock)
 {
     ASSERT(auction);
 
-    AuctionsMap[auction->Id] = auction;
+    {
+        std::unique_lock<std::shared_mutex> lock(_auctionsLock, std::defer_lock);
+        if (!skipLock)
+            lock.lock();
+
+        AuctionsMap[auction->Id] = auction;
+        IndexAuction(auction);
+        ++_generation;
+    }
+
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, bool skipLock)
 {
-    bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    bool wasInMap = false;
+    {
+        std::unique_lock<std::shared_mutex> lock(_auctionsLock, std::defer_lock);
+        if (!skipLock)
+            lock.lock();
+
+        wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+        if (wasInMap)
+            UnindexAuction(auction->Id);
+        ++_generation;
+    }
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -619,6 +717,160 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, bool skipLock)
     return wasInMap;
 }
 
+void AuctionHouseObject::IndexAuction(AuctionEntry* auction)
+{
+    // Reloading auctions replaces entries with the same id
+    UnindexAuction(auction->Id);
+
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->itemEntry);
+    if (!proto)
+        return;
+
+    int32 propRefID = 0;
+    if (Item* item = sAuctionMgr->GetAItem(auction->itemGUIDLow))
+        propRefID = item->GetItemRandomPropertyId();
+
+    AuctionSearchEntry& entry = _searchEntries[auction->Id];
+    entry.Entry = auction;
+    entry.Template = proto;
+    entry.NameKey = uint64(proto->ItemId) | (uint64(uint32(propRefID)) << 32);
+
+    _byClass[proto->Class].insert(auction->Id);
+    _bySubClass[proto->Class << 16 | proto->SubClass].insert(auction->Id);
+    _byInventoryType[proto->InventoryType == INVTYPE_ROBE ? INVTYPE_CHEST : proto->InventoryType].insert(auction->Id);
+    _byQuality[proto->Quality].insert(auction->Id);
+    _byLevel[proto->RequiredLevel].insert(auction->Id);
+    _byName[entry.NameKey].insert(auction->Id);
+
+    // Names in the default locale are built up front, other locales on their first search
+    GetSearchName(entry.NameKey, DEFAULT_LOCALE, DEFAULT_LOCALE);
+}
+
+void AuctionHouseObject::UnindexAuction(uint32 auctionId)
+{
+    auto itr = _searchEntries.find(auctionId);
+    if (itr == _searchEntries.end())
+        return;
+
+    ItemTemplate const* proto = itr->second.Template;
+    EraseFromAuctionIndex(_byClass, proto->Class, auctionId);
+    EraseFromAuctionIndex(_bySubClass, proto->Class << 16 | proto->SubClass, auctionId);
+    EraseFromAuctionIndex(_byInventoryType, proto->InventoryType == INVTYPE_ROBE ? INVTYPE_CHEST : proto->InventoryType, auctionId);
+    EraseFromAuctionIndex(_byQuality, proto->Quality, auctionId);
+    EraseFromAuctionIndex(_byLevel, proto->RequiredLevel, auctionId);
+    EraseFromAuctionIndex(_byName, itr->second.NameKey, auctionId);
+
+    _searchEntries.erase(itr);
+}
+
+std::wstring const* AuctionHouseObject::GetSearchName(uint64 nameKey, LocaleConstant loc_idx, LocaleConstant locdbc_idx)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(_searchNamesLock);
+        auto itr = _searchNames[loc_idx].find(nameKey);
+        if (itr != _searchNames[loc_idx].end())
+            return itr->second.empty() ? nullptr : &itr->second;
+    }
+
+    // Items without a name are cached as empty names and never match
+    std::wstring wname;
+    if (ItemTemplate const* proto = sObjectMgr->GetItemTemplate(uint32(nameKey)))
+    {
+        int32 propRefID = int32(nameKey >> 32);
+        std::string name = proto->Name1;
+        if (!name.empty())
+        {
+            // local name
+            if (loc_idx >= 0)
+                if (ItemLocale const *il = sObjectMgr->GetItemLocale(proto->ItemId))
+                    ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
+
+            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+            //  used in BuildAuctionInfo() which then causes wrong items to be listed
+            if (propRefID)
+            {
+                // Append the suffix to the name (ie: of the Monkey) if one exists
+                DbcStr const* temp = nullptr;
+                if (propRefID < 0)
+                {
+                    if (ItemRandomSuffixEntry const* itemRandProp = sItemRandomSuffixStore.LookupEntry(-propRefID))
+                        temp = &itemRandProp->nameSuffix;
+                }
+                else if (ItemRandomPropertiesEntry const* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID))
+                    temp = &itemRandProp->nameSuffix;
+
+                // dbc local name
+                if (temp)
+                {
+                    if (locdbc_idx < 0)
+                        locdbc_idx = LOCALE_enUS;
+
+                    // Append the suffix (ie: of the Monkey) to the name using localization
+                    name += " ";
+                    name += (*temp)[locdbc_idx];
+                }
+            }
+
+            if (Utf8toWStr(name, wname))
+                wstrToLower(wname);
+            else
+                wname.clear();
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_searchNamesLock);
+    std::wstring const& cached = _searchNames[loc_idx].emplace(nameKey, std::move(wname)).first->second;
+    return cached.empty() ? nullptr : &cached;
+}
+
+std::shared_ptr<std::vector<uint32> const> AuctionHouseObject::FindSearchView(std::string const& key, bool paging)
+{
+    std::lock_guard<std::mutex> lock(_searchViewsLock);
+    auto itr = _searchViews.find(key);
+    if (itr == _searchViews.end())
+        return nullptr;
+
+    // Views outlive auction changes for a moment, paging through a busy auction house would sort again for every page otherwise,
+    // but a new search (first page) after a change sorts again
+    if (GetMSTimeDiffToNow(itr->second.CreateTime) >= sWorld->getIntConfig(CONFIG_AUCTIONHOUSE_SEARCH_VIEW_MAX_AGE)
+        || (itr->second.Generation != _generation && !paging))
+    {
+        _searchViewsByUse.erase(itr->second.RecentUse);
+        _searchViews.erase(itr);
+        return nullptr;
+    }
+
+    _searchViewsByUse.splice(_searchViewsByUse.begin(), _searchViewsByUse, itr->second.RecentUse);
+    return itr->second.Auctions;
+}
+
+void AuctionHouseObject::StoreSearchView(std::string const& key, std::shared_ptr<std::vector<uint32> const> auctions)
+{
+    std::lock_guard<std::mutex> lock(_searchViewsLock);
+    auto itr = _searchViews.find(key);
+    if (itr != _searchViews.end())
+        _searchViewsByUse.splice(_searchViewsByUse.begin(), _searchViewsByUse, itr->second.RecentUse);
+    else
+    {
+        // the least recently paged searches make room
+        if (_searchViews.size() >= 256)
+        {
+            _searchViews.erase(_searchViewsByUse.back());
+            _searchViewsByUse.pop_back();
+        }
+
+        _searchViewsByUse.push_front(key);
+        itr = _searchViews.emplace(key, AuctionSearchView()).first;
+        itr->second.RecentUse = _searchViewsByUse.begin();
+    }
+
+    AuctionSearchView& view = itr->second;
+    view.Auctions = std::move(auctions);
+    view.Generation = _generation;
+    view.CreateTime = getMSTime();
+}
+
 void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld->GetGameTime();
@@ -638,7 +890,7 @@ void AuctionHouseObject::Update()
     do
     {
         // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = GetAuction(result->Fetch()->GetUInt32(), true);
+        AuctionEntry* auction = GetAuction(result->Fetch()->GetUInt32());
 
         if (!auction)
             continue;
@@ -669,13 +921,14 @@ void AuctionHouseObject::Update()
         CharacterDatabase.CommitTransaction(trans);
 
         sAuctionMgr->RemoveAItem(auction->itemGUIDLow);
-        RemoveAuction(auction, true);
+        RemoveAuction(auction);
     }
     while (result->NextRow());
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
 {
+    std::shared_lock<std::shared_mutex> lock(_auctionsLock);
 
     for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
     {
@@ -683,15 +936,17 @@ void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player,
         if (Aentry && Aentry->bidder == player->GetGUID().GetCounter())
         {
             if (itr->second->BuildAuctionInfo(data))
+            {
                 ++count;
-
-            ++totalcount;
+                ++totalcount;
+            }
         }
     }
 }
 
 void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
 {
+    std::shared_lock<std::shared_mutex> lock(_auctionsLock);
 
     for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
     {
@@ -699,9 +954,10 @@ void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player,
         if (Aentry && Aentry->owner == player->GetGUID().GetCounter())
         {
             if (Aentry->BuildAuctionInfo(data))
+            {
                 ++count;
-
-            ++totalcount;
+                ++totalcount;
+            }
         }
     }
 }
@@ -721,31 +977,154 @@ bool AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
     if (!Utf8toWStr(searchedname, wsearchedname))
         return false;
 
-    wstrToUpper(wsearchedname);
-
-    std::vector<AuctionEntryForSorting*> matched;
-    matched.reserve(AuctionsMap.size());
+    wstrToLower(wsearchedname);
 
     bool hasNameSortOrder = false;
     bool hasOwnerSortOrder = false;
+    bool hasStatusSortOrder = false;
     for (auto&& order : sortOrder)
     {
         if (abs(order) - 1 == SORT_COLUMN_NAME)
             hasNameSortOrder = true;
         else if (abs(order) - 1 == SORT_COLUMN_SELLER)
             hasOwnerSortOrder = true;
+        else if (abs(order) - 1 == SORT_COLUMN_STATUS)
+            hasStatusSortOrder = true;
     }
 
+    bool sorted = !sortOrder.empty() && sWorld->getBoolConfig(CONFIG_AUCTIONHOUSE_ALLOW_SORTING);
+
+    std::shared_lock<std::shared_mutex> lock(_auctionsLock);
+
+    // Sorted results are kept for the next pages, except "usable" ones which depend on the player
+    std::string viewKey;
+    if (sorted && !usable && sWorld->getIntConfig(CONFIG_AUCTIONHOUSE_SEARCH_VIEW_MAX_AGE))
+    {
+        std::ostringstream key;
+        key << int32(loc_idx) << ':' << searchedname << ':' << uint32(levelmin) << ':' << uint32(levelmax) << ':'
+            << inventoryType << ':' << itemClass << ':' << itemSubClass << ':' << quality << ':' << getAll;
+        for (auto&& order : sortOrder)
+            key << ':' << int32(order);
+        if (hasStatusSortOrder)
+            key << ':' << playerGuid;
+        viewKey = key.str();
+    }
+
+    if (std::shared_ptr<std::vector<uint32> const> view = viewKey.empty() ? nullptr : FindSearchView(viewKey, listfrom > 0))
+    {
+        // auctions gone since the view was sorted are neither sent nor counted
+        for (uint32 auctionId : *view)
+        {
+            AuctionEntryMap::const_iterator itr = AuctionsMap.find(auctionId);
+            if (itr == AuctionsMap.end() || !sAuctionMgr->GetAItem(itr->second->itemGUIDLow))
+                continue;
+
+            if (totalcount++ >= listfrom && (getAll || count < 50) && itr->second->BuildAuctionInfo(data))
+                ++count;
+        }
+
+        throttle = usable ? 1500 : 300;
+        return true;
+    }
+
+    // Walk the smallest index bucket covering one of the filters instead of every auction
+    std::vector<AuctionIdSet const*> candidates;
+    size_t candidateCount = AuctionsMap.size();
+    bool hasCandidates = false;
+    auto considerCandidates = [&](std::vector<AuctionIdSet const*>&& sets)
+    {
+        size_t setCount = 0;
+        for (AuctionIdSet const* set : sets)
+            setCount += set->size();
+
+        if (!hasCandidates || setCount < candidateCount)
+        {
+            candidates = std::move(sets);
+            candidateCount = setCount;
+            hasCandidates = true;
+        }
+    };
+    auto bucket = [](AuctionIndex const& index, uint32 key)
+    {
+        std::vector<AuctionIdSet const*> sets;
+        auto itr = index.find(key);
+        if (itr != index.end())
+            sets.push_back(&itr->second);
+        return sets;
+    };
+
+    // Names are matched once per distinct item name, not once per auction
+    std::unordered_set<uint64> matchedNames;
+    if (!wsearchedname.empty())
+    {
+        std::vector<AuctionIdSet const*> sets;
+        for (auto&& itr : _byName)
+        {
+            std::wstring const* wname = GetSearchName(itr.first, loc_idx, locdbc_idx);
+            if (wname && wname->find(wsearchedname) != std::wstring::npos)
+            {
+                matchedNames.insert(itr.first);
+                sets.push_back(&itr.second);
+            }
+        }
+        considerCandidates(std::move(sets));
+    }
+
+    if (itemClass != 0xffffffff && itemSubClass != 0xffffffff)
+        considerCandidates(bucket(_bySubClass, itemClass << 16 | itemSubClass));
+    else if (itemClass != 0xffffffff)
+        considerCandidates(bucket(_byClass, itemClass));
+
+    if (inventoryType != 0xffffffff)
+        considerCandidates(bucket(_byInventoryType, inventoryType));
+
+    if (quality != 0xffffffff)
+    {
+        std::vector<AuctionIdSet const*> sets;
+        for (auto&& itr : _byQuality)
+            if (itr.first >= quality)
+                sets.push_back(&itr.second);
+        considerCandidates(std::move(sets));
+    }
+
+    if (levelmin != 0x00 || levelmax != 0x00)
+    {
+        std::vector<AuctionIdSet const*> sets;
+        for (auto&& itr : _byLevel)
+            if ((levelmin == 0x00 || itr.first >= levelmin) && (levelmax == 0x00 || itr.first <= levelmax))
+                sets.push_back(&itr.second);
+        considerCandidates(std::move(sets));
+    }
+
+    std::vector<uint32> auctionIds;
+    auctionIds.reserve(candidateCount);
+    if (hasCandidates)
+    {
+        for (AuctionIdSet const* set : candidates)
+            auctionIds.insert(auctionIds.end(), set->begin(), set->end());
+
+        // unsorted results are listed by auction id
+        if (candidates.size() > 1)
+            std::sort(auctionIds.begin(), auctionIds.end());
+    }
+    else
+    {
+        for (auto&& entry : AuctionsMap)
+            auctionIds.push_back(entry.first);
+    }
+
+    std::vector<AuctionEntryForSorting> matched;
+    matched.reserve(auctionIds.size());
+
     AuctionHouseMgr* aucMgr = sAuctionMgr;
-    ObjectMgr* objMgr = sObjectMgr;
 
-    for (auto&& entry : AuctionsMap)
+    for (uint32 auctionId : auctionIds)
     {
-        Item *item = aucMgr->GetAItem(entry.second->itemGUIDLow);
-        if (!item)
+        auto entry = _searchEntries.find(auctionId);
+        if (entry == _searchEntries.end())
             continue;
 
-        ItemTemplate const *proto = objMgr->GetItemTemplate(item->GetEntry());
+        ItemTemplate const *proto = entry->second.Template;
 
         if (itemClass != 0xffffffff && proto->Class != itemClass)
             continue;
@@ -765,149 +1144,59 @@ bool AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
         if (levelmax != 0x00 && proto->RequiredLevel > levelmax)
             continue;
 
+        // auctions without their item cannot be sent and are not counted
+        Item* item = aucMgr->GetAItem(entry->second.Entry->itemGUIDLow);
+        if (!item)
+            continue;
+
         if (usable != 0x00 && player && player->CanUseItem(item) != EQUIP_ERR_OK)
             continue;
 
         // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        std::wstring* wname = nullptr;
-        // No need to do any of this if no search term was entered or no name sorting was selected
-        if (hasNameSortOrder || !wsearchedname.empty())
-        {
-            int32 propRefID = item->GetItemRandomPropertyId();
-            uint64 cacheEntry = uint64(proto->ItemId) | (uint64(uint32(propRefID)) << 32);
-            auto itr = ItemNameCache[loc_idx].find(cacheEntry);
-            if (itr == ItemNameCache[loc_idx].end())
-            {
-                std::string name = proto->Name1;
-                if (name.empty())
-                    continue;
-
-                // local name
-                if (loc_idx >= 0)
-                    if (ItemLocale const *il = objMgr->GetItemLocale(proto->ItemId))
-                        ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
-
-                // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-                //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-                //  used in BuildAuctionInfo() which then causes wrong items to be listed
-                if (propRefID)
-                {
-                    // Append the suffix to the name (ie: of the Monkey) if one exists
-                    DbcStr const* temp = nullptr;
-                    if (propRefID < 0)
-                    {
-                        if (ItemRandomSuffixEntry const* itemRandProp = sItemRandomSuffixStore.LookupEntry(-propRefID))
-                            temp = &itemRandProp->nameSuffix;
-                    }
-                    else if (ItemRandomPropertiesEntry const* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID))
-                        temp = &itemRandProp->nameSuffix;
-
-                    // dbc local name
-                    if (temp)
-                    {
-                        if (locdbc_idx < 0)
-                            locdbc_idx = LOCALE_enUS;
-
-                        // Append the suffix (ie: of the Monkey) to the name using localization
-                        name += " ";
-                        name += (*temp)[locdbc_idx];
-                    }
-                }
-
-                wname = &ItemNameCache[loc_idx][cacheEntry];
-
-                if (!Utf8toWStr(name, *wname))
-                    ASSERT(false);
-
-                wstrToUpper(*wname);
-            }
-            else
-                wname = &itr->second;
+        if (!wsearchedname.empty() && !matchedNames.count(entry->second.NameKey))
+            continue;
 
-            // Perform the search (with or without suffix)
-            if (!wsearchedname.empty() && wname->find(wsearchedname) == std::wstring::npos)
+        std::wstring const* wname = nullptr;
+        if (hasNameSortOrder)
+        {
+            wname = GetSearchName(entry->second.NameKey, loc_idx, locdbc_idx);
+            if (!wname)
                 continue;
         }
 
         std::string const* owner = NULL;
         if (hasOwnerSortOrder)
-            if (CharacterNameData const* charData = sWorld->GetCharacterNameData(ObjectGuid(HighGuid::Player, entry.second->owner)))
+            if (CharacterNameData const* charData = sWorld->GetCharacterNameData(ObjectGuid(HighGuid::Player, entry->second.Entry->owner)))
                 owner = &charData->m_name;
 
-        matched.push_back(new AuctionEntryForSorting(entry.second, proto, wname, owner));
+        matched.emplace_back(entry->second.Entry, proto, wname, owner);
     }
 
     totalcount = matched.size();
 
-    if (!sortOrder.empty() && sWorld->getBoolConfig(CONFIG_AUCTIONHOUSE_ALLOW_SORTING))
+    if (sorted)
     {
-        std::sort(matched.begin(), matched.end(), [&playerGuid, &sortOrder](AuctionEntryForSorting* const& a, AuctionEntryForSorting* const& b)
-        {
-            for (auto&& order : sortOrder)
-            {
-                int32 result = 0;
-                bool reverse = order < 0;
-                switch ((AuctionSortColumnIndex)(abs(order) - 1))
-                {
-                    case SORT_COLUMN_LEVEL:         result = AuctionCompare(reverse, std::max(1u, a->Template->RequiredLevel), std::max(1u, b->Template->RequiredLevel)); break;
-                    case SORT_COLUMN_QUALITY:       result = AuctionCompare(!reverse, a->Template->Quality, b->Template->Quality); break;
-                    case SORT_COLUMN_BUYOUTTHENBID: result = AuctionCompare(reverse, a->Entry->buyout ? a->Entry->buyout : a->Bid, b->Entry->buyout ? b->Entry->buyout : b->Bid, a->Bid, b->Bid); break;
-                    case SORT_COLUMN_DURATION:      result = AuctionCompare(reverse, a->Entry->expire_time, b->Entry->expire_time); break;
-                    case SORT_COLUMN_STATUS:        result = AuctionCompare(!reverse, playerGuid == a->Entry->bidder ? 2 : a->Entry->buyout ? 1 : 0, playerGuid == b->Entry->bidder ? 2 : b->Entry->buyout ? 1 : 0); break;
-                    case SORT_COLUMN_NAME:          result = AuctionCompare(reverse, a->Name, b->Name); break;
-                    case SORT_COLUMN_MINBIDBUYOUT:  result = AuctionCompare(reverse, a->Entry->buyout ? a->Entry->buyout : a->Bid, b->Entry->buyout ? b->Entry->buyout : b->Bid); break;
-                    case SORT_COLUMN_SELLER:        result = a->Owner && b->Owner ?
-                        AuctionCompare(reverse, a->Owner, b->Owner) :
-                        AuctionCompare(reverse, a->Entry->owner, b->Entry->owner); break;
-                    case SORT_COLUMN_BID:           result = AuctionCompare(reverse, a->Bid, b->Bid); break;
-                    case SORT_COLUMN_QUANTITY:      result = AuctionCompare(reverse, a->Entry->itemCount, b->Entry->itemCount); break;
-                    case SORT_COLUMN_BUYOUT:        result = AuctionCompare(reverse, a->Entry->buyout, b->Entry->buyout); break;
-                    default:                        result = 0; break;
-                }
-
-                if (result)
-                    return result < 0;
-            }
-            return false;
-        });
-    }
+        // Only the requested page has to be in order unless the whole result is kept
+        uint64 pageEnd = uint64(listfrom) + 50;
+        if (viewKey.empty() && !getAll && pageEnd < matched.size())
+            std::partial_sort(matched.begin(), matched.begin() + pageEnd, matched.end(), AuctionSortPredicate(playerGuid, sortOrder));
+        else
+            std::sort(matched.begin(), matched.end(), AuctionSortPredicate(playerGuid, sortOrder));
 
-    // Cut first [listfrom] elements out of the list
-    if (listfrom)
-    {
-        if (matched.size() <= listfrom)
+        if (!viewKey.empty())
         {
+            std::shared_ptr<std::vector<uint32>> view = std::make_shared<std::vector<uint32>>();
+            view->reserve(matched.size());
             for (auto&& match : matched)
-                delete match;
-
-            matched.clear();
-        }
-        else
-        {
-            auto endItr = matched.begin() + listfrom;
-            for (auto itr = matched.begin(); itr != endItr; ++itr)
-                delete *itr;
-
-            matched.erase(matched.begin(), endItr);
+                view->push_back(match.Entry->Id);
+            StoreSearchView(viewKey, std::move(view));
         }
     }
 
-    // Erase all elements outside of current page
-    if (!getAll && matched.size() > 50)
-    {
-        for (auto itr = matched.begin() + 50; itr != matched.end(); ++itr)
-            delete *itr;
-
-        matched.resize(50);
-    }
-
-    count = matched.size();
-
-    for (auto&& match : matched)
-    {
-        match->Entry->BuildAuctionInfo(data);
-        delete match;
-    }
+    // Skip the first [listfrom] elements and everything outside of the current page
+    for (size_t i = listfrom; i < matched.size() && (getAll || count < 50); ++i)
+        if (matched[i].Entry->BuildAuctionInfo(data))
+            ++count;
 
     throttle = usable ? 1500 : 300;
 
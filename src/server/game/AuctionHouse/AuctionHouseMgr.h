@@ -22,11 +22,15 @@
 #include "DBCStructure.h"
 #include "DatabaseEnv.h"
 #include "ProducerConsumerQueue.h"
+#include <condition_variable>
+#include <list>
+#include <shared_mutex>
 
 class Item;
 class Player;
 class WorldPacket;
 class LogFile;
+struct ItemTemplate;
 
 #define MIN_AUCTION_TIME    (12*HOUR)
 #define MAX_AUCTION_ITEMS    32
@@ -123,10 +127,28 @@ struct AuctionQueryContext
     int call();
 };
 
+// Search data of an auction, resolved once when the auction is added
+struct AuctionSearchEntry
+{
+    AuctionEntry* Entry;
+    ItemTemplate const* Template;
+    uint64 NameKey;                                         // item entry | random property id << 32, shared by equally named items
+};
+
+// Sorted result of a search, later pages of the same search are cut from it
+struct AuctionSearchView
+{
+    std::shared_ptr<std::vector<uint32> const> Auctions;
+    uint32 Generation;
+    uint32 CreateTime;
+    std::list<std::string>::iterator RecentUse;             // position in AuctionHouseObject::_searchViewsByUse
+};
+
 //this class is used as auctionhouse instance
 class AuctionHouseObject
 {
   public:
+    AuctionHouseObject() : _generation(0) { }
     ~AuctionHouseObject()
     {
         for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -142,6 +164,10 @@ class AuctionHouseObject
 
     AuctionEntry* GetAuction(uint32 id, bool skipLock = false)
     {
+        std::shared_lock<std::shared_mutex> lock(_auctionsLock, std::defer_lock);
+        if (!skipLock)
+            lock.lock();
+
         AuctionEntryMap::const_iterator itr = AuctionsMap.find(id);
         AuctionEntry* result = itr != AuctionsMap.end() ? itr->second : nullptr;
         return result;
@@ -162,9 +188,35 @@ class AuctionHouseObject
         uint32& count, uint32& totalcount, uint32& throttle);
 
   private:
-    AuctionEntryMap AuctionsMap;
-    std::map<uint64, std::wstring> ItemNameCache[TOTAL_LOCALES];
+    typedef std::set<uint32> AuctionIdSet;
+    typedef std::unordered_map<uint32, AuctionIdSet> AuctionIndex;
+
+    void IndexAuction(AuctionEntry* auction);
+    void UnindexAuction(uint32 auctionId);
+    std::wstring const* GetSearchName(uint64 nameKey, LocaleConstant loc_idx, LocaleConstant locdbc_idx);
+    std::shared_ptr<std::vector<uint32> const> FindSearchView(std::string const& key, bool paging);
+    void StoreSearchView(std::string const& key, std::shared_ptr<std::vector<uint32> const> auctions);
 
+    AuctionEntryMap AuctionsMap;
+    // Guards AuctionsMap and the search indexes, searches run on the search workers
+    mutable std::shared_mutex _auctionsLock;
+
+    std::unordered_map<uint32, AuctionSearchEntry> _searchEntries;
+    AuctionIndex _byClass;                                  // [class]
+    AuctionIndex _bySubClass;                               // [class << 16 | subclass]
+    AuctionIndex _byInventoryType;                          // [inventory type], robes listed as chest
+    AuctionIndex _byQuality;                                // [quality]
+    AuctionIndex _byLevel;                                  // [required level]
+    std::unordered_map<uint64, AuctionIdSet> _byName;       // [name key]
+
+    // Lowercase item names by name key, never erased so search results can point into them
+    std::unordered_map<uint64, std::wstring> _searchNames[TOTAL_LOCALES];
+    std::shared_mutex _searchNamesLock;
+
+    std::unordered_map<std::string, AuctionSearchView> _searchViews;
+    std::list<std::string> _searchViewsByUse;               // keys, most recently used first
+    std::mutex _searchViewsLock;
+    std::atomic<uint32> _generation;                        // bumped when auctions are added or removed
 };
 
 class AuctionHouseMgr
@@ -186,6 +238,7 @@ class AuctionHouseMgr
 
         Item* GetAItem(ObjectGuid::LowType id)
         {
+            std::shared_lock<std::shared_mutex> lock(mAitemsLock);
             ItemMap::const_iterator itr = mAitems.find(id);
             if (itr != mAitems.end())
                 return itr->second;
@@ -223,6 +276,11 @@ class AuctionHouseMgr
             uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
             bool getAll, std::vector<int8> const& sortOrder);
 
+        void StartSearchWorkers(uint32 count);
+        // blocks until the search workers are done with the queries of the player
+        void WaitForActiveQueries(Player* player);
+        void RemoveActiveQuery(Player* player, AuctionQueryContext* context);
+
     private:
 
         AuctionHouseObject mHordeAuctions;
@@ -230,8 +288,11 @@ class AuctionHouseMgr
         AuctionHouseObject mNeutralAuctions;
 
         ItemMap mAitems;
-        std::thread searchThread;
+        std::shared_mutex mAitemsLock;
+        std::vector<std::thread> searchThreads;
         ProducerConsumerQueue<AuctionQueryContext*> searchQueries;
+        std::mutex activeQueriesLock;                       // Player::m_activeAuctionQueries
+        std::condition_variable activeQueriesDone;
 };
 
 #define sAuctionMgr AuctionHouseMgr::instance()
@@ -22,6 +22,7 @@
 #include "World.h"
 #include "DatabaseEnv.h"
 #include "AccountMgr.h"
+#include "PacketBroadcast.h"
 #include "Player.h"
 
 Channel::Channel(std::string const& name, uint32 channelId, uint32 team):
@@ -728,18 +729,19 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket* data, ObjectGuid guid)
 {
-    for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
-        if (Player* player = ObjectAccessor::FindPlayer(i->first))
-            if (!guid || !player->GetSocial()->HasIgnore(guid))
-                player->GetSession()->SendPacket(data);
+    PacketBroadcast broadcast(data);
+    broadcast.AddPlayers(playersStore.begin(), playersStore.end(), [](PlayerContainer::value_type const& member) { return member.first; });
+    broadcast.Send([guid](Player* player) { return !guid || !player->GetSocial()->HasIgnore(guid); });
 }
 
 void Channel::SendToAllButOne(WorldPacket* data, ObjectGuid who)
 {
-    for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
-        if (i->first != who)
-            if (Player* player = ObjectAccessor::FindPlayer(i->first))
-                player->GetSession()->SendPacket(data);
+    PacketBroadcast broadcast(data);
+    broadcast.AddPlayers(playersStore.begin(), playersStore.end(), [who](PlayerContainer::value_type const& member)
+    {
+        return member.first != who ? member.first : ObjectGuid::Empty;
+    });
+    broadcast.Send();
 }
 
 void Channel::SendToOne(WorldPacket* data, ObjectGuid who)
@@ -887,7 +887,7 @@ std::string Condition::ToString(bool ext /*= false*/) const
     return ss.str();
 }
 
-ConditionMgr::ConditionMgr() { }
+ConditionMgr::ConditionMgr() : _generation(0) { }
 
 ConditionMgr::~ConditionMgr()
 {
@@ -1124,6 +1124,18 @@ bool ConditionMgr::IsObjectMeetingSmartEventConditions(int32 entryOrGuid, uint32
     return true;
 }
 
+ConditionContainer const* ConditionMgr::GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const
+{
+    SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
+    if (itr != SmartEventConditionStore.end())
+    {
+        ConditionsByEntryMap::const_iterator i = itr->second.find(eventId + 1);
+        if (i != itr->second.end())
+            return &i->second;
+    }
+    return nullptr;
+}
+
 ConditionContainer const* ConditionMgr::GetConditionsForPhaseDefinition(uint32 zone, uint32 entry) const
 {
     PhaseDefinitionConditionContainer::const_iterator itr = PhaseDefinitionsConditionStore.find(zone);
@@ -1168,6 +1180,7 @@ void ConditionMgr::LoadConditions(bool isReload)
     uint32 oldMSTime = getMSTime();
 
     Clean();
+    ++_generation;
 
     //must clear all custom handled cases (groupped types) before reload
     if (isReload)
@@ -1206,7 +1219,7 @@ void ConditionMgr::LoadConditions(bool isReload)
         sObjectMgr->LoadAreaPhases();
     }
 
-    QueryResult result = WorldDatabase.Query("SELECT SourceTypeOrReferenceId, SourceGroup, SourceEntry, SourceId, ElseGroup, ConditionTypeOrReference, ConditionTarget, "
+    QueryResult result = WorldDatabaseSnapshot.Query(WorldDatabase, "SELECT SourceTypeOrReferenceId, SourceGroup, SourceEntry, SourceId, ElseGroup, ConditionTypeOrReference, ConditionTarget, "
                                              " ConditionValue1, ConditionValue2, ConditionValue3, NegativeCondition, ErrorType, ErrorTextId, ScriptName FROM conditions");
 
     if (!result)
@@ -287,9 +287,13 @@ class TC_GAME_API ConditionMgr
         ConditionContainer const* GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId) const;
         bool IsObjectMeetingVehicleSpellConditions(uint32 creatureId, uint32 spellId, Player* player, Unit* vehicle) const;
         bool IsObjectMeetingSmartEventConditions(int32 entryOrGuid, uint32 eventId, uint32 sourceType, Unit* unit, WorldObject* baseObject) const;
+        ConditionContainer const* GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const;
         bool IsObjectMeetingVendorItemConditions(uint32 creatureId, uint32 itemId, Player* player, Creature* vendor) const;
 
 
+        // Bumped on every load, containers returned before a reload are freed by it
+        uint32 GetGeneration() const { return _generation; }
+
         void RegisterVehicleAI(VehicleAIBase* ai) { m_vehicleAIs.insert(ai); }
         void UnregisterVehicleAI(VehicleAIBase* ai) { m_vehicleAIs.erase(ai); }
 
@@ -326,6 +330,7 @@ class TC_GAME_API ConditionMgr
         PhaseDefinitionConditionContainer PhaseDefinitionsConditionStore;
 
         std::unordered_set<VehicleAIBase*> m_vehicleAIs;
+        uint32 _generation;
 };
 
 #define sConditionMgr ConditionMgr::instance()
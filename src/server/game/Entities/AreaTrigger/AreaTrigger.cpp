@@ -522,29 +522,35 @@ void AreaTrigger::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player*
         return;
 
     UpdateBuilder builder;
-    builder.SetSource(updateType == UPDATETYPE_VALUES ? _changesMask.GetBits() : m_uint32Values, m_valuesCount);
+    builder.SetSource(updateType == UPDATETYPE_VALUES ? &_changesMask : nullptr, m_uint32Values, m_valuesCount);
     builder.SetDest(data);
 
     uint32* flags = nullptr;
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    builder.SelectFields(GetUpdateFieldMasks(), visibleFlag, _fieldNotifyFlags);
+    builder.ForEachField([&](uint16 index)
     {
-        if (_fieldNotifyFlags & flags[index] || (builder.GetSrcBit(index) && (flags[index] & visibleFlag)))
-        {
-            builder.SetDestBit(index);
-
-            if (index == AREATRIGGER_FIELD_SPELL_VISUAL_ID)
-                *data << GetVisualForTarget(target);
-            else
-                *data << m_uint32Values[index];
-        }
-    }
+        uint32 viewerValue;
+        if (GetViewerDependentValue(index, target, viewerValue))
+            *data << viewerValue;
+        else
+            *data << m_uint32Values[index];
+    });
 
     builder.Finish();
     BuildDynamicValuesUpdate(updateType, data);
 }
 
+bool AreaTrigger::GetViewerDependentValue(uint16 index, Player* target, uint32& value) const
+{
+    if (index != AREATRIGGER_FIELD_SPELL_VISUAL_ID)
+        return false;
+
+    value = GetVisualForTarget(target);
+    return true;
+}
+
 uint32 AreaTrigger::GetVisualForTarget(Player const* target) const
 {
     auto getVisualIfHostile = [=](Player const* target, uint32 hostileViusal)
@@ -188,6 +188,7 @@ class AreaTrigger : public WorldObject, public GridObject<AreaTrigger>, public M
     private:
         void UpdateSplinePosition(uint32 diff);
         void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const;
+        bool GetViewerDependentValue(uint16 index, Player* target, uint32& value) const override;
 
         uint32 GetVisualForTarget(Player const* target) const;
 
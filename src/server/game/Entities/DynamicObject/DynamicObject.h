@@ -61,6 +61,7 @@ class DynamicObject : public WorldObject, public GridObject<DynamicObject>, publ
 
     private:
         void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const override;
+        bool GetViewerDependentValue(uint16 index, Player* target, uint32& value) const override;
         uint32 GetVisualForTarget(Player const* target) const;
 
     protected:
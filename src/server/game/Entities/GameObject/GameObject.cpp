@@ -2629,10 +2629,9 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
         return;
 
     bool forcedFlags = GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo()->chest.groupLootRules && HasLootRecipient();
-    bool targetIsGM = target->IsGameMaster();
 
     UpdateBuilder builder;
-    builder.SetSource(updateType == UPDATETYPE_VALUES ? _changesMask.GetBits() : m_uint32Values, m_valuesCount);
+    builder.SetSource(updateType == UPDATETYPE_VALUES ? &_changesMask : nullptr, m_uint32Values, m_valuesCount);
     builder.SetDest(data);
 
     uint32* flags = nullptr;
@@ -2640,64 +2639,71 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     if (GetOwnerGUID() == target->GetGUID())
         visibleFlag |= UF_FLAG_OWNER;
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    builder.SelectFields(GetUpdateFieldMasks(), visibleFlag, _fieldNotifyFlags);
+    if (forcedFlags)
+        builder.SetDestBit(GAMEOBJECT_FIELD_FLAGS);
+
+    builder.ForEachField([&](uint16 index)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            (builder.GetSrcBit(index) && (flags[index] & visibleFlag)) ||
-            (index == GAMEOBJECT_FIELD_FLAGS && forcedFlags)) // There are not many iterations, we can afford it
-        {
-            builder.SetDestBit(index);
+        uint32 viewerValue;
+        if (GetViewerDependentValue(index, target, viewerValue))
+            *data << viewerValue;
+        else
+            *data << m_uint32Values[index];                // other cases
+    });
 
-            if (index == OBJECT_FIELD_DYNAMIC_FLAGS)
+    builder.Finish();
+    *data << uint8(0);
+}
+
+bool GameObject::GetViewerDependentValue(uint16 index, Player* target, uint32& value) const
+{
+    switch (index)
+    {
+        case OBJECT_FIELD_DYNAMIC_FLAGS:
+        {
+            uint16 dynFlags = 0;
+            int16 pathProgress = -1;
+            switch (GetGoType())
             {
-                uint16 dynFlags = 0;
-                int16 pathProgress = -1;
-                switch (GetGoType())
+                case GAMEOBJECT_TYPE_CHEST:
+                case GAMEOBJECT_TYPE_GOOBER:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                    else if (target->IsGameMaster())
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_GENERIC:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                case GAMEOBJECT_TYPE_TRANSPORT:
+                case GAMEOBJECT_TYPE_MO_TRANSPORT:
                 {
-                    case GAMEOBJECT_TYPE_CHEST:
-                    case GAMEOBJECT_TYPE_GOOBER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
-                        else if (targetIsGM)
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_GENERIC:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        break;
-                    case GAMEOBJECT_TYPE_TRANSPORT:
-                    case GAMEOBJECT_TYPE_MO_TRANSPORT:
+                    if (uint32 transportPeriod = GetTransportPeriod())
                     {
-                        if (uint32 transportPeriod = GetTransportPeriod())
-                        {
-                            float timer = float(m_goValue.Transport.PathProgress % transportPeriod);
-                            pathProgress = int16(timer / float(transportPeriod) * 65535.0f);
-                        }
-                        break;
+                        float timer = float(m_goValue.Transport.PathProgress % transportPeriod);
+                        pathProgress = int16(timer / float(transportPeriod) * 65535.0f);
                     }
-                    default:
-                        break;
+                    break;
                 }
-
-                *data << uint16(dynFlags);
-                *data << int16(pathProgress);
+                default:
+                    break;
             }
-            else if (index == GAMEOBJECT_FIELD_FLAGS)
-            {
-                uint32 flags = m_uint32Values[GAMEOBJECT_FIELD_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
-                    if (((GetGOInfo()->chest.groupLootRules || GetGOInfo()->GetTrackingQuestId()) && !IsLootAllowedFor(target)) || GetMap()->IsChallengeDungeon())
-                        flags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
 
-                *data << flags;
-            }
-            else
-                *data << m_uint32Values[index];                // other cases
+            // uint16 flags followed by int16 path progress
+            value = uint32(dynFlags) | (uint32(uint16(pathProgress)) << 16);
+            return true;
         }
+        case GAMEOBJECT_FIELD_FLAGS:
+            value = m_uint32Values[GAMEOBJECT_FIELD_FLAGS];
+            if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
+                if (((GetGOInfo()->chest.groupLootRules || GetGOInfo()->GetTrackingQuestId()) && !IsLootAllowedFor(target)) || GetMap()->IsChallengeDungeon())
+                    value |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+            return true;
+        default:
+            return false;
     }
-
-    builder.Finish();
-    *data << uint8(0);
 }
 
 void GameObject::GetRespawnPosition(float &x, float &y, float &z, float* ori /* = NULL*/) const
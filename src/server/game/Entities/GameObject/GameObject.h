@@ -139,6 +139,7 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         ~GameObject();
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+        bool GetViewerDependentValue(uint16 index, Player* target, uint32& value) const override;
 
         void AddToWorld() override;
         void RemoveFromWorld() override;
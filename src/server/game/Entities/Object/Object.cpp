@@ -802,20 +802,17 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
         return;
 
     UpdateBuilder builder;
-    builder.SetSource(updateType == UPDATETYPE_VALUES ? _changesMask.GetBits() : m_uint32Values, m_valuesCount);
+    builder.SetSource(updateType == UPDATETYPE_VALUES ? &_changesMask : nullptr, m_uint32Values, m_valuesCount);
     builder.SetDest(data);
 
     uint32* flags = nullptr;
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    builder.SelectFields(GetUpdateFieldMasks(), visibleFlag, _fieldNotifyFlags);
+    builder.ForEachField([&](uint16 index)
     {
-        if (_fieldNotifyFlags & flags[index] || (builder.GetSrcBit(index) && (flags[index] & visibleFlag)))
-        {
-            builder.SetDestBit(index);
-            *data << m_uint32Values[index];
-        }
-    }
+        *data << m_uint32Values[index];
+    });
 
     builder.Finish();
     BuildDynamicValuesUpdate(updateType, data);
@@ -891,6 +888,67 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
     BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
 }
 
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, SharedValuesUpdateMap& sharedUpdates, ValuesUpdateCounters& counters) const
+{
+    uint32* flags = nullptr;
+    uint32 visibleFlag = GetUpdateFieldData(player, flags);
+
+    auto itr = sharedUpdates.find(visibleFlag);
+    if (itr == sharedUpdates.end())
+    {
+        itr = sharedUpdates.emplace(visibleFlag, SharedValuesUpdate()).first;
+        SharedValuesUpdate& update = itr->second;
+
+        update.Block << uint8(UPDATETYPE_VALUES);
+        update.Block << GetPackGUID();
+
+        size_t maskPos = update.Block.wpos();
+        BuildValuesUpdate(UPDATETYPE_VALUES, &update.Block, player);
+
+        // Same mask for everyone in this visibility class, only remember where the per viewer values went
+        uint8 blockCount = update.Block.read<uint8>(maskPos);
+        size_t valuePos = maskPos + 1 + blockCount * sizeof(uint32);
+        for (uint32 block = 0; block < blockCount; ++block)
+        {
+            for (uint32 bits = update.Block.read<uint32>(maskPos + 1 + block * sizeof(uint32)); bits; bits &= bits - 1)
+            {
+                uint16 index = uint16(block * 32 + UpdateMaskHelpers::CountTrailingZeroes(bits));
+
+                uint32 value;
+                if (GetViewerDependentValue(index, player, value))
+                    update.ViewerDependentFields.emplace_back(index, valuePos);
+
+                valuePos += sizeof(uint32);
+            }
+        }
+
+        counters.Built.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        for (auto&& field : itr->second.ViewerDependentFields)
+        {
+            uint32 value = 0;
+            GetViewerDependentValue(field.first, player, value);
+            itr->second.Block.put<uint32>(field.second, value);
+        }
+
+        counters.Shared.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    UpdateDataMapType::iterator iter = data_map.find(player);
+    if (iter == data_map.end())
+        iter = data_map.emplace(player, UpdateData(player->GetMapId())).first;
+
+    iter->second.AddUpdateBlock(itr->second.Block);
+}
+
+ValuesUpdateCounters& Object::GetValuesUpdateCounters()
+{
+    static ValuesUpdateCounters counters;
+    return counters;
+}
+
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
 {
     uint32 visibleFlag = UF_FLAG_PUBLIC | UF_FLAG_VIEWER_DEPENDENT;
@@ -949,6 +1007,29 @@ uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
     return visibleFlag;
 }
 
+UpdateFieldMasks const& Object::GetUpdateFieldMasks() const
+{
+    switch (GetTypeId())
+    {
+        case TYPEID_ITEM:
+        case TYPEID_CONTAINER:
+            return ItemUpdateFieldMasks;
+        case TYPEID_UNIT:
+        case TYPEID_PLAYER:
+            return UnitUpdateFieldMasks;
+        case TYPEID_GAMEOBJECT:
+            return GameObjectUpdateFieldMasks;
+        case TYPEID_DYNAMICOBJECT:
+            return DynamicObjectUpdateFieldMasks;
+        case TYPEID_CORPSE:
+            return CorpseUpdateFieldMasks;
+        case TYPEID_AREATRIGGER:
+            return AreaTriggerUpdateFieldMasks;
+        default:
+            return EmptyUpdateFieldMasks;
+    }
+}
+
 void Object::_LoadIntoDataField(std::string const& data, uint32 startOffset, uint32 count)
 {
     if (data.empty())
@@ -1386,7 +1467,7 @@ void MovementInfo::OutDebug()
 WorldObject::WorldObject(bool isWorldObject): Object(), WorldLocation(), LastUsedScriptID(0),
 m_name(""), m_isActive(false), m_isWorldObject(isWorldObject), m_zoneScript(nullptr),
 m_transport(nullptr), m_zoneId(0), m_areaId(0), m_outdoors(false), m_liquidStatus(LIQUID_MAP_NO_WATER),
-m_currMap(nullptr), m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL), m_explicitSeerGuid(),
+m_currMap(nullptr), m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL), _phases(PhaseSet::Empty()), m_explicitSeerGuid(),
 m_stealthVisibilityUpdateTimer(STEALTH_VISIBILITY_UPDATE_TIMER)
 {
     m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE | GHOST_VISIBILITY_GHOST);
@@ -1475,8 +1556,12 @@ void WorldObject::_Create(uint32 guidlow, HighGuid guidhigh, uint32 phaseMask, s
 {
     Object::_Create(guidlow, 0, guidhigh);
     m_phaseMask = phaseMask;
-    for (auto itr : phaseIds)
-        _phases.insert(itr);
+    if (!phaseIds.empty())
+    {
+        std::set<uint32> ids = _phases->GetIds();
+        ids.insert(phaseIds.begin(), phaseIds.end());
+        _phases = PhaseSet::Get(ids);
+    }
 }
 
 void WorldObject::UpdatePositionData()
@@ -3540,7 +3625,7 @@ void WorldObject::RebuildTerrainSwaps()
     _terrainSwaps.clear();
 
     // Check all applied phases for terrain swap and add it only once
-    for (uint32 phaseId : _phases)
+    for (uint32 phaseId : _phases->GetIds())
     {
         if (std::vector<uint32> const* swaps = sObjectMgr->GetPhaseTerrainSwaps(phaseId))
         {
@@ -3584,7 +3669,7 @@ void WorldObject::RebuildWorldMapAreaSwaps()
                         _worldMapSwaps.insert(worldMapAreaId);
 
     // Check all applied phases for world map area swaps
-    for (uint32 phaseId : _phases)
+    for (uint32 phaseId : _phases->GetIds())
         if (std::vector<uint32> const* swaps = sObjectMgr->GetPhaseTerrainSwaps(phaseId))
             for (uint32 const& swap : *swaps)
                 if (std::vector<uint32> const* uiMapSwaps = sObjectMgr->GetTerrainWorldMaps(swap))
@@ -3658,7 +3743,7 @@ void WorldObject::UpdateAreaAndZonePhase()
 
 bool WorldObject::HasPhaseList(uint32 phase)
 {
-    return _phases.find(phase) != _phases.end();
+    return _phases->HasPhase(phase);
 }
 
 bool WorldObject::SetPhased(uint32 id, bool update, bool apply)
@@ -3669,13 +3754,13 @@ bool WorldObject::SetPhased(uint32 id, bool update, bool apply)
         {
             if (HasPhaseList(id)) // do not run the updates if we are already in this phase
                 return false;
-            _phases.insert(id);
+            _phases = _phases->With(id);
         }
         else
         {
             if (!HasPhaseList(id)) // do not run the updates if we are not in this phase
                 return false;
-            _phases.erase(id);
+            _phases = _phases->Without(id);
         }
     }
 
@@ -3689,7 +3774,7 @@ bool WorldObject::SetPhased(uint32 id, bool update, bool apply)
 
 void WorldObject::ClearPhases(bool update)
 {
-    _phases.clear();
+    _phases = PhaseSet::Empty();
 
     RebuildTerrainSwaps();
 
@@ -3699,19 +3784,17 @@ void WorldObject::ClearPhases(bool update)
 
 bool WorldObject::IsPhased(WorldObject const* obj) const
 {
-    if (_phases.empty() && obj->GetPhases().empty())
+    PhaseSet const* phases = obj->GetPhaseSet();
+    if (_phases->IsEmpty() && (phases->IsEmpty() || phases->HasDefaultPhase()))
         return true;
 
-    if (_phases.empty() && obj->IsPhased(169))
-        return true;
-    
-    if (obj->GetPhases().empty() && IsPhased(169))
+    if (phases->IsEmpty() && _phases->HasDefaultPhase())
         return true;
 
     if (GetTypeId() == TYPEID_PLAYER && ToPlayer()->IsGameMaster())
         return true;
 
-    return Trinity::Containers::Intersects(_phases.begin(), _phases.end(), obj->GetPhases().begin(), obj->GetPhases().end());
+    return _phases->Intersects(phases);
 }
 
 bool WorldObject::InSamePhase(WorldObject const* obj) const
@@ -3934,6 +4017,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
     std::set<uint64> plr_list;
+    SharedValuesUpdateMap i_sharedUpdates;
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) { }
     void Visit(PlayerMapType &m)
     {
@@ -3991,7 +4075,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, i_sharedUpdates);
             plr_list.insert(player->GetGUID());
         }
     }
@@ -24,6 +24,7 @@
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
 #include "Optional.h"
+#include "PhaseSet.h"
 #include "Position.h"
 #include "UpdateMask.h"
 #include <G3D/Quat.h>
@@ -32,6 +33,7 @@
 #include <string>
 #include <sstream>
 #include <array>
+#include <atomic>
 
 // Reasons for why object was flagged as active
 enum class ActiveFlags : uint32
@@ -74,6 +76,21 @@ enum ZLiquidStatus : uint32;
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
+// Values update block serialized once for every viewer sharing the same visible update field flags
+struct SharedValuesUpdate
+{
+    ByteBuffer Block;
+    std::vector<std::pair<uint16, size_t>> ViewerDependentFields;   // field index, position of its value in Block
+};
+
+typedef std::unordered_map<uint32, SharedValuesUpdate> SharedValuesUpdateMap;
+
+struct ValuesUpdateCounters
+{
+    std::atomic<uint64> Built { 0 };
+    std::atomic<uint64> Shared { 0 };
+};
+
 float const DEFAULT_COLLISION_HEIGHT = 2.03128f; // Most common value in dbc
 
 class TC_GAME_API Object
@@ -164,6 +181,9 @@ class TC_GAME_API Object
         virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         virtual void BuildUpdate(UpdateDataMapType&) { }
         void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, SharedValuesUpdateMap&, ValuesUpdateCounters& counters = GetValuesUpdateCounters()) const;
+
+        static ValuesUpdateCounters& GetValuesUpdateCounters();
 
         void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
         void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -222,10 +242,13 @@ class TC_GAME_API Object
         void _LoadIntoDataField(std::string const& data, uint32 startOffset, uint32 count);
 
         uint32 GetUpdateFieldData(Player const* target, uint32*& flags) const;
+        UpdateFieldMasks const& GetUpdateFieldMasks() const;
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
         void BuildDynamicValuesUpdate(uint8 updatetype, ByteBuffer *data) const;
         virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
+        // Fills value with what target should see in the field at index if it differs between viewers of the same visibility class
+        virtual bool GetViewerDependentValue(uint16 /*index*/, Player* /*target*/, uint32& /*value*/) const { return false; }
         virtual void AddToUpdate() = 0;
         virtual void RemoveFromUpdate() = 0;
 
@@ -533,8 +556,9 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         bool HasPhaseList(uint32 phase);
         void ClearPhases(bool update = false);
         bool IsPhased(WorldObject const* obj) const;
-        bool IsPhased(uint32 phase) const { return _phases.find(phase) != _phases.end(); }
-        std::set<uint32> const& GetPhases() const { return _phases; }
+        bool IsPhased(uint32 phase) const { return _phases->HasPhase(phase); }
+        std::set<uint32> const& GetPhases() const { return _phases->GetIds(); }
+        PhaseSet const* GetPhaseSet() const { return _phases; }
         bool SetTerrainSwap(uint32 id, bool update, bool apply);
         bool IsTerrainSwaped(uint32 terrainSwap) const { return _terrainSwaps.find(terrainSwap) != _terrainSwaps.end(); }
         std::set<uint32> const& GetTerrainSwaps() const { return _terrainSwaps; }
@@ -791,7 +815,7 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         //uint32 m_mapId;                                     // object at map with map_id
         uint32 m_InstanceId;                                // in map copy with instance id
         uint32 m_phaseMask;                                 // in area phase state
-        std::set<uint32> _phases;
+        PhaseSet const* _phases;                            // interned, shared with every object in the same phases
         std::set<uint32> _terrainSwaps;
         std::set<uint32> _worldMapSwaps;
 
@@ -0,0 +1,145 @@
+/*
+* This file is part of the Legends of Azeroth Pandaria Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PhaseSet.h"
+#include "DBCStores.h"
+#include "Log.h"
+#include "ObjectMgr.h"
+#include "Timer.h"
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    // Guards both containers, only touched when an object changes phases
+    std::mutex PhaseSetLock;
+    std::unordered_map<uint32, uint32> PhaseIndexes;        // [phase id][dense index]
+    std::map<std::set<uint32>, PhaseSet const*> PhaseSets;  // never freed, handles are held by objects on all maps
+
+    uint32 GetPhaseIndex(uint32 id)
+    {
+        auto itr = PhaseIndexes.find(id);
+        if (itr != PhaseIndexes.end())
+            return itr->second;
+
+        uint32 index = PhaseIndexes.size();
+        PhaseIndexes[id] = index;
+        return index;
+    }
+}
+
+PhaseSet::PhaseSet(std::set<uint32> const& ids) : _ids(ids), _hasDefaultPhase(ids.find(DEFAULT_PHASE_ID) != ids.end())
+{
+    std::map<uint32, uint64> words;
+    for (uint32 id : ids)
+    {
+        uint32 index = GetPhaseIndex(id);
+        words[index / 64] |= UI64LIT(1) << (index % 64);
+    }
+
+    _words.assign(words.begin(), words.end());
+}
+
+bool PhaseSet::Intersects(PhaseSet const* other) const
+{
+    if (this == other)
+        return !IsEmpty();
+
+    auto first1 = _words.begin(), last1 = _words.end();
+    auto first2 = other->_words.begin(), last2 = other->_words.end();
+    while (first1 != last1 && first2 != last2)
+    {
+        if (first1->first < first2->first)
+            ++first1;
+        else if (first2->first < first1->first)
+            ++first2;
+        else if (first1->second & first2->second)
+            return true;
+        else
+        {
+            ++first1;
+            ++first2;
+        }
+    }
+
+    return false;
+}
+
+PhaseSet const* PhaseSet::With(uint32 id) const
+{
+    if (HasPhase(id))
+        return this;
+
+    std::set<uint32> ids = _ids;
+    ids.insert(id);
+    return Get(ids);
+}
+
+PhaseSet const* PhaseSet::Without(uint32 id) const
+{
+    if (!HasPhase(id))
+        return this;
+
+    std::set<uint32> ids = _ids;
+    ids.erase(id);
+    return Get(ids);
+}
+
+PhaseSet const* PhaseSet::Empty()
+{
+    static PhaseSet const* empty = Get(std::set<uint32>());
+    return empty;
+}
+
+PhaseSet const* PhaseSet::Get(std::set<uint32> const& ids)
+{
+    std::lock_guard<std::mutex> lock(PhaseSetLock);
+    PhaseSet const*& phaseSet = PhaseSets[ids];
+    if (!phaseSet)
+        phaseSet = new PhaseSet(ids);
+
+    return phaseSet;
+}
+
+void PhaseSet::LoadPhaseIndexes()
+{
+    uint32 oldMSTime = getMSTime();
+
+    std::lock_guard<std::mutex> lock(PhaseSetLock);
+
+    // area and zone phases first, an object usually carries the phases of its area at once
+    for (auto const& area : sObjectMgr->GetAreaAndZonePhases())
+        for (PhaseInfoStruct const& phase : area.second)
+            GetPhaseIndex(phase.id);
+
+    for (uint32 i = 0; i < sPhaseGroupStore.GetNumRows(); ++i)
+        if (PhaseGroupEntry const* group = sPhaseGroupStore.LookupEntry(i))
+            for (uint32 phaseId : GetPhasesForGroup(group->GroupId))
+                GetPhaseIndex(phaseId);
+
+    for (auto const& zone : *sObjectMgr->GetPhaseDefinitionStore())
+        for (PhaseDefinition const& definition : zone.second)
+            if (definition.phaseId)
+                GetPhaseIndex(definition.phaseId);
+
+    for (uint32 i = 0; i < sPhaseStore.GetNumRows(); ++i)
+        if (PhaseEntry const* phase = sPhaseStore.LookupEntry(i))
+            GetPhaseIndex(phase->ID);
+
+    TC_LOG_INFO("server.loading", ">> Indexed %u phases in %u ms", uint32(PhaseIndexes.size()), GetMSTimeDiffToNow(oldMSTime));
+}
@@ -0,0 +1,55 @@
+/*
+* This file is part of the Legends of Azeroth Pandaria Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef Trinity_game_PhaseSet_h__
+#define Trinity_game_PhaseSet_h__
+
+#include "Define.h"
+#include <set>
+#include <vector>
+
+#define DEFAULT_PHASE_ID 169                                // objects without phases see and are seen by this phase
+
+// Immutable set of phase ids, interned so equal sets share one instance.
+// Ids are remapped to dense indexes, overlapping sets are found with word ANDs instead of tree lookups.
+class TC_GAME_API PhaseSet
+{
+    public:
+        std::set<uint32> const& GetIds() const { return _ids; }
+        bool IsEmpty() const { return _ids.empty(); }
+        bool HasPhase(uint32 id) const { return _ids.find(id) != _ids.end(); }
+        bool HasDefaultPhase() const { return _hasDefaultPhase; }
+        bool Intersects(PhaseSet const* other) const;
+
+        PhaseSet const* With(uint32 id) const;
+        PhaseSet const* Without(uint32 id) const;
+
+        static PhaseSet const* Empty();
+        static PhaseSet const* Get(std::set<uint32> const& ids);
+
+        // Assigns dense indexes to the known phases, grouping phases that are usually applied together
+        static void LoadPhaseIndexes();
+
+    private:
+        explicit PhaseSet(std::set<uint32> const& ids);
+
+        std::set<uint32> _ids;
+        std::vector<std::pair<uint32, uint64>> _words;      // [word][bits] of the dense indexes, sorted by word
+        bool _hasDefaultPhase;
+};
+
+#endif // Trinity_game_PhaseSet_h__
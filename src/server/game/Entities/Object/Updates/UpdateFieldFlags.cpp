@@ -16,6 +16,7 @@
 */
 
 #include "UpdateFieldFlags.h"
+#include "UpdateMask.h"
 
 uint32 ItemUpdateFieldFlags[CONTAINER_END] =
 {
@@ -2291,4 +2292,12 @@ uint32 PlayerDynamicField [PLAYER_DYNAMIC_END] =
     UF_FLAG_PRIVATE, // PLAYER_DYNAMIC_FIELD_RESERACH_SITE
     UF_FLAG_PRIVATE, // PLAYER_DYNAMIC_FIELD_RESEARCH_SITE_PROGRESS
     UF_FLAG_PRIVATE, // PLAYER_DYNAMIC_FIELD_DAILY_QUESTS
-};
\ No newline at end of file
+};
+
+UpdateFieldMasks const ItemUpdateFieldMasks(ItemUpdateFieldFlags, CONTAINER_END);
+UpdateFieldMasks const UnitUpdateFieldMasks(UnitUpdateFieldFlags, PLAYER_END);
+UpdateFieldMasks const GameObjectUpdateFieldMasks(GameObjectUpdateFieldFlags, GAMEOBJECT_END);
+UpdateFieldMasks const DynamicObjectUpdateFieldMasks(DynamicObjectUpdateFieldFlags, DYNAMICOBJECT_END);
+UpdateFieldMasks const CorpseUpdateFieldMasks(CorpseUpdateFieldFlags, CORPSE_END);
+UpdateFieldMasks const AreaTriggerUpdateFieldMasks(AreaTriggerUpdateFieldFlags, AREATRIGGER_END);
+UpdateFieldMasks const EmptyUpdateFieldMasks(nullptr, 0);
@@ -43,4 +43,15 @@ extern uint32 DynamicObjectUpdateFieldFlags[DYNAMICOBJECT_END];
 extern uint32 CorpseUpdateFieldFlags[CORPSE_END];
 extern uint32 AreaTriggerUpdateFieldFlags[AREATRIGGER_END];
 
+class UpdateFieldMasks;
+
+// Same flags as above, precomputed as bitsets per flag
+extern UpdateFieldMasks const ItemUpdateFieldMasks;
+extern UpdateFieldMasks const UnitUpdateFieldMasks;
+extern UpdateFieldMasks const GameObjectUpdateFieldMasks;
+extern UpdateFieldMasks const DynamicObjectUpdateFieldMasks;
+extern UpdateFieldMasks const CorpseUpdateFieldMasks;
+extern UpdateFieldMasks const AreaTriggerUpdateFieldMasks;
+extern UpdateFieldMasks const EmptyUpdateFieldMasks;
+
 #endif // _UPDATEFIELDFLAGS_H
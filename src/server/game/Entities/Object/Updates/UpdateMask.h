@@ -21,83 +21,223 @@
 #include "UpdateFields.h"
 #include "Errors.h"
 #include "ByteBuffer.h"
+#include <array>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace UpdateMaskHelpers
+{
+    // Blocks are padded to a multiple of 8 so the whole mask can always be processed in 256 bit chunks
+    inline uint32 GetPaddedBlockCount(uint32 valuesCount) { return ((valuesCount + 31) / 32 + 7) & ~7u; }
+
+    inline uint32 CountTrailingZeroes(uint32 value)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return index;
+#else
+        return __builtin_ctz(value);
+#endif
+    }
+}
+
+uint32 const UPDATE_MASK_MAX_BLOCKS = ((PLAYER_END + 31) / 32 + 7) & ~7u;
+uint32 const UPDATE_FIELD_FLAG_COUNT = 10;              // bits used by UpdatefieldFlags
+
+// Bitset of changed update fields, one bit per field
 class UpdateMask
 {
 public:
-    UpdateMask() : _bits(nullptr), _length(0) { }
+    UpdateMask() : _bits(nullptr), _blockCount(0) { }
 
     ~UpdateMask() { delete[] _bits; }
 
-    void SetBit(uint32 index) { _bits[index] = 1; }
-    void UnsetBit(uint32 index) { _bits[index] = 0; }
-    uint32* GetBits() const { return _bits; }
+    void SetBit(uint32 index) { _bits[index >> 5] |= 1u << (index & 31); }
+    void UnsetBit(uint32 index) { _bits[index >> 5] &= ~(1u << (index & 31)); }
+    bool GetBit(uint32 index) const { return (_bits[index >> 5] & (1u << (index & 31))) != 0; }
+    uint32 const* GetBlocks() const { return _bits; }
+    uint32 GetBlockCount() const { return _blockCount; }
 
     void SetCount(uint32 valuesCount)
     {
         delete[] _bits;
 
-        _bits = new uint32[valuesCount];
-        _length = sizeof(uint32) * valuesCount;
-        memset(_bits, 0, _length);
+        _blockCount = UpdateMaskHelpers::GetPaddedBlockCount(valuesCount);
+        _bits = new uint32[_blockCount];
+        memset(_bits, 0, _blockCount * sizeof(uint32));
     }
 
     void Clear()
     {
         if (_bits)
-            memset(_bits, 0, _length);
+            memset(_bits, 0, _blockCount * sizeof(uint32));
     }
 
 private:
     uint32* _bits;
-    size_t _length;
+    uint32 _blockCount;
 };
 
-class UpdateBuilder
+// Fields of one object type grouped by UpdatefieldFlags, one bitset per flag bit
+class UpdateFieldMasks
 {
 public:
-    UpdateBuilder()
+    UpdateFieldMasks(uint32 const* flags, uint32 count)
     {
-        _mask = new uint32[sizeof(uint32) * (PLAYER_END + 31) / 32];
+        for (auto&& mask : _masks)
+            mask.fill(0);
+
+        for (uint32 index = 0; index < count; ++index)
+            for (uint32 bit = 0; bit < UPDATE_FIELD_FLAG_COUNT; ++bit)
+                if (flags[index] & (1u << bit))
+                    _masks[bit][index >> 5] |= 1u << (index & 31);
     }
 
-    ~UpdateBuilder() { delete[] _mask; }
+    // dest |= fields having any of the given flags
+    void Collect(uint32 flags, uint32* dest, uint32 blockCount) const
+    {
+        for (uint32 bit = 0; bit < UPDATE_FIELD_FLAG_COUNT; ++bit)
+        {
+            if (!(flags & (1u << bit)))
+                continue;
+
+            uint32 const* mask = _masks[bit].data();
+            for (uint32 i = 0; i < blockCount; ++i)
+                dest[i] |= mask[i];
+        }
+    }
+
+private:
+    std::array<std::array<uint32, UPDATE_MASK_MAX_BLOCKS>, UPDATE_FIELD_FLAG_COUNT> _masks;
+};
 
-    void SetSource(uint32* src, uint32 count)
+class UpdateBuilder
+{
+public:
+    UpdateBuilder() { }
+
+    // changes == nullptr selects every field with a non zero value, as needed for create blocks
+    void SetSource(UpdateMask const* changes, uint32 const* values, uint32 count)
     {
-        _src = src;
+        _count = count;
         _blockCount = (count + 31) / 32;
-        _length = _blockCount * sizeof(uint32);
-        memset(_mask, 0, _length);
+        _paddedBlockCount = UpdateMaskHelpers::GetPaddedBlockCount(count);
+
+        if (changes)
+            memcpy(_src.data(), changes->GetBlocks(), _paddedBlockCount * sizeof(uint32));
+        else
+        {
+            memset(_src.data(), 0, _paddedBlockCount * sizeof(uint32));
+            for (uint32 index = 0; index < count; ++index)
+                if (values[index])
+                    _src[index >> 5] |= 1u << (index & 31);
+        }
+
+        memset(_mask.data(), 0, _paddedBlockCount * sizeof(uint32));
     }
 
     void SetDest(ByteBuffer* dest)
     {
         _dest = dest;
         _start = dest->wpos();
-        dest->wpos(_start + 1 + _length);
+        dest->wpos(_start + 1 + _blockCount * sizeof(uint32));
     }
 
-    bool GetSrcBit(uint32 index) { return _src[index] != 0; }
-    void SetDestBit(uint32 index) { ((uint8*)_mask)[index >> 3] |= 1 << (index & 0x7); }
+    // Selects changed fields visible with visibleFlags and every field flagged with notifyFlags
+    void SelectFields(UpdateFieldMasks const& masks, uint32 visibleFlags, uint32 notifyFlags)
+    {
+        alignas(32) std::array<uint32, UPDATE_MASK_MAX_BLOCKS> visible;
+        memset(visible.data(), 0, _paddedBlockCount * sizeof(uint32));
+        masks.Collect(visibleFlags, visible.data(), _paddedBlockCount);
+        masks.Collect(notifyFlags, _mask.data(), _paddedBlockCount);
+
+        uint32* dest = _mask.data();
+        uint32 const* src = _src.data();
+        uint32 const* vis = visible.data();
+#if defined(__AVX2__)
+        for (uint32 i = 0; i < _paddedBlockCount; i += 8)
+        {
+            __m256i changed = _mm256_load_si256(reinterpret_cast<__m256i const*>(src + i));
+            __m256i seen = _mm256_load_si256(reinterpret_cast<__m256i const*>(vis + i));
+            __m256i selected = _mm256_load_si256(reinterpret_cast<__m256i const*>(dest + i));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_or_si256(selected, _mm256_and_si256(changed, seen)));
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        for (uint32 i = 0; i < _paddedBlockCount; i += 4)
+        {
+            __m128i changed = _mm_load_si128(reinterpret_cast<__m128i const*>(src + i));
+            __m128i seen = _mm_load_si128(reinterpret_cast<__m128i const*>(vis + i));
+            __m128i selected = _mm_load_si128(reinterpret_cast<__m128i const*>(dest + i));
+            _mm_store_si128(reinterpret_cast<__m128i*>(dest + i), _mm_or_si128(selected, _mm_and_si128(changed, seen)));
+        }
+#else
+        for (uint32 i = 0; i < _paddedBlockCount; ++i)
+            dest[i] |= src[i] & vis[i];
+#endif
+    }
+
+    // Selects every field flagged with flags, changed or not
+    void AddFields(UpdateFieldMasks const& masks, uint32 flags) { masks.Collect(flags, _mask.data(), _paddedBlockCount); }
+
+    // Drops every selected field at or above count
+    void LimitFields(uint32 count)
+    {
+        uint32 block = count >> 5;
+        if (block < _paddedBlockCount && (count & 31))
+            _mask[block++] &= (1u << (count & 31)) - 1;
+
+        for (; block < _paddedBlockCount; ++block)
+            _mask[block] = 0;
+    }
+
+    void SetDestBit(uint32 index) { _mask[index >> 5] |= 1u << (index & 31); }
+
+    // Calls fn(index) for every selected field in ascending order, the callback writes the value
+    template<class Fn>
+    void ForEachField(Fn&& fn)
+    {
+        for (uint32 block = 0; block < _blockCount; ++block)
+        {
+            for (uint32 bits = _mask[block]; bits; bits &= bits - 1)
+            {
+                uint32 index = block * 32 + UpdateMaskHelpers::CountTrailingZeroes(bits);
+                if (index >= _count)
+                    return;
+
+                fn(uint16(index));
+            }
+        }
+    }
 
     void Finish()
     {
+        LimitFields(_count);
+
         size_t endPos = _dest->wpos();
         _dest->wpos(_start);
         *_dest << _blockCount;
-        _dest->append((uint8*)_mask, _length);
+        for (uint32 block = 0; block < _blockCount; ++block)
+            *_dest << uint32(_mask[block]);
         _dest->wpos(endPos);
     }
 
 private:
-    uint32* _src = nullptr;
+    alignas(32) std::array<uint32, UPDATE_MASK_MAX_BLOCKS> _src;
+    alignas(32) std::array<uint32, UPDATE_MASK_MAX_BLOCKS> _mask;
     ByteBuffer* _dest = nullptr;
-    uint32* _mask;
     size_t _start = 0;
-    size_t _end = 0;
-    uint8 _blockCount =0 ;
-    size_t _length = 0;
+    uint32 _count = 0;
+    uint8 _blockCount = 0;
+    uint32 _paddedBlockCount = 0;
 };
 
 #endif
@@ -89,6 +89,7 @@
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include "WorldStateBuilder.h"
+#include "MovementCodecs.h"
 #include "MovementStructures.h"
 #include "Config.h"
 #include "ServiceMgr.h"
@@ -230,6 +231,8 @@ Player::Player(WorldSession* session) : Unit(true), phaseMgr(this), hasForcedMov
     m_needsZoneUpdate = false;
 
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
+    m_saveSectionHashes.fill(0);
+    m_saveSectionsLost = std::make_shared<std::atomic<bool>>(false);
 
     _resurrectionData = nullptr;
 
@@ -21173,12 +21176,20 @@ void Player::SaveToDB(bool create /*=false*/)
 
     trans->Append(stmt);
 
+    // sections are only compared with the previous save of this session, the first one writes them all
+    bool force = create || !sWorld->getBoolConfig(CONFIG_PLAYER_SAVE_SKIP_UNCHANGED);
+    if (m_saveSectionsLost->exchange(false))
+    {
+        m_saveSectionHashes.fill(0);
+        force = true;
+    }
+
     if (m_mailsUpdated)                                     //save mails only when needed
         _SaveMail(trans);
 
-    _SaveBGData(trans);
+    _SaveSection(trans, PLAYER_SAVE_SECTION_BG_DATA, &Player::_SaveBGData, force);
     _SaveInventory(trans);
-    _SaveVoidStorage(trans);
+    _SaveSection(trans, PLAYER_SAVE_SECTION_VOID_STORAGE, &Player::_SaveVoidStorage, force);
     _SaveQuestStatus(trans);
     _SaveQuestObjectiveStatus(trans);
     _SaveDailyQuestStatus(trans);
@@ -21189,29 +21200,39 @@ void Player::SaveToDB(bool create /*=false*/)
     _SaveSpells(trans);
     GetSpellHistory()->SaveToDB<Player>(trans);
     _SaveActions(trans);
-    _SaveAuras(trans);
+    _SaveSection(trans, PLAYER_SAVE_SECTION_AURAS, &Player::_SaveAuras, force);
     _SaveSkills(trans);
     GetAchievementMgr().SaveToDB(trans);
     GetSession()->GetAchievementMgr().SaveToDB(trans);
     m_reputationMgr->SaveToDB(trans);
     _SaveEquipmentSets(trans);
     GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
-    _SaveGlyphs(trans);
-    _SaveInstanceTimeRestrictions(trans);
+    _SaveSection(trans, PLAYER_SAVE_SECTION_GLYPHS, &Player::_SaveGlyphs, force);
+    _SaveSection(trans, PLAYER_SAVE_SECTION_INSTANCE_TIMES, &Player::_SaveInstanceTimeRestrictions, force);
     _SaveCurrency(trans);
-    _SaveCUFProfiles(trans);
-    _SaveResearchHistory(trans);
-    _SaveResearchProjects(trans);
-    _SaveDeserterInfo(trans);
-    _SaveBattlegroundStats(trans);
+    _SaveSection(trans, PLAYER_SAVE_SECTION_CUF_PROFILES, &Player::_SaveCUFProfiles, force);
+    _SaveSection(trans, PLAYER_SAVE_SECTION_RESEARCH_HISTORY, &Player::_SaveResearchHistory, force);
+    _SaveSection(trans, PLAYER_SAVE_SECTION_RESEARCH_PROJECTS, &Player::_SaveResearchProjects, force);
+    _SaveSection(trans, PLAYER_SAVE_SECTION_DESERTER_INFO, &Player::_SaveDeserterInfo, force);
+    _SaveSection(trans, PLAYER_SAVE_SECTION_BATTLEGROUND_STATS, &Player::_SaveBattlegroundStats, force);
     m_battlePetMgr->SaveToDb(trans);
 
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
-        _SaveStats(trans);
+        _SaveSection(trans, PLAYER_SAVE_SECTION_STATS, &Player::_SaveStats, force);
 
-    CharacterDatabase.CommitTransaction(trans);
+    PlayerSaveStats& stats = GetSaveStats();
+    ++stats.Saves;
+    stats.Statements += trans->GetSize();
+    stats.Bytes += trans->GetQueriesPayload(0);
+
+    // the section hashes are recorded before the commit, a failed one makes the next save write every section
+    GetSession()->AddTransactionCallback(CharacterDatabase.AsyncCommitTransaction(trans)).AfterComplete([lost = m_saveSectionsLost](bool success)
+    {
+        if (!success)
+            *lost = true;
+    });
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
@@ -21232,6 +21253,31 @@ void Player::SaveInventoryAndGoldToDB(CharacterDatabaseTransaction trans)
     SaveGoldToDB(trans);
 }
 
+PlayerSaveStats& Player::GetSaveStats()
+{
+    static PlayerSaveStats stats;
+    return stats;
+}
+
+// Drops the statements of a section when they are the same as the ones written by the previous save
+void Player::_SaveSection(CharacterDatabaseTransaction trans, PlayerSaveSection section, void (Player::*save)(CharacterDatabaseTransaction), bool force)
+{
+    std::size_t start = trans->GetSize();
+    (this->*save)(trans);
+
+    uint64 hash = trans->GetQueriesHash(start);
+    if (!force && m_saveSectionHashes[section] == hash)
+    {
+        PlayerSaveStats& stats = GetSaveStats();
+        ++stats.SkippedSections;
+        stats.SkippedStatements += trans->GetSize() - start;
+        trans->Truncate(start);
+        return;
+    }
+
+    m_saveSectionHashes[section] = hash;
+}
+
 void Player::SaveGoldToDB(CharacterDatabaseTransaction trans)
 {
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UDP_CHAR_MONEY);
@@ -29791,13 +29837,48 @@ uint32 Player::GetQuestObjectiveCounter(uint32 objectiveId) const
 
 void Player::ReadMovementInfo(WorldPacket& data, MovementInfo* mi, Movement::ExtraMovementStatusElement* extras /*= NULL*/, bool beforeAnticheat)
 {
-    MovementStatusElements const* sequence = GetMovementStatusElementsSequence(data.GetOpcode());
-    if (!sequence)
+    Movement::MovementCodec const* codec = Movement::GetMovementCodec(data.GetOpcode());
+    if (!codec)
     {
         TC_LOG_ERROR("network", "Player::ReadMovementInfo: No movement sequence found for opcode %s", GetOpcodeNameForLogging(static_cast<OpcodeClient>(data.GetOpcode())).c_str());
         return;
     }
 
+    bool validate = sWorld->getBoolConfig(CONFIG_MOVEMENT_VALIDATE_CODECS);
+    WorldPacket interpretedData;
+    MovementInfo interpreted;
+    if (validate)
+    {
+        interpretedData = data;
+        interpreted = *mi;
+        uint32 extrasIndex = extras ? extras->GetIndex() : 0;
+        ReadMovementInfoInterpreted(interpretedData, &interpreted, extras);
+        if (extras)
+            extras->SetIndex(extrasIndex);
+    }
+
+    Movement::MovementReadContext context(data, mi, extras);
+    codec->Read(context);
+
+    if (context.MountDisplayIdRead)
+        SetUInt32Value(UNIT_FIELD_MOUNT_DISPLAY_ID, context.MountDisplayId);
+
+    mi->guid = context.Guid;
+    mi->transport.guid = context.TransportGuid;
+
+    if (validate && (interpretedData.rpos() != data.rpos() || !Movement::IsSameMovementInfo(interpreted, *mi)))
+        TC_LOG_ERROR("network", "Player::ReadMovementInfo: Movement codec and interpreter differ for opcode %s", GetOpcodeNameForLogging(static_cast<OpcodeClient>(data.GetOpcode())).c_str());
+
+    SanitizeMovementInfo(mi, !beforeAnticheat);
+}
+
+// Walks the sequence of the opcode at runtime, only used to validate the codecs
+void Player::ReadMovementInfoInterpreted(WorldPacket& data, MovementInfo* mi, Movement::ExtraMovementStatusElement* extras)
+{
+    MovementStatusElements const* sequence = GetMovementStatusElementsSequence(data.GetOpcode());
+    if (!sequence)
+        return;
+
     bool hasMountDisplayId = false;
     bool hasMovementFlags = false;
     bool hasMovementFlags2 = false;
@@ -30033,8 +30114,6 @@ void Player::ReadMovementInfo(WorldPacket& data, MovementInfo* mi, Movement::Ext
 
     mi->guid = guid;
     mi->transport.guid = tguid;
-
-    SanitizeMovementInfo(mi, !beforeAnticheat);
 }
 
 void Player::SanitizeMovementInfo(MovementInfo* mi, bool afterAnticheat)
@@ -915,6 +915,32 @@ enum PlayerDelayedOperations
     DELAYED_END
 };
 
+// Sections of Player::SaveToDB that rewrite all their rows, skipped while the rows are the same as in the previous save
+enum PlayerSaveSection
+{
+    PLAYER_SAVE_SECTION_BG_DATA,
+    PLAYER_SAVE_SECTION_VOID_STORAGE,
+    PLAYER_SAVE_SECTION_AURAS,
+    PLAYER_SAVE_SECTION_GLYPHS,
+    PLAYER_SAVE_SECTION_INSTANCE_TIMES,
+    PLAYER_SAVE_SECTION_CUF_PROFILES,
+    PLAYER_SAVE_SECTION_RESEARCH_HISTORY,
+    PLAYER_SAVE_SECTION_RESEARCH_PROJECTS,
+    PLAYER_SAVE_SECTION_DESERTER_INFO,
+    PLAYER_SAVE_SECTION_BATTLEGROUND_STATS,
+    PLAYER_SAVE_SECTION_STATS,
+    MAX_PLAYER_SAVE_SECTION
+};
+
+struct PlayerSaveStats
+{
+    std::atomic<uint64> Saves{ 0 };
+    std::atomic<uint64> Statements{ 0 };
+    std::atomic<uint64> Bytes{ 0 };                         // bound parameters and raw query text
+    std::atomic<uint64> SkippedSections{ 0 };
+    std::atomic<uint64> SkippedStatements{ 0 };
+};
+
 // Player summoning auto-decline time (in secs)
 #define MAX_PLAYER_SUMMON_DELAY                   (2*MINUTE)
 // Maximum money amount : 2^31 - 1
@@ -1843,6 +1869,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
     void SaveToDB(bool create = false);
     void SaveInventoryAndGoldToDB(CharacterDatabaseTransaction trans);                    // fast save function for item/money cheating preventing
     void SaveGoldToDB(CharacterDatabaseTransaction trans);
+    static PlayerSaveStats& GetSaveStats();
 
     static void SetUInt32ValueInArray(Tokenizer& data, uint16 index, uint32 value);
     static void Customize(ObjectGuid guid, uint8 gender, uint8 skin, uint8 face, uint8 hairStyle, uint8 hairColor, uint8 facialHair);
@@ -3093,6 +3120,7 @@ public:
     }
 
     void ReadMovementInfo(WorldPacket& data, MovementInfo* mi, Movement::ExtraMovementStatusElement* extras = NULL, bool beforeAnticheat = false);
+    void ReadMovementInfoInterpreted(WorldPacket& data, MovementInfo* mi, Movement::ExtraMovementStatusElement* extras);
     void SanitizeMovementInfo(MovementInfo* mi, bool afterAnticheat);
 
     /*! These methods send different packets to the client in apply and unapply case.
@@ -3385,6 +3413,7 @@ protected:
     void _SaveResearchProjects(CharacterDatabaseTransaction trans);
     void _SaveDeserterInfo(CharacterDatabaseTransaction trans);
     void _SaveBattlegroundStats(CharacterDatabaseTransaction trans);
+    void _SaveSection(CharacterDatabaseTransaction trans, PlayerSaveSection section, void (Player::*save)(CharacterDatabaseTransaction), bool force);
 
     /*********************************************************/
     /***              ENVIRONMENTAL SYSTEM                 ***/
@@ -3406,6 +3435,8 @@ protected:
 
     uint32 m_team;
     uint32 m_nextSave;
+    std::array<uint64, MAX_PLAYER_SAVE_SECTION> m_saveSectionHashes;   // of the statements written by the previous save, 0 if unknown
+    std::shared_ptr<std::atomic<bool>> m_saveSectionsLost;              // set by a failed save commit, the hashes are ahead of the database
     time_t m_speakTime;
     uint32 m_speakCount;
     Difficulty m_dungeonDifficulty;
@@ -33,6 +33,7 @@
 #include "InstanceScript.h"
 #include "Log.h"
 #include "MapManager.h"
+#include "Metrics.h"
 #include "MoveSpline.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -59,12 +60,14 @@
 #include "Vehicle.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include "MovementCodecs.h"
 #include "MovementStructures.h"
 #include "MovementPacketBuilder.h"
 #include "WorldSession.h"
 #include "BattlePetMgr.h"
 #include "SpellHistory.h"
 #include "AreaTrigger.h"
+#include <bitset>
 #include <math.h>
 #include <numeric>
 #include "SpellScript.h"
@@ -99,6 +102,11 @@ float playerBaseMoveSpeed [MAX_MOVE_TYPE] =
 
 // Used for prepare can/can`t triggr aura
 static bool InitTriggerAuraData();
+
+// metrics counters of ProcDamageAndSpellFor, count is the number of proc events
+static char const* const ProcRegisteredMetricName = "proc_registered";
+static char const* const ProcVisitedMetricName = "proc_visited";
+static char const* const ProcTriggeredMetricName = "proc_triggered";
 // Define can trigger auras
 static bool isTriggerAura [TOTAL_AURAS];
 // Define can't trigger auras (need for disable second trigger)
@@ -189,7 +197,7 @@ WorldObject(isWorldObject), m_movedPlayer(NULL), m_lastSanctuaryTime(0),
 IsAIEnabled(false), NeedChangeAI(false), LastCharmerGUID(),
 m_ControlledByPlayer(false), movespline(new Movement::MoveSpline()),
 i_AI(NULL), i_disabledAI(NULL), m_AutoRepeatFirstCast(false), m_procDeep(0),
-m_removedAurasCount(0), i_motionMaster(new MotionMaster(this)), m_ThreatManager(this),
+m_procAuraCount(), m_procAurasGeneration(s_procAurasGeneration), m_removedAurasCount(0), i_motionMaster(new MotionMaster(this)), m_ThreatManager(this),
 m_vehicle(NULL), m_vehicleKit(NULL), m_unitTypeMask(UNIT_MASK_NONE),
 m_HostileRefManager(this),
 _aiAnimKitId(0), _movementAnimKitId(0), _meleeAnimKitId(0)
@@ -3838,21 +3846,11 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint32 effMask)
 
     Unit* caster = aura->GetCaster();
 
+    _UpdateProcAuras();
+
     AuraApplication * aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
-
-    auto procEntry = sSpellMgr->GetSpellProcEvent(aurId);
-    if (procEntry)
-    {
-        if (procEntry->phaseMask & ProcPhaseMask::Hit)
-            m_procAuras[uint32(ProcPhase::Hit)].insert(AuraApplicationMap::value_type(aurId, aurApp));
-        if (procEntry->phaseMask & ProcPhaseMask::Cast)
-            m_procAuras[uint32(ProcPhase::Cast)].insert(AuraApplicationMap::value_type(aurId, aurApp));
-        if (procEntry->phaseMask & ProcPhaseMask::AfterCast)
-            m_procAuras[uint32(ProcPhase::AfterCast)].insert(AuraApplicationMap::value_type(aurId, aurApp));
-    }
-    else
-        m_procAuras[uint32(ProcPhase::Hit)].insert(AuraApplicationMap::value_type(aurId, aurApp));
+    _RegisterProcAura(aurApp);
 
     if (aurSpellInfo->AuraInterruptFlags)
     {
@@ -3935,18 +3933,34 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
 
     Unit* caster = aura->GetCaster();
 
+    // the phases below are taken from the current proc data, the buckets must have been built from it
+    _UpdateProcAuras();
+
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
 
-    for (auto&& auras : m_procAuras)
+    auto procEntry = sSpellMgr->GetSpellProcEvent(aura->GetId());
+    for (uint32 phase = 0; phase < uint32(ProcPhase::Max); ++phase)
     {
-        auto bounds = auras.equal_range(aura->GetSpellInfo()->Id);
-        for (auto itr = bounds.first; itr != bounds.second;)
+        if (procEntry ? (procEntry->phaseMask & ProcPhaseMask(1 << phase)) : ProcPhase(phase) == ProcPhase::Hit)
+            if (m_procAuraCount[phase])
+                --m_procAuraCount[phase];
+
+        for (auto bucket = m_procAuras[phase].begin(); bucket != m_procAuras[phase].end();)
         {
-            if (itr->second == aurApp)
-                auras.erase(itr++);
+            auto bounds = bucket->second.equal_range(aura->GetSpellInfo()->Id);
+            for (auto itr = bounds.first; itr != bounds.second;)
+            {
+                if (itr->second.Application == aurApp)
+                    bucket->second.erase(itr++);
+                else
+                    ++itr;
+            }
+
+            if (bucket->second.empty())
+                bucket = m_procAuras[phase].erase(bucket);
             else
-                ++itr;
+                ++bucket;
         }
     }
 
@@ -4055,12 +4069,42 @@ void Unit::_RemoveNoStackAurasDueToAura(Aura* aura)
     }
 }
 
+AuraEffectIndex::EffectList const AuraEffectIndex::_empty;
+
+std::size_t AuraEffectIndex::Rank(AuraType type) const
+{
+    std::size_t word = type / WordBits;
+    std::size_t rank = 0;
+    for (std::size_t i = 0; i < word; ++i)
+        rank += std::bitset<WordBits>(_types[i]).count();
+
+    return rank + std::bitset<WordBits>(_types[word] & ((uint64(1) << (type % WordBits)) - 1)).count();
+}
+
+AuraEffectIndex::EffectList& AuraEffectIndex::GetOrCreate(AuraType type)
+{
+    std::size_t rank = Rank(type);
+    if (!Contains(type))
+    {
+        _types[type / WordBits] |= uint64(1) << (type % WordBits);
+        _lists.insert(_lists.begin() + rank, std::make_unique<EffectList>());
+    }
+
+    return *_lists[rank];
+}
+
+std::size_t AuraEffectIndex::GetMemoryUsage() const
+{
+    // list nodes are left out, they cost the same however the lists are indexed
+    return sizeof(AuraEffectIndex) + _lists.capacity() * sizeof(std::unique_ptr<EffectList>) + _lists.size() * sizeof(EffectList);
+}
+
 void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
 {
     if (apply)
-        m_modAuras [aurEff->GetAuraType()].push_back(aurEff);
+        m_modAuras.GetOrCreate(aurEff->GetAuraType()).push_back(aurEff);
     else
-        m_modAuras [aurEff->GetAuraType()].remove(aurEff);
+        m_modAuras.GetOrCreate(aurEff->GetAuraType()).remove(aurEff);
 }
 
 // All aura base removes should go threw this function!
@@ -4391,7 +4435,8 @@ void Unit::RemoveAurasDueToItemSpell(uint32 spellId, uint64 castItemGuid)
 
 void Unit::RemoveAurasByType(AuraType auraType, uint64 casterGUID, Aura* except, bool negative, bool positive)
 {
-    for (AuraEffectList::iterator iter = m_modAuras [auraType].begin(); iter != m_modAuras [auraType].end();)
+    AuraEffectList const& effects = m_modAuras.Get(auraType);
+    for (AuraEffectList::const_iterator iter = effects.begin(); iter != effects.end();)
     {
         Aura* aura = (*iter)->GetBase();
         AuraApplication * aurApp = aura->GetApplicationOfTarget(GetGUID());
@@ -4403,14 +4448,15 @@ void Unit::RemoveAurasByType(AuraType auraType, uint64 casterGUID, Aura* except,
             uint32 removedAuras = m_removedAurasCount;
             RemoveAura(aurApp);
             if (m_removedAurasCount > removedAuras + 1)
-                iter = m_modAuras [auraType].begin();
+                iter = effects.begin();
         }
     }
 }
 
 void Unit::RemoveAurasByTypeOnImmunity(AuraType auraType)
 {
-    for (auto itr = m_modAuras[auraType].begin(); itr != m_modAuras[auraType].end();)
+    AuraEffectList const& effects = m_modAuras.Get(auraType);
+    for (auto itr = effects.begin(); itr != effects.end();)
     {
         Aura* aura = (*itr)->GetBase();
         AuraApplication* aurApp = aura->GetApplicationOfTarget(GetGUID());
@@ -4426,7 +4472,7 @@ void Unit::RemoveAurasByTypeOnImmunity(AuraType auraType)
             uint32 removedAuras = m_removedAurasCount;
             RemoveAura(aurApp);
             if (m_removedAurasCount > removedAuras + 1)
-                itr = m_modAuras[auraType].begin();
+                itr = effects.begin();
         }
     }
 }
@@ -5136,7 +5182,7 @@ bool Unit::HasAura(uint32 spellId, uint64 casterGUID, uint64 itemCasterGUID, uin
 
 bool Unit::HasAuraType(AuraType auraType) const
 {
-    return (!m_modAuras [auraType].empty());
+    return m_modAuras.Has(auraType);
 }
 
 bool Unit::HasAuraTypeWithCaster(AuraType auratype, uint64 caster) const
@@ -5239,7 +5285,8 @@ uint32 Unit::GetDiseasesByCaster(uint64 casterGUID, bool remove)
     uint32 diseases = 0;
     for (AuraType const* itr = diseaseAuraTypes; *itr != SPELL_AURA_NONE; ++itr)
     {
-        for (AuraEffectList::iterator i = m_modAuras [*itr].begin(); i != m_modAuras [*itr].end();)
+        AuraEffectList const& effects = m_modAuras.Get(*itr);
+        for (AuraEffectList::const_iterator i = effects.begin(); i != effects.end();)
         {
             // Get auras with disease dispel type by caster
             if ((*i)->GetSpellInfo()->Dispel == DISPEL_DISEASE
@@ -5250,7 +5297,7 @@ uint32 Unit::GetDiseasesByCaster(uint64 casterGUID, bool remove)
                 if (remove)
                 {
                     RemoveAura((*i)->GetId(), (*i)->GetCasterGUID());
-                    i = m_modAuras [*itr].begin();
+                    i = effects.begin();
                     continue;
                 }
             }
@@ -14446,7 +14493,36 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
     ProcTriggeredList procTriggered;
 
-    AuraApplicationMap& procAuras = m_procAuras[uint32(context.Phase)];
+    // Only auras sharing a proc flag with the event can pass IsTriggeredAtSpellProcEvent. An aura is taken from
+    // the bucket of its lowest shared flag so it is visited once, all applications of a spell come from the same bucket.
+    _UpdateProcAuras();
+
+    std::vector<std::pair<uint32, AuraApplication*>> procAuras;
+    uint32 sharedBuckets = 0;
+    for (auto&& bucket : m_procAuras[uint32(context.Phase)])
+    {
+        if (!(bucket.first & procFlag))
+            continue;
+
+        uint32 lowerFlags = procFlag & (bucket.first - 1);
+        for (auto&& itr : bucket.second)
+            if (!(itr.second.ProcFlags & lowerFlags))
+                procAuras.emplace_back(itr.first, itr.second.Application);
+        ++sharedBuckets;
+    }
+
+    // keep the spell id order of a single map
+    if (sharedBuckets > 1)
+        std::stable_sort(procAuras.begin(), procAuras.end(), [](std::pair<uint32, AuraApplication*> const& left, std::pair<uint32, AuraApplication*> const& right)
+        {
+            return left.first < right.first;
+        });
+
+    static uint32 const registeredMetric = sMetrics->Register(ProcRegisteredMetricName, METRIC_COUNTER);
+    static uint32 const visitedMetric = sMetrics->Register(ProcVisitedMetricName, METRIC_COUNTER);
+    static uint32 const triggeredMetric = sMetrics->Register(ProcTriggeredMetricName, METRIC_COUNTER);
+    sMetrics->Add(registeredMetric, m_procAuraCount[uint32(context.Phase)]);
+    sMetrics->Add(visitedMetric, procAuras.size());
 
     // Fill procTriggered list
     for (auto&& itr : procAuras)
@@ -14509,6 +14585,8 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     if (procTriggered.empty())
         return;
 
+    sMetrics->Add(triggeredMetric, procTriggered.size());
+
     // Note: must SetCantProc(false) before return
     if (procExtra & (PROC_EX_INTERNAL_TRIGGERED | PROC_EX_INTERNAL_CANT_PROC))
         SetCantProc(true);
@@ -15448,6 +15526,75 @@ bool Unit::InitTamedPet(Pet* pet, uint8 level, uint32 spell_id)
     return true;
 }
 
+ProcDispatchStats Unit::GetProcDispatchStats()
+{
+    ProcDispatchStats stats;
+    for (MetricValue const& value : sMetrics->Snapshot())
+    {
+        if (value.Name == ProcRegisteredMetricName)
+        {
+            stats.Events = value.Count;
+            stats.Registered = value.Sum;
+        }
+        else if (value.Name == ProcVisitedMetricName)
+            stats.Visited = value.Sum;
+        else if (value.Name == ProcTriggeredMetricName)
+            stats.Triggered = value.Sum;
+    }
+    return stats;
+}
+
+std::atomic<uint32> Unit::s_procAurasGeneration(0);
+
+// auras without proc flags never pass IsTriggeredAtSpellProcEvent and are only counted
+void Unit::_RegisterProcAura(AuraApplication* aurApp)
+{
+    SpellInfo const* spellInfo = aurApp->GetBase()->GetSpellInfo();
+    uint32 procFlags = GetAuraProcFlags(spellInfo);
+    auto procEntry = sSpellMgr->GetSpellProcEvent(spellInfo->Id);
+    for (uint32 phase = 0; phase < uint32(ProcPhase::Max); ++phase)
+    {
+        if (procEntry ? !(procEntry->phaseMask & ProcPhaseMask(1 << phase)) : ProcPhase(phase) != ProcPhase::Hit)
+            continue;
+
+        for (uint32 flag = 1; flag && flag <= procFlags; flag <<= 1)
+            if (procFlags & flag)
+                m_procAuras[phase][flag].insert(ProcAuraMap::value_type(spellInfo->Id, ProcAuraEntry{ aurApp, procFlags }));
+        ++m_procAuraCount[phase];
+    }
+}
+
+// .reload spell_proc_event and spell_proc change the flags and phases the buckets were built from
+void Unit::_UpdateProcAuras()
+{
+    uint32 generation = s_procAurasGeneration;
+    if (m_procAurasGeneration == generation)
+        return;
+
+    m_procAurasGeneration = generation;
+    for (uint32 phase = 0; phase < uint32(ProcPhase::Max); ++phase)
+    {
+        m_procAuras[phase].clear();
+        m_procAuraCount[phase] = 0;
+    }
+
+    for (auto const& itr : m_appliedAuras)
+        _RegisterProcAura(itr.second);
+}
+
+uint32 Unit::GetAuraProcFlags(SpellInfo const* spellInfo)
+{
+    // same flags as IsTriggeredAtSpellProcEvent, auras handled by the new proc system don't proc here
+    if (sSpellMgr->GetSpellProcEntry(spellInfo->Id))
+        return 0;
+
+    SpellProcEventEntry const* spellProcEvent = sSpellMgr->GetSpellProcEvent(spellInfo->Id);
+    if (spellProcEvent && spellProcEvent->procFlags)
+        return spellProcEvent->procFlags;
+
+    return spellInfo->ProcFlags;
+}
+
 bool Unit::IsTriggeredAtSpellProcEvent(Unit* victim, ProcTriggeredData& triggerData, SpellInfo const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, bool active)
 {
     Aura* aura = triggerData.aura;
@@ -18439,6 +18586,80 @@ void Unit::NearTeleportTo(float x, float y, float z, float orientation, bool cas
 }
 
 void Unit::WriteMovementInfo(WorldPacket& data, Movement::ExtraMovementStatusElement* extras /*= NULL*/)
+{
+    Movement::MovementCodec const* codec = Movement::GetMovementCodec(data.GetOpcode());
+    if (!codec)
+    {
+        // the packet is left without movement info, as the sequence interpreter did
+        TC_LOG_DEBUG("network", "Unit::WriteMovementInfo: No movement sequence found for opcode %s", GetOpcodeNameForLogging(static_cast<OpcodeServer>(data.GetOpcode())).c_str());
+        return;
+    }
+
+    uint32 timestamp = getMSTime();
+
+    bool validate = sWorld->getBoolConfig(CONFIG_MOVEMENT_VALIDATE_CODECS);
+    WorldPacket interpreted;
+    if (validate)
+    {
+        interpreted = data;
+        uint32 counter = m_movementCounter;
+        uint32 extrasIndex = extras ? extras->GetIndex() : 0;
+        WriteMovementInfoInterpreted(interpreted, extras, timestamp);
+        m_movementCounter = counter;
+        if (extras)
+            extras->SetIndex(extrasIndex);
+    }
+
+    Movement::MovementWriteContext context(data, extras, m_movementInfo, m_movementCounter);
+    context.HasMountDisplayId = GetUInt32Value(UNIT_FIELD_MOUNT_DISPLAY_ID) != 0;
+    context.HasMovementFlags = GetUnitMovementFlags() != 0;
+    context.HasMovementFlags2 = GetExtraUnitMovementFlags() != 0;
+    context.HasTimestamp = true;
+    context.HasOrientation = !G3D::fuzzyEq(GetOrientation(), 0.0f);
+    context.HasTransportData = GetTransGUID() != 0;
+    context.HasSpline = IsSplineEnabled();
+    context.HasTransportTime2 = context.HasTransportData && m_movementInfo.transport.time2 != 0;
+    context.HasTransportTime3 = false;
+    context.HasPitch = HasUnitMovementFlag(MovementFlags(MOVEMENTFLAG_SWIMMING | MOVEMENTFLAG_FLYING)) || HasExtraUnitMovementFlag(MOVEMENTFLAG2_ALWAYS_ALLOW_PITCHING);
+    context.HasFallDirection = HasUnitMovementFlag(MOVEMENTFLAG_FALLING);
+    context.HasFallData = context.HasFallDirection || m_movementInfo.jump.fallTime != 0;
+    context.HasSplineElevation = HasUnitMovementFlag(MOVEMENTFLAG_SPLINE_ELEVATION);
+
+    context.Guid = GetGUID();
+    context.TransportGuid = context.HasTransportData ? GetTransGUID() : ObjectGuid::Empty;
+    if (data.GetOpcode() == SMSG_MOVE_TELEPORT && context.HasTransportData)
+    {
+        context.PositionX = GetTransOffsetX();
+        context.PositionY = GetTransOffsetY();
+        context.PositionZ = GetTransOffsetZ();
+        context.Orientation = GetTransOffsetO();
+    }
+    else
+    {
+        context.PositionX = GetPositionX();
+        context.PositionY = GetPositionY();
+        context.PositionZ = GetPositionZ();
+        context.Orientation = GetOrientation();
+    }
+    context.TransportPositionX = GetTransOffsetX();
+    context.TransportPositionY = GetTransOffsetY();
+    context.TransportPositionZ = GetTransOffsetZ();
+    context.TransportOrientation = GetTransOffsetO();
+    context.TransportSeat = GetTransSeat();
+    context.TransportTime = GetTransTime();
+    context.MountDisplayId = GetUInt32Value(UNIT_FIELD_MOUNT_DISPLAY_ID);
+    context.MovementFlags = GetUnitMovementFlags();
+    context.MovementFlags2 = GetExtraUnitMovementFlags();
+    context.Timestamp = timestamp;
+
+    codec->Write(context);
+
+    if (validate && !Movement::IsSameMovementPacket(interpreted, data))
+        TC_LOG_ERROR("network", "Unit::WriteMovementInfo: Movement codec and interpreter differ for opcode %s", GetOpcodeNameForLogging(static_cast<OpcodeServer>(data.GetOpcode())).c_str());
+}
+
+// Walks the sequence of the opcode at runtime, only used to validate the codecs
+void Unit::WriteMovementInfoInterpreted(WorldPacket& data, Movement::ExtraMovementStatusElement* extras, uint32 timestamp)
 {
     MovementInfo const& mi = m_movementInfo;
 
@@ -18460,10 +18681,7 @@ void Unit::WriteMovementInfo(WorldPacket& data, Movement::ExtraMovementStatusEle
 
     MovementStatusElements const* sequence = GetMovementStatusElementsSequence(data.GetOpcode());
     if (!sequence)
-    {
-        TC_LOG_ERROR("network", "Unit::WriteMovementInfo: No movement sequence found for opcode %s", GetOpcodeNameForLogging(static_cast<OpcodeClient>(data.GetOpcode())).c_str());
         return;
-    }
 
     ObjectGuid guid = GetGUID();
     ObjectGuid tguid = hasTransportData ? GetTransGUID() : ObjectGuid::Empty;
@@ -18577,7 +18795,7 @@ void Unit::WriteMovementInfo(WorldPacket& data, Movement::ExtraMovementStatusEle
                 break;
             case MSETimestamp:
                 if (hasTimestamp)
-                    data << getMSTime();
+                    data << timestamp;
                 break;
             case MSEPositionX:
                 if (data.GetOpcode() == SMSG_MOVE_TELEPORT && hasTransportData)
@@ -19573,11 +19791,9 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
         return;
 
     UpdateBuilder builder;
-    builder.SetSource(updateType == UPDATETYPE_VALUES ? _changesMask.GetBits() : m_uint32Values, m_valuesCount);
+    builder.SetSource(updateType == UPDATETYPE_VALUES ? &_changesMask : nullptr, m_uint32Values, m_valuesCount);
     builder.SetDest(data);
 
-    uint32 valCount = m_valuesCount;
-
     uint32* flags = nullptr;
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
 
@@ -19595,173 +19811,176 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     if (plr && plr->IsInSameRaidWith(target))
         visibleFlag |= UF_FLAG_PARTY_MEMBER;
 
+    builder.SelectFields(GetUpdateFieldMasks(), visibleFlag, _fieldNotifyFlags);
+    if (visibleFlag & UF_FLAG_SPECIAL_INFO)
+        builder.AddFields(GetUpdateFieldMasks(), UF_FLAG_SPECIAL_INFO);
+
+    // there are many private fields for player, avoid them first
     if (GetTypeId() == TYPEID_PLAYER && !(visibleFlag & UF_FLAG_PRIVATE))
-        valCount = PLAYER_FIELD_INV_SLOTS;
+        builder.LimitFields(PLAYER_FIELD_INV_SLOTS);
 
-    Creature const* creature = ToCreature();
-    for (uint16 index = 0; index < valCount; ++index)
+    builder.ForEachField([&](uint16 index)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((flags[index] & visibleFlag) & UF_FLAG_SPECIAL_INFO) ||
-            ((flags[index] & visibleFlag) && builder.GetSrcBit(index)))    // there are many private fields for player, avoid them first
+        uint32 viewerValue;
+        if (GetViewerDependentValue(index, target, viewerValue))
+            *data << viewerValue;
+        // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+        else if (index >= UNIT_FIELD_ATTACK_ROUND_BASE_TIME && index <= UNIT_FIELD_RANGED_ATTACK_ROUND_BASE_TIME)
         {
-            builder.SetDestBit(index);
+            // convert from float to uint32 and send
+            *data << uint32(m_floatValues [index] < 0 ? 0 : m_floatValues [index]);
+        }
+        // there are some float values which may be negative or can't get negative due to other checks
+        else if ((index >= UNIT_FIELD_STAT_NEG_BUFF   && index <= UNIT_FIELD_STAT_NEG_BUFF + 4) ||
+                 (index >= UNIT_FIELD_RESISTANCE_BUFF_MODS_POSITIVE  && index <= (UNIT_FIELD_RESISTANCE_BUFF_MODS_POSITIVE + 6)) ||
+                 (index >= UNIT_FIELD_RESISTANCE_BUFF_MODS_NEGATIVE  && index <= (UNIT_FIELD_RESISTANCE_BUFF_MODS_NEGATIVE + 6)) ||
+                 (index >= UNIT_FIELD_STAT_POS_BUFF   && index <= UNIT_FIELD_STAT_POS_BUFF + 4))
+        {
+            *data << uint32(m_floatValues [index]);
+        }
+        else if (index >= UNIT_FIELD_SUMMONED_BY && index < UNIT_FIELD_CREATED_BY)
+        {
+            if (IsSummon() && ToTempSummon()->IsSummonedByHidden())
+                *data << 0;
+            else
+                *data << m_uint32Values[index];
+        }
+        else
+        {
+            // send in current format (float as float, uint32 as uint32)
+            *data << m_uint32Values [index];
+        }
+    });
 
-            if (index == UNIT_FIELD_NPC_FLAGS)
-            {
-                uint32 appendValue = m_uint32Values [UNIT_FIELD_NPC_FLAGS];
+    builder.Finish();
 
-                if (creature)
-                    if (!target->CanSeeSpellClickOn(creature))
-                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+    BuildDynamicValuesUpdate(updateType, data);
+}
 
-                if (Battleground* bg = target->GetBattleground())
-                    if (!bg->CanSeeSpellClick(target, this))
-                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+bool Unit::GetViewerDependentValue(uint16 index, Player* target, uint32& value) const
+{
+    Creature const* creature = ToCreature();
+    switch (index)
+    {
+        case UNIT_FIELD_NPC_FLAGS:
+        {
+            value = m_uint32Values[UNIT_FIELD_NPC_FLAGS];
 
-                *data << uint32(appendValue);
-            }
-            else if (index == UNIT_FIELD_AURA_STATE)
-            {
-                // Check per caster aura states to not enable using a spell in client if specified aura is not by target
-                *data << BuildAuraStateUpdateForTarget(target);
-            }
-            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-            else if (index >= UNIT_FIELD_ATTACK_ROUND_BASE_TIME && index <= UNIT_FIELD_RANGED_ATTACK_ROUND_BASE_TIME)
-            {
-                // convert from float to uint32 and send
-                *data << uint32(m_floatValues [index] < 0 ? 0 : m_floatValues [index]);
-            }
-            // there are some float values which may be negative or can't get negative due to other checks
-            else if ((index >= UNIT_FIELD_STAT_NEG_BUFF   && index <= UNIT_FIELD_STAT_NEG_BUFF + 4) ||
-                     (index >= UNIT_FIELD_RESISTANCE_BUFF_MODS_POSITIVE  && index <= (UNIT_FIELD_RESISTANCE_BUFF_MODS_POSITIVE + 6)) ||
-                     (index >= UNIT_FIELD_RESISTANCE_BUFF_MODS_NEGATIVE  && index <= (UNIT_FIELD_RESISTANCE_BUFF_MODS_NEGATIVE + 6)) ||
-                     (index >= UNIT_FIELD_STAT_POS_BUFF   && index <= UNIT_FIELD_STAT_POS_BUFF + 4))
-            {
-                *data << uint32(m_floatValues [index]);
-            }
-            // Gamemasters should be always able to select units - remove not selectable flag
-            else if (index == UNIT_FIELD_FLAGS)
-            {
-                uint32 appendValue = m_uint32Values [UNIT_FIELD_FLAGS];
-                if (target->IsGameMaster())
-                    appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
+            if (creature)
+                if (!target->CanSeeSpellClickOn(creature))
+                    value &= ~UNIT_NPC_FLAG_SPELLCLICK;
 
-                *data << uint32(appendValue);
-            }
-            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-            else if (index == UNIT_FIELD_DISPLAY_ID)
+            if (Battleground* bg = target->GetBattleground())
+                if (!bg->CanSeeSpellClick(target, this))
+                    value &= ~UNIT_NPC_FLAG_SPELLCLICK;
+            return true;
+        }
+        case UNIT_FIELD_AURA_STATE:
+            // Check per caster aura states to not enable using a spell in client if specified aura is not by target
+            value = BuildAuraStateUpdateForTarget(target);
+            return true;
+        // Gamemasters should be always able to select units - remove not selectable flag
+        case UNIT_FIELD_FLAGS:
+            value = m_uint32Values[UNIT_FIELD_FLAGS];
+            if (target->IsGameMaster())
+                value &= ~UNIT_FLAG_NOT_SELECTABLE;
+            return true;
+        // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+        case UNIT_FIELD_DISPLAY_ID:
+        {
+            value = m_uint32Values[UNIT_FIELD_DISPLAY_ID];
+            if (creature)
             {
-                uint32 displayId = m_uint32Values [UNIT_FIELD_DISPLAY_ID];
-                if (creature)
-                {
-                    CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
-
-                    // this also applies for transform auras
-                    if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
-                        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-                            if (transform->Effects [i].IsAura(SPELL_AURA_TRANSFORM))
-                                if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects [i].MiscValue))
-                                {
-                                    cinfo = transformInfo;
-                                    break;
-                                }
+                CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
+
+                // this also applies for transform auras
+                if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
+                    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+                        if (transform->Effects [i].IsAura(SPELL_AURA_TRANSFORM))
+                            if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects [i].MiscValue))
+                            {
+                                cinfo = transformInfo;
+                                break;
+                            }
 
-                    if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                {
+                    if (target->IsGameMaster())
                     {
-                        if (target->IsGameMaster())
-                        {
-                            if (cinfo->Modelid1)
-                                displayId = cinfo->Modelid1;    // Modelid1 is a visible model for gms
-                            else
-                                displayId = 17519;              // world visible trigger's model
-                        }
+                        if (cinfo->Modelid1)
+                            value = cinfo->Modelid1;    // Modelid1 is a visible model for gms
                         else
-                        {
-                            if (cinfo->Modelid2)
-                                displayId = cinfo->Modelid2;    // Modelid2 is an invisible model for players
-                            else
-                                displayId = 11686;              // world invisible trigger's model
-                        }
+                            value = 17519;              // world visible trigger's model
+                    }
+                    else
+                    {
+                        if (cinfo->Modelid2)
+                            value = cinfo->Modelid2;    // Modelid2 is an invisible model for players
+                        else
+                            value = 11686;              // world invisible trigger's model
                     }
                 }
-
-                *data << uint32(displayId);
             }
-            // hide lootable animation for unallowed players
-            else if (index == OBJECT_FIELD_DYNAMIC_FLAGS)
-            {
-                uint32 dynamicFlags = m_uint32Values [OBJECT_FIELD_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+            return true;
+        }
+        // hide lootable animation for unallowed players
+        case OBJECT_FIELD_DYNAMIC_FLAGS:
+        {
+            value = m_uint32Values[OBJECT_FIELD_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
 
-                if (creature)
+            if (creature)
+            {
+                if (creature->HasLootRecipient())
                 {
-                    if (creature->HasLootRecipient())
-                    {
-                        dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                        if (creature->IsTappedBy(target))
-                            dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                    }
-
-                    if (!target->IsAllowedToLoot(creature))
-                        dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
+                    value |= UNIT_DYNFLAG_TAPPED;
+                    if (creature->IsTappedBy(target))
+                        value |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
                 }
 
-                // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                    if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                        dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+                if (!target->IsAllowedToLoot(creature))
+                    value &= ~UNIT_DYNFLAG_LOOTABLE;
+            }
 
-                if (dynamicFlags & UNIT_DYNFLAG_DEAD)
-                    if (HasFlag(UNIT_FIELD_FLAGS2, UNIT_FLAG2_FEIGN_DEATH) && IsInRaidWith(target))
-                        dynamicFlags &= ~UNIT_DYNFLAG_DEAD;
+            // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+            if (value & UNIT_DYNFLAG_TRACK_UNIT)
+                if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                    value &= ~UNIT_DYNFLAG_TRACK_UNIT;
 
-                *data << dynamicFlags;
-            }
-            // FG: pretend that OTHER players in own group are friendly ("blue")
-            else if (index == UNIT_FIELD_SHAPESHIFT_FORM || index == UNIT_FIELD_FACTION_TEMPLATE)
+            if (value & UNIT_DYNFLAG_DEAD)
+                if (HasFlag(UNIT_FIELD_FLAGS2, UNIT_FLAG2_FEIGN_DEATH) && IsInRaidWith(target))
+                    value &= ~UNIT_DYNFLAG_DEAD;
+            return true;
+        }
+        // FG: pretend that OTHER players in own group are friendly ("blue")
+        case UNIT_FIELD_SHAPESHIFT_FORM:
+        case UNIT_FIELD_FACTION_TEMPLATE:
+        {
+            value = m_uint32Values[index];
+
+            FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
+            FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
+            if (IsControlledByPlayer() && target != this && (sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) || target->GetGroup() && target->GetGroup()->isLFGGroup() && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_LFG)) && IsInRaidWith(target))
             {
-                FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
-                FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
-                if (IsControlledByPlayer() && target != this && (sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) || target->GetGroup() && target->GetGroup()->isLFGGroup() && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_LFG)) && IsInRaidWith(target))
+                if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
                 {
-                    if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
-                    {
-                        if (index == UNIT_FIELD_SHAPESHIFT_FORM)
-                            // Allow targetting opposite faction in party when enabled in config
-                            *data << (m_uint32Values [UNIT_FIELD_SHAPESHIFT_FORM] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                        else
-                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                            *data << uint32(target->GetFaction());
-                    }
+                    if (index == UNIT_FIELD_SHAPESHIFT_FORM)
+                        // Allow targetting opposite faction in party when enabled in config
+                        value = m_uint32Values[UNIT_FIELD_SHAPESHIFT_FORM] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8); // this flag is at uint8 offset 1 !!
                     else
-                        *data << m_uint32Values [index];
-                }
-                else if (GetMapId() == 37 && sWorld->getBoolConfig(CONFIG_ICORE_ROYALE_EVENT_ENABLED) &&  index == UNIT_FIELD_FACTION_TEMPLATE && IsControlledByPlayer() && target != this && ft1->IsFriendlyTo(*ft2))
-                {
-                    // pretend that all other ALLY players have opposing team's faction
-                    *data << uint32(target->GetTeamId() == TEAM_ALLIANCE ? 2 : 1);
+                        // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                        value = target->GetFaction();
                 }
-                else
-                    *data << m_uint32Values [index];
             }
-            else if (index >= UNIT_FIELD_SUMMONED_BY && index < UNIT_FIELD_CREATED_BY)
+            else if (GetMapId() == 37 && sWorld->getBoolConfig(CONFIG_ICORE_ROYALE_EVENT_ENABLED) && index == UNIT_FIELD_FACTION_TEMPLATE && IsControlledByPlayer() && target != this && ft1->IsFriendlyTo(*ft2))
             {
-                if (IsSummon() && ToTempSummon()->IsSummonedByHidden())
-                    *data << 0;
-                else
-                    *data << m_uint32Values[index];
-            }
-            else
-            {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values [index];
+                // pretend that all other ALLY players have opposing team's faction
+                value = target->GetTeamId() == TEAM_ALLIANCE ? 2 : 1;
             }
+            return true;
         }
+        default:
+            return false;
     }
-
-    builder.Finish();
-
-    BuildDynamicValuesUpdate(updateType, data);
 }
 
 // Returns collisionheight of the unit. If it is 0, it returns DEFAULT_COLLISION_HEIGHT.
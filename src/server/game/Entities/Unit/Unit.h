@@ -33,6 +33,7 @@
 #include "SpellInfo.h"
 #include "UnitDefines.h"
 #include <array>
+#include <atomic>
 #include <memory>
 
 #define WORLD_TRIGGER   12999
@@ -1141,6 +1142,50 @@ struct ProcTriggerContext
     ProcPhase Phase = ProcPhase::Hit;
 };
 
+// Proc auras checked by ProcDamageAndSpellFor across all units, for .server stats procs
+// Recorded as per thread metrics counters, only while Metrics.Enable is set
+struct ProcDispatchStats
+{
+    uint64 Events = 0;
+    uint64 Registered = 0;                                  // proc auras of the event's phase, all were checked before bucketing
+    uint64 Visited = 0;
+    uint64 Triggered = 0;
+};
+
+// Aura effects of a unit by aura type, only types applied at least once get a list
+class TC_GAME_API AuraEffectIndex
+{
+public:
+    typedef std::list<AuraEffect*> EffectList;
+
+    AuraEffectIndex() : _types() { }
+
+    EffectList const& Get(AuraType type) const
+    {
+        if (!Contains(type))
+            return _empty;
+
+        return *_lists[Rank(type)];
+    }
+
+    // Lists stay allocated until the unit is destroyed, callers may hold them while effects are removed
+    EffectList& GetOrCreate(AuraType type);
+
+    bool Has(AuraType type) const { return Contains(type) && !_lists[Rank(type)]->empty(); }
+    std::size_t GetTypeCount() const { return _lists.size(); }
+    std::size_t GetMemoryUsage() const;
+
+private:
+    static constexpr std::size_t WordBits = 64;
+
+    bool Contains(AuraType type) const { return (_types[type / WordBits] >> (type % WordBits)) & 1; }
+    std::size_t Rank(AuraType type) const;
+
+    uint64 _types[(TOTAL_AURAS + WordBits - 1) / WordBits];
+    std::vector<std::unique_ptr<EffectList>> _lists;        // ordered by aura type
+    static EffectList const _empty;
+};
+
 class TC_GAME_API Unit : public WorldObject
 {
 public:
@@ -1160,7 +1205,7 @@ public:
     typedef std::multimap<AuraStateType, AuraApplication*> AuraStateAurasMap;
     typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
-    typedef std::list<AuraEffect*> AuraEffectList;
+    typedef AuraEffectIndex::EffectList AuraEffectList;
     typedef std::list<Aura*> AuraList;
     typedef std::list<AuraApplication *> AuraApplicationList;
     typedef std::list<DiminishingReturn> Diminishing;
@@ -1502,6 +1547,9 @@ public:
 
     void ProcDamageAndSpell(Unit* victim, uint32 procAttacker, uint32 procVictim, uint32 procEx, uint32 amount, WeaponAttackType attType = BASE_ATTACK, SpellInfo const* procSpell = nullptr, SpellInfo const* procAura = nullptr, ProcTriggerContext const& context = ProcTriggerContext());
     void ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, SpellInfo const* procSpell, uint32 damage, SpellInfo const* procAura = nullptr, ProcTriggerContext const& context = ProcTriggerContext());
+    static ProcDispatchStats GetProcDispatchStats();
+    // proc data was reloaded, every unit rebuilds its proc buckets before it uses them again
+    static void InvalidateProcAuras() { ++s_procAurasGeneration; }
 
     void HandleEmoteCommand(uint32 anim_id);
     void HandleEmoteStateCommand(uint32 anim_id);
@@ -1966,8 +2014,9 @@ public:
 
     AuraEffectList const& GetAuraEffectsByType(AuraType type) const
     {
-        return m_modAuras [type];
+        return m_modAuras.Get(type);
     }
+    AuraEffectIndex const& GetAuraEffectIndex() const { return m_modAuras; }
 
     AuraEffect* GetAuraEffect(uint32 spellId, uint8 effIndex, uint64 casterGUID = 0) const;
     AuraEffect* GetAuraEffectOfRankedSpell(uint32 spellId, uint8 effIndex, uint64 casterGUID = 0) const;
@@ -2512,6 +2561,7 @@ public:
     void _EnterVehicle(Vehicle* vehicle, int8 seatId, AuraApplication const* aurApp = NULL);
 
     void WriteMovementInfo(WorldPacket& data, Movement::ExtraMovementStatusElement* extras = NULL);
+    void WriteMovementInfoInterpreted(WorldPacket& data, Movement::ExtraMovementStatusElement* extras, uint32 timestamp);
 
     bool isMoving() const { return m_movementInfo.HasMovementFlag(MOVEMENTFLAG_MASK_MOVING); }
     bool isTurning() const { return m_movementInfo.HasMovementFlag(MOVEMENTFLAG_MASK_TURNING); }
@@ -2626,6 +2676,7 @@ protected:
     explicit Unit (bool isWorldObject);
 
     void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    bool GetViewerDependentValue(uint16 index, Player* target, uint32& value) const override;
 
     UnitAI* i_AI, *i_disabledAI;
 
@@ -2668,12 +2719,22 @@ protected:
 
     AuraMap m_ownedAuras;
     AuraApplicationMap m_appliedAuras;
-    AuraApplicationMap m_procAuras[uint32(ProcPhase::Max)];
+    // Proc auras of each phase bucketed by proc flag, an aura is in the bucket of every flag it can trigger from
+    struct ProcAuraEntry
+    {
+        AuraApplication* Application;
+        uint32 ProcFlags;
+    };
+    typedef std::multimap<uint32, ProcAuraEntry> ProcAuraMap;
+    std::map<uint32, ProcAuraMap> m_procAuras[uint32(ProcPhase::Max)];
+    uint32 m_procAuraCount[uint32(ProcPhase::Max)];
+    uint32 m_procAurasGeneration;                           // s_procAurasGeneration the buckets were built for
+    static std::atomic<uint32> s_procAurasGeneration;
     AuraList m_removedAuras;
     AuraMap::iterator m_auraUpdateIterator;
     uint32 m_removedAurasCount;
 
-    AuraEffectList m_modAuras [TOTAL_AURAS];
+    AuraEffectIndex m_modAuras;
     AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
     AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
     std::map<uint32, AuraList> m_boundAuras;
@@ -2712,6 +2773,9 @@ protected:
     virtual void ProcessTerrainStatusUpdate(ZLiquidStatus oldLiquidStatus, Optional<LiquidData> const& newLiquidData);
 
 private:
+    static uint32 GetAuraProcFlags(SpellInfo const* spellInfo);
+    void _RegisterProcAura(AuraApplication* aurApp);
+    void _UpdateProcAuras();
     bool IsTriggeredAtSpellProcEvent(Unit* victim, ProcTriggeredData& triggerData, SpellInfo const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, bool active);
     bool HandleAuraProcOnPowerAmount(Unit* victim, uint32 damage, AuraEffect* triggeredByAura, SpellInfo const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown, ProcTriggerContext const& context);
     bool HandleDummyAuraProc(Unit* victim, uint32 damage, AuraEffect* triggeredByAura, SpellInfo const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown, ProcTriggerContext const& context);
@@ -95,6 +95,7 @@ namespace Trinity
     {
         WorldObject* i_source;
         WorldPacket* i_message;
+        std::shared_ptr<WorldPacket const> i_sharedMessage;     // one copy for all receivers, created on first send
         uint32 i_phaseMask;
         float i_distSq;
         uint32 team;
@@ -123,7 +124,12 @@ namespace Trinity
                 return;
 
             if (WorldSession* session = player->GetSession())
-                session->SendPacket(i_message);
+            {
+                if (!i_sharedMessage)
+                    i_sharedMessage = std::make_shared<WorldPacket>(*i_message);
+
+                session->SendPacket(i_sharedMessage);
+            }
         }
     };
 
@@ -26,6 +26,7 @@
 #include "Group.h"
 #include "Formulas.h"
 #include "ObjectAccessor.h"
+#include "PacketBroadcast.h"
 #include "Battleground.h"
 #include "BattlegroundMgr.h"
 #include "MapManager.h"
@@ -2264,6 +2265,7 @@ void Group::UpdatePlayerOutOfRange(Player* player)
 
 void Group::BroadcastAddonMessagePacket(WorldPacket* packet, const std::string& prefix, bool ignorePlayersInBGRaid, int group, uint64 ignore)
 {
+    PacketBroadcast broadcast(packet);
     for (GroupReference* itr = GetFirstMember(); itr != NULL; itr = itr->next())
     {
         Player* player = itr->GetSource();
@@ -2273,38 +2275,41 @@ void Group::BroadcastAddonMessagePacket(WorldPacket* packet, const std::string&
         if (WorldSession* session = player->GetSession())
             if (session && (group == -1 || itr->getSubGroup() == group))
                 if (session->IsAddonRegistered(prefix))
-                    session->SendPacket(packet);
+                    broadcast.SendTo(player);
     }
 }
 
 void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignore)
 {
+    PacketBroadcast broadcast(packet);
     for (GroupReference* itr = GetFirstMember(); itr != NULL; itr = itr->next())
     {
         Player* player = itr->GetSource();
         if (!player || (ignore != 0 && player->GetGUID() == ignore) || (ignorePlayersInBGRaid && player->GetGroup() != this))
             continue;
 
-        if (player->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            player->GetSession()->SendPacket(packet);
+        if (group == -1 || itr->getSubGroup() == group)
+            broadcast.SendTo(player);
     }
 }
 
 void Group::BroadcastChat(WorldPacket const* packet, ObjectGuid sender, int32 group) const
 {
+    PacketBroadcast broadcast(packet);
     for (auto&& player : *this)
         if ((group == -1 || player->GetSubGroup() == uint8(group)) && !player->GetSocial()->HasIgnore(sender))
-            player->GetSession()->SendPacket(packet);
+            broadcast.SendTo(player);
 }
 
 void Group::BroadcastReadyCheck(WorldPacket* packet)
 {
+    PacketBroadcast broadcast(packet);
     for (GroupReference* itr = GetFirstMember(); itr != NULL; itr = itr->next())
     {
         Player* player = itr->GetSource();
         if (player && player->GetSession())
             if (IsLeader(player->GetGUID()) || IsAssistant(player->GetGUID()))
-                player->GetSession()->SendPacket(packet);
+                broadcast.SendTo(player);
     }
 }
 
@@ -30,6 +30,7 @@
 #include "ScriptMgr.h"
 #include "SocialMgr.h"
 #include "Opcodes.h"
+#include "PacketBroadcast.h"
 #include "Realm.h"
 #include "ReputationMgr.h"
 
@@ -3101,11 +3102,13 @@ void Guild::BroadcastToGuild(WorldSession* session, bool officerOnly, std::strin
     {
         WorldPacket data;
         ChatHandler::BuildChatPacket(data, officerOnly ? CHAT_MSG_OFFICER : CHAT_MSG_GUILD, Language(language), session->GetPlayer(), NULL, msg);
-        for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-            if (Player* player = itr->second->FindPlayer())
-                if (player->GetSession() && HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
-                    !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUID()))
-                    player->GetSession()->SendPacket(&data);
+        ObjectGuid sender = session->GetPlayer()->GetGUID();
+        PacketBroadcast broadcast(&data);
+        broadcast.AddPlayers(m_members.begin(), m_members.end(), [](Members::value_type const& member) { return member.second->GetGUID(); });
+        broadcast.Send([this, officerOnly, sender](Player* player)
+        {
+            return HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) && !player->GetSocial()->HasIgnore(sender);
+        });
     }
 }
 
@@ -3115,36 +3118,42 @@ void Guild::BroadcastAddonToGuild(WorldSession* session, bool officerOnly, std::
     {
         WorldPacket data;
         ChatHandler::BuildChatPacket(data, officerOnly ? CHAT_MSG_OFFICER : CHAT_MSG_GUILD, LANG_ADDON, session->GetPlayer(), NULL, msg, 0, "", DEFAULT_LOCALE, prefix);
-        for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-            if (Player* player = itr->second->FindPlayer())
-                if (player->GetSession() && HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
-                    !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUID()) &&
-                    player->GetSession()->IsAddonRegistered(prefix))
-                        player->GetSession()->SendPacket(&data);
+        ObjectGuid sender = session->GetPlayer()->GetGUID();
+        PacketBroadcast broadcast(&data);
+        broadcast.AddPlayers(m_members.begin(), m_members.end(), [](Members::value_type const& member) { return member.second->GetGUID(); });
+        broadcast.Send([this, officerOnly, sender, &prefix](Player* player)
+        {
+            return player->GetSession() && HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
+                !player->GetSocial()->HasIgnore(sender) && player->GetSession()->IsAddonRegistered(prefix);
+        });
     }
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint8 rankId) const
 {
-    for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (itr->second->IsRank(rankId))
-            if (Player* player = itr->second->FindPlayer())
-                player->GetSession()->SendPacket(packet);
+    PacketBroadcast broadcast(packet);
+    broadcast.AddPlayers(m_members.begin(), m_members.end(), [rankId](Members::value_type const& member)
+    {
+        return member.second->IsRank(rankId) ? member.second->GetGUID() : ObjectGuid::Empty;
+    });
+    broadcast.Send();
 }
 
 void Guild::BroadcastPacket(WorldPacket* packet) const
 {
-    for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (Player* player = itr->second->FindPlayer())
-            player->GetSession()->SendPacket(packet);
+    PacketBroadcast broadcast(packet);
+    broadcast.AddPlayers(m_members.begin(), m_members.end(), [](Members::value_type const& member) { return member.second->GetGUID(); });
+    broadcast.Send();
 }
 
 void Guild::BroadcastPacketIfTrackingAchievement(WorldPacket* packet, uint32 criteriaId) const
 {
-    for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (itr->second->IsTrackingCriteriaId(criteriaId))
-            if (Player* player = itr->second->FindPlayer())
-                player->GetSession()->SendPacket(packet);
+    PacketBroadcast broadcast(packet);
+    broadcast.AddPlayers(m_members.begin(), m_members.end(), [criteriaId](Members::value_type const& member)
+    {
+        return member.second->IsTrackingCriteriaId(criteriaId) ? member.second->GetGUID() : ObjectGuid::Empty;
+    });
+    broadcast.Send();
 }
 
 void Guild::MassInviteToEvent(WorldSession* session, uint32 minLevel, uint32 maxLevel, uint32 minRank)
@@ -266,6 +266,45 @@ namespace LuaGlobalFunctions
         return 0;
     }
 
+    // SendStateMessage(channel, message[, mapId, instanceId]) - Queues message for the state of the map, the world state without mapId. Returns false if the map has no state
+    int SendStateMessage(lua_State* L)
+    {
+        size_t length = 0;
+        ElunaStateMessage message;
+        message.Channel = luaL_checkstring(L, 1);
+        const char* data = luaL_checklstring(L, 2, &length);
+        message.Data.assign(data, length);
+        message.SenderMapId = sEluna->GetMapId();
+        message.SenderInstanceId = sEluna->GetInstanceId();
+        int32 mapId = luaL_optint(L, 3, -1);
+        uint32 instanceId = luaL_optunsigned(L, 4, 0);
+
+        sEluna->Push(L, Eluna::PostMessage(mapId, instanceId, message));
+        return 1;
+    }
+
+    // BroadcastStateMessage(channel, message) - Queues message for every other state. Returns the amount of receiving states
+    int BroadcastStateMessage(lua_State* L)
+    {
+        size_t length = 0;
+        ElunaStateMessage message;
+        message.Channel = luaL_checkstring(L, 1);
+        const char* data = luaL_checklstring(L, 2, &length);
+        message.Data.assign(data, length);
+        message.SenderMapId = sEluna->GetMapId();
+        message.SenderInstanceId = sEluna->GetInstanceId();
+
+        sEluna->Push(L, Eluna::BroadcastMessage(message));
+        return 1;
+    }
+
+    // GetStateMap() - Returns the map the running state belongs to, nil for the world state
+    int GetStateMap(lua_State* L)
+    {
+        sEluna->Push(L, sEluna->GetMap());
+        return 1;
+    }
+
     // GetPlayerByGUID(guid) - Gets Player object by its guid
     int GetPlayerByGUID(lua_State* L)
     {
@@ -21,7 +21,10 @@ HookMgr* HookMgr::instance()
 
 void HookMgr::OnWorldUpdate(uint32 diff)
 {
-    sEluna->m_EventMgr.Update(diff);
+    ElunaStateGuard guard;
+    sEluna->Update(diff);
+    if (!Eluna::HasBindings(REGTYPE_SERVER, WORLD_EVENT_ON_UPDATE))
+        return;
     for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WORLD_EVENT_ON_UPDATE].begin();
         itr != sEluna->ServerEventBindings[WORLD_EVENT_ON_UPDATE].end(); ++itr)
     {
@@ -32,8 +35,29 @@ void HookMgr::OnWorldUpdate(uint32 diff)
     }
 }
 
+void HookMgr::OnMapUpdate(Map* map, uint32 diff)
+{
+    if (!Eluna::IsPerMapStates())
+        return;
+
+    // Maps nobody entered yet get their state on first use, not on every tick
+    if (Eluna* state = Eluna::GetState(map, map->HavePlayers()))
+    {
+        ElunaStateGuard guard(state);
+        state->Update(diff);
+    }
+}
+
+void HookMgr::OnDestroyMap(Map* map)
+{
+    Eluna::DestroyState(map);
+}
+
 void HookMgr::OnLootItem(Player* pPlayer, Item* pItem, uint32 count, uint64 guid)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_LOOT_ITEM))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LOOT_ITEM].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LOOT_ITEM].end(); ++itr)
     {
@@ -49,6 +73,9 @@ void HookMgr::OnLootItem(Player* pPlayer, Item* pItem, uint32 count, uint64 guid
 
 void HookMgr::OnLootMoney(Player* pPlayer, uint32 amount)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_LOOT_MONEY))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LOOT_MONEY].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LOOT_MONEY].end(); ++itr)
     {
@@ -62,6 +89,9 @@ void HookMgr::OnLootMoney(Player* pPlayer, uint32 amount)
 
 void HookMgr::OnFirstLogin(Player* pPlayer)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_FIRST_LOGIN))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_FIRST_LOGIN].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_FIRST_LOGIN].end(); ++itr)
     {
@@ -74,6 +104,9 @@ void HookMgr::OnFirstLogin(Player* pPlayer)
 
 void HookMgr::OnRepop(Player* pPlayer)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_REPOP))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_REPOP].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_REPOP].end(); ++itr)
     {
@@ -86,6 +119,9 @@ void HookMgr::OnRepop(Player* pPlayer)
 
 void HookMgr::OnResurrect(Player* pPlayer)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_RESURRECT))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_RESURRECT].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_RESURRECT].end(); ++itr)
     {
@@ -98,6 +134,9 @@ void HookMgr::OnResurrect(Player* pPlayer)
 
 void HookMgr::OnEquip(Player* pPlayer, Item* pItem, uint8 bag, uint8 slot)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_EQUIP))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_EQUIP].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_EQUIP].end(); ++itr)
     {
@@ -114,6 +153,9 @@ void HookMgr::OnEquip(Player* pPlayer, Item* pItem, uint8 bag, uint8 slot)
 InventoryResult HookMgr::OnCanUseItem(const Player* pPlayer, uint32 itemEntry)
 {
     InventoryResult result = EQUIP_ERR_OK;
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_CAN_USE_ITEM))
+        return result;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_CAN_USE_ITEM].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_CAN_USE_ITEM].end(); ++itr)
     {
@@ -134,6 +176,9 @@ InventoryResult HookMgr::OnCanUseItem(const Player* pPlayer, uint32 itemEntry)
 
 void HookMgr::HandleGossipSelectOption(Player* pPlayer, Item* item, uint32 sender, uint32 action, std::string code)
 {
+    if (!Eluna::HasBindings(REGTYPE_ITEM_GOSSIP, GOSSIP_EVENT_ON_SELECT))
+        return;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->ItemGossipBindings->GetBind(item->GetEntry(), GOSSIP_EVENT_ON_SELECT);
     if (bind)
     {
@@ -154,6 +199,9 @@ void HookMgr::HandleGossipSelectOption(Player* pPlayer, Item* item, uint32 sende
 
 void HookMgr::HandleGossipSelectOption(Player* pPlayer, uint32 menuId, uint32 sender, uint32 action, std::string code)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER_GOSSIP, GOSSIP_EVENT_ON_SELECT))
+        return;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->playerGossipBindings->GetBind(menuId, GOSSIP_EVENT_ON_SELECT);
     if (bind)
     {
@@ -175,6 +223,8 @@ void HookMgr::HandleGossipSelectOption(Player* pPlayer, uint32 menuId, uint32 se
 
 void HookMgr::OnEngineRestart()
 {
+    if (!Eluna::HasBindings(REGTYPE_SERVER, ELUNA_EVENT_ON_RESTART))
+        return;
     for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[ELUNA_EVENT_ON_RESTART].begin();
         itr != sEluna->ServerEventBindings[ELUNA_EVENT_ON_RESTART].end(); ++itr)
     {
@@ -187,6 +237,9 @@ void HookMgr::OnEngineRestart()
 // item
 bool HookMgr::OnDummyEffect(Unit* pCaster, uint32 spellId, SpellEffIndex effIndex, Item* pTarget)
 {
+    if (!Eluna::HasBindings(REGTYPE_ITEM, ITEM_EVENT_ON_DUMMY_EFFECT))
+        return false;
+    ElunaStateGuard guard(pCaster);
     int bind = sEluna->ItemEventBindings->GetBind(pTarget->GetEntry(), ITEM_EVENT_ON_DUMMY_EFFECT);
     if (!bind)
         return false;
@@ -202,6 +255,9 @@ bool HookMgr::OnDummyEffect(Unit* pCaster, uint32 spellId, SpellEffIndex effInde
 
 bool HookMgr::OnQuestAccept(Player* pPlayer, Item* pItem, Quest const* pQuest)
 {
+    if (!Eluna::HasBindings(REGTYPE_ITEM, ITEM_EVENT_ON_QUEST_ACCEPT))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->ItemEventBindings->GetBind(pItem->GetEntry(), ITEM_EVENT_ON_QUEST_ACCEPT);
     if (!bind)
         return false;
@@ -216,6 +272,9 @@ bool HookMgr::OnQuestAccept(Player* pPlayer, Item* pItem, Quest const* pQuest)
 
 bool HookMgr::OnUse(Player* pPlayer, Item* pItem, SpellCastTargets const& targets)
 {
+    if (!(Eluna::HasBindings(REGTYPE_ITEM_GOSSIP, GOSSIP_EVENT_ON_HELLO) || Eluna::HasBindings(REGTYPE_ITEM, ITEM_EVENT_ON_USE)))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind1 = sEluna->ItemGossipBindings->GetBind(pItem->GetEntry(), GOSSIP_EVENT_ON_HELLO);
     int bind2 = sEluna->ItemEventBindings->GetBind(pItem->GetEntry(), ITEM_EVENT_ON_USE);
     if (!bind1 && !bind2)
@@ -251,6 +310,9 @@ bool HookMgr::OnUse(Player* pPlayer, Item* pItem, SpellCastTargets const& target
 
 bool HookMgr::OnExpire(Player* pPlayer, ItemTemplate const* pProto)
 {
+    if (!Eluna::HasBindings(REGTYPE_ITEM, ITEM_EVENT_ON_EXPIRE))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->ItemEventBindings->GetBind(pProto->ItemId, ITEM_EVENT_ON_EXPIRE);
     if (!bind)
         return false;
@@ -264,6 +326,9 @@ bool HookMgr::OnExpire(Player* pPlayer, ItemTemplate const* pProto)
 // creature
 bool HookMgr::OnDummyEffect(Unit* pCaster, uint32 spellId, SpellEffIndex effIndex, Creature* pTarget)
 {
+    if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_DUMMY_EFFECT))
+        return false;
+    ElunaStateGuard guard(pCaster);
     int bind = sEluna->CreatureEventBindings->GetBind(pTarget->GetEntry(), CREATURE_EVENT_ON_DUMMY_EFFECT);
     if (!bind)
         return false;
@@ -279,6 +344,9 @@ bool HookMgr::OnDummyEffect(Unit* pCaster, uint32 spellId, SpellEffIndex effInde
 
 bool HookMgr::OnGossipHello(Player* pPlayer, Creature* pCreature)
 {
+    if (!Eluna::HasBindings(REGTYPE_CREATURE_GOSSIP, GOSSIP_EVENT_ON_HELLO))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->CreatureGossipBindings->GetBind(pCreature->GetEntry(), GOSSIP_EVENT_ON_HELLO);
     if (!bind)
         return false;
@@ -293,6 +361,9 @@ bool HookMgr::OnGossipHello(Player* pPlayer, Creature* pCreature)
 
 bool HookMgr::OnGossipSelect(Player* pPlayer, Creature* pCreature, uint32 sender, uint32 action)
 {
+    if (!Eluna::HasBindings(REGTYPE_CREATURE_GOSSIP, GOSSIP_EVENT_ON_SELECT))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->CreatureGossipBindings->GetBind(pCreature->GetEntry(), GOSSIP_EVENT_ON_SELECT);
     if (!bind)
         return false;
@@ -309,6 +380,9 @@ bool HookMgr::OnGossipSelect(Player* pPlayer, Creature* pCreature, uint32 sender
 
 bool HookMgr::OnGossipSelectCode(Player* pPlayer, Creature* pCreature, uint32 sender, uint32 action, const char* code)
 {
+    if (!Eluna::HasBindings(REGTYPE_CREATURE_GOSSIP, GOSSIP_EVENT_ON_SELECT))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->CreatureGossipBindings->GetBind(pCreature->GetEntry(), GOSSIP_EVENT_ON_SELECT);
     if (!bind)
         return false;
@@ -326,6 +400,9 @@ bool HookMgr::OnGossipSelectCode(Player* pPlayer, Creature* pCreature, uint32 se
 
 bool HookMgr::OnQuestAccept(Player* pPlayer, Creature* pCreature, Quest const* pQuest)
 {
+    if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_QUEST_ACCEPT))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->CreatureEventBindings->GetBind(pCreature->GetEntry(), CREATURE_EVENT_ON_QUEST_ACCEPT);
     if (!bind)
         return false;
@@ -340,6 +417,9 @@ bool HookMgr::OnQuestAccept(Player* pPlayer, Creature* pCreature, Quest const* p
 
 bool HookMgr::OnQuestSelect(Player* pPlayer, Creature* pCreature, Quest const* pQuest)
 {
+    if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_QUEST_SELECT))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->CreatureEventBindings->GetBind(pCreature->GetEntry(), CREATURE_EVENT_ON_QUEST_SELECT);
     if (!bind)
         return false;
@@ -354,6 +434,9 @@ bool HookMgr::OnQuestSelect(Player* pPlayer, Creature* pCreature, Quest const* p
 
 bool HookMgr::OnQuestComplete(Player* pPlayer, Creature* pCreature, Quest const* pQuest)
 {
+    if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_QUEST_COMPLETE))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->CreatureEventBindings->GetBind(pCreature->GetEntry(), CREATURE_EVENT_ON_QUEST_COMPLETE);
     if (!bind)
         return false;
@@ -368,6 +451,9 @@ bool HookMgr::OnQuestComplete(Player* pPlayer, Creature* pCreature, Quest const*
 
 bool HookMgr::OnQuestReward(Player* pPlayer, Creature* pCreature, Quest const* pQuest)
 {
+    if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_QUEST_REWARD))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->CreatureEventBindings->GetBind(pCreature->GetEntry(), CREATURE_EVENT_ON_QUEST_REWARD);
     if (!bind)
         return false;
@@ -382,6 +468,9 @@ bool HookMgr::OnQuestReward(Player* pPlayer, Creature* pCreature, Quest const* p
 
 Optional<QuestGiverStatus> HookMgr::GetDialogStatus(Player* pPlayer, Creature* pCreature)
 {
+    if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_DIALOG_STATUS))
+        return std::nullopt;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->CreatureEventBindings->GetBind(pCreature->GetEntry(), CREATURE_EVENT_ON_DIALOG_STATUS);
     if (!bind)
         return std::nullopt;
@@ -395,6 +484,9 @@ Optional<QuestGiverStatus> HookMgr::GetDialogStatus(Player* pPlayer, Creature* p
 // gameobject
 bool HookMgr::OnDummyEffect(Unit* pCaster, uint32 spellId, SpellEffIndex effIndex, GameObject* pTarget)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT, GAMEOBJECT_EVENT_ON_DUMMY_EFFECT))
+        return false;
+    ElunaStateGuard guard(pCaster);
     int bind = sEluna->GameObjectEventBindings->GetBind(pTarget->GetEntry(), GAMEOBJECT_EVENT_ON_DUMMY_EFFECT);
     if (!bind)
         return false;
@@ -410,6 +502,9 @@ bool HookMgr::OnDummyEffect(Unit* pCaster, uint32 spellId, SpellEffIndex effInde
 
 bool HookMgr::OnGossipHello(Player* pPlayer, GameObject* pGameObject)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT_GOSSIP, GOSSIP_EVENT_ON_HELLO))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->GameObjectGossipBindings->GetBind(pGameObject->GetEntry(), GOSSIP_EVENT_ON_HELLO);
     if (!bind)
         return false;
@@ -424,6 +519,9 @@ bool HookMgr::OnGossipHello(Player* pPlayer, GameObject* pGameObject)
 
 bool HookMgr::OnGossipSelect(Player* pPlayer, GameObject* pGameObject, uint32 sender, uint32 action)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT_GOSSIP, GOSSIP_EVENT_ON_SELECT))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->GameObjectGossipBindings->GetBind(pGameObject->GetEntry(), GOSSIP_EVENT_ON_SELECT);
     if (!bind)
         return false;
@@ -440,6 +538,9 @@ bool HookMgr::OnGossipSelect(Player* pPlayer, GameObject* pGameObject, uint32 se
 
 bool HookMgr::OnGossipSelectCode(Player* pPlayer, GameObject* pGameObject, uint32 sender, uint32 action, const char* code)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT_GOSSIP, GOSSIP_EVENT_ON_SELECT))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->GameObjectGossipBindings->GetBind(pGameObject->GetEntry(), GOSSIP_EVENT_ON_SELECT);
     if (!bind)
         return false;
@@ -457,6 +558,9 @@ bool HookMgr::OnGossipSelectCode(Player* pPlayer, GameObject* pGameObject, uint3
 
 bool HookMgr::OnQuestAccept(Player* pPlayer, GameObject* pGameObject, Quest const* pQuest)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT, GAMEOBJECT_EVENT_ON_QUEST_ACCEPT))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->GameObjectEventBindings->GetBind(pGameObject->GetEntry(), GAMEOBJECT_EVENT_ON_QUEST_ACCEPT);
     if (!bind)
         return false;
@@ -471,7 +575,10 @@ bool HookMgr::OnQuestAccept(Player* pPlayer, GameObject* pGameObject, Quest cons
 
 bool HookMgr::OnQuestComplete(Player* pPlayer, GameObject* pGameObject, Quest const* pQuest)
 {
-    int bind = sEluna->CreatureEventBindings->GetBind(pGameObject->GetEntry(), GAMEOBJECT_EVENT_ON_QUEST_COMPLETE);
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT, GAMEOBJECT_EVENT_ON_QUEST_COMPLETE))
+        return false;
+    ElunaStateGuard guard(pPlayer);
+    int bind = sEluna->GameObjectEventBindings->GetBind(pGameObject->GetEntry(), GAMEOBJECT_EVENT_ON_QUEST_COMPLETE);
     if (!bind)
         return false;
     sEluna->BeginCall(bind);
@@ -485,6 +592,9 @@ bool HookMgr::OnQuestComplete(Player* pPlayer, GameObject* pGameObject, Quest co
 
 bool HookMgr::OnQuestReward(Player* pPlayer, GameObject* pGameObject, Quest const* pQuest)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT, GAMEOBJECT_EVENT_ON_QUEST_REWARD))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->GameObjectEventBindings->GetBind(pGameObject->GetEntry(), GAMEOBJECT_EVENT_ON_QUEST_REWARD);
     if (!bind)
         return false;
@@ -499,6 +609,9 @@ bool HookMgr::OnQuestReward(Player* pPlayer, GameObject* pGameObject, Quest cons
 
 Optional<QuestGiverStatus> HookMgr::GetDialogStatus(Player* pPlayer, GameObject* pGameObject)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT, GAMEOBJECT_EVENT_ON_DIALOG_STATUS))
+        return std::nullopt;
+    ElunaStateGuard guard(pPlayer);
     int bind = sEluna->GameObjectEventBindings->GetBind(pGameObject->GetEntry(), GAMEOBJECT_EVENT_ON_DIALOG_STATUS);
     if (!bind)
         return std::nullopt;
@@ -512,6 +625,9 @@ Optional<QuestGiverStatus> HookMgr::GetDialogStatus(Player* pPlayer, GameObject*
 
 void HookMgr::OnDestroyed(GameObject* pGameObject, Player* pPlayer)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT, GAMEOBJECT_EVENT_ON_DESTROYED))
+        return;
+    ElunaStateGuard guard(pGameObject);
     int bind = sEluna->GameObjectEventBindings->GetBind(pGameObject->GetEntry(), GAMEOBJECT_EVENT_ON_DESTROYED);
     if (!bind)
         return;
@@ -524,6 +640,9 @@ void HookMgr::OnDestroyed(GameObject* pGameObject, Player* pPlayer)
 
 void HookMgr::OnDamaged(GameObject* pGameObject, Player* pPlayer)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT, GAMEOBJECT_EVENT_ON_DAMAGED))
+        return;
+    ElunaStateGuard guard(pGameObject);
     int bind = sEluna->GameObjectEventBindings->GetBind(pGameObject->GetEntry(), GAMEOBJECT_EVENT_ON_DAMAGED);
     if (!bind)
         return;
@@ -536,6 +655,9 @@ void HookMgr::OnDamaged(GameObject* pGameObject, Player* pPlayer)
 
 void HookMgr::OnLootStateChanged(GameObject* pGameObject, uint32 state, Unit* pUnit)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT, GAMEOBJECT_EVENT_ON_LOOT_STATE_CHANGE))
+        return;
+    ElunaStateGuard guard(pGameObject);
     int bind = sEluna->GameObjectEventBindings->GetBind(pGameObject->GetEntry(), GAMEOBJECT_EVENT_ON_LOOT_STATE_CHANGE);
     if (!bind)
         return;
@@ -549,6 +671,9 @@ void HookMgr::OnLootStateChanged(GameObject* pGameObject, uint32 state, Unit* pU
 
 void HookMgr::OnGameObjectStateChanged(GameObject* pGameObject, uint32 state)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT, GAMEOBJECT_EVENT_ON_GO_STATE_CHANGED))
+        return;
+    ElunaStateGuard guard(pGameObject);
     int bind = sEluna->GameObjectEventBindings->GetBind(pGameObject->GetEntry(), GAMEOBJECT_EVENT_ON_GO_STATE_CHANGED);
     if (!bind)
         return;
@@ -561,6 +686,9 @@ void HookMgr::OnGameObjectStateChanged(GameObject* pGameObject, uint32 state)
 // Player
 void HookMgr::OnPlayerJustEngagedWith(Player* pPlayer, Unit* pEnemy)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_ENTER_COMBAT))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_ENTER_COMBAT].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_ENTER_COMBAT].end(); ++itr)
     {
@@ -574,6 +702,9 @@ void HookMgr::OnPlayerJustEngagedWith(Player* pPlayer, Unit* pEnemy)
 
 void HookMgr::OnPlayerLeaveCombat(Player* pPlayer)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_LEAVE_COMBAT))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LEAVE_COMBAT].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LEAVE_COMBAT].end(); ++itr)
     {
@@ -586,6 +717,9 @@ void HookMgr::OnPlayerLeaveCombat(Player* pPlayer)
 
 void HookMgr::OnPVPKill(Player* pKiller, Player* pKilled)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_KILL_PLAYER))
+        return;
+    ElunaStateGuard guard(pKiller);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_KILL_PLAYER].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_KILL_PLAYER].end(); ++itr)
     {
@@ -599,6 +733,9 @@ void HookMgr::OnPVPKill(Player* pKiller, Player* pKilled)
 
 void HookMgr::OnCreatureKill(Player* pKiller, Creature* pKilled)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_KILL_CREATURE))
+        return;
+    ElunaStateGuard guard(pKiller);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_KILL_CREATURE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_KILL_CREATURE].end(); ++itr)
     {
@@ -612,6 +749,9 @@ void HookMgr::OnCreatureKill(Player* pKiller, Creature* pKilled)
 
 void HookMgr::OnPlayerKilledByCreature(Creature* pKiller, Player* pKilled)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_KILLED_BY_CREATURE))
+        return;
+    ElunaStateGuard guard(pKiller);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_KILLED_BY_CREATURE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_KILLED_BY_CREATURE].end(); ++itr)
     {
@@ -625,6 +765,9 @@ void HookMgr::OnPlayerKilledByCreature(Creature* pKiller, Player* pKilled)
 
 void HookMgr::OnLevelChanged(Player* pPlayer, uint8 oldLevel)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_LEVEL_CHANGE))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LEVEL_CHANGE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LEVEL_CHANGE].end(); ++itr)
     {
@@ -638,6 +781,9 @@ void HookMgr::OnLevelChanged(Player* pPlayer, uint8 oldLevel)
 
 void HookMgr::OnFreeTalentPointsChanged(Player* pPlayer, uint32 newPoints)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_TALENTS_CHANGE))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_TALENTS_CHANGE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_TALENTS_CHANGE].end(); ++itr)
     {
@@ -651,6 +797,9 @@ void HookMgr::OnFreeTalentPointsChanged(Player* pPlayer, uint32 newPoints)
 
 void HookMgr::OnTalentsReset(Player* pPlayer, bool noCost)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_TALENTS_RESET))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_TALENTS_RESET].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_TALENTS_RESET].end(); ++itr)
     {
@@ -664,6 +813,9 @@ void HookMgr::OnTalentsReset(Player* pPlayer, bool noCost)
 
 void HookMgr::OnMoneyChanged(Player* pPlayer, int64& amount)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_MONEY_CHANGE))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_MONEY_CHANGE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_MONEY_CHANGE].end(); ++itr)
     {
@@ -677,6 +829,9 @@ void HookMgr::OnMoneyChanged(Player* pPlayer, int64& amount)
 
 void HookMgr::OnGiveXP(Player* pPlayer, uint32& amount, Unit* pVictim)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_GIVE_XP))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_GIVE_XP].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_GIVE_XP].end(); ++itr)
     {
@@ -691,6 +846,9 @@ void HookMgr::OnGiveXP(Player* pPlayer, uint32& amount, Unit* pVictim)
 
 void HookMgr::OnReputationChange(Player* pPlayer, uint32 factionID, int32& standing, bool incremental)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_REPUTATION_CHANGE))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_REPUTATION_CHANGE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_REPUTATION_CHANGE].end(); ++itr)
     {
@@ -706,6 +864,9 @@ void HookMgr::OnReputationChange(Player* pPlayer, uint32 factionID, int32& stand
 
 void HookMgr::OnDuelRequest(Player* pTarget, Player* pChallenger)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_DUEL_REQUEST))
+        return;
+    ElunaStateGuard guard(pTarget);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_DUEL_REQUEST].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_DUEL_REQUEST].end(); ++itr)
     {
@@ -719,6 +880,9 @@ void HookMgr::OnDuelRequest(Player* pTarget, Player* pChallenger)
 
 void HookMgr::OnDuelStart(Player* pStarter, Player* pChallenger)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_DUEL_START))
+        return;
+    ElunaStateGuard guard(pStarter);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_DUEL_START].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_DUEL_START].end(); ++itr)
     {
@@ -732,6 +896,9 @@ void HookMgr::OnDuelStart(Player* pStarter, Player* pChallenger)
 
 void HookMgr::OnDuelEnd(Player* pWinner, Player* pLoser, DuelCompleteType type)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_DUEL_END))
+        return;
+    ElunaStateGuard guard(pWinner);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_DUEL_END].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_DUEL_END].end(); ++itr)
     {
@@ -746,6 +913,9 @@ void HookMgr::OnDuelEnd(Player* pWinner, Player* pLoser, DuelCompleteType type)
 
 void HookMgr::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg, Player* pReceiver)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_WHISPER))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_WHISPER].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_WHISPER].end(); ++itr)
     {
@@ -762,6 +932,9 @@ void HookMgr::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg
 
 void HookMgr::OnEmote(Player* pPlayer, uint32 emote)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_EMOTE))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_EMOTE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_EMOTE].end(); ++itr)
     {
@@ -775,6 +948,9 @@ void HookMgr::OnEmote(Player* pPlayer, uint32 emote)
 
 void HookMgr::OnTextEmote(Player* pPlayer, uint32 textEmote, uint32 emoteNum, uint64 guid)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_TEXT_EMOTE))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_TEXT_EMOTE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_TEXT_EMOTE].end(); ++itr)
     {
@@ -790,6 +966,9 @@ void HookMgr::OnTextEmote(Player* pPlayer, uint32 textEmote, uint32 emoteNum, ui
 
 void HookMgr::OnSpellCast(Player* pPlayer, Spell* pSpell, bool skipCheck)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_SPELL_CAST))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_SPELL_CAST].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_SPELL_CAST].end(); ++itr)
     {
@@ -804,6 +983,9 @@ void HookMgr::OnSpellCast(Player* pPlayer, Spell* pSpell, bool skipCheck)
 
 void HookMgr::OnLogin(Player* pPlayer)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_LOGIN))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LOGIN].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LOGIN].end(); ++itr)
     {
@@ -816,6 +998,9 @@ void HookMgr::OnLogin(Player* pPlayer)
 
 void HookMgr::OnLogout(Player* pPlayer)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_LOGOUT))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LOGOUT].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_LOGOUT].end(); ++itr)
     {
@@ -828,6 +1013,9 @@ void HookMgr::OnLogout(Player* pPlayer)
 
 void HookMgr::OnCreate(Player* pPlayer)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_CHARACTER_CREATE))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_CHARACTER_CREATE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_CHARACTER_CREATE].end(); ++itr)
     {
@@ -840,6 +1028,9 @@ void HookMgr::OnCreate(Player* pPlayer)
 
 void HookMgr::OnDelete(uint32 guidlow)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_CHARACTER_DELETE))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_CHARACTER_DELETE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_CHARACTER_DELETE].end(); ++itr)
     {
@@ -852,6 +1043,9 @@ void HookMgr::OnDelete(uint32 guidlow)
 
 void HookMgr::OnSave(Player* pPlayer)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_SAVE))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_SAVE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_SAVE].end(); ++itr)
     {
@@ -864,6 +1058,9 @@ void HookMgr::OnSave(Player* pPlayer)
 
 void HookMgr::OnBindToInstance(Player* pPlayer, Difficulty difficulty, uint32 mapid, bool permanent)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_BIND_TO_INSTANCE))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_BIND_TO_INSTANCE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_BIND_TO_INSTANCE].end(); ++itr)
     {
@@ -879,6 +1076,9 @@ void HookMgr::OnBindToInstance(Player* pPlayer, Difficulty difficulty, uint32 ma
 
 void HookMgr::OnUpdateZone(Player* pPlayer, uint32 newZone, uint32 newArea)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_UPDATE_ZONE))
+        return;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_UPDATE_ZONE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_UPDATE_ZONE].end(); ++itr)
     {
@@ -893,6 +1093,9 @@ void HookMgr::OnUpdateZone(Player* pPlayer, uint32 newZone, uint32 newArea)
 
 void HookMgr::OnMapChanged(Player* player)
 {
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_MAP_CHANGE))
+        return;
+    ElunaStateGuard guard(player);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_MAP_CHANGE].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_MAP_CHANGE].end(); ++itr)
     {
@@ -906,6 +1109,9 @@ void HookMgr::OnMapChanged(Player* player)
 bool HookMgr::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg)
 {
     bool Result = true;
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_CHAT))
+        return Result;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_CHAT].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_CHAT].end(); ++itr)
     {
@@ -929,6 +1135,9 @@ bool HookMgr::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg
 bool HookMgr::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg, Group* pGroup)
 {
     bool Result = true;
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_GROUP_CHAT))
+        return Result;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_GROUP_CHAT].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_GROUP_CHAT].end(); ++itr)
     {
@@ -953,6 +1162,9 @@ bool HookMgr::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg
 bool HookMgr::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg, Guild* pGuild)
 {
     bool Result = true;
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_GUILD_CHAT))
+        return Result;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_GUILD_CHAT].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_GUILD_CHAT].end(); ++itr)
     {
@@ -977,6 +1189,9 @@ bool HookMgr::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg
 bool HookMgr::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg, Channel* pChannel)
 {
     bool Result = true;
+    if (!Eluna::HasBindings(REGTYPE_PLAYER, PLAYER_EVENT_ON_CHANNEL_CHAT))
+        return Result;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->PlayerEventBindings[PLAYER_EVENT_ON_CHANNEL_CHAT].begin();
         itr != sEluna->PlayerEventBindings[PLAYER_EVENT_ON_CHANNEL_CHAT].end(); ++itr)
     {
@@ -1000,6 +1215,9 @@ bool HookMgr::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg
 // Vehicle
 void HookMgr::OnInstall(Vehicle* vehicle)
 {
+    if (!Eluna::HasBindings(REGTYPE_VEHICLE, VEHICLE_EVENT_ON_INSTALL))
+        return;
+    ElunaStateGuard guard(vehicle->GetBase());
     for (std::vector<int>::const_iterator itr = sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_INSTALL].begin();
         itr != sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_INSTALL].end(); ++itr)
     {
@@ -1012,6 +1230,9 @@ void HookMgr::OnInstall(Vehicle* vehicle)
 
 void HookMgr::OnUninstall(Vehicle* vehicle)
 {
+    if (!Eluna::HasBindings(REGTYPE_VEHICLE, VEHICLE_EVENT_ON_UNINSTALL))
+        return;
+    ElunaStateGuard guard(vehicle->GetBase());
     for (std::vector<int>::const_iterator itr = sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_UNINSTALL].begin();
         itr != sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_UNINSTALL].end(); ++itr)
     {
@@ -1024,6 +1245,9 @@ void HookMgr::OnUninstall(Vehicle* vehicle)
 
 void HookMgr::OnReset(Vehicle* vehicle)
 {
+    if (!Eluna::HasBindings(REGTYPE_VEHICLE, VEHICLE_EVENT_ON_RESET))
+        return;
+    ElunaStateGuard guard(vehicle->GetBase());
     for (std::vector<int>::const_iterator itr = sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_RESET].begin();
         itr != sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_RESET].end(); ++itr)
     {
@@ -1036,6 +1260,9 @@ void HookMgr::OnReset(Vehicle* vehicle)
 
 void HookMgr::OnInstallAccessory(Vehicle* vehicle, Creature* accessory)
 {
+    if (!Eluna::HasBindings(REGTYPE_VEHICLE, VEHICLE_EVENT_ON_INSTALL_ACCESSORY))
+        return;
+    ElunaStateGuard guard(accessory);
     for (std::vector<int>::const_iterator itr = sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_INSTALL_ACCESSORY].begin();
         itr != sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_INSTALL_ACCESSORY].end(); ++itr)
     {
@@ -1049,6 +1276,9 @@ void HookMgr::OnInstallAccessory(Vehicle* vehicle, Creature* accessory)
 
 void HookMgr::OnAddPassenger(Vehicle* vehicle, Unit* passenger, int8 seatId)
 {
+    if (!Eluna::HasBindings(REGTYPE_VEHICLE, VEHICLE_EVENT_ON_ADD_PASSENGER))
+        return;
+    ElunaStateGuard guard(passenger);
     for (std::vector<int>::const_iterator itr = sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_ADD_PASSENGER].begin();
         itr != sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_ADD_PASSENGER].end(); ++itr)
     {
@@ -1063,6 +1293,9 @@ void HookMgr::OnAddPassenger(Vehicle* vehicle, Unit* passenger, int8 seatId)
 
 void HookMgr::OnRemovePassenger(Vehicle* vehicle, Unit* passenger)
 {
+    if (!Eluna::HasBindings(REGTYPE_VEHICLE, VEHICLE_EVENT_ON_REMOVE_PASSENGER))
+        return;
+    ElunaStateGuard guard(passenger);
     for (std::vector<int>::const_iterator itr = sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_REMOVE_PASSENGER].begin();
         itr != sEluna->VehicleEventBindings[VEHICLE_EVENT_ON_REMOVE_PASSENGER].end(); ++itr)
     {
@@ -1077,6 +1310,9 @@ void HookMgr::OnRemovePassenger(Vehicle* vehicle, Unit* passenger)
 // areatrigger
 bool HookMgr::OnAreaTrigger(Player* pPlayer, AreaTriggerEntry const* pTrigger, bool entered)
 {
+    if (!Eluna::HasBindings(REGTYPE_SERVER, TRIGGER_EVENT_ON_TRIGGER))
+        return false;
+    ElunaStateGuard guard(pPlayer);
     for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[TRIGGER_EVENT_ON_TRIGGER].begin();
         itr != sEluna->ServerEventBindings[TRIGGER_EVENT_ON_TRIGGER].end(); ++itr)
     {
@@ -1092,6 +1328,9 @@ bool HookMgr::OnAreaTrigger(Player* pPlayer, AreaTriggerEntry const* pTrigger, b
 // weather
 void HookMgr::OnChange(Weather* weather, WeatherState state, float grade)
 {
+    if (!Eluna::HasBindings(REGTYPE_SERVER, WEATHER_EVENT_ON_CHANGE))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WEATHER_EVENT_ON_CHANGE].begin();
         itr != sEluna->ServerEventBindings[WEATHER_EVENT_ON_CHANGE].end(); ++itr)
     {
@@ -1119,6 +1358,9 @@ void HookMgr::OnRelocate(Transport* transport, uint32 waypointId, uint32 mapId,
 // Auction House
 void HookMgr::OnAdd(AuctionHouseObject* ah)
 {
+    if (!Eluna::HasBindings(REGTYPE_SERVER, AUCTION_EVENT_ON_ADD))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[AUCTION_EVENT_ON_ADD].begin();
         itr != sEluna->ServerEventBindings[AUCTION_EVENT_ON_ADD].end(); ++itr)
     {
@@ -1131,6 +1373,9 @@ void HookMgr::OnAdd(AuctionHouseObject* ah)
 
 void HookMgr::OnRemove(AuctionHouseObject* ah)
 {
+    if (!Eluna::HasBindings(REGTYPE_SERVER, AUCTION_EVENT_ON_REMOVE))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[AUCTION_EVENT_ON_REMOVE].begin();
         itr != sEluna->ServerEventBindings[AUCTION_EVENT_ON_REMOVE].end(); ++itr)
     {
@@ -1143,6 +1388,9 @@ void HookMgr::OnRemove(AuctionHouseObject* ah)
 
 void HookMgr::OnSuccessful(AuctionHouseObject* ah)
 {
+    if (!Eluna::HasBindings(REGTYPE_SERVER, AUCTION_EVENT_ON_SUCCESSFUL))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[AUCTION_EVENT_ON_SUCCESSFUL].begin();
         itr != sEluna->ServerEventBindings[AUCTION_EVENT_ON_SUCCESSFUL].end(); ++itr)
     {
@@ -1155,6 +1403,9 @@ void HookMgr::OnSuccessful(AuctionHouseObject* ah)
 
 void HookMgr::OnExpire(AuctionHouseObject* ah)
 {
+    if (!Eluna::HasBindings(REGTYPE_SERVER, AUCTION_EVENT_ON_EXPIRE))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[AUCTION_EVENT_ON_EXPIRE].begin();
         itr != sEluna->ServerEventBindings[AUCTION_EVENT_ON_EXPIRE].end(); ++itr)
     {
@@ -1173,6 +1424,9 @@ public:
 
     void OnOpenStateChange(bool open) override
     {
+        if (!Eluna::HasBindings(REGTYPE_SERVER, WORLD_EVENT_ON_OPEN_STATE_CHANGE))
+            return;
+        ElunaStateGuard guard;
         for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WORLD_EVENT_ON_OPEN_STATE_CHANGE].begin();
             itr != sEluna->ServerEventBindings[WORLD_EVENT_ON_OPEN_STATE_CHANGE].end(); ++itr)
         {
@@ -1185,6 +1439,9 @@ public:
 
     void OnConfigLoad(bool reload) override
     {
+        if (!Eluna::HasBindings(REGTYPE_SERVER, WORLD_EVENT_ON_CONFIG_LOAD))
+            return;
+        ElunaStateGuard guard;
         for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WORLD_EVENT_ON_CONFIG_LOAD].begin();
             itr != sEluna->ServerEventBindings[WORLD_EVENT_ON_CONFIG_LOAD].end(); ++itr)
         {
@@ -1197,6 +1454,9 @@ public:
 
     void OnMotdChange(std::string& newMotd) override
     {
+        if (!Eluna::HasBindings(REGTYPE_SERVER, WORLD_EVENT_ON_MOTD_CHANGE))
+            return;
+        ElunaStateGuard guard;
         for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WORLD_EVENT_ON_MOTD_CHANGE].begin();
             itr != sEluna->ServerEventBindings[WORLD_EVENT_ON_MOTD_CHANGE].end(); ++itr)
         {
@@ -1209,6 +1469,9 @@ public:
 
     void OnShutdownInitiate(ShutdownExitCode code, ShutdownMask mask) override
     {
+        if (!Eluna::HasBindings(REGTYPE_SERVER, WORLD_EVENT_ON_SHUTDOWN_INIT))
+            return;
+        ElunaStateGuard guard;
         for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WORLD_EVENT_ON_SHUTDOWN_INIT].begin();
             itr != sEluna->ServerEventBindings[WORLD_EVENT_ON_SHUTDOWN_INIT].end(); ++itr)
         {
@@ -1222,6 +1485,9 @@ public:
 
     void OnShutdownCancel() override
     {
+        if (!Eluna::HasBindings(REGTYPE_SERVER, WORLD_EVENT_ON_SHUTDOWN_CANCEL))
+            return;
+        ElunaStateGuard guard;
         for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WORLD_EVENT_ON_SHUTDOWN_CANCEL].begin();
             itr != sEluna->ServerEventBindings[WORLD_EVENT_ON_SHUTDOWN_CANCEL].end(); ++itr)
         {
@@ -1233,7 +1499,10 @@ public:
 
     void OnUpdate(uint32 diff) override
     {
-        sEluna->m_EventMgr.Update(diff);
+        ElunaStateGuard guard;
+        sEluna->Update(diff);
+        if (!Eluna::HasBindings(REGTYPE_SERVER, WORLD_EVENT_ON_UPDATE))
+            return;
         for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WORLD_EVENT_ON_UPDATE].begin();
             itr != sEluna->ServerEventBindings[WORLD_EVENT_ON_UPDATE].end(); ++itr)
         {
@@ -1246,6 +1515,7 @@ public:
     // executed when a  timed event fires
     void OnScriptEvent(int funcRef, uint32 delay, uint32 calls)
     {
+        ElunaStateGuard guard;
         sEluna->BeginCall(funcRef);
         sEluna->Push(sEluna->L, funcRef);
         sEluna->Push(sEluna->L, delay);
@@ -1255,6 +1525,9 @@ public:
 
     void OnStartup() override
     {
+        if (!Eluna::HasBindings(REGTYPE_SERVER, WORLD_EVENT_ON_STARTUP))
+            return;
+        ElunaStateGuard guard;
         for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WORLD_EVENT_ON_STARTUP].begin();
             itr != sEluna->ServerEventBindings[WORLD_EVENT_ON_STARTUP].end(); ++itr)
         {
@@ -1266,6 +1539,9 @@ public:
 
     void OnShutdown() override
     {
+        if (!Eluna::HasBindings(REGTYPE_SERVER, WORLD_EVENT_ON_SHUTDOWN))
+            return;
+        ElunaStateGuard guard;
         for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WORLD_EVENT_ON_SHUTDOWN].begin();
             itr != sEluna->ServerEventBindings[WORLD_EVENT_ON_SHUTDOWN].end(); ++itr)
         {
@@ -1285,6 +1561,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void UpdateAI(uint32 diff) override
     {
         ScriptedAI::UpdateAI(diff);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_AIUPDATE))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_AIUPDATE);
         if (!bind)
             return;
@@ -1300,6 +1579,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void JustEngagedWith(Unit* target) override
     {
         ScriptedAI::JustEngagedWith(target);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_ENTER_COMBAT))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_ENTER_COMBAT);
         if (!bind)
             return;
@@ -1314,6 +1596,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void DamageTaken(Unit* attacker, uint32& damage) override
     {
         ScriptedAI::DamageTaken(attacker, damage);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_DAMAGE_TAKEN))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_DAMAGE_TAKEN);
         if (!bind)
             return;
@@ -1329,6 +1614,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void JustDied(Unit* killer) override
     {
         ScriptedAI::JustDied(killer);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_DIED))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_DIED);
         if (!bind)
             return;
@@ -1343,6 +1631,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void KilledUnit(Unit* victim) override
     {
         ScriptedAI::KilledUnit(victim);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_TARGET_DIED))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_TARGET_DIED);
         if (!bind)
             return;
@@ -1357,6 +1648,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void JustSummoned(Creature* summon) override
     {
         ScriptedAI::JustSummoned(summon);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_JUST_SUMMONED_CREATURE))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_JUST_SUMMONED_CREATURE);
         if (!bind)
             return;
@@ -1371,6 +1665,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void SummonedCreatureDespawn(Creature* summon) override
     {
         ScriptedAI::SummonedCreatureDespawn(summon);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_SUMMONED_CREATURE_DESPAWN))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_SUMMONED_CREATURE_DESPAWN);
         if (!bind)
             return;
@@ -1385,6 +1682,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void SpellHit(Unit* caster, SpellInfo const* spell) override
     {
         ScriptedAI::SpellHit(caster, spell);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_HIT_BY_SPELL))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_HIT_BY_SPELL);
         if (!bind)
             return;
@@ -1400,6 +1700,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void SpellHitTarget(Unit* target, SpellInfo const* spell) override
     {
         ScriptedAI::SpellHitTarget(target, spell);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_SPELL_HIT_TARGET))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_SPELL_HIT_TARGET);
         if (!bind)
             return;
@@ -1415,6 +1718,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void MovementInform(uint32 type, uint32 id) override
     {
         ScriptedAI::MovementInform(type, id);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_REACH_WP))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_REACH_WP);
         if (!bind)
             return;
@@ -1430,6 +1736,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void OnPossess(bool apply)
     {
         ScriptedAI::OnPossess(apply);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_POSSESS))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_POSSESS);
         if (!bind)
             return;
@@ -1444,6 +1753,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void Reset() override
     {
         ScriptedAI::Reset();
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_RESET))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_RESET);
         if (!bind)
             return;
@@ -1457,6 +1769,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void AttackStart(Unit* target) override
     {
         ScriptedAI::AttackStart(target);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_PRE_COMBAT))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_PRE_COMBAT);
         if (!bind)
             return;
@@ -1471,6 +1786,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     bool CanRespawn() override
     {
         ScriptedAI::CanRespawn();
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_CAN_RESPAWN))
+            return true;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_CAN_RESPAWN);
         if (!bind)
             return true;
@@ -1485,6 +1803,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void EnterEvadeMode() override
     {
         ScriptedAI::EnterEvadeMode();
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_LEAVE_COMBAT))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_LEAVE_COMBAT);
         if (!bind)
             return;
@@ -1498,6 +1819,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void IsSummonedBy(Unit* summoner) override
     {
         ScriptedAI::IsSummonedBy(summoner);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_SUMMONED))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_SUMMONED);
         if (!bind)
             return;
@@ -1511,6 +1835,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void SummonedCreatureDies(Creature* summon, Unit* killer) override
     {
         ScriptedAI::SummonedCreatureDies(summon, killer);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_SUMMONED_CREATURE_DIED))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_SUMMONED_CREATURE_DIED);
         if (!bind)
             return;
@@ -1527,6 +1854,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     {
         /*
         ScriptedAI::AttackedBy(attacker);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_ATTACKED_AT))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_ATTACKED_AT);
         if (!bind)
             return;
@@ -1542,6 +1872,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void JustRespawned() override
     {
         ScriptedAI::JustRespawned();
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_SPAWN))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_SPAWN);
         if (!bind)
             return;
@@ -1554,6 +1887,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void OnCharmed(bool apply) override
     {
         ScriptedAI::OnCharmed(apply);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_CHARMED))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_CHARMED);
         if (!bind)
             return;
@@ -1568,6 +1904,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void JustReachedHome() override
     {
         ScriptedAI::JustReachedHome();
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_REACH_HOME))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_REACH_HOME);
         if (!bind)
             return;
@@ -1581,6 +1920,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void ReceiveEmote(Player* player, uint32 emoteId) override
     {
         ScriptedAI::ReceiveEmote(player, emoteId);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_RECEIVE_EMOTE))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_RECEIVE_EMOTE);
         if (!bind)
             return;
@@ -1597,6 +1939,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     {
         /*
         ScriptedAI::OwnerAttackedBy(attacker);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_OWNER_ATTACKED_AT))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_OWNER_ATTACKED_AT);
         if (!bind)
             return;
@@ -1612,6 +1957,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void OwnerAttacked(Unit* target) override
     {
         ScriptedAI::OwnerAttacked(target);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_OWNER_ATTACKED))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_OWNER_ATTACKED);
         if (!bind)
             return;
@@ -1626,6 +1974,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void CorpseRemoved(uint32& respawnDelay) override
     {
         ScriptedAI::CorpseRemoved(respawnDelay);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_CORPSE_REMOVED))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_CORPSE_REMOVED);
         if (!bind)
             return;
@@ -1639,6 +1990,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void PassengerBoarded(Unit* passenger, int8 seatId, bool apply) override
     {
         ScriptedAI::PassengerBoarded(passenger, seatId, apply);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_PASSANGER_BOARDED))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_PASSANGER_BOARDED);
         if (!bind)
             return;
@@ -1655,6 +2009,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     {
         /*
         ScriptedAI::OnSpellClick(clicker, result);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_SPELL_CLICK))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_SPELL_CLICK);
         if (!bind)
             return;
@@ -1670,6 +2027,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void MoveInLineOfSight(Unit* who) override
     {
         ScriptedAI::MoveInLineOfSight(who);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_MOVE_IN_LOS))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_MOVE_IN_LOS);
         if (!bind)
             return;
@@ -1684,6 +2044,9 @@ struct HookMgr::ElunaCreatureAI : ScriptedAI
     void MoveInLineOfSight_Safe(Unit* who)
     {
         ScriptedAI::MoveInLineOfSight_Safe(who);
+        if (!Eluna::HasBindings(REGTYPE_CREATURE, CREATURE_EVENT_ON_VISIBLE_MOVE_IN_LOS))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->CreatureEventBindings->GetBind(me->GetEntry(), CREATURE_EVENT_ON_VISIBLE_MOVE_IN_LOS);
         if (!bind)
             return;
@@ -1704,6 +2067,9 @@ struct HookMgr::ElunaGameObjectAI : public GameObjectAI
 
     void UpdateAI(uint32 diff) override
     {
+        if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT, GAMEOBJECT_EVENT_ON_AIUPDATE))
+            return;
+        ElunaStateGuard guard(me);
         int bind = sEluna->GameObjectEventBindings->GetBind(me->GetEntry(), GAMEOBJECT_EVENT_ON_AIUPDATE);
         if (!bind)
             return;
@@ -1717,6 +2083,7 @@ struct HookMgr::ElunaGameObjectAI : public GameObjectAI
     // executed when a timed event fires
     void OnScriptEvent(int funcRef, uint32 delay, uint32 calls) 
     {
+        ElunaStateGuard guard(me);
         sEluna->BeginCall(funcRef);
         sEluna->Push(sEluna->L, funcRef);
         sEluna->Push(sEluna->L, delay);
@@ -1727,6 +2094,9 @@ struct HookMgr::ElunaGameObjectAI : public GameObjectAI
 
     void Reset() override
     {
+        if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT, GAMEOBJECT_EVENT_ON_RESET))
+            return;
+        ElunaStateGuard guard(me);
         sEluna->BeginCall(sEluna->GameObjectEventBindings->GetBind(me->GetEntry(), GAMEOBJECT_EVENT_ON_RESET));
         sEluna->Push(sEluna->L, GAMEOBJECT_EVENT_ON_RESET);
         sEluna->Push(sEluna->L, me);
@@ -1736,6 +2106,9 @@ struct HookMgr::ElunaGameObjectAI : public GameObjectAI
 
 void HookMgr::OnAddMember(Guild* guild, Player* player, uint32 plRank)
 {
+    if (!Eluna::HasBindings(REGTYPE_GUILD, GUILD_EVENT_ON_ADD_MEMBER))
+        return;
+    ElunaStateGuard guard(player);
     for (std::vector<int>::const_iterator itr = sEluna->GuildEventBindings[GUILD_EVENT_ON_ADD_MEMBER].begin();
         itr != sEluna->GuildEventBindings[GUILD_EVENT_ON_ADD_MEMBER].end(); ++itr)
     {
@@ -1750,6 +2123,9 @@ void HookMgr::OnAddMember(Guild* guild, Player* player, uint32 plRank)
 
 void HookMgr::OnRemoveMember(Guild* guild, Player* player, bool isDisbanding, bool isKicked) // IsKicked not a part of Mangos, implement?
 {
+    if (!Eluna::HasBindings(REGTYPE_GUILD, GUILD_EVENT_ON_REMOVE_MEMBER))
+        return;
+    ElunaStateGuard guard(player);
     for (std::vector<int>::const_iterator itr = sEluna->GuildEventBindings[GUILD_EVENT_ON_REMOVE_MEMBER].begin();
         itr != sEluna->GuildEventBindings[GUILD_EVENT_ON_REMOVE_MEMBER].end(); ++itr)
     {
@@ -1765,6 +2141,9 @@ void HookMgr::OnRemoveMember(Guild* guild, Player* player, bool isDisbanding, bo
 
 void HookMgr::OnMOTDChanged(Guild* guild, const std::string& newMotd)
 {
+    if (!Eluna::HasBindings(REGTYPE_GUILD, GUILD_EVENT_ON_MOTD_CHANGE))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->GuildEventBindings[GUILD_EVENT_ON_MOTD_CHANGE].begin();
         itr != sEluna->GuildEventBindings[GUILD_EVENT_ON_MOTD_CHANGE].end(); ++itr)
     {
@@ -1778,6 +2157,9 @@ void HookMgr::OnMOTDChanged(Guild* guild, const std::string& newMotd)
 
 void HookMgr::OnInfoChanged(Guild* guild, const std::string& newInfo)
 {
+    if (!Eluna::HasBindings(REGTYPE_GUILD, GUILD_EVENT_ON_INFO_CHANGE))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->GuildEventBindings[GUILD_EVENT_ON_INFO_CHANGE].begin();
         itr != sEluna->GuildEventBindings[GUILD_EVENT_ON_INFO_CHANGE].end(); ++itr)
     {
@@ -1791,6 +2173,9 @@ void HookMgr::OnInfoChanged(Guild* guild, const std::string& newInfo)
 
 void HookMgr::OnCreate(Guild* guild, Player* leader, const std::string& name)
 {
+    if (!Eluna::HasBindings(REGTYPE_GUILD, GUILD_EVENT_ON_CREATE))
+        return;
+    ElunaStateGuard guard(leader);
     for (std::vector<int>::const_iterator itr = sEluna->GuildEventBindings[GUILD_EVENT_ON_CREATE].begin();
         itr != sEluna->GuildEventBindings[GUILD_EVENT_ON_CREATE].end(); ++itr)
     {
@@ -1805,6 +2190,9 @@ void HookMgr::OnCreate(Guild* guild, Player* leader, const std::string& name)
 
 void HookMgr::OnDisband(Guild* guild)
 {
+    if (!Eluna::HasBindings(REGTYPE_GUILD, GUILD_EVENT_ON_DISBAND))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->GuildEventBindings[GUILD_EVENT_ON_DISBAND].begin();
         itr != sEluna->GuildEventBindings[GUILD_EVENT_ON_DISBAND].end(); ++itr)
     {
@@ -1817,6 +2205,9 @@ void HookMgr::OnDisband(Guild* guild)
 
 void HookMgr::OnMemberWitdrawMoney(Guild* guild, Player* player, uint64 &amount, bool isRepair) // isRepair not a part of Mangos, implement?
 {
+    if (!Eluna::HasBindings(REGTYPE_GUILD, GUILD_EVENT_ON_MONEY_WITHDRAW))
+        return;
+    ElunaStateGuard guard(player);
     for (std::vector<int>::const_iterator itr = sEluna->GuildEventBindings[GUILD_EVENT_ON_MONEY_WITHDRAW].begin();
         itr != sEluna->GuildEventBindings[GUILD_EVENT_ON_MONEY_WITHDRAW].end(); ++itr)
     {
@@ -1832,6 +2223,9 @@ void HookMgr::OnMemberWitdrawMoney(Guild* guild, Player* player, uint64 &amount,
 
 void HookMgr::OnMemberDepositMoney(Guild* guild, Player* player, uint64 &amount)
 {
+    if (!Eluna::HasBindings(REGTYPE_GUILD, GUILD_EVENT_ON_MONEY_DEPOSIT))
+        return;
+    ElunaStateGuard guard(player);
     for (std::vector<int>::const_iterator itr = sEluna->GuildEventBindings[GUILD_EVENT_ON_MONEY_DEPOSIT].begin();
         itr != sEluna->GuildEventBindings[GUILD_EVENT_ON_MONEY_DEPOSIT].end(); ++itr)
     {
@@ -1847,6 +2241,9 @@ void HookMgr::OnMemberDepositMoney(Guild* guild, Player* player, uint64 &amount)
 void HookMgr::OnItemMove(Guild* guild, Player* player, Item* pItem, bool isSrcBank, uint8 srcContainer, uint8 srcSlotId,
                 bool isDestBank, uint8 destContainer, uint8 destSlotId)
 {
+    if (!Eluna::HasBindings(REGTYPE_GUILD, GUILD_EVENT_ON_ITEM_MOVE))
+        return;
+    ElunaStateGuard guard(player);
     for (std::vector<int>::const_iterator itr = sEluna->GuildEventBindings[GUILD_EVENT_ON_ITEM_MOVE].begin();
         itr != sEluna->GuildEventBindings[GUILD_EVENT_ON_ITEM_MOVE].end(); ++itr)
     {
@@ -1867,6 +2264,9 @@ void HookMgr::OnItemMove(Guild* guild, Player* player, Item* pItem, bool isSrcBa
 
 void HookMgr::OnEvent(Guild* guild, uint8 eventType, uint32 playerGuid1, uint32 playerGuid2, uint8 newRank)
 {
+    if (!Eluna::HasBindings(REGTYPE_GUILD, GUILD_EVENT_ON_EVENT))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->GuildEventBindings[GUILD_EVENT_ON_EVENT].begin();
         itr != sEluna->GuildEventBindings[GUILD_EVENT_ON_EVENT].end(); ++itr)
     {
@@ -1883,6 +2283,9 @@ void HookMgr::OnEvent(Guild* guild, uint8 eventType, uint32 playerGuid1, uint32
 
 void HookMgr::OnBankEvent(Guild* guild, uint8 eventType, uint8 tabId, uint32 playerGuid, uint32 itemOrMoney, uint16 itemStackCount, uint8 destTabId)
 {
+    if (!Eluna::HasBindings(REGTYPE_GUILD, GUILD_EVENT_ON_BANK_EVENT))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->GuildEventBindings[GUILD_EVENT_ON_BANK_EVENT].begin();
         itr != sEluna->GuildEventBindings[GUILD_EVENT_ON_BANK_EVENT].end(); ++itr)
     {
@@ -1901,6 +2304,9 @@ void HookMgr::OnBankEvent(Guild* guild, uint8 eventType, uint8 tabId, uint32 pla
 // Group
 void HookMgr::OnAddMember(Group* group, uint64 guid)
 {
+    if (!Eluna::HasBindings(REGTYPE_GROUP, GROUP_EVENT_ON_MEMBER_ADD))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->GroupEventBindings[GROUP_EVENT_ON_MEMBER_ADD].begin();
         itr != sEluna->GroupEventBindings[GROUP_EVENT_ON_MEMBER_ADD].end(); ++itr)
     {
@@ -1914,6 +2320,9 @@ void HookMgr::OnAddMember(Group* group, uint64 guid)
 
 void HookMgr::OnInviteMember(Group* group, uint64 guid)
 {
+    if (!Eluna::HasBindings(REGTYPE_GROUP, GROUP_EVENT_ON_MEMBER_INVITE))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->GroupEventBindings[GROUP_EVENT_ON_MEMBER_INVITE].begin();
         itr != sEluna->GroupEventBindings[GROUP_EVENT_ON_MEMBER_INVITE].end(); ++itr)
     {
@@ -1927,6 +2336,9 @@ void HookMgr::OnInviteMember(Group* group, uint64 guid)
 
 void HookMgr::OnRemoveMember(Group* group, uint64 guid, uint8 method, uint64 kicker, const char* reason) // Kicker and Reason not a part of Mangos, implement?
 {
+    if (!Eluna::HasBindings(REGTYPE_GROUP, GROUP_EVENT_ON_MEMBER_REMOVE))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->GroupEventBindings[GROUP_EVENT_ON_MEMBER_REMOVE].begin();
         itr != sEluna->GroupEventBindings[GROUP_EVENT_ON_MEMBER_REMOVE].end(); ++itr)
     {
@@ -1943,6 +2355,9 @@ void HookMgr::OnRemoveMember(Group* group, uint64 guid, uint8 method, uint64 kic
 
 void HookMgr::OnChangeLeader(Group* group, uint64 newLeaderGuid, uint64 oldLeaderGuid)
 {
+    if (!Eluna::HasBindings(REGTYPE_GROUP, GROUP_EVENT_ON_LEADER_CHANGE))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->GroupEventBindings[GROUP_EVENT_ON_LEADER_CHANGE].begin();
         itr != sEluna->GroupEventBindings[GROUP_EVENT_ON_LEADER_CHANGE].end(); ++itr)
     {
@@ -1957,6 +2372,9 @@ void HookMgr::OnChangeLeader(Group* group, uint64 newLeaderGuid, uint64 oldLeade
 
 void HookMgr::OnDisband(Group* group)
 {
+    if (!Eluna::HasBindings(REGTYPE_GROUP, GROUP_EVENT_ON_DISBAND))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->GroupEventBindings[GROUP_EVENT_ON_DISBAND].begin();
         itr != sEluna->GroupEventBindings[GROUP_EVENT_ON_DISBAND].end(); ++itr)
     {
@@ -1969,6 +2387,9 @@ void HookMgr::OnDisband(Group* group)
 
 void HookMgr::OnCreate(Group* group, uint64 leaderGuid, GroupType groupType)
 {
+    if (!Eluna::HasBindings(REGTYPE_GROUP, GROUP_EVENT_ON_CREATE))
+        return;
+    ElunaStateGuard guard;
     for (std::vector<int>::const_iterator itr = sEluna->GroupEventBindings[GROUP_EVENT_ON_CREATE].begin();
         itr != sEluna->GroupEventBindings[GROUP_EVENT_ON_CREATE].end(); ++itr)
     {
@@ -1983,6 +2404,9 @@ void HookMgr::OnCreate(Group* group, uint64 leaderGuid, GroupType groupType)
 
 CreatureAI* HookMgr::GetAI(Creature* creature)
 {
+    if (!Eluna::HasBindings(REGTYPE_CREATURE))
+        return NULL;
+    ElunaStateGuard guard(creature);
     if (!sEluna->CreatureEventBindings->GetBindMap(creature->GetEntry()))
         return NULL;
     return new ElunaCreatureAI(creature);
@@ -1990,6 +2414,9 @@ CreatureAI* HookMgr::GetAI(Creature* creature)
 
 GameObjectAI* HookMgr::GetAI(GameObject* gameObject)
 {
+    if (!Eluna::HasBindings(REGTYPE_GAMEOBJECT))
+        return NULL;
+    ElunaStateGuard guard(gameObject);
     if (!sEluna->GameObjectEventBindings->GetBindMap(gameObject->GetEntry()))
         return NULL;
     return new ElunaGameObjectAI(gameObject);
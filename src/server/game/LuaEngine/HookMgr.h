@@ -89,6 +89,9 @@ enum ServerEvents
     AUCTION_EVENT_ON_SUCCESSFUL             =     28,       // (event, AHObject)
     AUCTION_EVENT_ON_EXPIRE                 =     29,       // (event, AHObject)
 
+    // Eluna states
+    ELUNA_EVENT_ON_STATE_MESSAGE            =     30,       // (event, channel, message, senderMapId, senderInstanceId) - senderMapId is -1 for the world state
+
     SERVER_EVENT_COUNT
 };
 
@@ -273,6 +276,8 @@ struct HookMgr
 
     /* Misc */
     void OnWorldUpdate(uint32 diff);
+    void OnMapUpdate(Map* map, uint32 diff);
+    void OnDestroyMap(Map* map);
     void OnLootItem(Player* pPlayer, Item* pItem, uint32 count, uint64 guid);
     void OnLootMoney(Player* pPlayer, uint32 amount);
     void OnFirstLogin(Player* pPlayer);
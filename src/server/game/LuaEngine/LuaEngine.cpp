@@ -35,134 +35,389 @@ template<> const char* GetTName<Corpse>() { return "Corpse"; }
 template<> const char* GetTName<Weather>() { return "Weather"; }
 template<> const char* GetTName<AuctionHouseObject>() { return "AuctionHouse"; }
 
+thread_local Eluna* Eluna::t_Current = NULL;
+std::atomic<uint32> Eluna::s_Generation(0);
+std::atomic<uint32> Eluna::s_BindingCounts[REGTYPE_COUNT][Eluna::MaxEventCount];
+bool Eluna::s_PerMapStates = false;
+std::shared_mutex Eluna::s_MapStatesLock;
+Eluna::MapStateMap Eluna::s_MapStates;
+
+static_assert(SERVER_EVENT_COUNT <= Eluna::MaxEventCount && PLAYER_EVENT_COUNT <= Eluna::MaxEventCount &&
+    VEHICLE_EVENT_COUNT <= Eluna::MaxEventCount && GUILD_EVENT_COUNT <= Eluna::MaxEventCount &&
+    GROUP_EVENT_COUNT <= Eluna::MaxEventCount && CREATURE_EVENT_COUNT <= Eluna::MaxEventCount &&
+    GAMEOBJECT_EVENT_COUNT <= Eluna::MaxEventCount && ITEM_EVENT_COUNT <= Eluna::MaxEventCount &&
+    GOSSIP_EVENT_COUNT <= Eluna::MaxEventCount, "Eluna::MaxEventCount is too small");
+
 void StartEluna(bool restart)
 {
+    // Restarts are requested from running hooks (ReloadEluna) and from map threads (.reload config),
+    // every state reloads itself on its next update instead of being closed under a running script
     if (restart)
     {
-        sHookMgr->OnEngineRestart();
         TC_LOG_INFO("server.loading", "[Eluna]: Restarting Lua Engine");
+        Eluna::RequestRestart();
+        return;
+    }
 
-        if (sEluna->L)
-        {
-            // Unregisters and stops all timed events
-            sEluna->m_EventMgr.RemoveEvents();
+    AddElunaScripts();
+    Eluna::SetPerMapStates(sWorld->getBoolConfig(CONFIG_BOOL_ELUNA_PER_MAP_STATES));
 
-            // Remove bindings
-            for (std::map<int, std::vector<int> >::iterator itr = sEluna->ServerEventBindings.begin(); itr != sEluna->ServerEventBindings.end(); ++itr)
-            {
-                for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, (*it));
-                itr->second.clear();
-            }
+    ElunaStateGuard guard;
+    sEluna->LoadScripts();
+}
 
-            for (std::map<int, std::vector<int> >::iterator itr = sEluna->PlayerEventBindings.begin(); itr != sEluna->PlayerEventBindings.end(); ++itr)
-            {
-                for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, (*it));
-                itr->second.clear();
-            }
+Eluna* Eluna::instance()
+{
+    return t_Current ? t_Current : GetWorldState();
+}
 
-            for (std::map<int, std::vector<int> >::iterator itr = sEluna->VehicleEventBindings.begin(); itr != sEluna->VehicleEventBindings.end(); ++itr)
-            {
-                for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, (*it));
-                itr->second.clear();
-            }
+Eluna* Eluna::GetWorldState()
+{
+    static std::shared_ptr<Eluna> worldState = std::make_shared<Eluna>();
+    return worldState.get();
+}
 
-            for (std::map<int, std::vector<int> >::iterator itr = sEluna->GuildEventBindings.begin(); itr != sEluna->GuildEventBindings.end(); ++itr)
-            {
-                for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, (*it));
-                itr->second.clear();
-            }
+Eluna* Eluna::GetState(Map* map, bool create)
+{
+    if (!s_PerMapStates || !map)
+        return GetWorldState();
 
-            for (std::map<int, std::vector<int> >::iterator itr = sEluna->GroupEventBindings.begin(); itr != sEluna->GroupEventBindings.end(); ++itr)
-            {
-                for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, (*it));
-                itr->second.clear();
-            }
-            sEluna->CreatureEventBindings->Clear();
-            sEluna->CreatureGossipBindings->Clear();
-            sEluna->GameObjectEventBindings->Clear();
-            sEluna->GameObjectGossipBindings->Clear();
-            sEluna->ItemEventBindings->Clear();
-            sEluna->ItemGossipBindings->Clear();
-            sEluna->playerGossipBindings->Clear();
-
-            lua_close(sEluna->L);
+    {
+        std::shared_lock<std::shared_mutex> lock(s_MapStatesLock);
+        MapStateMap::const_iterator itr = s_MapStates.find(map);
+        if (itr != s_MapStates.end())
+            return itr->second.get();
+    }
+
+    if (!create)
+        return NULL;
+
+    // Loaded outside of the lock, scripts may run hooks while loading.
+    // If another thread of the same map wins the race its state is kept and this one dropped
+    std::shared_ptr<Eluna> state = std::make_shared<Eluna>(map);
+    state->LoadScripts();
+
+    std::unique_lock<std::shared_mutex> lock(s_MapStatesLock);
+    return s_MapStates.emplace(map, std::move(state)).first->second.get();
+}
+
+Eluna* Eluna::GetState(WorldObject const* obj)
+{
+    return GetState(obj ? obj->FindMap() : NULL);
+}
+
+void Eluna::DestroyState(Map const* map)
+{
+    std::shared_ptr<Eluna> state;
+    {
+        std::unique_lock<std::shared_mutex> lock(s_MapStatesLock);
+        MapStateMap::iterator itr = s_MapStates.find(map);
+        if (itr == s_MapStates.end())
+            return;
+
+        state = std::move(itr->second);
+        s_MapStates.erase(itr);
+    }
+
+    // Timed events left on objects of the map only hold weak references and expire with the state
+    ElunaStateGuard guard(state.get());
+    state->Unload();
+}
+
+bool Eluna::PostMessage(int32 mapId, uint32 instanceId, ElunaStateMessage const& message)
+{
+    // Without per map states the world state runs every script
+    if (mapId < 0 || !s_PerMapStates)
+    {
+        GetWorldState()->QueueMessage(message);
+        return true;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(s_MapStatesLock);
+    for (MapStateMap::const_iterator itr = s_MapStates.begin(); itr != s_MapStates.end(); ++itr)
+    {
+        if (int32(itr->first->GetId()) == mapId && itr->first->GetInstanceId() == instanceId)
+        {
+            itr->second->QueueMessage(message);
+            return true;
         }
     }
-    else
-        AddElunaScripts();
+    return false;
+}
 
-    sEluna->L = luaL_newstate();
-    TC_LOG_INFO("server.loading", "");
-    TC_LOG_INFO("server.loading", "[Eluna]: Lua Engine loaded.");
-    TC_LOG_INFO("server.loading", "");
+uint32 Eluna::BroadcastMessage(ElunaStateMessage const& message)
+{
+    uint32 count = 0;
+    Eluna* sender = instance();
+    if (GetWorldState() != sender)
+    {
+        GetWorldState()->QueueMessage(message);
+        ++count;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(s_MapStatesLock);
+    for (MapStateMap::const_iterator itr = s_MapStates.begin(); itr != s_MapStates.end(); ++itr)
+    {
+        if (itr->second.get() == sender)
+            continue;
+
+        itr->second->QueueMessage(message);
+        ++count;
+    }
+    return count;
+}
 
-	std::string lua_folderpath = sConfigMgr->GetStringDefault("Eluna.ScriptPath", "lua_scripts");
+void Eluna::QueueMessage(ElunaStateMessage const& message)
+{
+    std::lock_guard<std::mutex> lock(m_MessageLock);
+    m_Messages.push_back(message);
+}
+
+void Eluna::LoadScripts()
+{
+    // Registration functions called by the scripts bind to the current state
+    Eluna* previous = t_Current;
+    t_Current = this;
+
+    L = luaL_newstate();
+    ++m_LuaStateId;
+    if (!m_Map)
+    {
+        TC_LOG_INFO("server.loading", "");
+        TC_LOG_INFO("server.loading", "[Eluna]: Lua Engine loaded.");
+        TC_LOG_INFO("server.loading", "");
+    }
+
+    std::string lua_folderpath = sConfigMgr->GetStringDefault("Eluna.ScriptPath", "lua_scripts");
 
     LoadedScripts loadedScripts;
-    sEluna->LoadDirectory(lua_folderpath.c_str(), &loadedScripts);
-    luaL_openlibs(sEluna->L);
+    LoadDirectory(lua_folderpath.c_str(), &loadedScripts);
+    luaL_openlibs(L);
     // Register functions here
-    RegisterFunctions(sEluna->L);
+    RegisterFunctions(L);
 
     uint32 count = 0;
     char filename[200];
     for (std::set<std::string>::const_iterator itr = loadedScripts.begin(); itr !=  loadedScripts.end(); ++itr)
     {
         strcpy(filename, itr->c_str());
-        if (luaL_loadfile(sEluna->L, filename) != 0)
+        if (luaL_loadfile(L, filename) != 0)
         {
             TC_LOG_INFO("server.loading", "[Eluna]: Error loading file `%s`.", itr->c_str());
-            sEluna->report(sEluna->L);
+            report(L);
         }
         else
         {
-            int err = lua_pcall(sEluna->L, 0, 0, 0);
+            int err = lua_pcall(L, 0, 0, 0);
             if (err != 0 && err == LUA_ERRRUN)
             {
-                TC_LOG_INFO("server.loading", "server.loading", "[Eluna]: Error loading file `%s`.", itr->c_str());
-                sEluna->report(sEluna->L);
+                TC_LOG_INFO("server.loading", "[Eluna]: Error loading file `%s`.", itr->c_str());
+                report(L);
             }
         }
         ++count;
     }
 
-    
-    if (restart)
+    t_Current = previous;
+
+    if (m_Map)
+        TC_LOG_DEBUG("server.loading", "[Eluna]: Loaded %u Lua scripts for map %u instance %u", count, m_Map->GetId(), m_Map->GetInstanceId());
+    else
     {
-        //! Iterate over every supported source type (creature and gameobject)
-        //! Not entirely sure how this will affect units in non-loaded grids.
-        sMapMgr->DoForAllMaps([](Map* map)
+        TC_LOG_INFO("server.loading", "[Eluna]: Loaded %u Lua scripts..", count);
+        TC_LOG_INFO("server.loading", "");
+    }
+}
+
+void Eluna::Restart()
+{
+    // Caller holds an ElunaStateGuard on this state
+    sHookMgr->OnEngineRestart();
+    if (!m_Map)
+        TC_LOG_INFO("server.loading", "[Eluna]: Restarting Lua Engine");
+
+    Unload();
+    m_Generation = s_Generation;
+    LoadScripts();
+
+    //! Iterate over every supported source type (creature and gameobject)
+    //! Not entirely sure how this will affect units in non-loaded grids.
+    auto reinitializeAI = [this](Map* map)
+    {
+        for (auto itr : map->GetCreatureBySpawnIdStore())
         {
-            for (auto itr : map->GetCreatureBySpawnIdStore())
-            {
-                if (itr.second->IsInWorld())
-                    if(sEluna->CreatureEventBindings->GetBindMap(itr.second->GetEntry())) // update all AI or just Eluna?
-                        itr.second->AIM_Initialize();
-            }
+            if (itr.second->IsInWorld())
+                if (CreatureEventBindings->GetBindMap(itr.second->GetEntry())) // update all AI or just Eluna?
+                    itr.second->AIM_Initialize();
+        }
 
-            for (auto itr : map->GetGameObjectBySpawnIdStore())
-            {
-                if (itr.second->IsInWorld())
-                    if(sEluna->GameObjectEventBindings->GetBindMap(itr.second->GetEntry())) // update all AI or just Eluna?
-                        itr.second->AIM_Initialize();
-            }
-        });
+        for (auto itr : map->GetGameObjectBySpawnIdStore())
+        {
+            if (itr.second->IsInWorld())
+                if (GameObjectEventBindings->GetBindMap(itr.second->GetEntry())) // update all AI or just Eluna?
+                    itr.second->AIM_Initialize();
+        }
+    };
+
+    // Map states restart from their own map update, the world state only owns objects without per map states
+    if (m_Map)
+        reinitializeAI(m_Map);
+    else if (!s_PerMapStates)
+        sMapMgr->DoForAllMaps(reinitializeAI);
+}
+
+void Eluna::Update(uint32 diff)
+{
+    // Caller holds an ElunaStateGuard on this state
+    if (m_Generation != s_Generation)
+        Restart();
+
+    m_EventMgr.Update(diff);
+
+    std::vector<ElunaStateMessage> messages;
+    {
+        std::lock_guard<std::mutex> lock(m_MessageLock);
+        if (m_Messages.empty())
+            return;
+        messages.swap(m_Messages);
+    }
+
+    std::vector<int> const& bindings = ServerEventBindings[ELUNA_EVENT_ON_STATE_MESSAGE];
+    for (std::vector<ElunaStateMessage>::const_iterator message = messages.begin(); message != messages.end(); ++message)
+    {
+        for (std::vector<int>::const_iterator itr = bindings.begin(); itr != bindings.end(); ++itr)
+        {
+            BeginCall((*itr));
+            Push(L, ELUNA_EVENT_ON_STATE_MESSAGE);
+            Push(L, message->Channel);
+            Push(L, message->Data);
+            Push(L, message->SenderMapId);
+            Push(L, message->SenderInstanceId);
+            ExecuteCall(5, 0);
+        }
     }
-    
-    
-    TC_LOG_INFO("server.loading", "[Eluna]: Loaded %u Lua scripts..", count);
-    TC_LOG_INFO("server.loading", "");
 }
 
-Eluna* Eluna::instance()
+void Eluna::Unload()
 {
-    static Eluna instance;
-    return &instance;
+    if (!L)
+        return;
+
+    // Unregisters and stops all timed events
+    m_EventMgr.RemoveEvents();
+
+    // Remove bindings
+    for (std::map<int, std::vector<int> >::iterator itr = ServerEventBindings.begin(); itr != ServerEventBindings.end(); ++itr)
+    {
+        for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
+            luaL_unref(L, LUA_REGISTRYINDEX, (*it));
+        itr->second.clear();
+    }
+
+    for (std::map<int, std::vector<int> >::iterator itr = PlayerEventBindings.begin(); itr != PlayerEventBindings.end(); ++itr)
+    {
+        for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
+            luaL_unref(L, LUA_REGISTRYINDEX, (*it));
+        itr->second.clear();
+    }
+
+    for (std::map<int, std::vector<int> >::iterator itr = VehicleEventBindings.begin(); itr != VehicleEventBindings.end(); ++itr)
+    {
+        for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
+            luaL_unref(L, LUA_REGISTRYINDEX, (*it));
+        itr->second.clear();
+    }
+
+    for (std::map<int, std::vector<int> >::iterator itr = GuildEventBindings.begin(); itr != GuildEventBindings.end(); ++itr)
+    {
+        for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
+            luaL_unref(L, LUA_REGISTRYINDEX, (*it));
+        itr->second.clear();
+    }
+
+    for (std::map<int, std::vector<int> >::iterator itr = GroupEventBindings.begin(); itr != GroupEventBindings.end(); ++itr)
+    {
+        for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
+            luaL_unref(L, LUA_REGISTRYINDEX, (*it));
+        itr->second.clear();
+    }
+    CreatureEventBindings->Clear(L);
+    CreatureGossipBindings->Clear(L);
+    GameObjectEventBindings->Clear(L);
+    GameObjectGossipBindings->Clear(L);
+    ItemEventBindings->Clear(L);
+    ItemGossipBindings->Clear(L);
+    playerGossipBindings->Clear(L);
+
+    // Give back this state's share of the registered handler counts
+    for (uint8 regType = 0; regType < REGTYPE_COUNT; ++regType)
+    {
+        for (uint32 evt = 0; evt < MaxEventCount; ++evt)
+        {
+            if (m_BindingCounts[regType][evt])
+                s_BindingCounts[regType][evt] -= m_BindingCounts[regType][evt];
+            m_BindingCounts[regType][evt] = 0;
+        }
+    }
+
+    lua_close(L); // Closing
+    L = NULL;
+    ++m_LuaStateId;
+}
+
+void Eluna::AddBindingCount(uint8 regType, uint32 evt)
+{
+    ++m_BindingCounts[regType][evt];
+    ++m_BindingCounts[regType][0];
+    ++s_BindingCounts[regType][evt];
+    ++s_BindingCounts[regType][0];
+}
+
+ElunaStateGuard::ElunaStateGuard(WorldObject const* obj) : _previous(Eluna::t_Current), _locked(NULL)
+{
+    // Checked before resolving, a map state is not created just to be skipped
+    if (!_previous || !_previous->m_Map)
+        Enter(Eluna::GetState(obj));
+}
+
+ElunaStateGuard::ElunaStateGuard(Map* map) : _previous(Eluna::t_Current), _locked(NULL)
+{
+    if (!_previous || !_previous->m_Map)
+        Enter(Eluna::GetState(map));
+}
+
+ElunaStateGuard::ElunaStateGuard(Eluna* state) : _previous(Eluna::t_Current), _locked(NULL)
+{
+    Enter(state);
+}
+
+ElunaStateGuard::~ElunaStateGuard()
+{
+    if (!_locked)
+        return;
+
+    Eluna::t_Current = _previous;
+    _locked->m_Lock.unlock();
+}
+
+Eluna* ElunaStateGuard::GetState() const
+{
+    return Eluna::instance();
+}
+
+bool ElunaStateGuard::KeepsCurrent(Eluna const* state) const
+{
+    return _previous && (_previous == state || _previous->m_Map);
+}
+
+void ElunaStateGuard::Enter(Eluna* state)
+{
+    if (KeepsCurrent(state))
+        return;
+
+    state->m_Lock.lock();
+    _locked = state;
+    Eluna::t_Current = state;
 }
 
 // Loads lua scripts from given directory
@@ -478,6 +733,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
             if (evt < SERVER_EVENT_COUNT)
             {
                 ServerEventBindings[evt].push_back(functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -486,6 +742,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
             if (evt < PLAYER_EVENT_COUNT)
             {
                 PlayerEventBindings[evt].push_back(functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -494,6 +751,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
             if (evt < VEHICLE_EVENT_COUNT)
             {
                 VehicleEventBindings[evt].push_back(functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -502,6 +760,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
             if (evt < GUILD_EVENT_COUNT)
             {
                 GuildEventBindings[evt].push_back(functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -510,6 +769,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
             if (evt < GROUP_EVENT_COUNT)
             {
                 GroupEventBindings[evt].push_back(functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -523,7 +783,8 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->CreatureEventBindings->Insert(id, evt, functionRef);
+                CreatureEventBindings->Insert(L, id, evt, functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -537,7 +798,8 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->CreatureGossipBindings->Insert(id, evt, functionRef);
+                CreatureGossipBindings->Insert(L, id, evt, functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -551,7 +813,8 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->GameObjectEventBindings->Insert(id, evt, functionRef);
+                GameObjectEventBindings->Insert(L, id, evt, functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -565,7 +828,8 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->GameObjectGossipBindings->Insert(id, evt, functionRef);
+                GameObjectGossipBindings->Insert(L, id, evt, functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -579,7 +843,8 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->ItemEventBindings->Insert(id, evt, functionRef);
+                ItemEventBindings->Insert(L, id, evt, functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -593,7 +858,8 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->ItemGossipBindings->Insert(id, evt, functionRef);
+                ItemGossipBindings->Insert(L, id, evt, functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -601,7 +867,8 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
         case REGTYPE_PLAYER_GOSSIP:
             if (evt < GOSSIP_EVENT_COUNT)
             {
-                sEluna->playerGossipBindings->Insert(id, evt, functionRef);
+                playerGossipBindings->Insert(L, id, evt, functionRef);
+                AddBindingCount(regtype, evt);
                 return;
             }
             break;
@@ -613,30 +880,30 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
     luaL_error(L, "Unknown event type (regtype %d, id %d, event %d)", regtype, id, evt);
 }
 
-void Eluna::ElunaBind::Clear()
+void Eluna::ElunaBind::Clear(lua_State* L)
 {
     for (ElunaEntryMap::iterator itr = Bindings.begin(); itr != Bindings.end(); ++itr)
     {
         for (ElunaBindingMap::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-            luaL_unref(sEluna->L, LUA_REGISTRYINDEX, it->second);
+            luaL_unref(L, LUA_REGISTRYINDEX, it->second);
         itr->second.clear();
     }
     Bindings.clear();
 }
 
-void Eluna::ElunaBind::Insert(uint32 entryId, uint32 eventId, int funcRef)
+void Eluna::ElunaBind::Insert(lua_State* L, uint32 entryId, uint32 eventId, int funcRef)
 {
     if (Bindings[entryId][eventId])
     {
-        luaL_error(sEluna->L, "A function is already registered for entry (%d) event (%d)", entryId, eventId);
-        luaL_unref(sEluna->L, LUA_REGISTRYINDEX, funcRef); // free the unused ref
+        luaL_unref(L, LUA_REGISTRYINDEX, funcRef); // free the unused ref
+        luaL_error(L, "A function is already registered for entry (%d) event (%d)", entryId, eventId);
     }
     else
         Bindings[entryId][eventId] = funcRef;
 }
 
 EventMgr::LuaEvent::LuaEvent(EventProcessor* _events, int _funcRef, uint32 _delay, uint32 _calls, Object* _obj) :
-    events(_events), funcRef(_funcRef), delay(_delay), calls(_calls), obj(_obj)
+    owner(sEluna->shared_from_this()), stateId(sEluna->m_LuaStateId), obj(_obj), funcRef(_funcRef), delay(_delay), calls(_calls), events(_events)
 {
     hasObject = _obj;
     if (_events)
@@ -645,28 +912,44 @@ EventMgr::LuaEvent::LuaEvent(EventProcessor* _events, int _funcRef, uint32 _dela
 
 EventMgr::LuaEvent::~LuaEvent()
 {
+    // The reference died with the state if it was closed or restarted since
+    std::shared_ptr<Eluna> eluna = owner.lock();
+    if (!eluna || eluna->m_LuaStateId != stateId)
+        return;
+
+    ElunaStateGuard guard(eluna.get());
+    if (guard.GetState() != eluna.get())
+        return;
+
     if (events)
     {
         // Attempt to remove the pointer from LuaEvents
-        EventMgr::EventMap::const_iterator it = sEluna->m_EventMgr.LuaEvents.find(events); // Get event set
-        if (it != sEluna->m_EventMgr.LuaEvents.end())
-            sEluna->m_EventMgr.LuaEvents[events].erase(this); // Remove pointer
+        EventMgr::EventMap::const_iterator it = eluna->m_EventMgr.LuaEvents.find(events); // Get event set
+        if (it != eluna->m_EventMgr.LuaEvents.end())
+            eluna->m_EventMgr.LuaEvents[events].erase(this); // Remove pointer
     }
-    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, funcRef); // Free lua function ref
+    luaL_unref(eluna->L, LUA_REGISTRYINDEX, funcRef); // Free lua function ref
 }
 
 bool EventMgr::LuaEvent::Execute(uint64 time, uint32 diff)
 {
     if (hasObject && !obj) // interrupt event if object doesnt exist anymore and should exist.
         return true;
+    std::shared_ptr<Eluna> eluna = owner.lock();
+    if (!eluna || eluna->m_LuaStateId != stateId) // state was closed or restarted
+        return true;
     if (calls != 1)
         events->AddEvent(this, events->CalculateTime(delay)); // Reschedule before calling incase RemoveEvents used
-    sEluna->BeginCall(funcRef);
-    sEluna->Push(sEluna->L, funcRef);
-    sEluna->Push(sEluna->L, delay);
-    sEluna->Push(sEluna->L, calls);
-    sEluna->Push(sEluna->L, obj);
-    sEluna->ExecuteCall(4, 0);
+    ElunaStateGuard guard(eluna.get());
+    if (guard.GetState() == eluna.get()) // never call into another state's references
+    {
+        eluna->BeginCall(funcRef);
+        eluna->Push(eluna->L, funcRef);
+        eluna->Push(eluna->L, delay);
+        eluna->Push(eluna->L, calls);
+        eluna->Push(eluna->L, obj);
+        eluna->ExecuteCall(4, 0);
+    }
     return !(!calls || --calls); // Destory (true) event if not run
 }
 
@@ -16,9 +16,24 @@ extern "C"
 
 #include "Includes.h"
 #include "HookMgr.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 typedef std::set<std::string> LoadedScripts;
 
+class Eluna;
+
+// Data sent between Lua states, delivered with ELUNA_EVENT_ON_STATE_MESSAGE on the receiver's next update
+struct ElunaStateMessage
+{
+    std::string Channel;
+    std::string Data;
+    int32 SenderMapId;          // -1 for the world state
+    uint32 SenderInstanceId;
+};
+
 template<typename T> const char* GetTName();
 
 template<class T>
@@ -240,6 +255,8 @@ struct EventMgr
         // Should never execute on dead events
         bool Execute(uint64 time, uint32 diff);
 
+        std::weak_ptr<Eluna> owner; // State the function reference belongs to
+        uint32 stateId; // owner->m_LuaStateId at creation, the reference is stale once the owner restarts
         bool hasObject; // Dont call event if object no longer exists
         Object* obj;    // Object to push
         int funcRef;    // Lua function reference ID, also used as event ID
@@ -373,12 +390,35 @@ struct EventMgr
     }
 };
 
-class Eluna
+class Eluna : public std::enable_shared_from_this<Eluna>
 {
     public:
         friend class ScriptMgr;
+        friend class ElunaStateGuard;
+
+        static uint32 const MaxEventCount = 64;
+
+        // State of the hook running on this thread, the world state outside of hooks
         static Eluna* instance();
+        static Eluna* GetWorldState();
+        // Own state of the map with Eluna.PerMapStates, the world state otherwise
+        static Eluna* GetState(Map* map, bool create = true);
+        static Eluna* GetState(WorldObject const* obj);
+        static void DestroyState(Map const* map);
+        static bool IsPerMapStates() { return s_PerMapStates; }
+        static void SetPerMapStates(bool enabled) { s_PerMapStates = enabled; }
+
+        // Registered handlers over all states, lets hooks return before resolving and locking a state
+        static bool HasBindings(uint8 regType) { return s_BindingCounts[regType][0].load(std::memory_order_relaxed) != 0; }
+        static bool HasBindings(uint8 regType, uint32 evt) { return s_BindingCounts[regType][evt].load(std::memory_order_relaxed) != 0; }
+
+        // States reload their scripts on their next update, never from inside a running hook
+        static void RequestRestart() { ++s_Generation; }
+        static bool PostMessage(int32 mapId, uint32 instanceId, ElunaStateMessage const& message);
+        static uint32 BroadcastMessage(ElunaStateMessage const& message);
+
         lua_State* L;
+        uint32 m_LuaStateId; // bumped whenever L is created or closed, luaL_newstate may hand out the address of a closed state again
         EventMgr m_EventMgr;
 
         typedef std::map<int, int> ElunaBindingMap;
@@ -398,6 +438,13 @@ class Eluna
         ElunaBind* playerGossipBindings;
 
         void Initialize();
+        void LoadScripts();
+        void Restart();
+        void Update(uint32 diff);
+        void QueueMessage(ElunaStateMessage const& message);
+        Map* GetMap() const { return m_Map; }
+        int32 GetMapId() const { return m_Map ? int32(m_Map->GetId()) : -1; }
+        uint32 GetInstanceId() const { return m_Map ? m_Map->GetInstanceId() : 0; }
         static void report(lua_State*);
         void Register(uint8 reg, uint32 id, uint32 evt, int func);
         void BeginCall(int fReference);
@@ -519,9 +566,11 @@ class Eluna
         Item* CHECK_ITEM(lua_State* L, int narg);
 
         // Creates new binding stores
-        Eluna()
+        explicit Eluna(Map* map = NULL) : m_Map(map), m_Generation(s_Generation)
         {
             L = NULL;
+            m_LuaStateId = 0;
+            memset(m_BindingCounts, 0, sizeof(m_BindingCounts));
 
             for (int i = 0; i < SERVER_EVENT_COUNT; ++i)
             {
@@ -563,60 +612,21 @@ class Eluna
 
         ~Eluna()
         {
-            for (std::map<int, std::vector<int> >::iterator itr = ServerEventBindings.begin(); itr != ServerEventBindings.end(); ++itr)
-            {
-                for (std::vector<int>::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(L, LUA_REGISTRYINDEX, (*it));
-                itr->second.clear();
-            }
-
-            for (std::map<int, std::vector<int> >::iterator itr = PlayerEventBindings.begin(); itr != PlayerEventBindings.end(); ++itr)
-            {
-                for (std::vector<int>::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(L, LUA_REGISTRYINDEX, (*it));
-                itr->second.clear();
-            }
-
-            for (std::map<int, std::vector<int> >::iterator itr = VehicleEventBindings.begin(); itr != VehicleEventBindings.end(); ++itr)
-            {
-                for (std::vector<int>::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(L, LUA_REGISTRYINDEX, (*it));
-                itr->second.clear();
-            }
-
-            for (std::map<int, std::vector<int> >::iterator itr = GuildEventBindings.begin(); itr != GuildEventBindings.end(); ++itr)
-            {
-                for (std::vector<int>::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(L, LUA_REGISTRYINDEX, (*it));
-                itr->second.clear();
-            }
-
-            for (std::map<int, std::vector<int> >::iterator itr = GroupEventBindings.begin(); itr != GroupEventBindings.end(); ++itr)
-            {
-                for (std::vector<int>::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(L, LUA_REGISTRYINDEX, (*it));
-                itr->second.clear();
-            }
-            ServerEventBindings.clear();
-            PlayerEventBindings.clear();
-            VehicleEventBindings.clear();
-            GuildEventBindings.clear();
-            GroupEventBindings.clear();
-            CreatureEventBindings->Clear();
-            CreatureGossipBindings->Clear();
-            GameObjectEventBindings->Clear();
-            GameObjectGossipBindings->Clear();
-            ItemEventBindings->Clear();
-            ItemGossipBindings->Clear();
-            playerGossipBindings->Clear();
-
-            lua_close(L); // Closing
+            Unload();
+
+            delete CreatureEventBindings;
+            delete CreatureGossipBindings;
+            delete GameObjectEventBindings;
+            delete GameObjectGossipBindings;
+            delete ItemEventBindings;
+            delete ItemGossipBindings;
+            delete playerGossipBindings;
         }
 
         struct ElunaBind
         {
-            void Clear(); // unregisters all registered functions and clears all registered events from the bind std::maps (reset)
-            void Insert(uint32 entryId, uint32 eventId, int funcRef); // Inserts a new registered event
+            void Clear(lua_State* L); // unregisters all registered functions and clears all registered events from the bind std::maps (reset)
+            void Insert(lua_State* L, uint32 entryId, uint32 eventId, int funcRef); // Inserts a new registered event
 
             // Gets the function ref of an entry for an event
             int GetBind(uint32 entryId, uint32 eventId)
@@ -698,9 +708,55 @@ class Eluna
 
             WorldObjectInRangeCheck(WorldObjectInRangeCheck const&);
         };
+
+    private:
+        typedef std::unordered_map<Map const*, std::shared_ptr<Eluna> > MapStateMap;
+
+        void Unload(); // stops timed events, releases bindings and closes L
+        void AddBindingCount(uint8 regType, uint32 evt);
+
+        Map* m_Map; // NULL for the world state
+        uint32 m_Generation;
+        std::mutex m_Lock; // held by the ElunaStateGuard running hooks on this state
+        std::mutex m_MessageLock;
+        std::vector<ElunaStateMessage> m_Messages;
+        uint32 m_BindingCounts[REGTYPE_COUNT][MaxEventCount]; // this state's share of s_BindingCounts
+
+        static thread_local Eluna* t_Current;
+        static std::atomic<uint32> s_Generation;
+        static std::atomic<uint32> s_BindingCounts[REGTYPE_COUNT][MaxEventCount]; // [regType][0] counts all events
+        static bool s_PerMapStates;
+        static std::shared_mutex s_MapStatesLock;
+        static MapStateMap s_MapStates;
 };
 #define sEluna Eluna::instance()
 
+// Makes a state current for the hooks run in its scope and serializes access to it.
+// A thread only ever waits for a state while holding none or while holding the world state,
+// hooks reached from inside a map state keep running in that state, so states never wait on each other.
+class ElunaStateGuard
+{
+    public:
+        ElunaStateGuard() : ElunaStateGuard(Eluna::GetWorldState()) { }
+        explicit ElunaStateGuard(WorldObject const* obj);
+        explicit ElunaStateGuard(Map* map);
+        explicit ElunaStateGuard(Eluna* state);
+        ~ElunaStateGuard();
+
+        // State the hooks in scope run on, may differ from the requested one, see above
+        Eluna* GetState() const;
+
+        ElunaStateGuard(ElunaStateGuard const&) = delete;
+        ElunaStateGuard& operator=(ElunaStateGuard const&) = delete;
+
+    private:
+        bool KeepsCurrent(Eluna const* state) const;
+        void Enter(Eluna* state);
+
+        Eluna* _previous;
+        Eluna* _locked;
+};
+
 class LuaTaxiMgr
 {
     private:
@@ -75,6 +75,9 @@ void RegisterGlobals(lua_State* L)
 
     // Other
     lua_register(L, "ReloadEluna", &LuaGlobalFunctions::ReloadEluna);                                       // ReloadEluna() - Reload's Eluna engine
+    lua_register(L, "SendStateMessage", &LuaGlobalFunctions::SendStateMessage);                             // SendStateMessage(channel, message[, mapId, instanceId]) - Sends a message to the Lua state of the map, to the world state without mapId. Returns false if the map has no state. Received with ELUNA_EVENT_ON_STATE_MESSAGE
+    lua_register(L, "BroadcastStateMessage", &LuaGlobalFunctions::BroadcastStateMessage);                   // BroadcastStateMessage(channel, message) - Sends a message to every other Lua state. Returns the amount of receiving states
+    lua_register(L, "GetStateMap", &LuaGlobalFunctions::GetStateMap);                                       // GetStateMap() - Returns the map the running Lua state belongs to, nil for the world state
     lua_register(L, "SendWorldMessage", &LuaGlobalFunctions::SendWorldMessage);                             // SendWorldMessage(msg) - Sends a broadcast message to everyone
     lua_register(L, "WorldDBQuery", &LuaGlobalFunctions::WorldDBQuery);                                     // WorldDBQuery(sql) - Executes given SQL query to world database instantly and returns a QueryResult object
     lua_register(L, "WorldDBExecute", &LuaGlobalFunctions::WorldDBExecute);                                 // WorldDBExecute(sql) - Executes given SQL query to world database (not instant)
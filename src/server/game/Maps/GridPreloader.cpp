@@ -0,0 +1,187 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridPreloader.h"
+#include "DetourAlloc.h"
+#include "DisableMgr.h"
+#include "Log.h"
+#include "Map.h"
+#include "MMapFactory.h"
+#include "StringFormat.h"
+#include "ThreadPool.h"
+#include "Timer.h"
+#include "VMapFactory.h"
+#include "VMapManager2.h"
+#include "World.h"
+
+PreloadedGrid::~PreloadedGrid()
+{
+    delete Terrain;
+    dtFree(NavMeshTile);
+
+    if (!Models.empty())
+    {
+        VMAP::VMapManager2* vmgr = static_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager());
+        for (std::string const& model : Models)
+            vmgr->releaseModelInstance(model);
+    }
+}
+
+GridPreloader::GridPreloader() : _threads(0), _requests(0), _hits(0), _misses(0), _late(0), _expired(0), _savedTime(0), _stallTime(0)
+{
+}
+
+GridPreloader::~GridPreloader()
+{
+    Stop();
+}
+
+GridPreloader* GridPreloader::instance()
+{
+    static GridPreloader instance;
+    return &instance;
+}
+
+void GridPreloader::Start(uint32 threads)
+{
+    if (_pool || !threads)
+        return;
+
+    _threads = threads;
+    _pool = std::make_unique<Trinity::ThreadPool>(threads);
+
+    TC_LOG_INFO("maps", "Grid preloading running on %u threads", threads);
+}
+
+void GridPreloader::Stop()
+{
+    if (!_pool)
+        return;
+
+    _pool->Join();
+    _pool.reset();
+    _threads = 0;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _pending.clear();
+    _ready.clear();
+}
+
+void GridPreloader::RequestGrid(uint32 mapId, uint32 gx, uint32 gy)
+{
+    uint64 key = MakeKey(mapId, gx, gy);
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_ready.find(key) != _ready.end() || !_pending.insert(key).second)
+            return;
+    }
+
+    _requests.fetch_add(1, std::memory_order_relaxed);
+    _pool->PostWork([this, mapId, gx, gy]() { Load(mapId, gx, gy); });
+}
+
+std::unique_ptr<PreloadedGrid> GridPreloader::TakeGrid(uint32 mapId, uint32 gx, uint32 gy)
+{
+    std::unique_ptr<PreloadedGrid> grid;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto itr = _ready.find(MakeKey(mapId, gx, gy));
+        if (itr == _ready.end())
+            return nullptr;
+
+        grid = std::move(itr->second);
+        _ready.erase(itr);
+    }
+
+    _hits.fetch_add(1, std::memory_order_relaxed);
+    _savedTime.fetch_add(grid->LoadTime, std::memory_order_relaxed);
+    return grid;
+}
+
+void GridPreloader::RecordMiss(uint32 mapId, uint32 gx, uint32 gy, uint32 loadTime)
+{
+    _misses.fetch_add(1, std::memory_order_relaxed);
+    _stallTime.fetch_add(loadTime, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_pending.find(MakeKey(mapId, gx, gy)) != _pending.end())
+        _late.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GridPreloader::Update()
+{
+    std::vector<std::unique_ptr<PreloadedGrid>> expired;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        for (auto itr = _ready.begin(); itr != _ready.end();)
+        {
+            if (GetMSTimeDiffToNow(itr->second->ReadyTime) > GRID_PRELOAD_EXPIRE)
+            {
+                expired.push_back(std::move(itr->second));
+                itr = _ready.erase(itr);
+            }
+            else
+                ++itr;
+        }
+    }
+
+    // expired grids are freed here, releasing their vmap models outside of our lock
+    _expired.fetch_add(expired.size(), std::memory_order_relaxed);
+}
+
+void GridPreloader::Load(uint32 mapId, uint32 gx, uint32 gy)
+{
+    uint32 loadStart = getMSTime();
+    std::unique_ptr<PreloadedGrid> grid = std::make_unique<PreloadedGrid>();
+
+    std::string fileName = Trinity::StringFormat("%smaps/%04u_%02u_%02u.map", sWorld->GetDataPath().c_str(), mapId, gx, gy);
+    grid->Terrain = new GridMap();
+    if (!grid->Terrain->loadData(&fileName[0], sWorld->getBoolConfig(CONFIG_GRID_MAP_MEMORY_MAPPED)))
+        TC_LOG_ERROR("maps", "Error loading map file: \n %s\n", fileName.c_str());
+
+    static_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager())->acquireMapTileModels((sWorld->GetDataPath() + "vmaps").c_str(), mapId, gx, gy, grid->Models);
+
+    if (DisableMgr::IsPathfindingEnabled(mapId))
+        MMAP::MMapFactory::createOrGetMMapManager()->readMapTile(mapId, gx, gy, grid->NavMeshTile, grid->NavMeshTileSize);
+
+    grid->LoadTime = GetMSTimeDiffToNow(loadStart);
+    grid->ReadyTime = getMSTime();
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _pending.erase(MakeKey(mapId, gx, gy));
+    _ready[MakeKey(mapId, gx, gy)] = std::move(grid);
+}
+
+GridPreloadStats GridPreloader::GetStats()
+{
+    GridPreloadStats stats;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        stats.Pending = _pending.size();
+        stats.Ready = _ready.size();
+    }
+
+    stats.Threads = _threads;
+    stats.Requests = _requests.load(std::memory_order_relaxed);
+    stats.Hits = _hits.load(std::memory_order_relaxed);
+    stats.Misses = _misses.load(std::memory_order_relaxed);
+    stats.Late = _late.load(std::memory_order_relaxed);
+    stats.Expired = _expired.load(std::memory_order_relaxed);
+    stats.SavedTime = _savedTime.load(std::memory_order_relaxed);
+    stats.StallTime = _stallTime.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,113 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __GRIDPRELOADER_H
+#define __GRIDPRELOADER_H
+
+#include "Define.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class GridMap;
+
+namespace Trinity
+{
+    class ThreadPool;
+}
+
+#define GRID_PRELOAD_INTERVAL   1000                        // ms between predictions of a map
+#define GRID_PRELOAD_EXPIRE     (60 * IN_MILLISECONDS)      // ms a preloaded grid waits for its map
+
+/// Terrain, navmesh tile and vmap models of one grid, read off the map thread
+struct TC_GAME_API PreloadedGrid
+{
+    PreloadedGrid() : Terrain(nullptr), NavMeshTile(nullptr), NavMeshTileSize(0), LoadTime(0), ReadyTime(0) { }
+    ~PreloadedGrid();
+
+    GridMap* Terrain;
+    unsigned char* NavMeshTile;                             // dtAlloc'd, handed to MMapManager::loadMap
+    uint32 NavMeshTileSize;
+    std::vector<std::string> Models;                        // vmap models kept loaded until the tile is linked
+    uint32 LoadTime;                                        // ms the worker spent, saved on the map thread
+    uint32 ReadyTime;
+};
+
+struct GridPreloadStats
+{
+    uint32 Threads;
+    uint32 Pending;
+    uint32 Ready;
+    uint64 Requests;
+    uint64 Hits;
+    uint64 Misses;
+    uint64 Late;                                            // misses still being read by a worker
+    uint64 Expired;
+    uint64 SavedTime;                                       // ms of loading moved off the map threads
+    uint64 StallTime;                                       // ms map threads still spent loading grids
+};
+
+/// Reads grids of continents ahead of moving players, so crossing into them only links the data
+class TC_GAME_API GridPreloader
+{
+public:
+    static GridPreloader* instance();
+
+    void Start(uint32 threads);
+    void Stop();
+    bool IsEnabled() const { return _pool != nullptr; }
+
+    /// Grid map indexes as used by Map::GridMaps
+    void RequestGrid(uint32 mapId, uint32 gx, uint32 gy);
+    std::unique_ptr<PreloadedGrid> TakeGrid(uint32 mapId, uint32 gx, uint32 gy);
+    void RecordMiss(uint32 mapId, uint32 gx, uint32 gy, uint32 loadTime);
+
+    /// Drops grids nobody came for
+    void Update();
+
+    GridPreloadStats GetStats();
+
+private:
+    GridPreloader();
+    ~GridPreloader();
+
+    static uint64 MakeKey(uint32 mapId, uint32 gx, uint32 gy) { return uint64(mapId) << 32 | gx << 8 | gy; }
+    void Load(uint32 mapId, uint32 gx, uint32 gy);
+
+    std::unique_ptr<Trinity::ThreadPool> _pool;
+    uint32 _threads;
+
+    std::mutex _lock;                                       // guards _pending and _ready
+    std::unordered_set<uint64> _pending;
+    std::unordered_map<uint64, std::unique_ptr<PreloadedGrid>> _ready;
+
+    std::atomic<uint64> _requests;
+    std::atomic<uint64> _hits;
+    std::atomic<uint64> _misses;
+    std::atomic<uint64> _late;
+    std::atomic<uint64> _expired;
+    std::atomic<uint64> _savedTime;
+    std::atomic<uint64> _stallTime;
+};
+
+#define sGridPreloader GridPreloader::instance()
+
+#endif
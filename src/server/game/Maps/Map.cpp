@@ -23,14 +23,18 @@
 #include "DynamicTree.h"
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
+#include "GridPreloader.h"
 #include "GridStates.h"
 #include "Group.h"
 #include "InstanceScript.h"
 #include "LFGMgr.h"
 #include "MapInstanced.h"
 #include "MapManager.h"
+#include "MapRegion.h"
+#include "Metrics.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
+#include "PathfindingService.h"
 #include "Pet.h"
 #include "PoolMgr.h"
 #include "ScriptMgr.h"
@@ -38,8 +42,11 @@
 #include "Vehicle.h"
 #include "VMapFactory.h"
 #include "VMapManager2.h"
+#include "WaypointMovementGenerator.h"
 #include "BattlePetSpawnMgr.h"
 #include "G3D/Plane.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 u_map_magic MapMagic        = { {'M','A','P','S'} };
 uint32 MapVersionMagic      = 10;
@@ -56,6 +63,12 @@ static uint16 const holetab_v[4] = { 0x000F, 0x00F0, 0x0F00, 0xF000 };
 
 GridState* si_GridStates[MAX_GRID_STATE];
 
+namespace
+{
+    // Region updated by the current thread, see Map::UpdateRegions
+    thread_local MapRegion* CurrentRegion = nullptr;
+}
+
 Map::~Map()
 {
     sBattlePetSpawnMgr->DepopulateMap(i_mapEntry->MapID);
@@ -135,12 +148,20 @@ bool Map::ExistVMap(uint32 mapid, int gx, int gy)
     return true;
 }
 
-void Map::LoadMMap(int gx, int gy)
+void Map::LoadMMap(int gx, int gy, PreloadedGrid* preloaded)
 {
     if (!DisableMgr::IsPathfindingEnabled(GetId()))
         return;
 
-    bool mmapLoadResult = MMAP::MMapFactory::createOrGetMMapManager()->loadMap(GetId(), gx, gy);
+    bool mmapLoadResult;
+    if (preloaded && preloaded->NavMeshTile)
+    {
+        // the manager owns the tile from here on, even if it refuses it
+        mmapLoadResult = MMAP::MMapFactory::createOrGetMMapManager()->loadMap(GetId(), gx, gy, preloaded->NavMeshTile, preloaded->NavMeshTileSize);
+        preloaded->NavMeshTile = nullptr;
+    }
+    else
+        mmapLoadResult = MMAP::MMapFactory::createOrGetMMapManager()->loadMap(GetId(), gx, gy);
 
     if (mmapLoadResult)
         TC_LOG_DEBUG("maps", "MMAP loaded name:%s, id:%d, x:%d, y:%d (mmap rep.: x:%d, y:%d)", GetMapName(), GetId(), gx, gy, gx, gy);
@@ -203,7 +224,7 @@ void Map::LoadMap(int gx, int gy, bool reload)
     TC_LOG_DEBUG("maps", "Loading map %s", tmp);
     // loading data
     GridMaps[gx][gy] = new GridMap();
-    if (!GridMaps[gx][gy]->loadData(tmp))
+    if (!GridMaps[gx][gy]->loadData(tmp, sWorld->getBoolConfig(CONFIG_GRID_MAP_MEMORY_MAPPED)))
         TC_LOG_ERROR("maps", "Error loading map file: \n %s\n", tmp);
     delete [] tmp;
 
@@ -212,6 +233,29 @@ void Map::LoadMap(int gx, int gy, bool reload)
 
 void Map::LoadMapAndVMap(int gx, int gy)
 {
+    // Continents may have read the grid ahead of a player already
+    if (i_InstanceId == 0 && !Instanceable() && sGridPreloader->IsEnabled() && !GridMaps[gx][gy])
+    {
+        if (std::unique_ptr<PreloadedGrid> grid = sGridPreloader->TakeGrid(GetId(), gx, gy))
+        {
+            GridMaps[gx][gy] = grid->Terrain;
+            grid->Terrain = nullptr;
+            sScriptMgr->OnLoadGridMap(this, GridMaps[gx][gy], gx, gy);
+
+            // models are kept loaded by the preloaded grid, linking them only bumps their references
+            LoadVMap(gx, gy);
+            LoadMMap(gx, gy, grid.get());
+            return;
+        }
+
+        uint32 loadStart = getMSTime();
+        LoadMap(gx, gy);
+        LoadVMap(gx, gy);
+        LoadMMap(gx, gy);
+        sGridPreloader->RecordMiss(GetId(), gx, gy, GetMSTimeDiffToNow(loadStart));
+        return;
+    }
+
     LoadMap(gx, gy);
    // Only load the data for the base map
     if (i_InstanceId == 0)
@@ -261,6 +305,9 @@ i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
     Map::InitVisibilityDistance();
 
     _poolData = sPoolMgr->InitPoolsForMap(this);
+    _pathfinding = std::make_unique<PathfindingService>(id);
+
+    m_updateMetric = sMetrics->Register(Trinity::StringFormat("map_update,map=%u", id), METRIC_TIMER);
 
     sScriptMgr->OnCreateMap(this);
 }
@@ -457,6 +504,8 @@ void Map::EnsureGridLoadedForActiveObject(Cell const& cell, WorldObject const* o
 //Create NGrid and load the object data in it
 bool Map::EnsureGridLoaded(const Cell &cell)
 {
+    auto guard = GuardRegionUpdate();
+
     EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
     NGridType *grid = getNGrid(cell.GridX(), cell.GridY());
 
@@ -542,6 +591,8 @@ void Map::InitializeObject(GameObject* obj)
 template<class T>
 bool Map::AddToMap(T* obj)
 {
+    auto guard = GuardRegionUpdate();
+
     /// @todo Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -648,6 +699,9 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
     // Update mobs/objects in ALL visible cells around object!
     CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), obj->GetGridActivationRange());
 
+    MapRegion* region = GetCurrentRegion();
+    MarkedCells& markedCells = region ? region->MarkedCells : marked_cells;
+
     for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
     {
         for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
@@ -655,10 +709,10 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
             // marked cells are those that have been visited
             // don't visit the same cell twice
             uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-            if (isCellMarked(cell_id))
+            if (markedCells.test(cell_id))
                 continue;
 
-            markCell(cell_id);
+            markedCells.set(cell_id);
             CellCoord pair(x, y);
             Cell cell(pair);
             cell.SetNoCreate();
@@ -683,6 +737,9 @@ void Map::Update(const uint32 t_diff)
     if (!Instanceable()) // Map update time for instanced maps is handled in InstanceMap::Update
         updateTimeMark = getMSTime();
 
+    // paths requested during the previous update
+    _pathfinding->Collect();
+
     _dynamicTree.update(t_diff);
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -696,44 +753,50 @@ void Map::Update(const uint32 t_diff)
             session->Update(t_diff, updater);
         }
     }
+    if (!Instanceable() && sGridPreloader->IsEnabled())
+        PreloadGridsAhead(t_diff);
+
     /// update active cells around players and active objects
-    resetMarkedCells();
+    if (!UpdateRegions(t_diff))
+    {
+        resetMarkedCells();
 
-    Trinity::ObjectUpdater updater(t_diff);
-    // for creature
-    TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
-    // for pets
-    TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+        Trinity::ObjectUpdater updater(t_diff);
+        // for creature
+        TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+        // for pets
+        TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
-    {
-        Player* player = m_mapRefIter->GetSource();
+        // the player iterator is stored in the map object
+        // to make sure calls to Map::Remove don't invalidate it
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* player = m_mapRefIter->GetSource();
 
-        if (!player || !player->IsInWorld())
-            continue;
+            if (!player || !player->IsInWorld())
+                continue;
 
-        // update players at tick
-        player->Update(t_diff);
+            // update players at tick
+            player->Update(t_diff);
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+            VisitNearbyCellsOf(player, grid_object_update, world_object_update);
 
-        // If player is using far sight or mind vision, visit that object too
-        if (WorldObject* viewPoint = player->GetViewpoint())
-            VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
-    }
+            // If player is using far sight or mind vision, visit that object too
+            if (WorldObject* viewPoint = player->GetViewpoint())
+                VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+        }
 
-    // non-player active objects, increasing iterator in the loop in case of object removal
-    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
-    {
-        WorldObject* obj = *m_activeNonPlayersIter;
-        ++m_activeNonPlayersIter;
+        // non-player active objects, increasing iterator in the loop in case of object removal
+        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        {
+            WorldObject* obj = *m_activeNonPlayersIter;
+            ++m_activeNonPlayersIter;
 
-        if (!obj || !obj->IsInWorld() || !((uint32)obj->GetActiveFlags() & ~(uint32)ActiveFlags::OnlyInNonEmptyMapsMask) && !HavePlayers())
-            continue;
+            if (!obj || !obj->IsInWorld() || !((uint32)obj->GetActiveFlags() & ~(uint32)ActiveFlags::OnlyInNonEmptyMapsMask) && !HavePlayers())
+                continue;
 
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+            VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        }
     }
 
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
@@ -780,6 +843,8 @@ void Map::Update(const uint32 t_diff)
         }
     }
 
+    _pathfinding->Dispatch();
+
     if (!Instanceable())
     {
         m_updateTime = getMSTime() - updateTimeMark;
@@ -788,6 +853,342 @@ void Map::Update(const uint32 t_diff)
     }
 }
 
+void Map::PreloadGridsAhead(uint32 diff)
+{
+    _gridPreloadTimer -= diff;
+    if (_gridPreloadTimer > 0)
+        return;
+
+    _gridPreloadTimer = GRID_PRELOAD_INTERVAL;
+
+    float lookAhead = float(sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD));
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->GetSource();
+        if (player && player->IsInWorld())
+            PreloadGridsAhead(player, player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : MOVE_RUN) * lookAhead);
+    }
+}
+
+void Map::PreloadGridsAhead(Player* player, float distance)
+{
+    // taxi paths are known in advance, follow the nodes still ahead
+    if (player->GetMotionMaster()->GetCurrentMovementGeneratorType() == FLIGHT_MOTION_TYPE)
+    {
+        FlightPathMovementGenerator* flight = static_cast<FlightPathMovementGenerator*>(player->GetMotionMaster()->top());
+        TaxiPathNodeList const& path = flight->GetPath();
+
+        float x = player->GetPositionX();
+        float y = player->GetPositionY();
+        for (uint32 i = flight->GetCurrentNode(); i < path.size() && distance > 0.0f; ++i)
+        {
+            TaxiPathNodeEntry const& node = path[i];
+            if (node.MapId != GetId())
+                break;
+
+            distance -= std::sqrt((node.LocX - x) * (node.LocX - x) + (node.LocY - y) * (node.LocY - y));
+            x = node.LocX;
+            y = node.LocY;
+            PreloadGridAt(x, y);
+        }
+        return;
+    }
+
+    if (!player->isMoving())
+        return;
+
+    float orientation = player->GetOrientation();
+    if (player->HasUnitMovementFlag(MOVEMENTFLAG_BACKWARD))
+        orientation = Position::NormalizeOrientation(orientation + float(M_PI));
+
+    // half grid steps cannot skip a grid, the last one always lands on the look ahead distance
+    // so that speeds below half a grid per look ahead (running, ground mounts) preload too
+    float step = std::min(distance, SIZE_OF_GRIDS / 2);
+    if (step <= 0.0f)
+        return;
+
+    for (float dist = step; dist < distance + step; dist += step)
+    {
+        float reach = std::min(dist, distance);
+        PreloadGridAt(player->GetPositionX() + reach * std::cos(orientation), player->GetPositionY() + reach * std::sin(orientation));
+    }
+}
+
+void Map::PreloadGridAt(float x, float y)
+{
+    if (!Trinity::IsValidMapCoord(x, y))
+        return;
+
+    GridCoord p = Trinity::ComputeGridCoord(x, y);
+    uint32 gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+    uint32 gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+    if (!GridMaps[gx][gy])
+        sGridPreloader->RequestGrid(GetId(), gx, gy);
+}
+
+bool Map::CanUpdateInRegions() const
+{
+    if (Instanceable() || !sWorld->getBoolConfig(CONFIG_MAP_UPDATE_REGIONS))
+        return false;
+
+    // Splitting only pays off when other map update threads can pick up the regions
+    if (!sMapMgr->GetMapUpdater()->activated() || sWorld->getIntConfig(CONFIG_NUMTHREADS) < 2)
+        return false;
+
+    return m_mapRefManager.getSize() >= sWorld->getIntConfig(CONFIG_MAP_UPDATE_REGIONS_MIN_PLAYERS);
+}
+
+bool Map::BuildRegions()
+{
+    int32 const distance = int32(sWorld->getIntConfig(CONFIG_MAP_UPDATE_REGIONS_GRID_DISTANCE));
+
+    if (_regionGridSlots.empty())
+        _regionGridSlots.assign(MAX_NUMBER_OF_GRIDS * MAX_NUMBER_OF_GRIDS, -1);
+
+    std::vector<uint32> grids;                              // occupied grid ids, indexed by slot
+    std::vector<uint32> parents;                            // union-find over slots
+    std::vector<std::pair<WorldObject*, uint32>> anchors;   // object and slot of its grid
+
+    auto findRoot = [&parents](uint32 slot)
+    {
+        while (parents[slot] != slot)
+            slot = parents[slot] = parents[parents[slot]];
+        return slot;
+    };
+
+    auto unite = [&parents, &findRoot](uint32 left, uint32 right)
+    {
+        parents[findRoot(left)] = findRoot(right);
+    };
+
+    auto gridSlot = [this, &grids, &parents](WorldObject const* obj)
+    {
+        GridCoord p = Trinity::ComputeGridCoord(obj->GetPositionX(), obj->GetPositionY());
+        uint32 gridId = p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord;
+        if (_regionGridSlots[gridId] < 0)
+        {
+            _regionGridSlots[gridId] = int32(grids.size());
+            parents.push_back(grids.size());
+            grids.push_back(gridId);
+        }
+        return uint32(_regionGridSlots[gridId]);
+    };
+
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->GetSource();
+        if (!player || !player->IsInWorld() || !player->IsPositionValid())
+            continue;
+
+        uint32 slot = gridSlot(player);
+        anchors.emplace_back(player, slot);
+
+        // Far sight and mind vision keep the viewpoint in the same region as the player
+        if (WorldObject* viewPoint = player->GetViewpoint())
+            if (viewPoint->IsPositionValid())
+                unite(gridSlot(viewPoint), slot);
+    }
+
+    for (WorldObject* obj : m_activeNonPlayers)
+    {
+        if (!obj || !obj->IsInWorld() || !obj->IsPositionValid() || !((uint32)obj->GetActiveFlags() & ~(uint32)ActiveFlags::OnlyInNonEmptyMapsMask) && !HavePlayers())
+            continue;
+
+        anchors.emplace_back(obj, gridSlot(obj));
+    }
+
+    // Grids closer than the configured distance may touch the same cells during one update
+    for (uint32 slot = 0; slot < grids.size(); ++slot)
+    {
+        int32 gx = int32(grids[slot] / MAX_NUMBER_OF_GRIDS);
+        int32 gy = int32(grids[slot] % MAX_NUMBER_OF_GRIDS);
+        for (int32 x = std::max(0, gx - distance + 1); x <= std::min(int32(MAX_NUMBER_OF_GRIDS) - 1, gx + distance - 1); ++x)
+            for (int32 y = std::max(0, gy - distance + 1); y <= std::min(int32(MAX_NUMBER_OF_GRIDS) - 1, gy + distance - 1); ++y)
+                if (int32 other = _regionGridSlots[x * MAX_NUMBER_OF_GRIDS + y]; other >= 0 && uint32(other) != slot)
+                    unite(slot, uint32(other));
+    }
+
+    for (uint32 gridId : grids)
+        _regionGridSlots[gridId] = -1;
+
+    std::vector<int32> regionOfRoot(grids.size(), -1);
+    uint32 count = 0;
+    for (uint32 slot = 0; slot < grids.size(); ++slot)
+        if (regionOfRoot[findRoot(slot)] < 0)
+            regionOfRoot[findRoot(slot)] = int32(count++);
+
+    _updateRegionCount = count;
+    if (count < 2)
+        return false;
+
+    while (_regions.size() < count)
+        _regions.push_back(std::make_unique<MapRegion>(this));
+
+    for (uint32 i = 0; i < count; ++i)
+        _regions[i]->Reset();
+
+    for (auto const& anchor : anchors)
+    {
+        MapRegion& region = *_regions[regionOfRoot[findRoot(anchor.second)]];
+        if (Player* player = anchor.first->ToPlayer())
+            region.Players.push_back(player);
+        else
+            region.ActiveObjects.push_back(anchor.first);
+    }
+
+    return true;
+}
+
+bool Map::UpdateRegions(uint32 t_diff)
+{
+    if (!CanUpdateInRegions())
+    {
+        _updateRegionCount = 0;
+        return false;
+    }
+
+    if (!BuildRegions())
+        return false;
+
+    std::vector<MapRegion*> regions;
+    regions.reserve(_updateRegionCount);
+    for (uint32 i = 0; i < _updateRegionCount; ++i)
+        regions.push_back(_regions[i].get());
+
+    // Most crowded regions first, they are the most expensive ones
+    std::sort(regions.begin(), regions.end(), [](MapRegion const* left, MapRegion const* right)
+    {
+        return left->Players.size() + left->ActiveObjects.size() > right->Players.size() + right->ActiveObjects.size();
+    });
+
+    _regionUpdateActive = true;
+
+    auto batch = std::make_shared<MapRegionBatch>(*this, t_diff, std::move(regions));
+
+    uint32 helpers = std::min(_updateRegionCount, sWorld->getIntConfig(CONFIG_NUMTHREADS)) - 1;
+    for (uint32 i = 0; i < helpers; ++i)
+        sMapMgr->GetMapUpdater()->schedule_task([batch]() { batch->Run(); }, GetUpdateCost() / _updateRegionCount);
+
+    batch->Run();
+    batch->Wait();
+
+    _regionUpdateActive = false;
+
+    MergeRegions();
+    return true;
+}
+
+void Map::UpdateRegion(MapRegion& region, uint32 t_diff)
+{
+    MapRegion* previousRegion = CurrentRegion;
+    CurrentRegion = &region;
+
+    Trinity::ObjectUpdater updater(t_diff);
+    // for creature
+    TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    // for pets
+    TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+    // anchors removed from the map meanwhile are nulled by ForgetRegionAnchor
+    for (size_t i = 0; i < region.Players.size(); ++i)
+    {
+        Player* player;
+        {
+            auto guard = GuardRegionUpdate();
+            player = region.Players[i];
+        }
+
+        if (!player || !player->IsInWorld())
+            continue;
+
+        player->Update(t_diff);
+
+        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+
+        if (WorldObject* viewPoint = player->GetViewpoint())
+            VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+    }
+
+    for (size_t i = 0; i < region.ActiveObjects.size(); ++i)
+    {
+        WorldObject* obj;
+        {
+            auto guard = GuardRegionUpdate();
+            obj = region.ActiveObjects[i];
+        }
+
+        if (!obj || !obj->IsInWorld())
+            continue;
+
+        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+    }
+
+    CurrentRegion = previousRegion;
+}
+
+void Map::MergeRegions()
+{
+    for (uint32 i = 0; i < _updateRegionCount; ++i)
+    {
+        MapRegion& region = *_regions[i];
+
+        for (Object* obj : region.RemovedUpdatable)
+            m_updatable.erase(obj);
+        m_updatable.insert(region.Updatable.begin(), region.Updatable.end());
+
+        // the player is already at its new position, only its grid reference is left behind
+        for (Player* player : region.PlayersToMove)
+            if (player->IsInWorld() && player->FindMap() == this)
+                PlayerCellRelocation(player, true);
+
+        _creaturesToMove.insert(_creaturesToMove.end(), region.CreaturesToMove.begin(), region.CreaturesToMove.end());
+        _gameObjectsToMove.insert(_gameObjectsToMove.end(), region.GameObjectsToMove.begin(), region.GameObjectsToMove.end());
+        _dynamicObjectsToMove.insert(_dynamicObjectsToMove.end(), region.DynamicObjectsToMove.begin(), region.DynamicObjectsToMove.end());
+        _areaTriggersToMove.insert(_areaTriggersToMove.end(), region.AreaTriggersToMove.begin(), region.AreaTriggersToMove.end());
+
+        region.Reset();
+    }
+}
+
+MapRegion* Map::GetCurrentRegion() const
+{
+    if (!_regionUpdateActive || !CurrentRegion || CurrentRegion->Owner != this)
+        return nullptr;
+
+    return CurrentRegion;
+}
+
+void Map::ForgetRegionAnchor(WorldObject* obj)
+{
+    for (uint32 i = 0; i < _updateRegionCount; ++i)
+    {
+        MapRegion& region = *_regions[i];
+        if (Player* player = obj->ToPlayer())
+            std::replace(region.Players.begin(), region.Players.end(), player, static_cast<Player*>(nullptr));
+        else
+            std::replace(region.ActiveObjects.begin(), region.ActiveObjects.end(), obj, static_cast<WorldObject*>(nullptr));
+    }
+}
+
+void Map::AddUpdateObject(Object* object)
+{
+    if (MapRegion* region = GetCurrentRegion())
+        region->Updatable.insert(object);
+    else
+        m_updatable.insert(object);
+}
+
+void Map::RemoveUpdateObject(Object* object)
+{
+    if (MapRegion* region = GetCurrentRegion())
+    {
+        region->Updatable.erase(object);
+        region->RemovedUpdatable.push_back(object);
+    }
+    else
+        m_updatable.erase(object);
+}
+
 void Map::RemovePlayerFromMap(Player* player, bool remove)
 {
     // Before leaving map, update zone/area for stats
@@ -816,6 +1217,8 @@ void Map::RemovePlayerFromMap(Player* player, bool remove)
 template<class T>
 void Map::RemoveFromMap(T *obj, bool remove)
 {
+    auto guard = GuardRegionUpdate();
+
     if (Creature* creature = obj->ToCreature())
         sBattlePetSpawnMgr->OnRemoveFromMap(creature);
 
@@ -894,12 +1297,11 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
     {
         TC_LOG_DEBUG("maps", "Player %s relocation grid[%u, %u]cell[%u, %u]->grid[%u, %u]cell[%u, %u]", player->GetName().c_str(), old_cell.GridX(), old_cell.GridY(), old_cell.CellX(), old_cell.CellY(), new_cell.GridX(), new_cell.GridY(), new_cell.CellX(), new_cell.CellY());
 
-        player->RemoveFromGrid();
-
-        if (old_cell.DiffGrid(new_cell))
-            EnsureGridLoadedForActiveObject(new_cell, player);
-
-        AddToGrid(player, new_cell);
+        // other regions may walk or load the same grids meanwhile, the grid move is done by MergeRegions
+        if (MapRegion* region = GetCurrentRegion())
+            region->PlayersToMove.push_back(player);
+        else
+            PlayerCellRelocation(player, old_cell.DiffGrid(new_cell));
     }
 
     player->OnRelocated();
@@ -907,6 +1309,18 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
     
 }
 
+void Map::PlayerCellRelocation(Player* player, bool loadGrid)
+{
+    Cell new_cell(player->GetPositionX(), player->GetPositionY());
+
+    player->RemoveFromGrid();
+
+    if (loadGrid)
+        EnsureGridLoadedForActiveObject(new_cell, player);
+
+    AddToGrid(player, new_cell);
+}
+
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool respawnRelocationOnFail)
 {
     ASSERT(CheckGridIntegrity(creature, false));
@@ -1040,7 +1454,12 @@ void Map::AddCreatureToMoveList(Creature* c, float x, float y, float z, float an
         return;
 
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
-        _creaturesToMove.push_back(c);
+    {
+        if (MapRegion* region = GetCurrentRegion())
+            region->CreaturesToMove.push_back(c);
+        else
+            _creaturesToMove.push_back(c);
+    }
     c->SetNewCellPosition(x, y, z, ang);
     // Screw it, let's see what happens!
     c->Relocate(x, y, z, ang);
@@ -1061,7 +1480,12 @@ void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, flo
         return;
 
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
-        _gameObjectsToMove.push_back(go);
+    {
+        if (MapRegion* region = GetCurrentRegion())
+            region->GameObjectsToMove.push_back(go);
+        else
+            _gameObjectsToMove.push_back(go);
+    }
     go->SetNewCellPosition(x, y, z, ang);
     // Screw it, let's see what happens!
     go->Relocate(x, y, z, ang);
@@ -1082,7 +1506,12 @@ void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj, float x, float y, fl
         return;
 
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
-        _dynamicObjectsToMove.push_back(dynObj);
+    {
+        if (MapRegion* region = GetCurrentRegion())
+            region->DynamicObjectsToMove.push_back(dynObj);
+        else
+            _dynamicObjectsToMove.push_back(dynObj);
+    }
     dynObj->SetNewCellPosition(x, y, z, ang);
     // Screw it, let's see what happens!
     dynObj->Relocate(x, y, z, ang);
@@ -1103,7 +1532,12 @@ void Map::AddAreaTriggerToMoveList(AreaTrigger* areaTrigger, float x, float y, f
         return;
 
     if (areaTrigger->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
-        _areaTriggersToMove.push_back(areaTrigger);
+    {
+        if (MapRegion* region = GetCurrentRegion())
+            region->AreaTriggersToMove.push_back(areaTrigger);
+        else
+            _areaTriggersToMove.push_back(areaTrigger);
+    }
     areaTrigger->SetNewCellPosition(x, y, z, ang);
     // Screw it, let's see what happens!
     areaTrigger->Relocate(x, y, z, ang);
@@ -1666,6 +2100,9 @@ void Map::RemoveAllPlayers()
 
 void Map::UnloadAll()
 {
+    // the workers may still be reading tiles of this map
+    _pathfinding->Wait();
+
     // clear all delayed moves, useless anyway do this moves before map unload.
     _creaturesToMove.clear();
     _gameObjectsToMove.clear();
@@ -1766,11 +2203,15 @@ GridMap::~GridMap()
     unloadData();
 }
 
-bool GridMap::loadData(char* filename)
+bool GridMap::loadData(char* filename, bool memoryMapped)
 {
     // Unload old data if exist
     unloadData();
 
+    // files from older extractors may not be aligned for it, those are read into memory below
+    if (memoryMapped && loadMappedData(filename))
+        return true;
+
     map_fileheader header;
     // Not return error if file not found
     FILE* in = fopen(filename, "rb");
@@ -1823,16 +2264,181 @@ bool GridMap::loadData(char* filename)
     return false;
 }
 
+bool GridMap::loadMappedData(char const* filename)
+{
+    std::unique_ptr<boost::interprocess::mapped_region> mapping;
+    try
+    {
+        boost::interprocess::file_mapping file(filename, boost::interprocess::read_only);
+        mapping = std::make_unique<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const&)
+    {
+        return false;
+    }
+
+    char const* data = static_cast<char const*>(mapping->get_address());
+    std::size_t size = mapping->get_size();
+
+    // typed views into the mapping, only handed out when in bounds and aligned for the type
+    auto section = [data, size](std::size_t offset, std::size_t length, std::size_t alignment) -> void*
+    {
+        if (offset > size || length > size - offset || uintptr_t(data + offset) % alignment)
+            return nullptr;
+        return const_cast<char*>(data + offset);
+    };
+
+    map_fileheader header;
+    if (size < sizeof(header))
+        return false;
+
+    memcpy(&header, data, sizeof(header));
+    if (header.mapMagic.asUInt != MapMagic.asUInt || header.versionMagic != MapVersionMagic)
+        return false;
+
+    bool loaded = [&]()
+    {
+        if (header.areaMapOffset)
+        {
+            map_areaHeader areaHeader;
+            char const* areaData = static_cast<char const*>(section(header.areaMapOffset, sizeof(areaHeader), 1));
+            if (!areaData)
+                return false;
+
+            memcpy(&areaHeader, areaData, sizeof(areaHeader));
+            if (areaHeader.fourcc != MapAreaMagic.asUInt)
+                return false;
+
+            _gridArea = areaHeader.gridArea;
+            if (!(areaHeader.flags & MAP_AREA_NO_AREA))
+                if (!(_areaMap = static_cast<uint16*>(section(header.areaMapOffset + sizeof(areaHeader), sizeof(uint16) * 16 * 16, alignof(uint16)))))
+                    return false;
+        }
+
+        if (header.heightMapOffset)
+        {
+            map_heightHeader heightHeader;
+            char const* heightData = static_cast<char const*>(section(header.heightMapOffset, sizeof(heightHeader), 1));
+            if (!heightData)
+                return false;
+
+            memcpy(&heightHeader, heightData, sizeof(heightHeader));
+            if (heightHeader.fourcc != MapHeightMagic.asUInt)
+                return false;
+
+            _gridHeight = heightHeader.gridHeight;
+            std::size_t offset = header.heightMapOffset + sizeof(heightHeader);
+            if (!(heightHeader.flags & MAP_HEIGHT_NO_HEIGHT))
+            {
+                std::size_t valueSize = sizeof(float);
+                if (heightHeader.flags & MAP_HEIGHT_AS_INT16)
+                {
+                    valueSize = sizeof(uint16);
+                    _gridIntHeightMultiplier = (heightHeader.gridMaxHeight - heightHeader.gridHeight) / 65535;
+                    _gridGetHeight = &GridMap::getHeightFromUint16;
+                }
+                else if (heightHeader.flags & MAP_HEIGHT_AS_INT8)
+                {
+                    valueSize = sizeof(uint8);
+                    _gridIntHeightMultiplier = (heightHeader.gridMaxHeight - heightHeader.gridHeight) / 255;
+                    _gridGetHeight = &GridMap::getHeightFromUint8;
+                }
+                else
+                    _gridGetHeight = &GridMap::getHeightFromFloat;
+
+                m_V9 = static_cast<float*>(section(offset, valueSize * 129 * 129, valueSize));
+                offset += valueSize * 129 * 129;
+                m_V8 = static_cast<float*>(section(offset, valueSize * 128 * 128, valueSize));
+                offset += valueSize * 128 * 128;
+                if (!m_V9 || !m_V8)
+                    return false;
+            }
+
+            if (heightHeader.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
+            {
+                std::array<int16, 9> minHeights;
+                char const* bounds = static_cast<char const*>(section(offset, sizeof(int16) * 9 * 2, 1));
+                if (!bounds)
+                    return false;
+
+                // max heights come first and are not used
+                memcpy(minHeights.data(), bounds + sizeof(int16) * 9, sizeof(int16) * 9);
+                loadMinHeightPlanes(minHeights);
+            }
+        }
+
+        if (header.liquidMapOffset)
+        {
+            map_liquidHeader liquidHeader;
+            char const* liquidData = static_cast<char const*>(section(header.liquidMapOffset, sizeof(liquidHeader), 1));
+            if (!liquidData)
+                return false;
+
+            memcpy(&liquidHeader, liquidData, sizeof(liquidHeader));
+            if (liquidHeader.fourcc != MapLiquidMagic.asUInt)
+                return false;
+
+            _liquidType = liquidHeader.liquidType;
+            _liquidOffX = liquidHeader.offsetX;
+            _liquidOffY = liquidHeader.offsetY;
+            _liquidWidth = liquidHeader.width;
+            _liquidHeight = liquidHeader.height;
+            _liquidLevel = liquidHeader.liquidLevel;
+
+            std::size_t offset = header.liquidMapOffset + sizeof(liquidHeader);
+            if (!(liquidHeader.flags & MAP_LIQUID_NO_TYPE))
+            {
+                _liquidEntry = static_cast<uint16*>(section(offset, sizeof(uint16) * 16 * 16, alignof(uint16)));
+                offset += sizeof(uint16) * 16 * 16;
+                _liquidFlags = static_cast<uint8*>(section(offset, sizeof(uint8) * 16 * 16, 1));
+                offset += sizeof(uint8) * 16 * 16;
+                if (!_liquidEntry || !_liquidFlags)
+                    return false;
+            }
+            if (!(liquidHeader.flags & MAP_LIQUID_NO_HEIGHT))
+                if (!(_liquidMap = static_cast<float*>(section(offset, sizeof(float) * _liquidWidth * _liquidHeight, alignof(float)))))
+                    return false;
+        }
+
+        // no holes section (zero size) means no holes, an unexpected size is left to the stream loader
+        if (header.holesOffset && header.holesSize)
+        {
+            if (header.holesSize != sizeof(uint16) * 16 * 16)
+                return false;
+
+            if (!(_holes = static_cast<uint16*>(section(header.holesOffset, header.holesSize, alignof(uint16)))))
+                return false;
+        }
+
+        return true;
+    }();
+
+    _mapping = std::move(mapping);
+    if (!loaded)
+    {
+        TC_LOG_DEBUG("maps", "Map file '%s' can not be memory mapped, re-extract maps with aligned sections to map it.", filename);
+        unloadData();
+        return false;
+    }
+
+    return true;
+}
+
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
+    if (_mapping)
+        _mapping.reset();
+    else
+    {
+        delete[] _areaMap;
+        delete[] m_V9;
+        delete[] m_V8;
+        delete[] _liquidEntry;
+        delete[] _liquidFlags;
+        delete[] _liquidMap;
+        delete[] _holes;
+    }
     delete[] _minHeightPlanes;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
-    delete[] _holes;
     _areaMap = nullptr;
     m_V9 = nullptr;
     m_V8 = nullptr;
@@ -1923,43 +2529,48 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
             fread(minHeights.data(), sizeof(int16), minHeights.size(), in) != minHeights.size())
             return false;
 
-        static uint32 constexpr indices[8][3] =
-        {
-            { 3, 0, 4 },
-            { 0, 1, 4 },
-            { 1, 2, 4 },
-            { 2, 5, 4 },
-            { 5, 8, 4 },
-            { 8, 7, 4 },
-            { 7, 6, 4 },
-            { 6, 3, 4 }
-        };
-
-        static float constexpr boundGridCoords[9][2] =
-        {
-            { 0.0f, 0.0f },
-            { 0.0f, -266.66666f },
-            { 0.0f, -533.33331f },
-            { -266.66666f, 0.0f },
-            { -266.66666f, -266.66666f },
-            { -266.66666f, -533.33331f },
-            { -533.33331f, 0.0f },
-            { -533.33331f, -266.66666f },
-            { -533.33331f, -533.33331f }
-        };
-
-        _minHeightPlanes = new G3D::Plane[8];
-        for (uint32 quarterIndex = 0; quarterIndex < 8; ++quarterIndex)
-            _minHeightPlanes[quarterIndex] = G3D::Plane(
-                G3D::Vector3(boundGridCoords[indices[quarterIndex][0]][0], boundGridCoords[indices[quarterIndex][0]][1], minHeights[indices[quarterIndex][0]]),
-                G3D::Vector3(boundGridCoords[indices[quarterIndex][1]][0], boundGridCoords[indices[quarterIndex][1]][1], minHeights[indices[quarterIndex][1]]),
-                G3D::Vector3(boundGridCoords[indices[quarterIndex][2]][0], boundGridCoords[indices[quarterIndex][2]][1], minHeights[indices[quarterIndex][2]])
-            );
+        loadMinHeightPlanes(minHeights);
     }
 
     return true;
 }
 
+void GridMap::loadMinHeightPlanes(std::array<int16, 9> const& minHeights)
+{
+    static uint32 constexpr indices[8][3] =
+    {
+        { 3, 0, 4 },
+        { 0, 1, 4 },
+        { 1, 2, 4 },
+        { 2, 5, 4 },
+        { 5, 8, 4 },
+        { 8, 7, 4 },
+        { 7, 6, 4 },
+        { 6, 3, 4 }
+    };
+
+    static float constexpr boundGridCoords[9][2] =
+    {
+        { 0.0f, 0.0f },
+        { 0.0f, -266.66666f },
+        { 0.0f, -533.33331f },
+        { -266.66666f, 0.0f },
+        { -266.66666f, -266.66666f },
+        { -266.66666f, -533.33331f },
+        { -533.33331f, 0.0f },
+        { -533.33331f, -266.66666f },
+        { -533.33331f, -533.33331f }
+    };
+
+    _minHeightPlanes = new G3D::Plane[8];
+    for (uint32 quarterIndex = 0; quarterIndex < 8; ++quarterIndex)
+        _minHeightPlanes[quarterIndex] = G3D::Plane(
+            G3D::Vector3(boundGridCoords[indices[quarterIndex][0]][0], boundGridCoords[indices[quarterIndex][0]][1], minHeights[indices[quarterIndex][0]]),
+            G3D::Vector3(boundGridCoords[indices[quarterIndex][1]][0], boundGridCoords[indices[quarterIndex][1]][1], minHeights[indices[quarterIndex][1]]),
+            G3D::Vector3(boundGridCoords[indices[quarterIndex][2]][0], boundGridCoords[indices[quarterIndex][2]][1], minHeights[indices[quarterIndex][2]])
+        );
+}
+
 bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 {
     map_liquidHeader header;
@@ -3068,6 +3679,8 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 {
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    auto guard = GuardRegionUpdate();
+
     obj->SetDestroyedObject(true);
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
@@ -3083,6 +3696,8 @@ void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
     if (obj->GetTypeId() != TYPEID_UNIT && obj->GetTypeId() != TYPEID_GAMEOBJECT)
         return;
 
+    auto guard = GuardRegionUpdate();
+
     std::map<WorldObject*, bool>::iterator itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -3854,21 +4469,25 @@ Player* Map::GetPlayer(ObjectGuid guid)
 
 AreaTrigger* Map::GetAreaTrigger(ObjectGuid const& guid)
 {
+    auto guard = GuardRegionUpdate();
     return _objectsStore.Find<AreaTrigger>(guid);
 }
 
 Corpse* Map::GetCorpse(ObjectGuid const& guid)
 {
+    auto guard = GuardRegionUpdate();
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid guid)
 {
+    auto guard = GuardRegionUpdate();
     return _objectsStore.Find<Creature>(guid);
 }
 
 GameObject* Map::GetGameObject(ObjectGuid guid)
 {
+    auto guard = GuardRegionUpdate();
     return _objectsStore.Find<GameObject>(guid);
 }
 
@@ -3883,11 +4502,13 @@ Transport* Map::GetTransport(ObjectGuid guid)
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    auto guard = GuardRegionUpdate();
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
 Creature* Map::GetCreatureBySpawnId(ObjectGuid::LowType spawnId) const
 {
+    auto guard = const_cast<Map*>(this)->GuardRegionUpdate();
     auto const bounds = GetCreatureBySpawnIdStore().equal_range(spawnId);
     if (bounds.first == bounds.second)
         return nullptr;
@@ -3902,6 +4523,7 @@ Creature* Map::GetCreatureBySpawnId(ObjectGuid::LowType spawnId) const
 
 GameObject* Map::GetGameObjectBySpawnId(ObjectGuid::LowType spawnId) const
 {
+    auto guard = const_cast<Map*>(this)->GuardRegionUpdate();
     auto const bounds = GetGameObjectBySpawnIdStore().equal_range(spawnId);
     if (bounds.first == bounds.second)
         return nullptr;
@@ -3916,17 +4538,26 @@ GameObject* Map::GetGameObjectBySpawnId(ObjectGuid::LowType spawnId) const
 
 Pet* Map::GetPet(ObjectGuid const& guid)
 {
+    auto guard = GuardRegionUpdate();
     return _objectsStore.Find<Pet>(guid);
 }
 
 void Map::UpdateIteratorBack(Player* player)
 {
+    if (_regionUpdateActive)
+    {
+        auto guard = GuardRegionUpdate();
+        ForgetRegionAnchor(player);
+    }
+
     if (m_mapRefIter == player->GetMapRef())
         m_mapRefIter = m_mapRefIter->nocheck_prev();
 }
 
 void Map::SaveCreatureRespawnTime(uint32 dbGuid, time_t respawnTime)
 {
+    auto guard = GuardRegionUpdate();
+
     if (!respawnTime)
     {
         // Delete only
@@ -3946,6 +4577,8 @@ void Map::SaveCreatureRespawnTime(uint32 dbGuid, time_t respawnTime)
 
 void Map::RemoveCreatureRespawnTime(uint32 dbGuid)
 {
+    auto guard = GuardRegionUpdate();
+
     _creatureRespawnTimes.erase(dbGuid);
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
@@ -3957,6 +4590,8 @@ void Map::RemoveCreatureRespawnTime(uint32 dbGuid)
 
 void Map::SaveGORespawnTime(uint32 dbGuid, time_t respawnTime)
 {
+    auto guard = GuardRegionUpdate();
+
     if (!respawnTime)
     {
         // Delete only
@@ -3976,6 +4611,8 @@ void Map::SaveGORespawnTime(uint32 dbGuid, time_t respawnTime)
 
 void Map::RemoveGORespawnTime(uint32 dbGuid)
 {
+    auto guard = GuardRegionUpdate();
+
     _goRespawnTimes.erase(dbGuid);
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
@@ -4104,6 +4741,8 @@ void Map::DeleteCorpseData()
 
 void Map::AddCorpse(Corpse *corpse)
 {
+    auto guard = GuardRegionUpdate();
+
     corpse->SetMap(this);
 
     _corpsesByCell[corpse->GetCellCoord().GetId()].insert(corpse);
@@ -4115,6 +4754,8 @@ void Map::AddCorpse(Corpse *corpse)
 
 void Map::RemoveCorpse(Corpse *corpse)
 {
+    auto guard = GuardRegionUpdate();
+
     ASSERT(corpse);
 
     corpse->DestroyForNearbyPlayers();
@@ -33,8 +33,10 @@
 #include "GameObjectModel.h"
 #include "ObjectGuid.h"
 
+#include <array>
 #include <bitset>
 #include <list>
+#include <memory>
 
 class Unit;
 class WorldPacket;
@@ -47,6 +49,7 @@ class TempSummon;
 class Player;
 class ActivePoolData;
 class CreatureGroup;
+class PathfindingService;
 struct ScriptInfo;
 struct ScriptAction;
 struct Position;
@@ -55,8 +58,11 @@ class MapInstanced;
 class BattlegroundMap;
 class InstanceMap;
 class Transport;
+struct MapRegion;
+struct PreloadedGrid;
 namespace Trinity { struct ObjectUpdater; }
 namespace VMAP { enum class ModelIgnoreFlags : uint32; }
+namespace boost { namespace interprocess { class mapped_region; } }
 
 struct ScriptAction
 {
@@ -214,10 +220,15 @@ class TC_GAME_API GridMap
 
     uint16* _holes = nullptr;
 
+    // Read-only view of the whole file when memory mapped, the data pointers above point into it instead of owning copies
+    std::unique_ptr<boost::interprocess::mapped_region> _mapping;
+
+    bool loadMappedData(char const* filename);
     bool loadAreaData(FILE* in, uint32 offset, uint32 size);
     bool loadHeightData(FILE* in, uint32 offset, uint32 size);
     bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
     bool loadHolesData(FILE *in, uint32 offset, uint32 size);
+    void loadMinHeightPlanes(std::array<int16, 9> const& minHeights);
     bool isHole(int row, int col) const;
 
     // Get height functions and pointers
@@ -231,7 +242,7 @@ class TC_GAME_API GridMap
 public:
     GridMap();
     ~GridMap();
-    bool loadData(char* filaname);
+    bool loadData(char* filaname, bool memoryMapped = false);
     void unloadData();
 
     uint16 getArea(float x, float y) const;
@@ -293,6 +304,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 {
     friend class MapReference;
     public:
+        typedef std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> MarkedCells;
+
         Map(uint32 id, time_t, uint32 InstanceId, uint16 SpawnMode, Map* _parent = nullptr);
         virtual ~Map();
 
@@ -319,6 +332,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32);
+        void UpdateRegion(MapRegion& region, uint32 t_diff);
+        uint32 GetUpdateRegionCount() const { return _updateRegionCount; }
 
         float GetVisibilityRange() const { return m_VisibleDistance; }
         void SetVisibilityRange(float distance) { m_VisibleDistance = distance; }
@@ -604,12 +619,25 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         inline ObjectGuid::LowType GenerateLowGuid()
         {
             static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+            auto guard = GuardRegionUpdate();
             return GetGuidSequenceGenerator<high>().Generate();
         }
 
         uint32 GetUpdateTime() const { return m_updateTime; }
-        void AddUpdateObject(Object* object) { m_updatable.insert(object); }
-        void RemoveUpdateObject(Object* object) { m_updatable.erase(object); }
+        // Smoothed cost of the last updates in microseconds, maintained by MapUpdater to order the next tick
+        uint32 GetUpdateCost() const { return m_updateCost; }
+        void RecordUpdateCost(uint32 cost) { m_updateCost = m_updateCost ? (m_updateCost * 3 + cost) / 4 : cost; }
+        uint32 GetUpdateMetric() const { return m_updateMetric; }
+        void AddUpdateObject(Object* object);
+        void RemoveUpdateObject(Object* object);
+
+        // Serializes access to map wide containers while regions of this map are updated in parallel, no-op otherwise
+        std::unique_lock<std::recursive_mutex> GuardRegionUpdate()
+        {
+            if (!_regionUpdateActive)
+                return std::unique_lock<std::recursive_mutex>();
+            return std::unique_lock<std::recursive_mutex>(_regionLock);
+        }
 
         Group* GetInstanceGroup() const;
         Player* GetFirstPlayerInInstance() const;
@@ -629,17 +657,20 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         ActivePoolData& GetPoolData() { return *_poolData; }
         ActivePoolData const& GetPoolData() const { return *_poolData; }
 
+        PathfindingService& GetPathfinding() { return *_pathfinding; }
+
     private:
         void LoadMapAndVMap(int gx, int gy);
         void LoadVMap(int gx, int gy);
         void LoadMap(int gx, int gy, bool reload = false);
-        void LoadMMap(int gx, int gy);
+        void LoadMMap(int gx, int gy, PreloadedGrid* preloaded = nullptr);
         GridMap* GetGrid(float x, float y);
 
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
         void SendInitSelf(Player* player);
 
+        void PlayerCellRelocation(Player* player, bool loadGrid);
         bool CreatureCellRelocation(Creature* creature, Cell new_cell);
         bool GameObjectCellRelocation(GameObject* go, Cell new_cell);
         bool DynamicObjectCellRelocation(DynamicObject* dynObj, Cell new_cell);
@@ -688,6 +719,16 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void ScriptsProcess();
 
         void UpdateActiveCells(const float &x, const float &y, const uint32 t_diff);
+        void PreloadGridsAhead(uint32 diff);
+        void PreloadGridsAhead(Player* player, float distance);
+        void PreloadGridAt(float x, float y);
+
+        bool CanUpdateInRegions() const;
+        bool BuildRegions();
+        bool UpdateRegions(uint32 t_diff);
+        void MergeRegions();
+        MapRegion* GetCurrentRegion() const;
+        void ForgetRegionAnchor(WorldObject* obj);
 
     protected:
         void SetUnloadReferenceLock(const GridCoord &p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadReferenceLock(on); }
@@ -720,6 +761,9 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         TransportsContainer::iterator _transportsUpdateIter;
 
         uint32 m_updateTime = 0;
+        uint32 m_updateCost = 0;
+        uint32 m_updateMetric;                              // map_update timer, shared by the instances of the map
+        int32 _gridPreloadTimer = 0;
 
     private:
         Player* _GetScriptPlayerSourceOrTarget(Object* source, Object* target, const ScriptInfo* scriptInfo) const;
@@ -739,7 +783,13 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         NGridType* i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         GridMap* GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
-        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        MarkedCells marked_cells;
+
+        std::vector<std::unique_ptr<MapRegion>> _regions;
+        std::vector<int32> _regionGridSlots;
+        uint32 _updateRegionCount = 0;
+        bool _regionUpdateActive = false;
+        std::recursive_mutex _regionLock;
 
         bool i_scriptLock;
         std::set<WorldObject*> i_objectsToRemove;
@@ -759,12 +809,17 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         template <class T>
         bool AddToActiveHelper(T* obj)
         {
+            auto guard = GuardRegionUpdate();
             return m_activeNonPlayers.insert(obj).second;
         }
 
         template <class T>
         bool RemoveFromActiveHelper(T* obj)
         {
+            auto guard = GuardRegionUpdate();
+            if (_regionUpdateActive)
+                ForgetRegionAnchor(obj);
+
             // Map::Update for active object in proccess
             if (m_activeNonPlayersIter != m_activeNonPlayers.end())
             {
@@ -792,6 +847,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         std::map<HighGuid, std::unique_ptr<ObjectGuidGeneratorBase>> _guidGenerators;
         std::unique_ptr<ActivePoolData> _poolData;
+        std::unique_ptr<PathfindingService> _pathfinding;
         MapStoredObjectTypesContainer _objectsStore;
         CreatureBySpawnIdContainer _creatureBySpawnIdStore;
         GameObjectBySpawnIdContainer _gameObjectBySpawnIdStore;
@@ -22,6 +22,8 @@
 #include "ObjectAccessor.h"
 #include "Transport.h"
 #include "GridDefines.h"
+#include "GridPreloader.h"
+#include "PathfindingService.h"
 #include "MapInstanced.h"
 #include "InstanceScript.h"
 #include "Config.h"
@@ -69,7 +71,9 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0)
         m_updater.activate(num_threads);
-    
+
+    sGridPreloader->Start(sWorld->getIntConfig(CONFIG_GRID_PRELOAD_THREADS));
+    sPathfindingMgr->Start(sWorld->getIntConfig(CONFIG_PATHFINDING_ASYNC_THREADS), sWorld->getBoolConfig(CONFIG_PATHFINDING_ASYNC_SHARED_SEARCH));
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -396,6 +400,9 @@ void MapManager::Update(uint32 diff)
     if (m_updater.activated())
         m_updater.wait();
 
+    sGridPreloader->Update();
+    sPathfindingMgr->Update(uint32(i_timer.GetCurrent()));
+
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
     sWorld->RecordTimeDiff("MapUpdate");
@@ -429,6 +436,9 @@ bool MapManager::IsValidMAP(uint32 mapid, bool startUp)
 
 void MapManager::UnloadAll()
 {
+    // preloaded grids hold vmap models, drop them while the maps still exist
+    sGridPreloader->Stop();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end();)
     {
         iter->second->UnloadAll();
@@ -436,6 +446,9 @@ void MapManager::UnloadAll()
         i_maps.erase(iter++);
     }
 
+    // every map waited for its last batch while unloading
+    sPathfindingMgr->Stop();
+
     if (m_updater.activated())
         m_updater.deactivate();
 
@@ -0,0 +1,52 @@
+/*
+* This file is part of the Legends of Azeroth Pandaria Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "MapRegion.h"
+
+void MapRegion::Reset()
+{
+    MarkedCells.reset();
+    Players.clear();
+    ActiveObjects.clear();
+    Updatable.clear();
+    RemovedUpdatable.clear();
+    PlayersToMove.clear();
+    CreaturesToMove.clear();
+    GameObjectsToMove.clear();
+    DynamicObjectsToMove.clear();
+    AreaTriggersToMove.clear();
+}
+
+void MapRegionBatch::Run()
+{
+    for (size_t index = _next++; index < _regions.size(); index = _next++)
+    {
+        _map.UpdateRegion(*_regions[index], _diff);
+
+        std::lock_guard<std::mutex> lock(_lock);
+        if (++_done == _regions.size())
+            _condition.notify_all();
+    }
+}
+
+void MapRegionBatch::Wait()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+
+    while (_done < _regions.size())
+        _condition.wait(lock);
+}
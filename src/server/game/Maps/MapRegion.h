@@ -0,0 +1,78 @@
+/*
+* This file is part of the Legends of Azeroth Pandaria Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRINITY_MAP_REGION_H
+#define TRINITY_MAP_REGION_H
+
+#include "Map.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+class AreaTrigger;
+class Creature;
+class DynamicObject;
+class GameObject;
+
+// Group of NGrids of a continent that no other region can reach during one update,
+// so its players and active objects can be updated on their own thread (MapUpdate.Regions.Enable).
+// Side effects that touch map wide containers are collected here and applied by Map::MergeRegions.
+struct MapRegion
+{
+    explicit MapRegion(Map* owner) : Owner(owner) { }
+
+    void Reset();
+
+    Map* Owner;
+    Map::MarkedCells MarkedCells;
+
+    std::vector<Player*> Players;
+    std::vector<WorldObject*> ActiveObjects;
+
+    std::set<Object*> Updatable;
+    std::vector<Object*> RemovedUpdatable;
+
+    std::vector<Player*> PlayersToMove;
+    std::vector<Creature*> CreaturesToMove;
+    std::vector<GameObject*> GameObjectsToMove;
+    std::vector<DynamicObject*> DynamicObjectsToMove;
+    std::vector<AreaTrigger*> AreaTriggersToMove;
+};
+
+// Regions of one map update shared between the map worker and the helper tasks it scheduled.
+// Whoever runs first claims the next region, so a helper starting late simply finds nothing left.
+class MapRegionBatch
+{
+    public:
+        MapRegionBatch(Map& map, uint32 diff, std::vector<MapRegion*> regions)
+            : _map(map), _diff(diff), _regions(std::move(regions)), _next(0), _done(0) { }
+
+        void Run();
+        void Wait();
+
+    private:
+        Map& _map;
+        uint32 _diff;
+        std::vector<MapRegion*> _regions;
+        std::atomic<size_t> _next;
+
+        std::mutex _lock;
+        std::condition_variable _condition;
+        size_t _done;
+};
+
+#endif
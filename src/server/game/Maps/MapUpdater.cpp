@@ -17,71 +17,217 @@
 
 #include "DatabaseEnv.h"
 #include "MapUpdater.h"
+#include "Metrics.h"
 #include "Map.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <mutex>
 
-class MapUpdateRequest
+namespace
 {
-    private:
+    // Identifies the updater and queue owned by the current thread, so that requests scheduled
+    // from inside Map::Update (MapInstanced) land in the local queue instead of the staging area.
+    thread_local MapUpdater const* WorkerOwner = nullptr;
+    thread_local size_t WorkerIndex = std::numeric_limits<size_t>::max();
 
-        Map& m_map;
-        MapUpdater& m_updater;
-        uint32 m_diff;
-
-    public:
-
-        MapUpdateRequest(Map& m, MapUpdater& u, uint32 d)
-            : m_map(m), m_updater(u), m_diff(d)
-        {
-        }
-
-        void call()
-        {
-            //TC_METRIC_TIMER("map_update_time_diff", TC_METRIC_TAG("map_id", std::to_string(m_map.GetId())));
-            m_map.Update (m_diff);
-            m_updater.update_finished();
-        }
-};
+    bool CostlierRequest(MapUpdateRequest const& left, MapUpdateRequest const& right)
+    {
+        return left.cost > right.cost;
+    }
+}
 
 void MapUpdater::activate(size_t num_threads)
 {
+    for (size_t i = 0; i < num_threads; ++i)
+        _queues.push_back(std::make_unique<WorkerQueue>());
+
     for (size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
 void MapUpdater::deactivate()
 {
-    _cancelationToken = true;
-
     wait();
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _cancelationToken = true;
+    }
+
+    _workCondition.notify_all();
 
     for (auto& thread : _workerThreads)
     {
         thread.join();
     }
+
+    _workerThreads.clear();
+    _queues.clear();
 }
 
 void MapUpdater::wait()
 {
+    auto start = std::chrono::steady_clock::now();
+
+    dispatch_staged();
+
     std::unique_lock<std::mutex> lock(_lock);
 
-    while (pending_requests > 0)
+    while (_pendingRequests > 0)
         _condition.wait(lock);
 
     lock.unlock();
+
+    _lastTickTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
 }
 
 void MapUpdater::schedule_update(Map& map, uint32 diff)
 {
+    enqueue({ &map, diff, map.GetUpdateCost(), nullptr });
+}
+
+void MapUpdater::schedule_task(std::function<void()>&& task, uint32 cost)
+{
+    enqueue({ nullptr, 0, cost, std::move(task) });
+}
+
+void MapUpdater::enqueue(MapUpdateRequest&& request)
+{
+    if (WorkerOwner == this)
+    {
+        ++_pendingRequests;
+
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            ++_queuedRequests;
+        }
+
+        push_request(*_queues[WorkerIndex], std::move(request));
+
+        _workCondition.notify_one();
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(_lock);
 
-    ++pending_requests;
+    ++_pendingRequests;
+
+    _stagedRequests.push_back(std::move(request));
+}
+
+void MapUpdater::dispatch_staged()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        if (_stagedRequests.empty())
+            return;
+
+        for (auto& queue : _queues)
+        {
+            queue->Updates = 0;
+            queue->Steals = 0;
+            queue->BusyTime = 0;
+        }
+
+        // Longest processing time first: the most expensive maps start first, each on the least loaded worker
+        std::stable_sort(_stagedRequests.begin(), _stagedRequests.end(), CostlierRequest);
+
+        _queuedRequests += _stagedRequests.size();
+
+        for (MapUpdateRequest& request : _stagedRequests)
+        {
+            auto queue = std::min_element(_queues.begin(), _queues.end(), [](std::unique_ptr<WorkerQueue> const& left, std::unique_ptr<WorkerQueue> const& right)
+            {
+                return left->RemainingCost < right->RemainingCost;
+            });
+
+            push_request(**queue, std::move(request));
+        }
+
+        _stagedRequests.clear();
+    }
+
+    _workCondition.notify_all();
+}
+
+void MapUpdater::push_request(WorkerQueue& queue, MapUpdateRequest&& request)
+{
+    std::lock_guard<std::mutex> lock(queue.Lock);
+
+    queue.RemainingCost += std::max<uint32>(request.cost, 1);
+
+    auto itr = std::upper_bound(queue.Requests.begin() + queue.Head, queue.Requests.end(), request, CostlierRequest);
+    queue.Requests.insert(itr, std::move(request));
+}
+
+bool MapUpdater::pop_request(size_t index, MapUpdateRequest& request)
+{
+    WorkerQueue& queue = *_queues[index];
+    std::lock_guard<std::mutex> lock(queue.Lock);
+
+    if (queue.Head >= queue.Requests.size())
+        return false;
+
+    request = std::move(queue.Requests[queue.Head++]);
+    queue.RemainingCost -= std::max<uint32>(request.cost, 1);
+
+    if (queue.Head == queue.Requests.size())
+    {
+        queue.Requests.clear();
+        queue.Head = 0;
+    }
+
+    --_queuedRequests;
+    return true;
+}
+
+bool MapUpdater::steal_request(size_t index, MapUpdateRequest& request)
+{
+    while (_queuedRequests > 0)
+    {
+        WorkerQueue* victim = nullptr;
+        uint64 victimCost = 0;
+        for (size_t i = 0; i < _queues.size(); ++i)
+        {
+            if (i == index)
+                continue;
+
+            uint64 cost = _queues[i]->RemainingCost;
+            if (cost > victimCost)
+            {
+                victim = _queues[i].get();
+                victimCost = cost;
+            }
+        }
+
+        if (!victim)
+            return false;
+
+        std::lock_guard<std::mutex> lock(victim->Lock);
+
+        // Someone else may have emptied it in the meantime, look again
+        if (victim->Head >= victim->Requests.size())
+            continue;
+
+        request = std::move(victim->Requests[victim->Head++]);
+        victim->RemainingCost -= std::max<uint32>(request.cost, 1);
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff));
+        if (victim->Head == victim->Requests.size())
+        {
+            victim->Requests.clear();
+            victim->Head = 0;
+        }
+
+        --_queuedRequests;
+        ++_queues[index]->Steals;
+        return true;
+    }
+
+    return false;
 }
 
 bool MapUpdater::activated()
@@ -89,32 +235,75 @@ bool MapUpdater::activated()
     return _workerThreads.size() > 0;
 }
 
+std::vector<MapUpdaterWorkerStats> MapUpdater::GetWorkerStats() const
+{
+    std::vector<MapUpdaterWorkerStats> stats;
+    stats.reserve(_queues.size());
+
+    for (auto const& queue : _queues)
+        stats.push_back({ queue->Updates, queue->Steals, queue->BusyTime });
+
+    return stats;
+}
+
 void MapUpdater::update_finished()
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    if (--_pendingRequests > 0)
+        return;
 
-    --pending_requests;
+    std::lock_guard<std::mutex> lock(_lock);
 
     _condition.notify_all();
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::WorkerThread(size_t index)
 {
+    WorkerOwner = this;
+    WorkerIndex = index;
+
     LoginDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
 
+    WorkerQueue& queue = *_queues[index];
+
     while (true)
     {
-        MapUpdateRequest* request = nullptr;
+        MapUpdateRequest request;
+
+        if (!pop_request(index, request) && !steal_request(index, request))
+        {
+            std::unique_lock<std::mutex> lock(_lock);
 
-        _queue.WaitAndPop(request);
+            while (!_cancelationToken && _queuedRequests == 0)
+                _workCondition.wait(lock);
 
-        if (_cancelationToken)
-            return;
+            if (_cancelationToken)
+                return;
+
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        if (request.map)
+            request.map->Update(request.diff);
+        else
+        {
+            request.task();
+            request.task = nullptr;
+        }
+
+        uint64 elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        if (request.map)
+        {
+            request.map->RecordUpdateCost(uint32(std::min<uint64>(elapsed, std::numeric_limits<uint32>::max())));
+            sMetrics->Record(request.map->GetUpdateMetric(), elapsed);
+        }
 
-        request->call();
+        ++queue.Updates;
+        queue.BusyTime += elapsed;
 
-        delete request;
+        update_finished();
     }
 }
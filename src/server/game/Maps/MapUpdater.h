@@ -18,26 +18,51 @@
 #ifndef _MAP_UPDATER_H_INCLUDED
 #define _MAP_UPDATER_H_INCLUDED
 
+#include <atomic>
 #include <condition_variable>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
-#include "ProducerConsumerQueue.h"
+#include "Define.h"
 
 class Map;
-class MapUpdateRequest;
 
+struct MapUpdateRequest
+{
+    Map* map;
+    uint32 diff;
+    uint32 cost;
+    std::function<void()> task;                         // executed instead of a map update when map is null
+};
+
+struct MapUpdaterWorkerStats
+{
+    uint32 Updates;                                     // maps updated by the worker during the last tick
+    uint32 Steals;                                      // requests taken from other workers' queues
+    uint64 BusyTime;                                    // microseconds spent inside Map::Update during the last tick
+};
+
+// Work-stealing map update scheduler.
+// Requests scheduled from the world thread are staged until wait(), then sorted by their
+// last update cost and distributed over the worker queues (largest first, to the least loaded worker).
+// Requests scheduled from a worker (instances of a MapInstanced) go to that worker's own queue.
+// Idle workers steal the largest remaining request from the most loaded queue.
 class MapUpdater
 {
     public:
 
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
+        MapUpdater() : _cancelationToken(false), _pendingRequests(0), _queuedRequests(0), _lastTickTime(0) {}
         ~MapUpdater() { };
 
-        friend class MapUpdateRequest;
-
         void schedule_update(Map& map, uint32 diff);
 
+        // Runs a piece of work belonging to a map being updated (see Map::UpdateRegions).
+        // Only starts before the next wait() when called from a worker thread.
+        void schedule_task(std::function<void()>&& task, uint32 cost);
+
         void wait();
 
         void activate(size_t num_threads);
@@ -46,20 +71,45 @@ class MapUpdater
 
         bool activated();
 
+        std::vector<MapUpdaterWorkerStats> GetWorkerStats() const;
+        uint64 GetLastTickTime() const { return _lastTickTime; }  // microseconds between dispatch and completion of the last tick
+
     private:
 
-        ProducerConsumerQueue<MapUpdateRequest*> _queue;
+        struct WorkerQueue
+        {
+            std::mutex Lock;
+            std::vector<MapUpdateRequest> Requests;     // sorted by descending cost starting at Head, storage reused between ticks
+            size_t Head = 0;
+            std::atomic<uint64> RemainingCost{ 0 };
+
+            std::atomic<uint32> Updates{ 0 };
+            std::atomic<uint32> Steals{ 0 };
+            std::atomic<uint64> BusyTime{ 0 };
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> _queues;
+        std::vector<MapUpdateRequest> _stagedRequests;
 
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
         std::mutex _lock;
         std::condition_variable _condition;
-        size_t pending_requests;
+        std::condition_variable _workCondition;
+        std::atomic<size_t> _pendingRequests;
+        std::atomic<size_t> _queuedRequests;
+        std::atomic<uint64> _lastTickTime;
+
+        void dispatch_staged();
+        void enqueue(MapUpdateRequest&& request);
+        void push_request(WorkerQueue& queue, MapUpdateRequest&& request);
+        bool pop_request(size_t index, MapUpdateRequest& request);
+        bool steal_request(size_t index, MapUpdateRequest& request);
 
         void update_finished();
 
-        void WorkerThread();
+        void WorkerThread(size_t index);
 
 };
 
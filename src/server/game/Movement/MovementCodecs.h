@@ -0,0 +1,523 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SF_MOVEMENT_CODECS_H
+#define SF_MOVEMENT_CODECS_H
+
+#include "MovementStructures.h"
+#include "ByteBuffer.h"
+#include "Errors.h"
+#include <G3D/g3dmath.h>
+#include <utility>
+
+// Straight-line readers and writers generated from the MovementStatusElements sequences.
+// Every element of a sequence is resolved at compile time, so a codec is only the reads and
+// writes of its opcode. Player::ReadMovementInfoInterpreted and Unit::WriteMovementInfoInterpreted
+// still walk the sequences at runtime, Movement.ValidateCodecs compares both on every packet.
+namespace Movement
+{
+    struct MovementReadContext
+    {
+        MovementReadContext(ByteBuffer& data, MovementInfo* info, ExtraMovementStatusElement* extras) : Data(data), Info(info), Extras(extras) { }
+
+        ByteBuffer& Data;
+        MovementInfo* Info;
+        ExtraMovementStatusElement* Extras;
+
+        ObjectGuid Guid;
+        ObjectGuid TransportGuid;
+        bool HasMountDisplayId = false;
+        bool HasMovementFlags = false;
+        bool HasMovementFlags2 = false;
+        bool HasTimestamp = false;
+        bool HasOrientation = false;
+        bool HasTransportData = false;
+        bool HasTransportTime2 = false;
+        bool HasTransportTime3 = false;
+        bool HasPitch = false;
+        bool HasFallData = false;
+        bool HasFallDirection = false;
+        bool HasSplineElevation = false;
+        bool HasCounter = false;
+        uint32 ForcesCount = 0;
+
+        // applied to the unit by the caller
+        bool MountDisplayIdRead = false;
+        uint32 MountDisplayId = 0;
+    };
+
+    // Everything Unit::WriteMovementInfo takes from the unit, gathered before the sequence is written
+    struct MovementWriteContext
+    {
+        MovementWriteContext(ByteBuffer& data, ExtraMovementStatusElement* extras, MovementInfo const& info, uint32& counter) : Data(data), Extras(extras), Info(info), Counter(counter) { }
+
+        ByteBuffer& Data;
+        ExtraMovementStatusElement* Extras;
+        MovementInfo const& Info;
+        uint32& Counter;                                    // Unit::m_movementCounter
+
+        ObjectGuid Guid;
+        ObjectGuid TransportGuid;
+        float PositionX = 0.0f;                             // transport offset for SMSG_MOVE_TELEPORT on a transport
+        float PositionY = 0.0f;
+        float PositionZ = 0.0f;
+        float Orientation = 0.0f;
+        float TransportPositionX = 0.0f;
+        float TransportPositionY = 0.0f;
+        float TransportPositionZ = 0.0f;
+        float TransportOrientation = 0.0f;
+        int8 TransportSeat = 0;
+        uint32 TransportTime = 0;
+        uint32 MountDisplayId = 0;
+        uint32 MovementFlags = 0;
+        uint16 MovementFlags2 = 0;
+        uint32 Timestamp = 0;
+
+        bool HasMountDisplayId = false;
+        bool HasMovementFlags = false;
+        bool HasMovementFlags2 = false;
+        bool HasTimestamp = false;
+        bool HasOrientation = false;
+        bool HasTransportData = false;
+        bool HasSpline = false;
+        bool HasTransportTime2 = false;
+        bool HasTransportTime3 = false;
+        bool HasPitch = false;
+        bool HasFallData = false;
+        bool HasFallDirection = false;
+        bool HasSplineElevation = false;
+    };
+
+    struct MovementCodec
+    {
+        void (*Read)(MovementReadContext& context);
+        void (*Write)(MovementWriteContext& context);
+    };
+
+    // nullptr when the opcode has no movement sequence
+    MovementCodec const* GetMovementCodec(uint32 opcode);
+
+    // Same bytes and pending bits, used by the codec validation
+    bool IsSameMovementPacket(ByteBuffer const& left, ByteBuffer const& right);
+    bool IsSameMovementInfo(MovementInfo const& left, MovementInfo const& right);
+
+    template<MovementStatusElements Element>
+    inline void ReadElement(MovementReadContext& context)
+    {
+        ByteBuffer& data = context.Data;
+        MovementInfo* mi = context.Info;
+
+        if constexpr (Element >= MSEHasGuidByte0 && Element <= MSEHasGuidByte7)
+            context.Guid[Element - MSEHasGuidByte0] = data.ReadBit();
+        else if constexpr (Element >= MSEHasTransportGuidByte0 && Element <= MSEHasTransportGuidByte7)
+        {
+            if (context.HasTransportData)
+                context.TransportGuid[Element - MSEHasTransportGuidByte0] = data.ReadBit();
+        }
+        else if constexpr (Element >= MSEGuidByte0 && Element <= MSEGuidByte7)
+            data.ReadByteSeq(context.Guid[Element - MSEGuidByte0]);
+        else if constexpr (Element >= MSETransportGuidByte0 && Element <= MSETransportGuidByte7)
+        {
+            if (context.HasTransportData)
+                data.ReadByteSeq(context.TransportGuid[Element - MSETransportGuidByte0]);
+        }
+        else if constexpr (Element == MSEHasMovementFlags)
+            context.HasMovementFlags = !data.ReadBit();
+        else if constexpr (Element == MSEHasMovementFlags2)
+            context.HasMovementFlags2 = !data.ReadBit();
+        else if constexpr (Element == MSEHasTimestamp)
+            context.HasTimestamp = !data.ReadBit();
+        else if constexpr (Element == MSEHasOrientation)
+            context.HasOrientation = !data.ReadBit();
+        else if constexpr (Element == MSEHasTransportData)
+            context.HasTransportData = data.ReadBit();
+        else if constexpr (Element == MSEHasTransportTime2)
+        {
+            if (context.HasTransportData)
+                context.HasTransportTime2 = data.ReadBit();
+        }
+        else if constexpr (Element == MSEHasTransportTime3)
+        {
+            if (context.HasTransportData)
+                context.HasTransportTime3 = data.ReadBit();
+        }
+        else if constexpr (Element == MSEHasPitch)
+            context.HasPitch = !data.ReadBit();
+        else if constexpr (Element == MSEHasFallData)
+            context.HasFallData = data.ReadBit();
+        else if constexpr (Element == MSEHasFallDirection)
+        {
+            if (context.HasFallData)
+                context.HasFallDirection = data.ReadBit();
+        }
+        else if constexpr (Element == MSEHasSplineElevation)
+            context.HasSplineElevation = !data.ReadBit();
+        else if constexpr (Element == MSEHasSpline || Element == MSEZeroBit || Element == MSEOneBit)
+            data.ReadBit();
+        else if constexpr (Element == MSEHasMountDisplayId)
+            context.HasMountDisplayId = !data.ReadBit();
+        else if constexpr (Element == MSEMountDisplayIdWithCheck || Element == MSEMountDisplayIdWithoutCheck)
+        {
+            if (Element == MSEMountDisplayIdWithoutCheck || context.HasMountDisplayId)
+            {
+                data >> context.MountDisplayId;
+                context.MountDisplayIdRead = true;
+            }
+        }
+        else if constexpr (Element == MSEMovementFlags)
+        {
+            if (context.HasMovementFlags)
+                mi->flags = data.ReadBits(30);
+        }
+        else if constexpr (Element == MSEMovementFlags2)
+        {
+            if (context.HasMovementFlags2)
+                mi->flags2 = data.ReadBits(13);
+        }
+        else if constexpr (Element == MSETimestamp)
+        {
+            if (context.HasTimestamp)
+                data >> mi->time;
+        }
+        else if constexpr (Element == MSEPositionX)
+            data >> mi->pos.m_positionX;
+        else if constexpr (Element == MSEPositionY)
+            data >> mi->pos.m_positionY;
+        else if constexpr (Element == MSEPositionZ)
+            data >> mi->pos.m_positionZ;
+        else if constexpr (Element == MSEOrientation)
+        {
+            if (context.HasOrientation)
+                mi->pos.SetOrientation(data.read<float>());
+        }
+        else if constexpr (Element == MSETransportPositionX)
+        {
+            if (context.HasTransportData)
+                data >> mi->transport.pos.m_positionX;
+        }
+        else if constexpr (Element == MSETransportPositionY)
+        {
+            if (context.HasTransportData)
+                data >> mi->transport.pos.m_positionY;
+        }
+        else if constexpr (Element == MSETransportPositionZ)
+        {
+            if (context.HasTransportData)
+                data >> mi->transport.pos.m_positionZ;
+        }
+        else if constexpr (Element == MSETransportOrientation)
+        {
+            if (context.HasTransportData)
+                mi->transport.pos.SetOrientation(data.read<float>());
+        }
+        else if constexpr (Element == MSETransportSeat)
+        {
+            if (context.HasTransportData)
+                data >> mi->transport.seat;
+        }
+        else if constexpr (Element == MSETransportTime)
+        {
+            if (context.HasTransportData)
+                data >> mi->transport.time;
+        }
+        else if constexpr (Element == MSETransportTime2)
+        {
+            if (context.HasTransportData && context.HasTransportTime2)
+                data >> mi->transport.time2;
+        }
+        else if constexpr (Element == MSETransportTime3)
+        {
+            if (context.HasTransportData && context.HasTransportTime3)
+                data >> mi->transport.time3;
+        }
+        else if constexpr (Element == MSEPitch)
+        {
+            if (context.HasPitch)
+                mi->pitch = G3D::wrap(data.read<float>(), float(-M_PI), float(M_PI));
+        }
+        else if constexpr (Element == MSEFallTime)
+        {
+            if (context.HasFallData)
+                data >> mi->jump.fallTime;
+        }
+        else if constexpr (Element == MSEFallVerticalSpeed)
+        {
+            if (context.HasFallData)
+                data >> mi->jump.zspeed;
+        }
+        else if constexpr (Element == MSEFallCosAngle)
+        {
+            if (context.HasFallData && context.HasFallDirection)
+                data >> mi->jump.cosAngle;
+        }
+        else if constexpr (Element == MSEFallSinAngle)
+        {
+            if (context.HasFallData && context.HasFallDirection)
+                data >> mi->jump.sinAngle;
+        }
+        else if constexpr (Element == MSEFallHorizontalSpeed)
+        {
+            if (context.HasFallData && context.HasFallDirection)
+                data >> mi->jump.xyspeed;
+        }
+        else if constexpr (Element == MSESplineElevation)
+        {
+            if (context.HasSplineElevation)
+                data >> mi->splineElevation;
+        }
+        else if constexpr (Element == MSEForcesCount)
+            context.ForcesCount = data.ReadBits(22);
+        else if constexpr (Element == MSEForces)
+        {
+            for (uint32 i = 0; i < context.ForcesCount; i++)
+                data.read_skip<uint32>();
+        }
+        else if constexpr (Element == MSEHasCounter)
+            context.HasCounter = !data.ReadBit();
+        else if constexpr (Element == MSECounter)
+        {
+            if (context.HasCounter)
+                data.read_skip<uint32>();
+        }
+        else if constexpr (Element == MSECount)
+            data.read_skip<uint32>();
+        else if constexpr (Element == MSEExtraElement)
+            context.Extras->ReadNextElement(data);
+        else
+            ASSERT(PrintInvalidSequenceElement(Element, "Movement::ReadElement"));
+    }
+
+    template<MovementStatusElements Element>
+    inline void WriteElement(MovementWriteContext& context)
+    {
+        ByteBuffer& data = context.Data;
+        MovementInfo const& mi = context.Info;
+
+        if constexpr (Element >= MSEHasGuidByte0 && Element <= MSEHasGuidByte7)
+            data.WriteBit(context.Guid[Element - MSEHasGuidByte0]);
+        else if constexpr (Element >= MSEHasTransportGuidByte0 && Element <= MSEHasTransportGuidByte7)
+        {
+            if (context.HasTransportData)
+                data.WriteBit(context.TransportGuid[Element - MSEHasTransportGuidByte0]);
+        }
+        else if constexpr (Element >= MSEGuidByte0 && Element <= MSEGuidByte7)
+            data.WriteByteSeq(context.Guid[Element - MSEGuidByte0]);
+        else if constexpr (Element >= MSETransportGuidByte0 && Element <= MSETransportGuidByte7)
+        {
+            if (context.HasTransportData)
+                data.WriteByteSeq(context.TransportGuid[Element - MSETransportGuidByte0]);
+        }
+        else if constexpr (Element == MSEHasCounter)
+            data.WriteBit(!context.Counter);
+        else if constexpr (Element == MSEHasMovementFlags)
+            data.WriteBit(!context.HasMovementFlags);
+        else if constexpr (Element == MSEHasMovementFlags2)
+            data.WriteBit(!context.HasMovementFlags2);
+        else if constexpr (Element == MSEHasMountDisplayId)
+            data.WriteBit(!context.HasMountDisplayId);
+        else if constexpr (Element == MSEHasTimestamp)
+            data.WriteBit(!context.HasTimestamp);
+        else if constexpr (Element == MSEHasOrientation)
+            data.WriteBit(!context.HasOrientation);
+        else if constexpr (Element == MSEHasTransportData)
+            data.WriteBit(context.HasTransportData);
+        else if constexpr (Element == MSEHasTransportTime2)
+        {
+            if (context.HasTransportData)
+                data.WriteBit(context.HasTransportTime2);
+        }
+        else if constexpr (Element == MSEHasTransportTime3)
+        {
+            if (context.HasTransportData)
+                data.WriteBit(context.HasTransportTime3);
+        }
+        else if constexpr (Element == MSEHasPitch)
+            data.WriteBit(!context.HasPitch);
+        else if constexpr (Element == MSEHasFallData)
+            data.WriteBit(context.HasFallData);
+        else if constexpr (Element == MSEHasFallDirection)
+        {
+            if (context.HasFallData)
+                data.WriteBit(context.HasFallDirection);
+        }
+        else if constexpr (Element == MSEHasSplineElevation)
+            data.WriteBit(!context.HasSplineElevation);
+        else if constexpr (Element == MSEHasSpline)
+            data.WriteBit(context.HasSpline);
+        else if constexpr (Element == MSEMountDisplayIdWithCheck || Element == MSEMountDisplayIdWithoutCheck)
+        {
+            if (Element == MSEMountDisplayIdWithoutCheck || context.HasMountDisplayId)
+                data << context.MountDisplayId;
+        }
+        else if constexpr (Element == MSEMovementFlags)
+        {
+            if (context.HasMovementFlags)
+                data.WriteBits(context.MovementFlags, 30);
+        }
+        else if constexpr (Element == MSEMovementFlags2)
+        {
+            if (context.HasMovementFlags2)
+                data.WriteBits(context.MovementFlags2, 13);
+        }
+        else if constexpr (Element == MSETimestamp)
+        {
+            if (context.HasTimestamp)
+                data << context.Timestamp;
+        }
+        else if constexpr (Element == MSEPositionX)
+            data << context.PositionX;
+        else if constexpr (Element == MSEPositionY)
+            data << context.PositionY;
+        else if constexpr (Element == MSEPositionZ)
+            data << context.PositionZ;
+        else if constexpr (Element == MSEOrientation || Element == MSEOrientationWithoutCheck)
+        {
+            if (Element == MSEOrientationWithoutCheck || context.HasOrientation)
+                data << context.Orientation;
+        }
+        else if constexpr (Element == MSETransportPositionX)
+        {
+            if (context.HasTransportData)
+                data << context.TransportPositionX;
+        }
+        else if constexpr (Element == MSETransportPositionY)
+        {
+            if (context.HasTransportData)
+                data << context.TransportPositionY;
+        }
+        else if constexpr (Element == MSETransportPositionZ)
+        {
+            if (context.HasTransportData)
+                data << context.TransportPositionZ;
+        }
+        else if constexpr (Element == MSETransportOrientation)
+        {
+            if (context.HasTransportData)
+                data << context.TransportOrientation;
+        }
+        else if constexpr (Element == MSETransportSeat)
+        {
+            if (context.HasTransportData)
+                data << context.TransportSeat;
+        }
+        else if constexpr (Element == MSETransportTime)
+        {
+            if (context.HasTransportData)
+                data << context.TransportTime;
+        }
+        else if constexpr (Element == MSETransportTime2)
+        {
+            if (context.HasTransportData && context.HasTransportTime2)
+                data << mi.transport.time2;
+        }
+        else if constexpr (Element == MSETransportTime3)
+        {
+            if (context.HasTransportData && context.HasTransportTime3)
+                data << mi.transport.time3;
+        }
+        else if constexpr (Element == MSEPitch)
+        {
+            if (context.HasPitch)
+                data << mi.pitch;
+        }
+        else if constexpr (Element == MSEFallTime)
+        {
+            if (context.HasFallData)
+                data << mi.jump.fallTime;
+        }
+        else if constexpr (Element == MSEFallVerticalSpeed)
+        {
+            if (context.HasFallData)
+                data << mi.jump.zspeed;
+        }
+        else if constexpr (Element == MSEFallCosAngle)
+        {
+            if (context.HasFallData && context.HasFallDirection)
+                data << mi.jump.cosAngle;
+        }
+        else if constexpr (Element == MSEFallSinAngle)
+        {
+            if (context.HasFallData && context.HasFallDirection)
+                data << mi.jump.sinAngle;
+        }
+        else if constexpr (Element == MSEFallHorizontalSpeed)
+        {
+            if (context.HasFallData && context.HasFallDirection)
+                data << mi.jump.xyspeed;
+        }
+        else if constexpr (Element == MSESplineElevation)
+        {
+            if (context.HasSplineElevation)
+                data << mi.splineElevation;
+        }
+        else if constexpr (Element == MSEForcesCount)
+            data.WriteBits(0, 22);
+        else if constexpr (Element == MSECounter)
+        {
+            if (context.Counter)
+                data << context.Counter;
+            context.Counter++;
+        }
+        else if constexpr (Element == MSECount)
+            data << context.Counter++;
+        else if constexpr (Element == MSEZeroBit)
+            data.WriteBit(0);
+        else if constexpr (Element == MSEOneBit)
+            data.WriteBit(1);
+        else if constexpr (Element == MSEExtraElement)
+            context.Extras->WriteNextElement(data);
+        else if constexpr (Element == MSEUintCount)
+            data << uint32(0);
+        else if constexpr (Element != MSEForces)            // no forces are sent
+            ASSERT(PrintInvalidSequenceElement(Element, "Movement::WriteElement"));
+    }
+
+    template<auto const& Sequence>
+    constexpr std::size_t GetSequenceLength()
+    {
+        std::size_t length = 0;
+        while (Sequence[length] != MSEEnd)
+            ++length;
+        return length;
+    }
+
+    template<auto const& Sequence, std::size_t... Index>
+    inline void ReadSequence(MovementReadContext& context, std::index_sequence<Index...>)
+    {
+        (ReadElement<Sequence[Index]>(context), ...);
+    }
+
+    template<auto const& Sequence, std::size_t... Index>
+    inline void WriteSequence(MovementWriteContext& context, std::index_sequence<Index...>)
+    {
+        (WriteElement<Sequence[Index]>(context), ...);
+    }
+
+    template<auto const& Sequence>
+    void ReadMovement(MovementReadContext& context)
+    {
+        ReadSequence<Sequence>(context, std::make_index_sequence<GetSequenceLength<Sequence>()>());
+    }
+
+    template<auto const& Sequence>
+    void WriteMovement(MovementWriteContext& context)
+    {
+        WriteSequence<Sequence>(context, std::make_index_sequence<GetSequenceLength<Sequence>()>());
+    }
+}
+
+#endif
@@ -26,13 +26,13 @@
 #include "Player.h"
 #include "Transport.h"
 #include "Spell.h"
+#include "PathfindingService.h"
 
 template<class T, typename D>
 bool TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool updateDestination)
 {
     enum
     {
-        REACH_TIME      = 1000, // How much time it takes for a pet to reach its owner
         LEADING_TIME    = 1000, // How far into the future to predict owner's movement
         LEADING_STEPS   = 4,    // How many segments to split the leading path into. 1 is fastest but can result in issues when moving on slopes
     };
@@ -185,7 +185,20 @@ bool TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
     bool forceDest = (owner->GetTypeId() == TYPEID_UNIT && owner->ToCreature()->IsPet()
         && owner->HasUnitState(UNIT_STATE_FOLLOW));
 
+    if (!forceDest && _requestAsyncPath(owner, x, y, z, updateDestination, leadingTarget))
+        return false;
+
     bool result = i_path->CalculatePath(x, y, z, forceDest);
+    return _launchPath(owner, result, x, y, z, forceDest, updateDestination, leadingTarget);
+}
+
+template<class T, typename D>
+bool TargetedMovementGeneratorMedium<T, D>::_launchPath(T* owner, bool result, float x, float y, float z, bool forceDest, bool updateDestination, bool leadingTarget)
+{
+    enum
+    {
+        REACH_TIME      = 1000, // How much time it takes for a pet to reach its owner
+    };
 
     if (!result || (i_path->GetPathType() & PATHFIND_NOPATH) && !forceDest)
     {
@@ -241,6 +254,60 @@ bool TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
     return true;
 }
 
+template<class T, typename D>
+bool TargetedMovementGeneratorMedium<T, D>::_requestAsyncPath(T* owner, float x, float y, float z, bool updateDestination, bool leadingTarget)
+{
+    if (owner->GetTypeId() != TYPEID_UNIT || owner->VisualizePathfinding || !sPathfindingMgr->IsEnabled())
+        return false;
+
+    PathfindingRequest request;
+    if (!i_path->PrepareAsyncPath(x, y, z, request))
+        return false;
+
+    request.Target = i_target->GetGUID();
+    i_target->GetPosition(request.TargetPosition.x, request.TargetPosition.y, request.TargetPosition.z);
+
+    i_pathTicket = owner->GetMap()->GetPathfinding().Request(std::move(request));
+    if (!i_pathTicket)
+        return false;
+
+    i_pathMap = owner->GetMap();
+    i_pathDestination = G3D::Vector3(x, y, z);
+    i_pathUpdateDestination = updateDestination;
+    i_pathLeadingTarget = leadingTarget;
+    return true;
+}
+
+// return: false while the path is still being solved
+template<class T, typename D>
+bool TargetedMovementGeneratorMedium<T, D>::_updateAsyncPath(T* owner)
+{
+    PathfindingResult const* result = nullptr;
+    if (i_pathMap == owner->GetMap())
+    {
+        bool pending;
+        result = owner->GetMap()->GetPathfinding().GetResult(i_pathTicket, pending);
+        if (pending)
+            return false;
+    }
+
+    i_pathTicket = 0;
+
+    // the target may have come in reach while the path was solved
+    if (static_cast<D*>(this)->IsTargetReachableNow(owner, false))
+        return true;
+
+    G3D::Vector3 const& dest = i_pathDestination;
+    bool calculated = true;
+    if (result && result->Solved)
+        i_path->ApplyAsyncPath(*result);
+    else
+        calculated = i_path->CalculatePath(dest.x, dest.y, dest.z);
+
+    _launchPath(owner, calculated, dest.x, dest.y, dest.z, false, i_pathUpdateDestination, i_pathLeadingTarget);
+    return true;
+}
+
 template<class T, typename D>
 bool TargetedMovementGeneratorMedium<T, D>::DoUpdate(T* owner, uint32 time_diff)
 {
@@ -335,7 +402,12 @@ bool TargetedMovementGeneratorMedium<T, D>::DoUpdate(T* owner, uint32 time_diff)
     //     transportChanged = true;
     // }
 
-    if (i_recalculateTravel || targetMoved)
+    if (i_pathTicket)
+    {
+        if (!_updateAsyncPath(owner))
+            return true;
+    }
+    else if (i_recalculateTravel || targetMoved)
     {
         bool splineStarted = _setTargetLocation(owner, targetMoved);
 
@@ -56,6 +56,9 @@ class TargetedMovementGeneratorMedium : public MovementGeneratorMedium< T, D >,
         bool IsReachable() const { return (i_path) ? (i_path->GetPathType() & PATHFIND_NORMAL) : true; }
     protected:
         bool _setTargetLocation(T* owner, bool updateDestination);
+        bool _launchPath(T* owner, bool result, float x, float y, float z, bool forceDest, bool updateDestination, bool leadingTarget);
+        bool _requestAsyncPath(T* owner, float x, float y, float z, bool updateDestination, bool leadingTarget);
+        bool _updateAsyncPath(T* owner);
 
         G3D::Vector3 GetDestination(T* owner) const;
 
@@ -73,6 +76,13 @@ class TargetedMovementGeneratorMedium : public MovementGeneratorMedium< T, D >,
         bool i_pendingFacingUpdate = false;
         TimeTrackerSmall i_pendingFacingUpdateDelay { 0 };
 
+        // path of _setTargetLocation being solved by the PathfindingService of the map
+        uint64 i_pathTicket = 0;
+        Map const* i_pathMap = nullptr;
+        G3D::Vector3 i_pathDestination;
+        bool i_pathUpdateDestination = false;
+        bool i_pathLeadingTarget = false;
+
 };
 
 template<class T>
@@ -16,9 +16,10 @@
 */
 
 #include "MovementStructures.h"
+#include "MovementCodecs.h"
 #include "Player.h"
 
-MovementStatusElements const PlayerMove[] = // 5.4.8 18414
+constexpr MovementStatusElements PlayerMove[] = // 5.4.8 18414
 {
     MSEHasPitch,               // 112
     MSEHasGuidByte2,           // 18
@@ -95,7 +96,7 @@ MovementStatusElements const PlayerMove[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementFallLand[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementFallLand[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionZ,              // 44
@@ -172,7 +173,7 @@ MovementStatusElements const MovementFallLand[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementHeartBeat[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementHeartBeat[] = // 5.4.8 18414
 {
     MSEPositionZ,              // 44
     MSEPositionX,              // 36
@@ -249,7 +250,7 @@ MovementStatusElements const MovementHeartBeat[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementJump[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementJump[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionX,              // 36
@@ -326,7 +327,7 @@ MovementStatusElements const MovementJump[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementSetFacing[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementSetFacing[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionX,              // 36
@@ -403,7 +404,7 @@ MovementStatusElements const MovementSetFacing[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementSetPitch[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementSetPitch[] = // 5.4.8 18414
 {
     MSEPositionZ,              // 44
     MSEPositionX,              // 36
@@ -480,7 +481,7 @@ MovementStatusElements const MovementSetPitch[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStartBackward[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStartBackward[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionZ,              // 44
@@ -557,7 +558,7 @@ MovementStatusElements const MovementStartBackward[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStartForward[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStartForward[] = // 5.4.8 18414
 {
     MSEPositionZ,              // 44
     MSEPositionX,              // 36
@@ -634,7 +635,7 @@ MovementStatusElements const MovementStartForward[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStartStrafeLeft[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStartStrafeLeft[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionZ,              // 44
@@ -711,7 +712,7 @@ MovementStatusElements const MovementStartStrafeLeft[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStartStrafeRight[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStartStrafeRight[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionX,              // 36
@@ -788,7 +789,7 @@ MovementStatusElements const MovementStartStrafeRight[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStartTurnLeft[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStartTurnLeft[] = // 5.4.8 18414
 {
     MSEPositionZ,              // 44
     MSEPositionX,              // 36
@@ -865,7 +866,7 @@ MovementStatusElements const MovementStartTurnLeft[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStartTurnRight[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStartTurnRight[] = // 5.4.8 18414
 {
     MSEPositionX,              // 36
     MSEPositionZ,              // 44
@@ -942,7 +943,7 @@ MovementStatusElements const MovementStartTurnRight[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStop[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStop[] = // 5.4.8 18414
 {
     MSEPositionX,              // 36
     MSEPositionY,              // 40
@@ -1019,7 +1020,7 @@ MovementStatusElements const MovementStop[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStopStrafe[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStopStrafe[] = // 5.4.8 18414
 {
     MSEPositionZ,              // 44
     MSEPositionX,              // 36
@@ -1096,7 +1097,7 @@ MovementStatusElements const MovementStopStrafe[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStopTurn[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStopTurn[] = // 5.4.8 18414
 {
     MSEPositionX,              // 36
     MSEPositionZ,              // 44
@@ -1173,7 +1174,7 @@ MovementStatusElements const MovementStopTurn[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStartAscend[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStartAscend[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionX,              // 36
@@ -1250,7 +1251,7 @@ MovementStatusElements const MovementStartAscend[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStartDescend[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStartDescend[] = // 5.4.8 18414
 {
     MSEPositionX,              // 36
     MSEPositionY,              // 40
@@ -1327,7 +1328,7 @@ MovementStatusElements const MovementStartDescend[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStartSwim[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStartSwim[] = // 5.4.8 18414
 {
     MSEPositionX,              // 36
     MSEPositionY,              // 40
@@ -1404,7 +1405,7 @@ MovementStatusElements const MovementStartSwim[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStopSwim[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStopSwim[] = // 5.4.8 18414
 {
     MSEPositionX,              // 36
     MSEPositionZ,              // 44
@@ -1481,7 +1482,7 @@ MovementStatusElements const MovementStopSwim[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStopAscend[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStopAscend[] = // 5.4.8 18414
 {
     MSEPositionZ,              // 44
     MSEPositionX,              // 36
@@ -1558,7 +1559,7 @@ MovementStatusElements const MovementStopAscend[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStopPitch[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStopPitch[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionX,              // 36
@@ -1635,7 +1636,7 @@ MovementStatusElements const MovementStopPitch[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStartPitchDown[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStartPitchDown[] = // 5.4.8 18414
 {
     MSEPositionZ,              // 44
     MSEPositionY,              // 40
@@ -1712,7 +1713,7 @@ MovementStatusElements const MovementStartPitchDown[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementStartPitchUp[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementStartPitchUp[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionZ,              // 44
@@ -1789,7 +1790,7 @@ MovementStatusElements const MovementStartPitchUp[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MoveChngTransport[]= // 5.4.8 18414
+constexpr MovementStatusElements MoveChngTransport[] = // 5.4.8 18414
 {
     MSEPositionX,
     MSEPositionY,
@@ -1866,7 +1867,7 @@ MovementStatusElements const MoveChngTransport[]= // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MoveSplineDone[] = // 5.4.8 18414
+constexpr MovementStatusElements MoveSplineDone[] = // 5.4.8 18414
 {
     MSECounter,
     MSEPositionZ,
@@ -1944,7 +1945,7 @@ MovementStatusElements const MoveSplineDone[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveNotActiveMover[] =
+constexpr MovementStatusElements MoveNotActiveMover[] =
 {
     MSEPositionZ,
     MSEPositionX,
@@ -2023,7 +2024,7 @@ MovementStatusElements const MoveNotActiveMover[] =
     MSEEnd,
 };
 
-MovementStatusElements const DismissControlledVehicle[] =  // 5.4.8 18414
+constexpr MovementStatusElements DismissControlledVehicle[] =  // 5.4.8 18414
 {
     MSEPositionZ,              // 44
     MSEPositionY,              // 40
@@ -2101,7 +2102,7 @@ MovementStatusElements const DismissControlledVehicle[] =  // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MoveTeleport[] =
+constexpr MovementStatusElements MoveTeleport[] =
 {
     MSEHasGuidByte0,
     MSEHasGuidByte6,
@@ -2145,7 +2146,7 @@ MovementStatusElements const MoveTeleport[] =
     MSEEnd
 };
 
-MovementStatusElements const MoveUpdateTeleport[] =
+constexpr MovementStatusElements MoveUpdateTeleport[] =
 {
     MSEPositionZ,
     MSEPositionY,
@@ -2227,7 +2228,7 @@ MovementStatusElements const MoveUpdateTeleport[] =
     MSEEnd,
 };
 
-MovementStatusElements const MovementSetRunMode[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementSetRunMode[] = // 5.4.8 18414
 {
     MSEPositionZ,              // 44
     MSEPositionY,              // 40
@@ -2305,7 +2306,7 @@ MovementStatusElements const MovementSetRunMode[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementSetWalkMode[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementSetWalkMode[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionX,              // 36
@@ -2383,7 +2384,7 @@ MovementStatusElements const MovementSetWalkMode[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementSetCanFly[] =
+constexpr MovementStatusElements MovementSetCanFly[] =
 {
     MSEPositionY,              // 40
     MSEPositionX,              // 36
@@ -2460,7 +2461,7 @@ MovementStatusElements const MovementSetCanFly[] =
     MSEEnd
 };
 
-MovementStatusElements const MovementSetCanTransitionBetweenSwimAndFlyAck[] =
+constexpr MovementStatusElements MovementSetCanTransitionBetweenSwimAndFlyAck[] =
 {
     MSEPositionZ,
     MSEPositionY,
@@ -2533,7 +2534,7 @@ MovementStatusElements const MovementSetCanTransitionBetweenSwimAndFlyAck[] =
     MSEEnd,
 };
 
-MovementStatusElements const MovementApplyMovementForceAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementApplyMovementForceAck[] = // 5.4.8 18414
 {
     MSECount,                  // 176
     MSEExtraElement,           // 196
@@ -2616,7 +2617,7 @@ MovementStatusElements const MovementApplyMovementForceAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementRemoveMovementForceAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementRemoveMovementForceAck[] = // 5.4.8 18414
 {
     MSECount,                  // 184
     MSEPositionZ,              // 52  34h
@@ -2696,12 +2697,12 @@ MovementStatusElements const MovementRemoveMovementForceAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementSetIgnoreMovementForceAck[] = // 5.4.8 18414 (placeholder)
+constexpr MovementStatusElements MovementSetIgnoreMovementForceAck[] = // 5.4.8 18414 (placeholder)
 {
     MSEEnd,
 };
 
-MovementStatusElements const MovementUpdateSwimBackSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementUpdateSwimBackSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte3,           // 27
     MSEHasGuidByte6,           // 30
@@ -2780,7 +2781,7 @@ MovementStatusElements const MovementUpdateSwimBackSpeed[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementUpdateSwimSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementUpdateSwimSpeed[] = // 5.4.8 18414
 {
     MSEHasOrientation,         // 56  38h
     MSEHasGuidByte0,           // 24
@@ -2859,7 +2860,7 @@ MovementStatusElements const MovementUpdateSwimSpeed[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementUpdateRunSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementUpdateRunSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte0,           // 24
     MSEHasGuidByte3,           // 27
@@ -2938,7 +2939,7 @@ MovementStatusElements const MovementUpdateRunSpeed[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementUpdateFlightBackSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementUpdateFlightBackSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte0,           // 24
     MSEZeroBit,                // 157
@@ -3017,7 +3018,7 @@ MovementStatusElements const MovementUpdateFlightBackSpeed[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementUpdateFlightSpeed[] =
+constexpr MovementStatusElements MovementUpdateFlightSpeed[] =
 {
     MSEHasGuidByte3,
     MSEHasGuidByte2,
@@ -3096,7 +3097,7 @@ MovementStatusElements const MovementUpdateFlightSpeed[] =
     MSEEnd
 };
 
-MovementStatusElements const MovementUpdateCollisionHeight[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementUpdateCollisionHeight[] = // 5.4.8 18414
 {
     MSEHasGuidByte7,           // 31
     MSEHasGuidByte3,           // 27
@@ -3175,7 +3176,7 @@ MovementStatusElements const MovementUpdateCollisionHeight[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementForceRunSpeedChangeAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementForceRunSpeedChangeAck[] = // 5.4.8 18414
 {
     MSECount,                  // 176
     MSEPositionY,              // 40
@@ -3255,7 +3256,7 @@ MovementStatusElements const MovementForceRunSpeedChangeAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementForceSwimBackSpeedChangeAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementForceSwimBackSpeedChangeAck[] = // 5.4.8 18414
 {
     MSEExtraElement,           // 184
     MSEPositionY,              // 40
@@ -3335,7 +3336,7 @@ MovementStatusElements const MovementForceSwimBackSpeedChangeAck[] = // 5.4.8 18
     MSEEnd
 };
 
-MovementStatusElements const MovementSetCollisionHeightAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementSetCollisionHeightAck[] = // 5.4.8 18414
 {
     MSEMountDisplayIdWithoutCheck, // 196
     MSEPositionZ,              // 52  34h
@@ -3417,7 +3418,7 @@ MovementStatusElements const MovementSetCollisionHeightAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementForceFlightBackSpeedChangeAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementForceFlightBackSpeedChangeAck[] = // 5.4.8 18414
 {
     MSEExtraElement,           // 184
     MSEPositionZ,              // 44
@@ -3497,7 +3498,7 @@ MovementStatusElements const MovementForceFlightBackSpeedChangeAck[] = // 5.4.8
     MSEEnd
 };
 
-MovementStatusElements const MovementForceFlightSpeedChangeAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementForceFlightSpeedChangeAck[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSECount,                  // 176
@@ -3577,7 +3578,7 @@ MovementStatusElements const MovementForceFlightSpeedChangeAck[] = // 5.4.8 1841
     MSEEnd
 };
 
-MovementStatusElements const MovementForcePitchRateChangeAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementForcePitchRateChangeAck[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEExtraElement,           // 184
@@ -3657,7 +3658,7 @@ MovementStatusElements const MovementForcePitchRateChangeAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementSetCanFlyAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementSetCanFlyAck[] = // 5.4.8 18414
 {
     MSEPositionZ,              // 44
     MSECount,                  // 176
@@ -3736,7 +3737,7 @@ MovementStatusElements const MovementSetCanFlyAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementSetFly[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementSetFly[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionZ,              // 44
@@ -3814,7 +3815,7 @@ MovementStatusElements const MovementSetFly[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementForceSwimSpeedChangeAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementForceSwimSpeedChangeAck[] = // 5.4.8 18414
 {
     MSEExtraElement,           // 184
     MSEPositionY,              // 40
@@ -3894,7 +3895,7 @@ MovementStatusElements const MovementForceSwimSpeedChangeAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementForceTurnRateChangeAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementForceTurnRateChangeAck[] = // 5.4.8 18414
 {
     MSECount,                  // 176
     MSEPositionZ,              // 44
@@ -3974,7 +3975,7 @@ MovementStatusElements const MovementForceTurnRateChangeAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementForceWalkSpeedChangeAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementForceWalkSpeedChangeAck[] = // 5.4.8 18414
 {
     MSECount,                  // 176
     MSEExtraElement,           // 184
@@ -4054,7 +4055,7 @@ MovementStatusElements const MovementForceWalkSpeedChangeAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementForceRunBackSpeedChangeAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementForceRunBackSpeedChangeAck[] = // 5.4.8 18414
 {
     MSEExtraElement,           // 184
     MSECount,                  // 176
@@ -4134,7 +4135,7 @@ MovementStatusElements const MovementForceRunBackSpeedChangeAck[] = // 5.4.8 184
     MSEEnd
 };
 
-MovementStatusElements const MovementUpdateRunBackSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementUpdateRunBackSpeed[] = // 5.4.8 18414
 {
     MSEPositionZ,              // 52  34h
     MSEPositionY,              // 48  30h
@@ -4213,7 +4214,7 @@ MovementStatusElements const MovementUpdateRunBackSpeed[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementUpdateWalkSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementUpdateWalkSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte4,           // 28
     MSEHasGuidByte0,           // 24
@@ -4291,7 +4292,7 @@ MovementStatusElements const MovementUpdateWalkSpeed[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const ForceMoveRootAck[] = // 5.4.8 18414
+constexpr MovementStatusElements ForceMoveRootAck[] = // 5.4.8 18414
 {
     MSEPositionX,
     MSECounter,
@@ -4369,7 +4370,7 @@ MovementStatusElements const ForceMoveRootAck[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const ForceMoveUnrootAck[] = // 5.4.8 18414
+constexpr MovementStatusElements ForceMoveUnrootAck[] = // 5.4.8 18414
 {
     MSEPositionX,
     MSEPositionY,
@@ -4447,7 +4448,7 @@ MovementStatusElements const ForceMoveUnrootAck[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MovementFallReset[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementFallReset[] = // 5.4.8 18414
 {
     MSEPositionZ,              // 44
     MSEPositionX,              // 36
@@ -4525,7 +4526,7 @@ MovementStatusElements const MovementFallReset[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementFeatherFallAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementFeatherFallAck[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionX,              // 36
@@ -4604,7 +4605,7 @@ MovementStatusElements const MovementFeatherFallAck[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MovementGravityDisableAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementGravityDisableAck[] = // 5.4.8 18414
 {
     MSECount,                  // 176
     MSEPositionY,              // 40
@@ -4683,7 +4684,7 @@ MovementStatusElements const MovementGravityDisableAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementGravityEnableAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementGravityEnableAck[] = // 5.4.8 18414
 {
     MSEPositionY,              // 40
     MSEPositionX,              // 36
@@ -4762,7 +4763,7 @@ MovementStatusElements const MovementGravityEnableAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementHoverAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementHoverAck[] = // 5.4.8 18414
 {
     MSECount,                  // 176
     MSEPositionY,              // 40
@@ -4841,7 +4842,7 @@ MovementStatusElements const MovementHoverAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementKnockBackAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementKnockBackAck[] = // 5.4.8 18414
 {
     MSECount,                  // 176
     MSEPositionX,              // 36
@@ -4920,7 +4921,7 @@ MovementStatusElements const MovementKnockBackAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementWaterWalkAck[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementWaterWalkAck[] = // 5.4.8 18414
 {
     MSEPositionX,              // 36
     MSEPositionY,              // 40
@@ -4999,7 +5000,7 @@ MovementStatusElements const MovementWaterWalkAck[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementUpdateKnockBack[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementUpdateKnockBack[] = // 5.4.8 18414
 {
     MSEHasGuidByte5,           // 21
     MSEHasSplineElevation,     // 144 90h
@@ -5077,7 +5078,7 @@ MovementStatusElements const MovementUpdateKnockBack[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementUpdatePitchBack[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementUpdatePitchBack[] = // 5.4.8 18414
 {
     MSEHasGuidByte7,           // 23
     MSEHasMovementFlags,       // 24
@@ -5156,7 +5157,7 @@ MovementStatusElements const MovementUpdatePitchBack[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const MovementUpdateTurnRate[] = // 5.4.8 18414
+constexpr MovementStatusElements MovementUpdateTurnRate[] = // 5.4.8 18414
 {
     MSEHasGuidByte4,           // 28
     MSEHasFallData,            // 148
@@ -5235,7 +5236,7 @@ MovementStatusElements const MovementUpdateTurnRate[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const SplineMoveSetWalkSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetWalkSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte4,
     MSEHasGuidByte1,
@@ -5257,7 +5258,7 @@ MovementStatusElements const SplineMoveSetWalkSpeed[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetRunSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetRunSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte3,
     MSEHasGuidByte0,
@@ -5279,7 +5280,7 @@ MovementStatusElements const SplineMoveSetRunSpeed[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetRunBackSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetRunBackSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte7,
     MSEHasGuidByte4,
@@ -5301,7 +5302,7 @@ MovementStatusElements const SplineMoveSetRunBackSpeed[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetSwimSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetSwimSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte5,
     MSEHasGuidByte6,
@@ -5323,7 +5324,7 @@ MovementStatusElements const SplineMoveSetSwimSpeed[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetSwimBackSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetSwimBackSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte2,
     MSEHasGuidByte6,
@@ -5345,7 +5346,7 @@ MovementStatusElements const SplineMoveSetSwimBackSpeed[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetTurnRate[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetTurnRate[] = // 5.4.8 18414
 {
     MSEHasGuidByte5,
     MSEHasGuidByte7,
@@ -5367,7 +5368,7 @@ MovementStatusElements const SplineMoveSetTurnRate[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetFlightSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetFlightSpeed[] = // 5.4.8 18414
 {
     MSEExtraElement,
     MSEHasGuidByte1,
@@ -5389,7 +5390,7 @@ MovementStatusElements const SplineMoveSetFlightSpeed[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetFlightBackSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetFlightBackSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte6,
     MSEHasGuidByte0,
@@ -5411,7 +5412,7 @@ MovementStatusElements const SplineMoveSetFlightBackSpeed[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetPitchRate[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetPitchRate[] = // 5.4.8 18414
 {
     MSEHasGuidByte2,
     MSEHasGuidByte6,
@@ -5433,7 +5434,7 @@ MovementStatusElements const SplineMoveSetPitchRate[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetWalkSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements MoveSetWalkSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte6,
     MSEHasGuidByte7,
@@ -5456,7 +5457,7 @@ MovementStatusElements const MoveSetWalkSpeed[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetRunSpeed[] = // 5.4.8 18414
+constexpr MovementStatusElements MoveSetRunSpeed[] = // 5.4.8 18414
 {
     MSEHasGuidByte1,
     MSEHasGuidByte7,
@@ -5479,7 +5480,7 @@ MovementStatusElements const MoveSetRunSpeed[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetRunBackSpeed[] = //5.4.8 18414
+constexpr MovementStatusElements MoveSetRunBackSpeed[] = //5.4.8 18414
 {
     MSEHasGuidByte7,
     MSEHasGuidByte1,
@@ -5502,7 +5503,7 @@ MovementStatusElements const MoveSetRunBackSpeed[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetSwimSpeed[] = //5.4.8 18414
+constexpr MovementStatusElements MoveSetSwimSpeed[] = //5.4.8 18414
 {
     MSEHasGuidByte5,
     MSEHasGuidByte0,
@@ -5525,7 +5526,7 @@ MovementStatusElements const MoveSetSwimSpeed[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetSwimBackSpeed[] = //5.4.8 18414
+constexpr MovementStatusElements MoveSetSwimBackSpeed[] = //5.4.8 18414
 {
     MSEHasGuidByte5,
     MSEHasGuidByte0,
@@ -5548,7 +5549,7 @@ MovementStatusElements const MoveSetSwimBackSpeed[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetTurnRate[] = //5.4.8 18414
+constexpr MovementStatusElements MoveSetTurnRate[] = //5.4.8 18414
 {
     MSEHasGuidByte6,
     MSEHasGuidByte5,
@@ -5571,7 +5572,7 @@ MovementStatusElements const MoveSetTurnRate[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetFlightSpeed[] = //5.4.8 18414
+constexpr MovementStatusElements MoveSetFlightSpeed[] = //5.4.8 18414
 {
     MSEExtraElement,
     MSECount,
@@ -5594,7 +5595,7 @@ MovementStatusElements const MoveSetFlightSpeed[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetFlightBackSpeed[] = //5.4.8 18414
+constexpr MovementStatusElements MoveSetFlightBackSpeed[] = //5.4.8 18414
 {
     MSEHasGuidByte2,
     MSEHasGuidByte7,
@@ -5617,7 +5618,7 @@ MovementStatusElements const MoveSetFlightBackSpeed[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetPitchRate[] = //5.4.8 18414
+constexpr MovementStatusElements MoveSetPitchRate[] = //5.4.8 18414
 {
     MSEHasGuidByte7,
     MSEHasGuidByte5,
@@ -5640,7 +5641,7 @@ MovementStatusElements const MoveSetPitchRate[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetCollisionHeight[] = // 5.4.8 18414
+constexpr MovementStatusElements MoveSetCollisionHeight[] = // 5.4.8 18414
 {
     MSEHasGuidByte7,
     MSEHasGuidByte0,
@@ -5668,7 +5669,7 @@ MovementStatusElements const MoveSetCollisionHeight[] = // 5.4.8 18414
     MSEEnd
 };
 
-MovementStatusElements const SplineMoveSetWalkMode[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetWalkMode[] = // 5.4.8 18414
 {
     MSEHasGuidByte4,
     MSEHasGuidByte3,
@@ -5689,7 +5690,7 @@ MovementStatusElements const SplineMoveSetWalkMode[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetRunMode[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetRunMode[] = // 5.4.8 18414
 {
     MSEHasGuidByte5,
     MSEHasGuidByte6,
@@ -5710,7 +5711,7 @@ MovementStatusElements const SplineMoveSetRunMode[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveGravityDisable[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveGravityDisable[] = // 5.4.8 18414
 {
     MSEHasGuidByte1,
     MSEHasGuidByte7,
@@ -5731,7 +5732,7 @@ MovementStatusElements const SplineMoveGravityDisable[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveGravityEnable[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveGravityEnable[] = // 5.4.8 18414
 {
     MSEHasGuidByte5,
     MSEHasGuidByte7,
@@ -5752,7 +5753,7 @@ MovementStatusElements const SplineMoveGravityEnable[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetHover[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetHover[] = // 5.4.8 18414
 {
     MSEHasGuidByte6,
     MSEHasGuidByte5,
@@ -5773,7 +5774,7 @@ MovementStatusElements const SplineMoveSetHover[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveUnsetHover[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveUnsetHover[] = // 5.4.8 18414
 {
     MSEHasGuidByte3,
     MSEHasGuidByte1,
@@ -5794,7 +5795,7 @@ MovementStatusElements const SplineMoveUnsetHover[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveStartSwim[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveStartSwim[] = // 5.4.8 18414
 {
     MSEHasGuidByte7,
     MSEHasGuidByte4,
@@ -5815,7 +5816,7 @@ MovementStatusElements const SplineMoveStartSwim[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveStopSwim[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveStopSwim[] = // 5.4.8 18414
 {
     MSEHasGuidByte3,
     MSEHasGuidByte7,
@@ -5836,7 +5837,7 @@ MovementStatusElements const SplineMoveStopSwim[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetFlying[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetFlying[] = // 5.4.8 18414
 {
     MSEHasGuidByte4,
     MSEHasGuidByte1,
@@ -5857,7 +5858,7 @@ MovementStatusElements const SplineMoveSetFlying[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveUnsetFlying[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveUnsetFlying[] = // 5.4.8 18414
 {
     MSEHasGuidByte1,
     MSEHasGuidByte5,
@@ -5878,7 +5879,7 @@ MovementStatusElements const SplineMoveUnsetFlying[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetWaterWalk[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetWaterWalk[] = // 5.4.8 18414
 {
     MSEHasGuidByte3,
     MSEHasGuidByte1,
@@ -5899,7 +5900,7 @@ MovementStatusElements const SplineMoveSetWaterWalk[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetLandWalk[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetLandWalk[] = // 5.4.8 18414
 {
     MSEHasGuidByte1,
     MSEHasGuidByte5,
@@ -5920,7 +5921,7 @@ MovementStatusElements const SplineMoveSetLandWalk[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetFeatherFall[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetFeatherFall[] = // 5.4.8 18414
 {
     MSEHasGuidByte1,
     MSEHasGuidByte5,
@@ -5941,7 +5942,7 @@ MovementStatusElements const SplineMoveSetFeatherFall[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetNormalFall[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveSetNormalFall[] = // 5.4.8 18414
 {
     MSEHasGuidByte6,
     MSEHasGuidByte1,
@@ -5962,7 +5963,7 @@ MovementStatusElements const SplineMoveSetNormalFall[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveRoot[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveRoot[] = // 5.4.8 18414
 {
     MSEHasGuidByte3,
     MSEHasGuidByte7,
@@ -5983,7 +5984,7 @@ MovementStatusElements const SplineMoveRoot[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveUnroot[] = // 5.4.8 18414
+constexpr MovementStatusElements SplineMoveUnroot[] = // 5.4.8 18414
 {
     MSEHasGuidByte1,
     MSEHasGuidByte5,
@@ -6004,7 +6005,7 @@ MovementStatusElements const SplineMoveUnroot[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetCanFly[] = // 5.4.8 18414
+constexpr MovementStatusElements MoveSetCanFly[] = // 5.4.8 18414
 {
     MSEHasGuidByte6,
     MSEHasGuidByte1,
@@ -6026,7 +6027,7 @@ MovementStatusElements const MoveSetCanFly[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveUnsetCanFly[] = // 5.4.8 18414
+constexpr MovementStatusElements MoveUnsetCanFly[] = // 5.4.8 18414
 {
     MSEHasGuidByte6,
     MSEHasGuidByte5,
@@ -6048,7 +6049,7 @@ MovementStatusElements const MoveUnsetCanFly[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveSetHover[] = //5.4.8 18414
+constexpr MovementStatusElements MoveSetHover[] = //5.4.8 18414
 {
     MSEHasGuidByte7,
     MSEHasGuidByte1,
@@ -6070,7 +6071,7 @@ MovementStatusElements const MoveSetHover[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveUnsetHover[] = // 5.4.8 18414
+constexpr MovementStatusElements MoveUnsetHover[] = // 5.4.8 18414
 {
     MSEHasGuidByte3,
     MSEHasGuidByte5,
@@ -6092,7 +6093,7 @@ MovementStatusElements const MoveUnsetHover[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveWaterWalk[] = //5.4.8 18414
+constexpr MovementStatusElements MoveWaterWalk[] = //5.4.8 18414
 {
     MSEHasGuidByte2,
     MSEHasGuidByte0,
@@ -6114,7 +6115,7 @@ MovementStatusElements const MoveWaterWalk[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveLandWalk[] = //5.4.8 18414
+constexpr MovementStatusElements MoveLandWalk[] = //5.4.8 18414
 {
     MSEHasGuidByte0,
     MSEHasGuidByte7,
@@ -6136,7 +6137,7 @@ MovementStatusElements const MoveLandWalk[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveFeatherFall[] = //5.4.8 18414
+constexpr MovementStatusElements MoveFeatherFall[] = //5.4.8 18414
 {
     MSEHasGuidByte4,
     MSEHasGuidByte1,
@@ -6158,7 +6159,7 @@ MovementStatusElements const MoveFeatherFall[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveNormalFall[] = //5.4.8 18414
+constexpr MovementStatusElements MoveNormalFall[] = //5.4.8 18414
 {
     MSEHasGuidByte3,
     MSEHasGuidByte1,
@@ -6180,7 +6181,7 @@ MovementStatusElements const MoveNormalFall[] = //5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveRoot[] = // 5.4.8 18414
+constexpr MovementStatusElements MoveRoot[] = // 5.4.8 18414
 {
     MSEHasGuidByte0,
     MSEHasGuidByte3,
@@ -6202,7 +6203,7 @@ MovementStatusElements const MoveRoot[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MoveUnroot[] = // 5.4.8 18414
+constexpr MovementStatusElements MoveUnroot[] = // 5.4.8 18414
 {
     MSEHasGuidByte3,
     MSEHasGuidByte5,
@@ -6224,7 +6225,7 @@ MovementStatusElements const MoveUnroot[] = // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const ChangeSeatsOnControlledVehicle[] =
+constexpr MovementStatusElements ChangeSeatsOnControlledVehicle[] =
 {
     MSEExtraElement,           // 176 byte
     MSEPositionY,              // 40
@@ -6319,7 +6320,7 @@ MovementStatusElements const ChangeSeatsOnControlledVehicle[] =
     MSEEnd
 };
 
-MovementStatusElements const CastSpellEmbeddedMovement[] =
+constexpr MovementStatusElements CastSpellEmbeddedMovement[] =
 {
     MSEPositionZ,
     MSEPositionY,
@@ -6391,7 +6392,7 @@ MovementStatusElements const CastSpellEmbeddedMovement[] =
     MSEEnd,
 };
 
-MovementStatusElements const MovementGravityDisable[] =  // 5.4.8 18414
+constexpr MovementStatusElements MovementGravityDisable[] =  // 5.4.8 18414
 {
     MSEHasGuidByte6,
     MSEHasGuidByte1,
@@ -6413,7 +6414,7 @@ MovementStatusElements const MovementGravityDisable[] =  // 5.4.8 18414
     MSEEnd,
 };
 
-MovementStatusElements const MovementGravityEnable[] =  // 5.4.8 18414
+constexpr MovementStatusElements MovementGravityEnable[] =  // 5.4.8 18414
 {
     MSEHasGuidByte3,
     MSEHasGuidByte0,
@@ -6435,7 +6436,7 @@ MovementStatusElements const MovementGravityEnable[] =  // 5.4.8 18414
     MSEEnd, 
 };
 
-MovementStatusElements const SetVehicleRecIdAck[] =  // 5.4.8 18414
+constexpr MovementStatusElements SetVehicleRecIdAck[] =  // 5.4.8 18414
 {
     MSEPositionY,              // 48  30h
     MSECount,                  // 16 (unk)
@@ -6902,4 +6903,176 @@ MovementStatusElements const* GetMovementStatusElementsSequence(uint32 opcode)
     }
 
     return NULL;
-}
\ No newline at end of file
+}
+
+#define MOVEMENT_CODEC(sequence) { sequence, { &Movement::ReadMovement<sequence>, &Movement::WriteMovement<sequence> } }
+
+Movement::MovementCodec const* Movement::GetMovementCodec(uint32 opcode)
+{
+    static std::unordered_map<uint32, MovementCodec> const codecs = []
+    {
+        static std::pair<MovementStatusElements const*, MovementCodec> const sequenceCodecs[] =
+        {
+        MOVEMENT_CODEC(MovementFallLand),
+        MOVEMENT_CODEC(MovementHeartBeat),
+        MOVEMENT_CODEC(MovementJump),
+        MOVEMENT_CODEC(MovementSetFacing),
+        MOVEMENT_CODEC(MovementSetPitch),
+        MOVEMENT_CODEC(MovementStartAscend),
+        MOVEMENT_CODEC(MovementStartBackward),
+        MOVEMENT_CODEC(MovementStartDescend),
+        MOVEMENT_CODEC(MovementStartForward),
+        MOVEMENT_CODEC(MovementStartPitchDown),
+        MOVEMENT_CODEC(MovementStartPitchUp),
+        MOVEMENT_CODEC(MovementStartStrafeLeft),
+        MOVEMENT_CODEC(MovementStartStrafeRight),
+        MOVEMENT_CODEC(MovementStartSwim),
+        MOVEMENT_CODEC(MovementStartTurnLeft),
+        MOVEMENT_CODEC(MovementStartTurnRight),
+        MOVEMENT_CODEC(MovementStop),
+        MOVEMENT_CODEC(MovementStopAscend),
+        MOVEMENT_CODEC(MovementStopPitch),
+        MOVEMENT_CODEC(MovementStopStrafe),
+        MOVEMENT_CODEC(MovementStopSwim),
+        MOVEMENT_CODEC(MovementStopTurn),
+        MOVEMENT_CODEC(PlayerMove),
+        MOVEMENT_CODEC(MoveChngTransport),
+        MOVEMENT_CODEC(MoveSplineDone),
+        MOVEMENT_CODEC(MoveNotActiveMover),
+        MOVEMENT_CODEC(DismissControlledVehicle),
+        MOVEMENT_CODEC(MoveTeleport),
+        MOVEMENT_CODEC(MoveUpdateTeleport),
+        MOVEMENT_CODEC(ForceMoveRootAck),
+        MOVEMENT_CODEC(ForceMoveUnrootAck),
+        MOVEMENT_CODEC(MovementFallReset),
+        MOVEMENT_CODEC(MovementFeatherFallAck),
+        MOVEMENT_CODEC(MovementForceFlightBackSpeedChangeAck),
+        MOVEMENT_CODEC(MovementForceFlightSpeedChangeAck),
+        MOVEMENT_CODEC(MovementForcePitchRateChangeAck),
+        MOVEMENT_CODEC(MovementForceRunBackSpeedChangeAck),
+        MOVEMENT_CODEC(MovementForceRunSpeedChangeAck),
+        MOVEMENT_CODEC(MovementForceSwimBackSpeedChangeAck),
+        MOVEMENT_CODEC(MovementForceSwimSpeedChangeAck),
+        MOVEMENT_CODEC(MovementForceTurnRateChangeAck),
+        MOVEMENT_CODEC(MovementForceWalkSpeedChangeAck),
+        MOVEMENT_CODEC(MovementGravityDisableAck),
+        MOVEMENT_CODEC(MovementGravityEnableAck),
+        MOVEMENT_CODEC(MovementHoverAck),
+        MOVEMENT_CODEC(MovementKnockBackAck),
+        MOVEMENT_CODEC(MovementSetCanFly),
+        MOVEMENT_CODEC(MovementSetCanFlyAck),
+        MOVEMENT_CODEC(MovementSetFly),
+        MOVEMENT_CODEC(MovementSetCanTransitionBetweenSwimAndFlyAck),
+        MOVEMENT_CODEC(MovementApplyMovementForceAck),
+        MOVEMENT_CODEC(MovementRemoveMovementForceAck),
+        MOVEMENT_CODEC(MovementSetIgnoreMovementForceAck),
+        MOVEMENT_CODEC(MoveSetCollisionHeight),
+        MOVEMENT_CODEC(MovementSetCollisionHeightAck),
+        MOVEMENT_CODEC(MovementUpdateCollisionHeight),
+        MOVEMENT_CODEC(MovementWaterWalkAck),
+        MOVEMENT_CODEC(MovementSetRunMode),
+        MOVEMENT_CODEC(MovementSetWalkMode),
+        MOVEMENT_CODEC(MovementUpdateFlightBackSpeed),
+        MOVEMENT_CODEC(MovementUpdateFlightSpeed),
+        MOVEMENT_CODEC(MovementUpdateRunSpeed),
+        MOVEMENT_CODEC(MovementUpdateKnockBack),
+        MOVEMENT_CODEC(MovementUpdatePitchBack),
+        MOVEMENT_CODEC(MovementUpdateRunBackSpeed),
+        MOVEMENT_CODEC(MovementUpdateSwimBackSpeed),
+        MOVEMENT_CODEC(MovementUpdateSwimSpeed),
+        MOVEMENT_CODEC(MovementUpdateWalkSpeed),
+        MOVEMENT_CODEC(MovementUpdateTurnRate),
+        MOVEMENT_CODEC(SplineMoveSetWalkSpeed),
+        MOVEMENT_CODEC(SplineMoveSetRunSpeed),
+        MOVEMENT_CODEC(SplineMoveSetRunBackSpeed),
+        MOVEMENT_CODEC(SplineMoveSetSwimSpeed),
+        MOVEMENT_CODEC(SplineMoveSetSwimBackSpeed),
+        MOVEMENT_CODEC(SplineMoveSetTurnRate),
+        MOVEMENT_CODEC(SplineMoveSetFlightSpeed),
+        MOVEMENT_CODEC(SplineMoveSetFlightBackSpeed),
+        MOVEMENT_CODEC(SplineMoveSetPitchRate),
+        MOVEMENT_CODEC(MoveSetWalkSpeed),
+        MOVEMENT_CODEC(MoveSetRunSpeed),
+        MOVEMENT_CODEC(MoveSetRunBackSpeed),
+        MOVEMENT_CODEC(MoveSetSwimSpeed),
+        MOVEMENT_CODEC(MoveSetSwimBackSpeed),
+        MOVEMENT_CODEC(MoveSetTurnRate),
+        MOVEMENT_CODEC(MoveSetFlightSpeed),
+        MOVEMENT_CODEC(MoveSetFlightBackSpeed),
+        MOVEMENT_CODEC(MoveSetPitchRate),
+        MOVEMENT_CODEC(SplineMoveSetWalkMode),
+        MOVEMENT_CODEC(SplineMoveSetRunMode),
+        MOVEMENT_CODEC(SplineMoveGravityDisable),
+        MOVEMENT_CODEC(SplineMoveGravityEnable),
+        MOVEMENT_CODEC(SplineMoveSetHover),
+        MOVEMENT_CODEC(SplineMoveUnsetHover),
+        MOVEMENT_CODEC(SplineMoveStartSwim),
+        MOVEMENT_CODEC(SplineMoveStopSwim),
+        MOVEMENT_CODEC(SplineMoveSetFlying),
+        MOVEMENT_CODEC(SplineMoveUnsetFlying),
+        MOVEMENT_CODEC(SplineMoveSetWaterWalk),
+        MOVEMENT_CODEC(SplineMoveSetLandWalk),
+        MOVEMENT_CODEC(SplineMoveSetFeatherFall),
+        MOVEMENT_CODEC(SplineMoveSetNormalFall),
+        MOVEMENT_CODEC(SplineMoveRoot),
+        MOVEMENT_CODEC(SplineMoveUnroot),
+        MOVEMENT_CODEC(MoveSetCanFly),
+        MOVEMENT_CODEC(MoveUnsetCanFly),
+        MOVEMENT_CODEC(MoveSetHover),
+        MOVEMENT_CODEC(MoveUnsetHover),
+        MOVEMENT_CODEC(MoveWaterWalk),
+        MOVEMENT_CODEC(MoveLandWalk),
+        MOVEMENT_CODEC(MoveFeatherFall),
+        MOVEMENT_CODEC(MoveNormalFall),
+        MOVEMENT_CODEC(MoveRoot),
+        MOVEMENT_CODEC(MoveUnroot),
+        MOVEMENT_CODEC(MovementGravityDisable),
+        MOVEMENT_CODEC(MovementGravityEnable),
+        MOVEMENT_CODEC(ChangeSeatsOnControlledVehicle),
+        MOVEMENT_CODEC(SetVehicleRecIdAck),
+        MOVEMENT_CODEC(CastSpellEmbeddedMovement),
+        };
+
+        // every opcode sharing a sequence shares its codec
+        std::unordered_map<uint32, MovementCodec> result;
+        for (uint32 i = 0; i < NUM_OPCODE_HANDLERS; ++i)
+            if (MovementStatusElements const* sequence = GetMovementStatusElementsSequence(i))
+                for (auto const& sequenceCodec : sequenceCodecs)
+                    if (sequenceCodec.first == sequence)
+                        result[i] = sequenceCodec.second;
+
+        return result;
+    }();
+
+    auto itr = codecs.find(opcode);
+    return itr != codecs.end() ? &itr->second : nullptr;
+}
+
+#undef MOVEMENT_CODEC
+
+bool Movement::IsSameMovementPacket(ByteBuffer const& left, ByteBuffer const& right)
+{
+    // compare with the pending bits written out
+    ByteBuffer leftCopy(left);
+    ByteBuffer rightCopy(right);
+    leftCopy.FlushBits();
+    rightCopy.FlushBits();
+    if (leftCopy.wpos() != rightCopy.wpos() || leftCopy.size() != rightCopy.size())
+        return false;
+
+    return leftCopy.empty() || std::equal(leftCopy.contents(), leftCopy.contents() + leftCopy.size(), rightCopy.contents());
+}
+
+bool Movement::IsSameMovementInfo(MovementInfo const& left, MovementInfo const& right)
+{
+    return left.guid == right.guid && left.flags == right.flags && left.flags2 == right.flags2 && left.time == right.time
+        && left.pos.GetPositionX() == right.pos.GetPositionX() && left.pos.GetPositionY() == right.pos.GetPositionY()
+        && left.pos.GetPositionZ() == right.pos.GetPositionZ() && left.pos.GetOrientation() == right.pos.GetOrientation()
+        && left.transport.guid == right.transport.guid && left.transport.seat == right.transport.seat
+        && left.transport.time == right.transport.time && left.transport.time2 == right.transport.time2 && left.transport.time3 == right.transport.time3
+        && left.transport.pos.GetPositionX() == right.transport.pos.GetPositionX() && left.transport.pos.GetPositionY() == right.transport.pos.GetPositionY()
+        && left.transport.pos.GetPositionZ() == right.transport.pos.GetPositionZ() && left.transport.pos.GetOrientation() == right.transport.pos.GetOrientation()
+        && left.pitch == right.pitch && left.jump.fallTime == right.jump.fallTime && left.jump.zspeed == right.jump.zspeed
+        && left.jump.sinAngle == right.jump.sinAngle && left.jump.cosAngle == right.jump.cosAngle && left.jump.xyspeed == right.jump.xyspeed
+        && left.splineElevation == right.splineElevation;
+}
@@ -134,6 +134,10 @@ namespace Movement
         void ReadNextElement(ByteBuffer& packet);
         void WriteNextElement(ByteBuffer& packet);
 
+        // codec validation runs a sequence twice over the same elements
+        uint32 GetIndex() const { return _index; }
+        void SetIndex(uint32 index) { _index = index; }
+
         struct
         {
             ObjectGuid guid;
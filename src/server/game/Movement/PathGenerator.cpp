@@ -25,6 +25,7 @@
 #include "MMapFactory.h"
 #include "MMapManager.h"
 #include "Log.h"
+#include "PathfindingService.h"
 #include "World.h"
 
 #include "DetourCommon.h"
@@ -33,9 +34,9 @@
 ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
-    _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH),
+    _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
     _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
-    _navMeshQuery(nullptr), _useRaycast(false)
+    _navMeshQuery(nullptr)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
@@ -52,9 +53,22 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
     CreateFilter();
 }
 
+PathGenerator::PathGenerator(dtNavMeshQuery const* navMeshQuery, PathfindingRequest const& request) :
+    _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(request.UseStraightPath),
+    _forceDestination(false), _pointPathLimit(request.PointPathLimit), _useRaycast(false),
+    _endPosition(G3D::Vector3::zero()), _source(nullptr), _navMesh(navMeshQuery->getAttachedNavMesh()),
+    _navMeshQuery(navMeshQuery), _filter(request.Filter)
+{
+    memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
+
+    SetStartPosition(request.Start);
+    SetEndPosition(request.End);
+}
+
 PathGenerator::~PathGenerator()
 {
-    TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::~PathGenerator() for %u \n", _source->GetGUID().GetCounter());
+    if (_source)
+        TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::~PathGenerator() for %u \n", _source->GetGUID().GetCounter());
     delete visualizePathWaypointGUIDs;
     delete visualizeNavmeshWaypointGUIDs;
 }
@@ -115,6 +129,112 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
     return true;
 }
 
+bool PathGenerator::PrepareAsyncPath(float destX, float destY, float destZ, PathfindingRequest& request)
+{
+    Unit const* _sourceUnit = _source->ToUnit();
+    if (!_navMesh || !_navMeshQuery || _useRaycast || !_sourceUnit || _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING))
+        return false;
+
+    float x, y, z;
+    _source->GetPosition(x, y, z);
+
+    if (!Trinity::IsValidMapCoord(destX, destY, destZ) || !Trinity::IsValidMapCoord(x, y, z))
+        return false;
+
+    // FIXME, same as CalculatePath
+    if (_source->GetMapId() == 1098 && (z > 54.0f || destZ > 54.0f)) // Throne of Thunder
+        return false;
+
+    G3D::Vector3 start(x, y, z);
+    G3D::Vector3 dest(destX, destY, destZ);
+    if (!HaveTile(start) || !HaveTile(dest))
+        return false;
+
+    SetStartPosition(start);
+    SetEndPosition(dest);
+    _forceDestination = false;
+
+    UpdateFilter();
+
+    request.Start = start;
+    request.End = dest;
+    request.Filter = _filter;
+    request.UseStraightPath = _useStraightPath;
+    request.PointPathLimit = _pointPathLimit;
+    return true;
+}
+
+void PathGenerator::ApplyAsyncPath(PathfindingResult const& result)
+{
+    Clear();
+
+    _polyLength = std::min<uint32>(result.Corridor.size(), MAX_PATH_LENGTH);
+    memcpy(_pathPolyRefs, result.Corridor.data(), _polyLength * sizeof(dtPolyRef));
+
+    _type = result.Type;
+    _pathPoints = result.Points;
+    NormalizePath();
+
+    SetActualEndPosition(_pathPoints.back());
+
+    if (_source->ToUnit()->VisualizePathfinding)
+    {
+        VisualizePath(2500);
+        VisualizeNavmesh(2500);
+    }
+}
+
+bool PathGenerator::BuildDetachedPath(PathfindingSearch const* search, PathfindingResult& result)
+{
+    // only the common case of BuildPolyPath, everything that needs the map is left to CalculatePath
+    float distToStartPoly, distToEndPoly;
+    float startPoint[VERTEX_SIZE] = { _startPosition.y, _startPosition.z, _startPosition.x };
+    float endPoint[VERTEX_SIZE] = { _endPosition.y, _endPosition.z, _endPosition.x };
+
+    dtPolyRef startPoly = GetPolyByLocation(startPoint, &distToStartPoly);
+    dtPolyRef endPoly = GetPolyByLocation(endPoint, &distToEndPoly);
+    if (startPoly == INVALID_POLYREF || endPoly == INVALID_POLYREF || distToStartPoly > 7.0f || distToEndPoly > 7.0f)
+        return false;
+
+    if (startPoly == endPoly)
+    {
+        _pathPolyRefs[0] = startPoly;
+        _polyLength = 1;
+    }
+    else if (search && search->GetCorridor(_navMeshQuery, startPoly, endPoly, _pathPolyRefs, _polyLength))
+        result.Shared = true;
+    else
+    {
+        dtStatus dtResult = _navMeshQuery->findPath(startPoly, endPoly, startPoint, endPoint, &_filter, _pathPolyRefs, (int*)&_polyLength, MAX_PATH_LENGTH);
+        if (!_polyLength || dtStatusFailed(dtResult))
+            return false;
+    }
+
+    _type = _pathPolyRefs[_polyLength - 1] == endPoly ? PATHFIND_NORMAL : PATHFIND_INCOMPLETE;
+
+    float pathPoints[MAX_POINT_PATH_LENGTH*VERTEX_SIZE];
+    uint32 pointCount = 0;
+    dtStatus dtResult = FindPointPath(startPoint, endPoint, pathPoints, &pointCount);
+
+    // same special case as BuildPointPath, its failures build shortcuts which need the map
+    if (_polyLength == 1 && pointCount == 1)
+    {
+        dtVcopy(&pathPoints[1 * VERTEX_SIZE], endPoint);
+        pointCount++;
+    }
+    else if (pointCount < 2 || pointCount >= _pointPathLimit || dtStatusFailed(dtResult))
+        return false;
+
+    result.Solved = true;
+    result.Type = _type;
+    result.Corridor.assign(_pathPolyRefs, _pathPolyRefs + _polyLength);
+    result.Points.resize(pointCount);
+    for (uint32 i = 0; i < pointCount; ++i)
+        result.Points[i] = G3D::Vector3(pathPoints[i*VERTEX_SIZE+2], pathPoints[i*VERTEX_SIZE], pathPoints[i*VERTEX_SIZE+1]);
+
+    return true;
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -564,30 +684,8 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
         _type = PATHFIND_NOPATH;
         return;
     }
-    else if (_useStraightPath)
-    {
-        dtResult = _navMeshQuery->findStraightPath(
-                startPoint,         // start position
-                endPoint,           // end position
-                _pathPolyRefs,     // current path
-                _polyLength,       // lenth of current path
-                pathPoints,         // [out] path corner points
-                NULL,               // [out] flags
-                NULL,               // [out] shortened path
-                (int*)&pointCount,
-                _pointPathLimit);   // maximum number of points/polygons to use
-    }
     else
-    {
-        dtResult = FindSmoothPath(
-                startPoint,         // start position
-                endPoint,           // end position
-                _pathPolyRefs,     // current path
-                _polyLength,       // length of current path
-                pathPoints,         // [out] path corner points
-                (int*)&pointCount,
-                _pointPathLimit);    // maximum number of points
-    }
+        dtResult = FindPointPath(startPoint, endPoint, pathPoints, &pointCount);
 
     // Special case with start and end positions very close to each other
     if (_polyLength == 1 && pointCount == 1)
@@ -645,6 +743,32 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
     TC_LOG_DEBUG("maps", "++ PathGenerator::BuildPointPath path type %d size %d poly-size %d\n", _type, pointCount, _polyLength);
 }
 
+dtStatus PathGenerator::FindPointPath(float const* startPoint, float const* endPoint, float* pathPoints, uint32* pointCount)
+{
+    if (_useStraightPath)
+    {
+        return _navMeshQuery->findStraightPath(
+                startPoint,         // start position
+                endPoint,           // end position
+                _pathPolyRefs,     // current path
+                _polyLength,       // lenth of current path
+                pathPoints,         // [out] path corner points
+                NULL,               // [out] flags
+                NULL,               // [out] shortened path
+                (int*)pointCount,
+                _pointPathLimit);   // maximum number of points/polygons to use
+    }
+
+    return FindSmoothPath(
+            startPoint,         // start position
+            endPoint,           // end position
+            _pathPolyRefs,     // current path
+            _polyLength,       // length of current path
+            pathPoints,         // [out] path corner points
+            (int*)pointCount,
+            _pointPathLimit);    // maximum number of points
+}
+
 void PathGenerator::NormalizePath()
 {
     for (uint32 i = 0; i < _pathPoints.size(); ++i)
@@ -964,7 +1088,7 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
         npolys = FixupCorridor(polys, npolys, MAX_PATH_LENGTH, visited, nvisited);
 
         if (dtStatusFailed(_navMeshQuery->getPolyHeight(polys[0], result, &result[1])))
-            TC_LOG_DEBUG("maps.mmaps", "Cannot find height at position X: %f Y: %f Z: %f for %u", result[2], result[0], result[1], _source->GetGUID().GetCounter());
+            TC_LOG_DEBUG("maps.mmaps", "Cannot find height at position X: %f Y: %f Z: %f for %u", result[2], result[0], result[1], _source ? _source->GetGUID().GetCounter() : 0);
         result[1] += 0.5f;
         dtVcopy(iterPos, result);
 
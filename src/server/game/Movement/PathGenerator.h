@@ -25,6 +25,9 @@
 #include "MoveSplineInitArgs.h"
 
 class Unit;
+class PathfindingSearch;
+struct PathfindingRequest;
+struct PathfindingResult;
 
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -54,6 +57,8 @@ enum PathType
 
 class TC_GAME_API PathGenerator
 {
+    friend class PathfindingService;
+
     public:
         explicit PathGenerator(WorldObject const* owner);
         ~PathGenerator();
@@ -63,6 +68,11 @@ class TC_GAME_API PathGenerator
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false, bool straightLine = false, bool assumeSourceOnGround = false);
         bool IsInvalidDestinationZ(Unit const* target) const;
 
+        // Same as CalculatePath without forceDest, solved by the PathfindingService of the map
+        // return: false if the path has to be calculated right away
+        bool PrepareAsyncPath(float destX, float destY, float destZ, PathfindingRequest& request);
+        void ApplyAsyncPath(PathfindingResult const& result);
+
         // option setters - use optional
         void SetUseStraightPath(bool useStraightPath) { _useStraightPath = useStraightPath; }
         void SetPathLengthLimit(float distance) { _pointPathLimit = std::min<uint32>(uint32(distance/SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); }
@@ -90,6 +100,9 @@ class TC_GAME_API PathGenerator
         Map* visualizePathMap = nullptr;
 
     private:
+        // worker side of PrepareAsyncPath, without an owner
+        PathGenerator(dtNavMeshQuery const* navMeshQuery, PathfindingRequest const& request);
+        bool BuildDetachedPath(PathfindingSearch const* search, PathfindingResult& result);
 
         dtPolyRef _pathPolyRefs[MAX_PATH_LENGTH];   // array of detour polygon references
         uint32 _polyLength;                         // number of polygons in the path
@@ -147,6 +160,7 @@ class TC_GAME_API PathGenerator
         dtStatus FindSmoothPath(float const* startPos, float const* endPos,
                               dtPolyRef const* polyPath, uint32 polyPathSize,
                               float* smoothPath, int* smoothPathSize, uint32 smoothPathMaxSize);
+        dtStatus FindPointPath(float const* startPoint, float const* endPoint, float* pathPoints, uint32* pointCount);
 
         void AddFarFromPolyFlags(bool startFarFromPoly, bool endFarFromPoly);
 };
@@ -0,0 +1,310 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "PathfindingService.h"
+#include "Log.h"
+#include "Metrics.h"
+#include "MMapFactory.h"
+#include "MMapManager.h"
+#include "ThreadPool.h"
+#include "DetourCommon.h"
+#include <chrono>
+#include <map>
+#include <tuple>
+
+bool PathfindingSearch::Build(dtNavMeshQuery const* query, dtQueryFilter const& filter, G3D::Vector3 const& root, float radius)
+{
+    float rootPoint[VERTEX_SIZE] = { root.y, root.z, root.x };
+    float extents[VERTEX_SIZE] = { 3.0f, 5.0f, 3.0f };
+    float closestPoint[VERTEX_SIZE];
+    if (dtStatusFailed(query->findNearestPoly(rootPoint, extents, &filter, &_root, closestPoint)) || _root == INVALID_POLYREF)
+        return false;
+
+    dtPolyRef polys[PATHFINDING_SHARED_SEARCH_POLYS];
+    dtPolyRef parents[PATHFINDING_SHARED_SEARCH_POLYS];
+    int count = 0;
+
+    // running out of space still leaves the polygons nearest to the target
+    dtStatus status = query->findPolysAroundCircle(_root, closestPoint, radius, &filter, polys, parents, nullptr, &count, PATHFINDING_SHARED_SEARCH_POLYS);
+    if (dtStatusFailed(status) || !count)
+        return false;
+
+    _parents.reserve(count);
+    for (int i = 0; i < count; ++i)
+        _parents.emplace(polys[i], parents[i]);
+
+    return true;
+}
+
+bool PathfindingSearch::GetCorridor(dtNavMeshQuery const* query, dtPolyRef startPoly, dtPolyRef endPoly, dtPolyRef* path, uint32& length) const
+{
+    // the search only tells how to get to the target, not to any other end
+    if (endPoly != _root)
+    {
+        auto itr = _parents.find(endPoly);
+        if (itr == _parents.end() || itr->second != _root)
+            return false;
+    }
+
+    dtNavMesh const* navMesh = query->getAttachedNavMesh();
+    length = 0;
+
+    // parents lead towards the root, the reversed direction is only safe without off-mesh connections
+    for (dtPolyRef poly = startPoly; poly != INVALID_POLYREF;)
+    {
+        if (length >= MAX_PATH_LENGTH - 1)
+            return false;
+
+        dtMeshTile const* tile = nullptr;
+        dtPoly const* polyData = nullptr;
+        if (dtStatusFailed(navMesh->getTileAndPolyByRef(poly, &tile, &polyData)) || polyData->getType() == DT_POLYTYPE_OFFMESH_CONNECTION)
+            return false;
+
+        path[length++] = poly;
+        if (poly == endPoly)
+            return true;
+
+        auto itr = _parents.find(poly);
+        if (itr == _parents.end())
+            return false;
+
+        poly = itr->second;
+    }
+
+    // reached the root, endPoly is next to it
+    path[length++] = endPoly;
+    return true;
+}
+
+PathfindingMgr::PathfindingMgr() : _threads(0), _sharedSearch(true), _solveMetric(0), _requests(0), _solved(0), _shared(0), _fallbacks(0),
+    _expired(0), _solveTime(0), _waitTime(0), _rateTimer(IN_MILLISECONDS), _rateRequests(0), _queriesPerSecond(0)
+{
+}
+
+PathfindingMgr::~PathfindingMgr()
+{
+    Stop();
+}
+
+PathfindingMgr* PathfindingMgr::instance()
+{
+    static PathfindingMgr instance;
+    return &instance;
+}
+
+void PathfindingMgr::Start(uint32 threads, bool sharedSearch)
+{
+    if (_pool || !threads)
+        return;
+
+    _threads = threads;
+    _sharedSearch = sharedSearch;
+    _solveMetric = sMetrics->Register("pathfinding_solve", METRIC_TIMER);
+    _pool = std::make_unique<Trinity::ThreadPool>(threads);
+
+    TC_LOG_INFO("maps", "Asynchronous pathfinding running on %u threads", threads);
+}
+
+void PathfindingMgr::Stop()
+{
+    if (!_pool)
+        return;
+
+    _pool->Join();
+    _pool.reset();
+    _threads = 0;
+}
+
+void PathfindingMgr::Update(uint32 diff)
+{
+    _rateTimer -= int32(diff);
+    if (_rateTimer > 0)
+        return;
+
+    uint64 requests = _requests.load(std::memory_order_relaxed);
+    _queriesPerSecond.store(uint32((requests - _rateRequests) * IN_MILLISECONDS / (IN_MILLISECONDS - _rateTimer)), std::memory_order_relaxed);
+    _rateRequests = requests;
+    _rateTimer = IN_MILLISECONDS;
+}
+
+PathfindingStats PathfindingMgr::GetStats() const
+{
+    PathfindingStats stats;
+    stats.Threads = _threads;
+    stats.Requests = _requests.load(std::memory_order_relaxed);
+    stats.Solved = _solved.load(std::memory_order_relaxed);
+    stats.Shared = _shared.load(std::memory_order_relaxed);
+    stats.Fallbacks = _fallbacks.load(std::memory_order_relaxed);
+    stats.Expired = _expired.load(std::memory_order_relaxed);
+    stats.SolveTime = _solveTime.load(std::memory_order_relaxed);
+    stats.WaitTime = _waitTime.load(std::memory_order_relaxed);
+    stats.QueriesPerSecond = _queriesPerSecond.load(std::memory_order_relaxed);
+    return stats;
+}
+
+PathfindingService::PathfindingService(uint32 mapId) : _mapId(mapId), _nextTicket(0), _tileLock(nullptr), _pendingJobs(0), _publishedTicket(0)
+{
+}
+
+PathfindingService::~PathfindingService()
+{
+    Wait();
+}
+
+uint64 PathfindingService::Request(PathfindingRequest&& request)
+{
+    if (!sPathfindingMgr->IsEnabled())
+        return 0;
+
+    sPathfindingMgr->_requests.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(_queueLock);
+    _queued.Tickets.push_back(++_nextTicket);
+    _queued.Requests.push_back(std::move(request));
+    return _nextTicket;
+}
+
+PathfindingResult const* PathfindingService::GetResult(uint64 ticket, bool& pending) const
+{
+    pending = ticket > _publishedTicket;
+    if (pending)
+        return nullptr;
+
+    auto itr = _results.find(ticket);
+    return itr != _results.end() ? &itr->second : nullptr;
+}
+
+void PathfindingService::Collect()
+{
+    // results of the previous batch the generators did not pick up during the last update
+    if (!_results.empty())
+    {
+        sPathfindingMgr->_expired.fetch_add(_results.size(), std::memory_order_relaxed);
+        _results.clear();
+    }
+
+    if (_batch.Tickets.empty())
+        return;
+
+    auto waitStart = std::chrono::steady_clock::now();
+    Wait();
+    sPathfindingMgr->_waitTime.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - waitStart).count(), std::memory_order_relaxed);
+
+    for (size_t i = 0; i < _batch.Tickets.size(); ++i)
+        _results.emplace(_batch.Tickets[i], std::move(_batch.Results[i]));
+
+    _publishedTicket = _batch.Tickets.back();
+    _batch.Tickets.clear();
+    _batch.Requests.clear();
+    _batch.Results.clear();
+}
+
+void PathfindingService::Dispatch()
+{
+    if (!_batch.Tickets.empty())
+        return;                                             // not collected yet, the queue waits for the next update
+
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        if (_queued.Tickets.empty())
+            return;
+
+        std::swap(_batch, _queued);
+    }
+
+    _batch.Results.resize(_batch.Tickets.size());
+
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    _tileLock = mmap->GetTileLock(_mapId);
+    if (!_tileLock || !sPathfindingMgr->IsEnabled())
+    {
+        // every result stays unsolved and falls back to the map thread
+        sPathfindingMgr->_fallbacks.fetch_add(_batch.Tickets.size(), std::memory_order_relaxed);
+        return;
+    }
+
+    // one job per target, chasers of the same target share its search
+    std::map<std::tuple<ObjectGuid, uint16, uint16>, std::vector<uint32>> jobs;
+    for (uint32 i = 0; i < _batch.Requests.size(); ++i)
+    {
+        PathfindingRequest const& request = _batch.Requests[i];
+        jobs[std::make_tuple(request.Target, request.Filter.getIncludeFlags(), request.Filter.getExcludeFlags())].push_back(i);
+    }
+
+    _pendingJobs = jobs.size();
+    for (auto& job : jobs)
+        sPathfindingMgr->_pool->PostWork([this, indexes = std::move(job.second)]() { Solve(indexes); });
+}
+
+void PathfindingService::Wait()
+{
+    std::unique_lock<std::mutex> lock(_batchLock);
+    _batchCondition.wait(lock, [this]() { return _pendingJobs == 0; });
+}
+
+void PathfindingService::Solve(std::vector<uint32> const& indexes)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(*_tileLock);
+        if (dtNavMeshQuery const* query = MMAP::MMapFactory::createOrGetMMapManager()->GetThreadNavMeshQuery(_mapId))
+        {
+            PathfindingRequest const& first = _batch.Requests[indexes.front()];
+
+            PathfindingSearch search;
+            bool shared = false;
+            if (indexes.size() > 1 && !first.Target.IsEmpty() && sPathfindingMgr->IsSharedSearchEnabled())
+            {
+                float radius = 0.0f;
+                for (uint32 index : indexes)
+                    radius = std::max(radius, (_batch.Requests[index].Start - first.TargetPosition).length());
+
+                shared = search.Build(query, first.Filter, first.TargetPosition, std::min(radius + SMOOTH_PATH_STEP_SIZE, PATHFINDING_SHARED_SEARCH_RADIUS));
+            }
+
+            for (uint32 index : indexes)
+            {
+                auto solveStart = std::chrono::steady_clock::now();
+
+                PathGenerator path(query, _batch.Requests[index]);
+                PathfindingResult& result = _batch.Results[index];
+                if (!path.BuildDetachedPath(shared ? &search : nullptr, result))
+                    result = PathfindingResult();
+
+                uint64 solveTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - solveStart).count();
+                sPathfindingMgr->_solveTime.fetch_add(solveTime, std::memory_order_relaxed);
+                if (sMetrics->IsEnabled())
+                    sMetrics->Record(sPathfindingMgr->_solveMetric, solveTime);
+            }
+        }
+    }
+
+    uint32 solved = 0, sharedCorridors = 0;
+    for (uint32 index : indexes)
+    {
+        if (_batch.Results[index].Solved)
+            ++solved;
+        if (_batch.Results[index].Shared)
+            ++sharedCorridors;
+    }
+
+    sPathfindingMgr->_solved.fetch_add(solved, std::memory_order_relaxed);
+    sPathfindingMgr->_shared.fetch_add(sharedCorridors, std::memory_order_relaxed);
+    sPathfindingMgr->_fallbacks.fetch_add(indexes.size() - solved, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(_batchLock);
+    if (!--_pendingJobs)
+        _batchCondition.notify_all();
+}
@@ -0,0 +1,176 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef TRINITY_PATHFINDINGSERVICE_H
+#define TRINITY_PATHFINDINGSERVICE_H
+
+#include "PathGenerator.h"
+#include "ObjectGuid.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Trinity
+{
+    class ThreadPool;
+}
+
+#define PATHFINDING_SHARED_SEARCH_RADIUS    80.0f       // chasers further from their target get their own search
+#define PATHFINDING_SHARED_SEARCH_POLYS     1024
+
+/// Everything a worker needs to solve a path, copied from the owner on the map thread
+struct PathfindingRequest
+{
+    ObjectGuid Target;                      // requests towards the same target share one search
+    G3D::Vector3 TargetPosition;
+    G3D::Vector3 Start;
+    G3D::Vector3 End;
+    dtQueryFilter Filter;
+    bool UseStraightPath = false;
+    uint32 PointPathLimit = MAX_POINT_PATH_LENGTH;
+};
+
+struct PathfindingResult
+{
+    bool Solved = false;                    // false when the path needs the map (holes, water, flying), see PathGenerator::CalculatePath
+    bool Shared = false;                    // corridor taken from the search of the target
+    PathType Type = PATHFIND_BLANK;
+    std::vector<dtPolyRef> Corridor;
+    Movement::PointsArray Points;           // heights are not adjusted yet, see PathGenerator::ApplyAsyncPath
+};
+
+/// Dijkstra search from the polygon of a target, every chaser standing on a reached polygon
+/// walks the parents back to the target instead of running its own findPath
+class PathfindingSearch
+{
+    public:
+        bool Build(dtNavMeshQuery const* query, dtQueryFilter const& filter, G3D::Vector3 const& root, float radius);
+
+        // corridor from startPoly towards the target, ending in endPoly
+        bool GetCorridor(dtNavMeshQuery const* query, dtPolyRef startPoly, dtPolyRef endPoly, dtPolyRef* path, uint32& length) const;
+
+    private:
+        dtPolyRef _root = INVALID_POLYREF;
+        std::unordered_map<dtPolyRef, dtPolyRef> _parents;
+};
+
+struct PathfindingStats
+{
+    uint32 Threads;
+    uint64 Requests;
+    uint64 Solved;
+    uint64 Shared;                          // solved from the search of another chaser of the same target
+    uint64 Fallbacks;                       // left to the map thread
+    uint64 Expired;                         // results nobody came for
+    uint64 SolveTime;                       // us spent by the workers
+    uint64 WaitTime;                        // us map threads waited for a batch at the start of their update
+    uint32 QueriesPerSecond;
+};
+
+/// Worker threads and counters shared by the PathfindingService of every map
+class TC_GAME_API PathfindingMgr
+{
+    friend class PathfindingService;
+
+    public:
+        static PathfindingMgr* instance();
+
+        void Start(uint32 threads, bool sharedSearch);
+        void Stop();
+        bool IsEnabled() const { return _pool != nullptr; }
+        bool IsSharedSearchEnabled() const { return _sharedSearch; }
+
+        void Update(uint32 diff);
+
+        PathfindingStats GetStats() const;
+
+    private:
+        PathfindingMgr();
+        ~PathfindingMgr();
+
+        std::unique_ptr<Trinity::ThreadPool> _pool;
+        uint32 _threads;
+        bool _sharedSearch;
+
+        uint32 _solveMetric;
+        std::atomic<uint64> _requests;
+        std::atomic<uint64> _solved;
+        std::atomic<uint64> _shared;
+        std::atomic<uint64> _fallbacks;
+        std::atomic<uint64> _expired;
+        std::atomic<uint64> _solveTime;
+        std::atomic<uint64> _waitTime;
+
+        int32 _rateTimer;
+        uint64 _rateRequests;
+        std::atomic<uint32> _queriesPerSecond;
+};
+
+#define sPathfindingMgr PathfindingMgr::instance()
+
+/// Paths of one map solved on the PathfindingMgr workers between two updates of the map.
+/// Requests queued during Map::Update are dispatched at its end, their results are published
+/// at the start of the next Map::Update and stay readable for that update only.
+class TC_GAME_API PathfindingService
+{
+    public:
+        explicit PathfindingService(uint32 mapId);
+        ~PathfindingService();
+
+        PathfindingService(PathfindingService const&) = delete;
+        PathfindingService& operator=(PathfindingService const&) = delete;
+
+        /// Safe from region threads, returns 0 when asynchronous pathfinding is disabled
+        uint64 Request(PathfindingRequest&& request);
+
+        /// nullptr while the request is pending, or once its result has expired
+        PathfindingResult const* GetResult(uint64 ticket, bool& pending) const;
+
+        void Collect();
+        void Dispatch();
+        void Wait();
+
+    private:
+        struct Batch
+        {
+            std::vector<uint64> Tickets;
+            std::vector<PathfindingRequest> Requests;
+            std::vector<PathfindingResult> Results;
+        };
+
+        void Solve(std::vector<uint32> const& indexes);
+
+        uint32 _mapId;
+
+        std::mutex _queueLock;                              // guards _nextTicket and _queued
+        uint64 _nextTicket;
+        Batch _queued;
+
+        Batch _batch;                                       // being solved, only touched by the workers until _pendingJobs is 0
+        std::shared_mutex* _tileLock;
+        std::mutex _batchLock;
+        std::condition_variable _batchCondition;
+        uint32 _pendingJobs;
+
+        std::unordered_map<uint64, PathfindingResult> _results;
+        uint64 _publishedTicket;                            // tickets up to this one are in _results or expired
+};
+
+#endif
@@ -475,11 +475,16 @@ void ScriptMgr::OnPacketReceive(WorldSession* session, WorldPacket packet)
     FOREACH_SCRIPT(ServerScript)->OnPacketReceive(session, packet);
 }
 
-void ScriptMgr::OnPacketSend(WorldSession* session, WorldPacket packet)
+void ScriptMgr::OnPacketSend(WorldSession* session, WorldPacket const& packet)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnPacketSend(session, packet);
+    if (SCR_REG_LST(ServerScript).empty())
+        return;
+
+    // Scripts get their own copy, don't pay for it on every sent packet when there are none
+    WorldPacket copy(packet);
+    FOREACH_SCRIPT(ServerScript)->OnPacketSend(session, copy);
 }
 
 void ScriptMgr::OnUnknownPacketReceive(WorldSocket* socket, WorldPacket packet)
@@ -594,6 +599,9 @@ void ScriptMgr::OnCreateMap(Map* map)
 void ScriptMgr::OnDestroyMap(Map* map)
 {
     ASSERT(map);
+#ifdef ELUNA
+    sHookMgr->OnDestroyMap(map);
+#endif
 
     SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
         itr->second->OnDestroy(map);
@@ -685,6 +693,9 @@ void ScriptMgr::OnPlayerLeaveMap(Map* map, Player* player)
 void ScriptMgr::OnMapUpdate(Map* map, uint32 diff)
 {
     ASSERT(map);
+#ifdef ELUNA
+    sHookMgr->OnMapUpdate(map, diff);
+#endif
 
     SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
         itr->second->OnUpdate(map, diff);
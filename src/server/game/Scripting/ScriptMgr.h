@@ -1009,7 +1009,7 @@ class TC_GAME_API ScriptMgr
         void OnSocketOpen(std::shared_ptr<WorldSocket>);
         void OnSocketClose(std::shared_ptr<WorldSocket>);
         void OnPacketReceive(WorldSession* session, WorldPacket packet);
-        void OnPacketSend(WorldSession* session, WorldPacket packet);
+        void OnPacketSend(WorldSession* session, WorldPacket const& packet);
         void OnUnknownPacketReceive(WorldSocket* socket, WorldPacket packet);
 
     public: /* WorldScript */
@@ -0,0 +1,37 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PacketBroadcast.h"
+#include "Player.h"
+#include "WorldSession.h"
+
+void PacketBroadcast::SendTo(Player* player)
+{
+    WorldSession* session = player->GetSession();
+    if (!session)
+        return;
+
+    if (!_sharedPacket)
+        _sharedPacket = std::make_shared<WorldPacket>(*_packet);
+
+    session->SendPacket(_sharedPacket);
+}
+
+bool PacketBroadcast::IsInWorld(Player* player)
+{
+    return player->IsInWorld();
+}
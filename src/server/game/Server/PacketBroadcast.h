@@ -0,0 +1,78 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PacketBroadcast_h__
+#define PacketBroadcast_h__
+
+#include "ObjectAccessor.h"
+#include <memory>
+#include <vector>
+
+class Player;
+class WorldPacket;
+
+// Sends one packet to many players (channels, guilds, groups, battlegrounds).
+// Receivers looked up by guid take a single lock of the player map, and all of them share one copy
+// of the packet: the sockets keep a reference and frame and encrypt it on their network thread.
+class TC_GAME_API PacketBroadcast
+{
+    public:
+        explicit PacketBroadcast(WorldPacket const* packet) : _packet(packet) { }
+
+        // Looks the guids up like ObjectAccessor::FindPlayer, guidOf may return an empty guid to skip an element
+        template<class Iterator, class GuidOf>
+        PacketBroadcast& AddPlayers(Iterator begin, Iterator end, GuidOf guidOf)
+        {
+            std::shared_lock<std::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+            HashMapHolder<Player>::MapType const& players = HashMapHolder<Player>::GetContainer();
+            for (; begin != end; ++begin)
+            {
+                ObjectGuid guid = guidOf(*begin);
+                if (!guid)
+                    continue;
+
+                auto itr = players.find(guid);
+                if (itr != players.end() && IsInWorld(itr->second))
+                    _players.push_back(itr->second);
+            }
+
+            return *this;
+        }
+
+        // Sends to the added players accepted by the filter
+        template<class Filter>
+        void Send(Filter filter)
+        {
+            for (Player* player : _players)
+                if (filter(player))
+                    SendTo(player);
+        }
+
+        void Send() { Send([](Player*) { return true; }); }
+
+        // Sends to a player that is already at hand
+        void SendTo(Player* player);
+
+    private:
+        static bool IsInWorld(Player* player);
+
+        WorldPacket const* _packet;
+        std::shared_ptr<WorldPacket const> _sharedPacket;   // created for the first receiver
+        std::vector<Player*> _players;
+};
+
+#endif // PacketBroadcast_h__
@@ -0,0 +1,108 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PacketCompressionMgr.h"
+#include "Log.h"
+#include "ThreadPool.h"
+#include "World.h"
+#include <zlib.h>
+
+PacketCompressionMgr::PacketCompressionMgr() : _threads(0), _backlog(0), _packets(0), _bytesIn(0), _bytesOut(0), _time(0)
+{
+}
+
+PacketCompressionMgr::~PacketCompressionMgr()
+{
+    Stop();
+}
+
+PacketCompressionMgr* PacketCompressionMgr::instance()
+{
+    static PacketCompressionMgr instance;
+    return &instance;
+}
+
+void PacketCompressionMgr::Start(uint32 threads)
+{
+    if (_pool || !threads)
+        return;
+
+    _threads = threads;
+    _pool = std::make_unique<Trinity::ThreadPool>(threads);
+
+    TC_LOG_INFO("network", "Packet compression running on %u threads", threads);
+}
+
+void PacketCompressionMgr::Stop()
+{
+    if (!_pool)
+        return;
+
+    _pool->Join();
+    _pool.reset();
+    _threads = 0;
+}
+
+void PacketCompressionMgr::Post(std::function<void()>&& job)
+{
+    ++_backlog;
+    _pool->PostWork([this, job = std::move(job)]()
+    {
+        job();
+        --_backlog;
+    });
+}
+
+int32 PacketCompressionMgr::SelectCompressionLevel(uint32 packetSize) const
+{
+    int32 level = sWorld->getIntConfig(CONFIG_COMPRESSION);
+    uint32 largePacketSize = sWorld->getIntConfig(CONFIG_COMPRESSION_LARGE_PACKET_SIZE);
+    if (!largePacketSize)
+        return level;
+
+    // Only big packets (object updates, auction lists) are worth the configured level,
+    // and nothing is while the compression threads are falling behind
+    if (packetSize < largePacketSize || IsBacklogged())
+        return Z_BEST_SPEED;
+
+    return level;
+}
+
+void PacketCompressionMgr::RecordCompression(uint32 bytesIn, uint32 bytesOut, uint64 time)
+{
+    _packets.fetch_add(1, std::memory_order_relaxed);
+    _bytesIn.fetch_add(bytesIn, std::memory_order_relaxed);
+    _bytesOut.fetch_add(bytesOut, std::memory_order_relaxed);
+    _time.fetch_add(time, std::memory_order_relaxed);
+}
+
+PacketCompressionStats PacketCompressionMgr::GetStats() const
+{
+    PacketCompressionStats stats;
+    stats.Threads = _threads;
+    stats.Backlog = _backlog.load(std::memory_order_relaxed);
+    stats.Packets = _packets.load(std::memory_order_relaxed);
+    stats.BytesIn = _bytesIn.load(std::memory_order_relaxed);
+    stats.BytesOut = _bytesOut.load(std::memory_order_relaxed);
+    stats.Time = _time.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool PacketCompressionMgr::IsBacklogged() const
+{
+    return _threads && _backlog.load(std::memory_order_relaxed) > _threads * 4;
+}
@@ -0,0 +1,79 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __PACKETCOMPRESSIONMGR_H
+#define __PACKETCOMPRESSIONMGR_H
+
+#include "Define.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace Trinity
+{
+    class ThreadPool;
+}
+
+struct PacketCompressionStats
+{
+    uint32 Threads;
+    uint32 Backlog;
+    uint64 Packets;
+    uint64 BytesIn;
+    uint64 BytesOut;
+    uint64 Time;                                            // microseconds spent in deflate
+};
+
+/// Picks compression levels for outgoing packets and optionally runs socket compression jobs on dedicated threads
+class TC_GAME_API PacketCompressionMgr
+{
+public:
+    static PacketCompressionMgr* instance();
+
+    void Start(uint32 threads);
+    void Stop();
+
+    /// True when sockets should hand batches containing compressed packets to Post instead of compressing them inline
+    bool IsEnabled() const { return _pool != nullptr; }
+
+    /// Jobs of one socket must not overlap, WorldSocket keeps at most one in flight
+    void Post(std::function<void()>&& job);
+
+    int32 SelectCompressionLevel(uint32 packetSize) const;
+    void RecordCompression(uint32 bytesIn, uint32 bytesOut, uint64 time);
+
+    PacketCompressionStats GetStats() const;
+
+private:
+    PacketCompressionMgr();
+    ~PacketCompressionMgr();
+
+    bool IsBacklogged() const;
+
+    std::unique_ptr<Trinity::ThreadPool> _pool;
+    uint32 _threads;
+    std::atomic<uint32> _backlog;
+
+    std::atomic<uint64> _packets;
+    std::atomic<uint64> _bytesIn;
+    std::atomic<uint64> _bytesOut;
+    std::atomic<uint64> _time;
+};
+
+#define sPacketCompressionMgr PacketCompressionMgr::instance()
+
+#endif
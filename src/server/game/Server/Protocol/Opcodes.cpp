@@ -17,6 +17,7 @@
 
 #include "Opcodes.h"
 #include "Log.h"
+#include "Metrics.h"
 #include "WorldSession.h"
 #include "Packets/AllPackets.h"
 #include <iomanip>
@@ -101,6 +102,7 @@ void OpcodeTable::ValidateAndSetClientOpcode(OpcodeClient opcode, char const* na
     }
 
     _internalTableClient[opcode] = new PacketHandler<typename get_packet_class<Handler>::type, HandlerFunction>(name, status, processing);
+    _internalTableClient[opcode]->MetricId = sMetrics->Register(std::string("opcode,name=") + name, METRIC_TIMER);
 }
 
 void OpcodeTable::ValidateAndSetServerOpcode(OpcodeServer opcode, char const* name, SessionStatus status)
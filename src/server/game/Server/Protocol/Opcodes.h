@@ -1510,6 +1510,7 @@ public:
     virtual void Call(WorldSession* session, WorldPacket& packet) const = 0;
 
     PacketProcessing ProcessingPlace;
+    uint32 MetricId = 0;                                    // opcode timer of WorldSession::Update
 };
 
 class ServerOpcodeHandler : public OpcodeHandler
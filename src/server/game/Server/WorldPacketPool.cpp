@@ -0,0 +1,107 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "WorldPacketPool.h"
+#include <mutex>
+
+namespace
+{
+    std::mutex PoolsLock;
+    std::vector<WorldPacketPool*> Pools;                    // for GetStats, pools are never destroyed
+}
+
+WorldPacketPool* WorldPacketPool::GetThreadPool()
+{
+    // released packets may still come back during shutdown, so the pool outlives its thread
+    thread_local WorldPacketPool* pool = nullptr;
+    if (!pool)
+    {
+        pool = new WorldPacketPool();
+        std::lock_guard<std::mutex> lock(PoolsLock);
+        Pools.push_back(pool);
+    }
+
+    return pool;
+}
+
+PooledWorldPacket* WorldPacketPool::Acquire(uint32 opcode, uint8 const* data, std::size_t size)
+{
+    if (_free.empty())
+        CollectReturned();
+
+    PooledWorldPacket* packet;
+    if (!_free.empty())
+    {
+        packet = _free.back();
+        _free.pop_back();
+        _reusedPackets.store(_reusedPackets.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (packet->capacity() >= size)
+            _reusedStorage.store(_reusedStorage.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    else
+        packet = new PooledWorldPacket(this);
+
+    _acquired.store(_acquired.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    _freeCount.store(_free.size(), std::memory_order_relaxed);
+
+    packet->Initialize(opcode, size);
+    packet->SetReceiveTime(TimePoint());
+    if (size)
+        packet->append(data, size);
+
+    return packet;
+}
+
+void WorldPacketPool::CollectReturned()
+{
+    PooledWorldPacket* packet;
+    while (_returned.Dequeue(packet))
+    {
+        if (_free.size() < MAX_FREE_PACKETS)
+            _free.push_back(packet);
+        else
+            delete packet;
+    }
+}
+
+void WorldPacketPool::Release(PooledWorldPacket* packet)
+{
+    if (!packet)
+        return;
+
+    if (packet->capacity() > MAX_POOLED_STORAGE)
+        static_cast<WorldPacket&>(*packet) = WorldPacket();
+
+    packet->GetPool()->_returned.Enqueue(packet);
+}
+
+WorldPacketPoolStats WorldPacketPool::GetStats()
+{
+    WorldPacketPoolStats stats;
+
+    std::lock_guard<std::mutex> lock(PoolsLock);
+    for (WorldPacketPool const* pool : Pools)
+    {
+        stats.Acquired += pool->_acquired.load(std::memory_order_relaxed);
+        stats.ReusedPackets += pool->_reusedPackets.load(std::memory_order_relaxed);
+        stats.ReusedStorage += pool->_reusedStorage.load(std::memory_order_relaxed);
+        stats.Free += pool->_freeCount.load(std::memory_order_relaxed);
+    }
+
+    stats.Pools = Pools.size();
+    return stats;
+}
@@ -0,0 +1,98 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WorldPacketPool_h__
+#define WorldPacketPool_h__
+
+#include "WorldPacket.h"
+#include "MPSCQueue.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class WorldPacketPool;
+
+// Client packet on its way from a WorldSocket to WorldSession::Update, recycled by the pool of the network thread that read it
+class PooledWorldPacket : public WorldPacket
+{
+    public:
+        explicit PooledWorldPacket(WorldPacketPool* pool) : _pool(pool)
+        {
+            QueueLink.store(nullptr, std::memory_order_relaxed);
+        }
+
+        WorldPacketPool* GetPool() const { return _pool; }
+
+        // WorldSession receive queue or the return queue of the pool, never both
+        std::atomic<PooledWorldPacket*> QueueLink;
+
+    private:
+        WorldPacketPool* _pool;
+};
+
+typedef MPSCQueue<PooledWorldPacket, &PooledWorldPacket::QueueLink> PooledWorldPacketQueue;
+
+struct WorldPacketPoolStats
+{
+    uint64 Acquired = 0;
+    uint64 ReusedPackets = 0;                               // no WorldPacket allocation
+    uint64 ReusedStorage = 0;                               // no storage allocation
+    std::size_t Free = 0;                                   // cached in the pools right now
+    std::size_t Pools = 0;
+};
+
+// One pool per network thread. Only that thread acquires, any thread may release,
+// released packets are handed back through a lock-free queue.
+class WorldPacketPool
+{
+    public:
+        static constexpr std::size_t MAX_FREE_PACKETS = 2048;
+        static constexpr std::size_t MAX_POOLED_STORAGE = 4096; // larger buffers are freed on release
+
+        struct Releaser
+        {
+            void operator()(PooledWorldPacket* packet) const { Release(packet); }
+        };
+
+        typedef std::unique_ptr<PooledWorldPacket, Releaser> Ptr;
+
+        // Pool of the calling thread, created on first use and never destroyed
+        static WorldPacketPool* GetThreadPool();
+
+        static void Release(PooledWorldPacket* packet);
+
+        static WorldPacketPoolStats GetStats();
+
+        PooledWorldPacket* Acquire(uint32 opcode, uint8 const* data, std::size_t size);
+
+    private:
+        WorldPacketPool() = default;
+        ~WorldPacketPool() = delete;
+
+        void CollectReturned();
+
+        std::vector<PooledWorldPacket*> _free;
+        PooledWorldPacketQueue _returned;
+
+        // written by the owning thread only
+        std::atomic<uint64> _acquired{ 0 };
+        std::atomic<uint64> _reusedPackets{ 0 };
+        std::atomic<uint64> _reusedStorage{ 0 };
+        std::atomic<std::size_t> _freeCount{ 0 };
+};
+
+#endif // WorldPacketPool_h__
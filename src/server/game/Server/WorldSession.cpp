@@ -24,6 +24,7 @@
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "AccountMgr.h"
+#include "AuctionHouseMgr.h"
 #include "Log.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
@@ -40,6 +41,7 @@
 #include "BattlegroundMgr.h"
 #include "OutdoorPvPMgr.h"
 #include "MapManager.h"
+#include "Metrics.h"
 #include "SocialMgr.h"
 #include "zlib.h"
 #include "ScriptMgr.h"
@@ -159,9 +161,11 @@ WorldSession::~WorldSession()
     delete m_charBooster;
 
     ///- empty incoming packet queue
-    WorldPacket* packet = nullptr;
-    while (_recvQueue.next(packet))
-        delete packet;
+    PooledWorldPacket* packet = nullptr;
+    while (_recvQueue.Dequeue(packet))
+        WorldPacketPool::Release(packet);
+    for (PooledWorldPacket* pending : _recvPending)
+        WorldPacketPool::Release(pending);
 
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
 
@@ -196,16 +200,33 @@ uint32 WorldSession::GetGuidLow() const
 
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/)
+{
+    if (!CanSendPacket(packet, forced))
+        return;
+
+    m_Socket->SendPacket(*packet);
+}
+
+/// Sends a packet whose storage is shared with other sessions, the socket keeps a reference instead of copying it
+void WorldSession::SendPacket(std::shared_ptr<WorldPacket const> const& packet, bool forced /*= false*/)
+{
+    if (!CanSendPacket(packet.get(), forced))
+        return;
+
+    m_Socket->SendPacket(packet);
+}
+
+bool WorldSession::CanSendPacket(WorldPacket const* packet, bool forced)
 {
     if (packet->GetOpcode() == NULL_OPCODE)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of NULL_OPCODE to %s", GetPlayerInfo().c_str());
-        return;
+        return false;
     }
     else if (packet->GetOpcode() == UNKNOWN_OPCODE)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of UNKNOWN_OPCODE to %s", GetPlayerInfo().c_str());
-        return;
+        return false;
     }
 
     ServerOpcodeHandler const* handler = opcodeTable[static_cast<OpcodeServer>(packet->GetOpcode())];
@@ -215,13 +236,13 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
         TC_LOG_ERROR("network.opcode", "Prevented sending of opcode %s with non existing handler to %s",
                      GetOpcodeNameForLogging(static_cast<OpcodeClient>(packet->GetOpcode())).c_str(),
                      GetPlayerInfo().c_str());
-        return;
+        return false;
     }
 
     if (!m_Socket)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of %s to non existent socket to %s", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str(), GetPlayerInfo().c_str());
-        return;
+        return false;
     }
 
     if (!forced)
@@ -230,7 +251,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
         if (!handler || handler->Status == STATUS_UNHANDLED)
         {
             TC_LOG_ERROR("network.opcode", "Prevented sending disabled opcode %s to %s", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str(), GetPlayerInfo().c_str());
-            return;
+            return false;
         }
     }
 
@@ -268,22 +289,20 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     }
 #endif                                                      // !TRINITY_DEBUG
 
+    // count = packets, sum = bytes
+    static uint32 const sendPacketMetric = sMetrics->Register("packets_sent", METRIC_COUNTER);
+    sMetrics->Add(sendPacketMetric, packet->size());
+
     sScriptMgr->OnPacketSend(this, *packet);
 
     TC_LOG_TRACE("network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str());
-    m_Socket->SendPacket(*packet);
+    return true;
 }
 
-/// Add an incoming packet to the queue
-void WorldSession::QueuePacket(WorldPacket* new_packet)
+/// Add an incoming packet to the queue, called by the network thread
+void WorldSession::QueuePacket(PooledWorldPacket* new_packet)
 {
-    // prioritize CMSG_PLAYER_LOGIN
-    // sometimes CMSG_PLAYER_LOGIN arrives after hundreds of packets that require STATUS_LOGGEDIN
-    // if CMSG_PLAYER_LOGIN is not prioritized, login will never complete
-    if (!_player && new_packet->GetOpcode() == CMSG_PLAYER_LOGIN)
-        _recvQueue.push_front(new_packet);
-    else
-        _recvQueue.add(new_packet);
+    _recvQueue.Enqueue(new_packet);
 }
 
 /// Logging helper for unexpected opcodes
@@ -328,19 +347,34 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
-    WorldPacket* packet = nullptr;
+    PooledWorldPacket* packet = nullptr;
     //! Delete packet after processing by default
     bool deletePacket = true;
-    std::vector<WorldPacket*> requeuePackets;
+    std::vector<PooledWorldPacket*> requeuePackets;
     uint32 _startMSTime = getMSTime();
     uint32 processedPackets = 0;
     time_t currentTime = GameTime::GetGameTime();
 
     constexpr uint32 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE = 100;
 
-    while (m_Socket && _recvQueue.next(packet, updater))
+    while (_recvQueue.Dequeue(packet))
     {
+        // prioritize CMSG_PLAYER_LOGIN
+        // sometimes CMSG_PLAYER_LOGIN arrives after hundreds of packets that require STATUS_LOGGEDIN
+        // if CMSG_PLAYER_LOGIN is not prioritized, login will never complete
+        if (!_player && packet->GetOpcode() == CMSG_PLAYER_LOGIN)
+            _recvPending.push_front(packet);
+        else
+            _recvPending.push_back(packet);
+    }
+
+    while (m_Socket && !_recvPending.empty() && updater.Process(_recvPending.front()))
+    {
+        packet = _recvPending.front();
+        _recvPending.pop_front();
+
         ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())];
+        MetricScopedTimer opcodeTimer(opHandle->MetricId);
         try
         {
             switch (opHandle->Status)
@@ -439,7 +473,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
         }
 
         if (deletePacket)
-            delete packet;
+            WorldPacketPool::Release(packet);
 
         deletePacket = true;
 
@@ -452,7 +486,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     }
 
-    _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
+    _recvPending.insert(_recvPending.begin(), requeuePackets.begin(), requeuePackets.end());
 
     if (m_Socket && m_Socket->IsOpen() && _warden)
         _warden->Update();
@@ -508,11 +542,8 @@ void WorldSession::LogoutPlayer(bool save)
         HandleMoveWorldportAck();
 
     // Wait until all async auction queries are processed.
-    while (_player)
-    {
-        if (_player->m_activeAuctionQueries.empty())
-            break;
-    }
+    if (_player)
+        sAuctionMgr->WaitForActiveQueries(_player);
 
     m_playerLogout = true;
     m_playerSave = save;
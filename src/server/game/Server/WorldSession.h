@@ -29,12 +29,14 @@
 #include "AddonMgr.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include "WorldPacketPool.h"
 #include "Cryptography/BigNumber.h"
 #include "Opcodes.h"
 #include "AccountMgr.h"
 #include "Object.h"
 #include "AsyncCallbackProcessor.h"
 #include "DatabaseEnvFwd.h"
+#include <deque>
 
 class BigNumber;
 class AccountAchievementMgr;
@@ -280,6 +282,7 @@ class TC_GAME_API WorldSession
         bool IsAddonRegistered(const std::string& prefix) const;
 
         void SendPacket(WorldPacket const* packet, bool forced = false);
+        void SendPacket(std::shared_ptr<WorldPacket const> const& packet, bool forced = false);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName *declinedName);
@@ -343,7 +346,7 @@ class TC_GAME_API WorldSession
         void KickPlayer();
         bool forceExit;
 
-        void QueuePacket(WorldPacket* new_packet);
+        void QueuePacket(PooledWorldPacket* new_packet);
         bool Update(uint32 diff, PacketFilter& updater);
 
         /// Handle the authentication waiting queue (to be completed)
@@ -1224,6 +1227,9 @@ class TC_GAME_API WorldSession
         // logging helper
         void LogUnexpectedOpcode(WorldPacket* packet, const char* status, const char *reason);
 
+        // checks and logging shared by both SendPacket overloads
+        bool CanSendPacket(WorldPacket const* packet, bool forced);
+
         // EnumData helpers
         bool IsLegitCharacterForAccount(ObjectGuid guid)
         {
@@ -1271,7 +1277,8 @@ class TC_GAME_API WorldSession
         uint32 recruiterId;
         bool isRecruiter;
         bool m_hasBoost;
-        LockedQueue<WorldPacket*> _recvQueue;
+        PooledWorldPacketQueue _recvQueue;                  // filled by the network thread
+        std::deque<PooledWorldPacket*> _recvPending;        // taken from _recvQueue, only used by the thread updating the session
         uint32 expireTime;
         time_t timeLastWhoCommand;
 
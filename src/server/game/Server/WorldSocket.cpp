@@ -23,12 +23,14 @@
 #include "CryptoRandom.h"
 #include "IPLocation.h"
 #include "Opcodes.h"
+#include "PacketCompressionMgr.h"
 #include "PacketLog.h"
 #include "Random.h"
 //#include "RBAC.h"
 #include "Realm.h"
 #include "ScriptMgr.h"
 #include "World.h"
+#include "WorldPacketPool.h"
 #include "WorldSession.h"
 #include <memory>
 #include <zlib.h>
@@ -48,6 +50,7 @@ struct CompressedWorldPacket
 std::string const WorldSocket::ServerConnectionInitialize("WORLD OF WARCRAFT CONNECTION - SERVER TO CLIENT");
 std::string const WorldSocket::ClientConnectionInitialize("WORLD OF WARCRAFT CONNECTION - CLIENT TO SERVER");
 uint32 const WorldSocket::MinSizeForCompression = 0x400;
+uint32 const WorldSocket::MinSizeForSharedPayload = 0x200;
 uint32 const SizeOfHeader = sizeof(uint16) + sizeof(uint16);
 
 struct ServerPktHeader
@@ -80,7 +83,8 @@ struct ServerPktHeader
 using boost::asio::ip::tcp;
 
 WorldSocket::WorldSocket(tcp::socket&& socket)
-    : Socket(std::move(socket)), _OverSpeedPings(0), _worldSession(nullptr), _authed(false), _sendBufferSize(4096), _compressionStream(nullptr)
+    : Socket(std::move(socket)), _OverSpeedPings(0), _worldSession(nullptr), _authed(false), _sendBufferSize(4096), _compressionStream(nullptr),
+    _compressionLevel(0), _compressionJobActive(false)
 {
     Trinity::Crypto::GetRandomBytes(_authSeed);
     _headerBuffer.Resize(sizeof(ClientPktHeader));
@@ -183,7 +187,8 @@ void WorldSocket::InitializeHandler(boost::system::error_code error, std::size_t
             _compressionStream->opaque = (voidpf)nullptr;
             _compressionStream->avail_in = 0;
             _compressionStream->next_in = nullptr;
-            int32 z_res = deflateInit2(_compressionStream, sWorld->getIntConfig(CONFIG_COMPRESSION), Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+            _compressionLevel = sWorld->getIntConfig(CONFIG_COMPRESSION);
+            int32 z_res = deflateInit2(_compressionStream, _compressionLevel, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
             if (z_res != Z_OK)
             {
                 CloseSocket();
@@ -203,38 +208,41 @@ void WorldSocket::InitializeHandler(boost::system::error_code error, std::size_t
 
 bool WorldSocket::Update()
 {
-    EncryptablePacket* queued;
-    MessageBuffer buffer(_sendBufferSize);
-    while (_bufferQueue.Dequeue(queued))
+    // While a compression job runs new packets stay in _bufferQueue, behind the ones being compressed
+    if (!_compressionJobActive.load(std::memory_order_acquire))
     {
+        if (!_compressedBuffers.empty())
+        {
+            QueueSerializedBuffers(_compressedBuffers);
+            _compressedBuffers.clear();
+        }
 
-        uint32 packetSize = queued->size();
-        if (packetSize > MinSizeForCompression && queued->NeedsEncryption())
-            packetSize = compressBound(packetSize) + sizeof(CompressedWorldPacket);
-
-        if (buffer.GetRemainingSpace() < SizeOfHeader + packetSize)
+        std::vector<EncryptablePacket*> packets;
+        bool compress = false;
+        EncryptablePacket* queued;
+        while (_bufferQueue.Dequeue(queued))
         {
-            QueuePacket(std::move(buffer));
-            buffer.Resize(_sendBufferSize);
+            compress = compress || NeedsCompression(*queued);
+            packets.push_back(queued);
         }
 
-        if (buffer.GetRemainingSpace() >=  SizeOfHeader + packetSize)
+        if (compress && sPacketCompressionMgr->IsEnabled())
         {
-            WritePacketToBuffer(*queued, buffer);
+            _compressionJobActive.store(true, std::memory_order_relaxed);
+            sPacketCompressionMgr->Post([self = shared_from_this(), packets = std::move(packets)]()
+            {
+                self->SerializePackets(packets, self->_compressedBuffers);
+                self->_compressionJobActive.store(false, std::memory_order_release);
+            });
         }
-        else    // single packet larger than 4096 bytes
+        else if (!packets.empty())
         {
-            MessageBuffer packetBuffer(SizeOfHeader + packetSize);
-            WritePacketToBuffer(*queued, packetBuffer);
-            QueuePacket(std::move(packetBuffer));
+            std::vector<SerializedBuffer> buffers;
+            SerializePackets(packets, buffers);
+            QueueSerializedBuffers(buffers);
         }
-
-        delete queued;
     }
 
-    if (buffer.GetActiveSize() > 0)
-        QueuePacket(std::move(buffer));
-
     if (!BaseSocket::Update())
         return false;
 
@@ -243,6 +251,90 @@ bool WorldSocket::Update()
     return true;
 }
 
+bool WorldSocket::NeedsCompression(EncryptablePacket const& packet)
+{
+    return packet.GetPacket().size() > MinSizeForCompression && packet.NeedsEncryption();
+}
+
+void WorldSocket::SerializePackets(std::vector<EncryptablePacket*> const& packets, std::vector<SerializedBuffer>& buffers)
+{
+    struct PacketLayout
+    {
+        uint32 PacketSize;
+        uint32 BufferedSize;
+        bool SharePayload;
+    };
+
+    std::vector<PacketLayout> layouts;
+    layouts.reserve(packets.size());
+    for (EncryptablePacket const* queued : packets)
+    {
+        uint32 packetSize = queued->GetPacket().size();
+        bool compress = NeedsCompression(*queued);
+        if (compress)
+            packetSize = compressBound(packetSize) + sizeof(CompressedWorldPacket);
+
+        // Bigger uncompressed payloads are written straight from packet storage, only the header is buffered
+        bool sharePayload = !compress && packetSize >= MinSizeForSharedPayload;
+        layouts.push_back({ packetSize, SizeOfHeader + (sharePayload ? 0 : packetSize), sharePayload });
+    }
+
+    MessageBuffer buffer(0);    // allocated once there is something to send
+    for (std::size_t i = 0; i < packets.size(); ++i)
+    {
+        EncryptablePacket* queued = packets[i];
+        WorldPacket const& packet = queued->GetPacket();
+        PacketLayout const& layout = layouts[i];
+
+        if (buffer.GetRemainingSpace() < layout.BufferedSize)
+        {
+            if (buffer.GetActiveSize() > 0)
+                buffers.emplace_back(std::move(buffer));
+
+            // a shared payload takes the buffer with it, so only allocate what is written up to the next one
+            std::size_t needed = 0;
+            for (std::size_t j = i; j < packets.size() && needed < _sendBufferSize; ++j)
+            {
+                needed += layouts[j].BufferedSize;
+                if (layouts[j].SharePayload)
+                    break;
+            }
+
+            buffer.Resize(std::max<std::size_t>(std::min(needed, _sendBufferSize), layout.BufferedSize));
+        }
+
+        if (layout.SharePayload)
+        {
+            uint8* headerPos = buffer.GetWritePointer();
+            buffer.WriteCompleted(SizeOfHeader);
+            WritePacketHeader(headerPos, layout.PacketSize, packet.GetOpcode(), queued->NeedsEncryption());
+
+            buffers.emplace_back(std::move(buffer), queued->GetSharedPacket());
+        }
+        else
+            WritePacketToBuffer(*queued, buffer);
+
+        delete queued;
+    }
+
+    if (buffer.GetActiveSize() > 0)
+        buffers.emplace_back(std::move(buffer));
+}
+
+void WorldSocket::QueueSerializedBuffers(std::vector<SerializedBuffer>& buffers)
+{
+    for (SerializedBuffer& serialized : buffers)
+    {
+        if (serialized.Payload)
+        {
+            WorldPacket const& packet = *serialized.Payload;
+            QueuePacket(std::move(serialized.Buffer), serialized.Payload, packet.contents(), packet.size());
+        }
+        else
+            QueuePacket(std::move(serialized.Buffer));
+    }
+}
+
 void WorldSocket::HandleSendAuthSession()
 {
     WorldPacket packet(SMSG_AUTH_CHALLENGE, 37);
@@ -376,8 +468,9 @@ bool WorldSocket::ReadHeaderHandler()
 
 void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer)
 {
-    uint32 opcode = packet.GetOpcode();
-    uint32 packetSize = packet.size();
+    WorldPacket const& data = packet.GetPacket();
+    uint32 opcode = data.GetOpcode();
+    uint32 packetSize = data.size();
 
     // Reserve space for buffer
     uint8* headerPos = buffer.GetWritePointer();
@@ -387,13 +480,13 @@ void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBu
     {
         CompressedWorldPacket cmp;
         cmp.UncompressedSize = packetSize + 4;
-        cmp.UncompressedAdler = adler32(adler32(0x9827D8F1, reinterpret_cast<Bytef*>(&opcode), 4), packet.contents(), packetSize);
+        cmp.UncompressedAdler = adler32(adler32(0x9827D8F1, reinterpret_cast<Bytef*>(&opcode), 4), data.contents(), packetSize);
 
         // Reserve space for compression info - uncompressed size and checksums
         uint8* compressionInfo = buffer.GetWritePointer();
         buffer.WriteCompleted(sizeof(CompressedWorldPacket));
 
-        uint32 compressedSize = CompressPacket(buffer.GetWritePointer(), packet);
+        uint32 compressedSize = CompressPacket(buffer.GetWritePointer(), data);
 
         cmp.CompressedAdler = adler32(0x9827D8F1, buffer.GetWritePointer(), compressedSize);
 
@@ -403,13 +496,18 @@ void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBu
 
         opcode = SMSG_COMPRESSED_PACKET;
     }
-    else if (!packet.empty())
-        buffer.Write(packet.contents(), packet.size());
+    else if (!data.empty())
+        buffer.Write(data.contents(), data.size());
+
+    WritePacketHeader(headerPos, packetSize, opcode, packet.NeedsEncryption());
+}
 
+void WorldSocket::WritePacketHeader(uint8* headerPos, uint32 packetSize, uint32 opcode, bool encrypt)
+{
     // packetSize += 2 /*opcode*/;
 
-    ServerPktHeader header(!packet.NeedsEncryption() ? packetSize + 2 : packetSize, opcode, packet.NeedsEncryption());
-    if (packet.NeedsEncryption())
+    ServerPktHeader header(!encrypt ? packetSize + 2 : packetSize, opcode, encrypt);
+    if (encrypt)
         _authCrypt.EncryptSend(reinterpret_cast<uint8*>(&header.header), 4);
 
     memcpy(headerPos, &header.header, SizeOfHeader);
@@ -422,6 +520,19 @@ uint32 WorldSocket::CompressPacket(uint8* buffer, WorldPacket const& packet)
 
     _compressionStream->next_out = buffer;
     _compressionStream->avail_out = bufferSize;
+
+    int32 level = sPacketCompressionMgr->SelectCompressionLevel(packet.size());
+    if (level != _compressionLevel)
+    {
+        // nothing is pending after the previous Z_SYNC_FLUSH, output is set anyway in case zlib flushes a block
+        int32 z_res = deflateParams(_compressionStream, level, Z_DEFAULT_STRATEGY);
+        if (z_res == Z_OK)
+            _compressionLevel = level;
+        else
+            TC_LOG_ERROR("network", "Can't change packet compression level (zlib: deflateParams) Error code: %i (%s)", z_res, zError(z_res));
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
     _compressionStream->next_in = (Bytef*)&opcode;
     _compressionStream->avail_in = sizeof(uint32);
 
@@ -442,7 +553,11 @@ uint32 WorldSocket::CompressPacket(uint8* buffer, WorldPacket const& packet)
         return 0;
     }
 
-    return bufferSize - _compressionStream->avail_out;
+    uint32 compressedSize = bufferSize - _compressionStream->avail_out;
+    sPacketCompressionMgr->RecordCompression(packet.size() + sizeof(opcode), compressedSize,
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+
+    return compressedSize;
 }
 
 
@@ -516,8 +631,12 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     ClientPktHeader* header = reinterpret_cast<ClientPktHeader*>(_headerBuffer.GetReadPointer());
     OpcodeClient opcode = static_cast<OpcodeClient>(header->cmd);
 
-    WorldPacket packet(opcode, std::move(_packetBuffer));
-    WorldPacket* packetToQueue;
+    // the payload is copied into a recycled packet, _packetBuffer keeps its storage for the next one
+    WorldPacketPool::Ptr pooledPacket(WorldPacketPool::GetThreadPool()->Acquire(opcode, _packetBuffer.GetReadPointer(), _packetBuffer.GetActiveSize()));
+    _packetBuffer.Reset();
+    _packetBuffer.Resize(0);
+
+    WorldPacket& packet = *pooledPacket;
 
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort());
@@ -604,11 +723,9 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
 
         case CMSG_TIME_SYNC_RESP:
             packet.SetReceiveTime(std::chrono::steady_clock::now());
-            packetToQueue = new WorldPacket(std::move(packet));
             break;
 
         default:
-            packetToQueue = new WorldPacket(std::move(packet));
             break;
     }
 
@@ -619,7 +736,6 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     if (!_worldSession)
     {
         TC_LOG_ERROR("network.opcode", "ProcessIncoming: Client not authed opcode = %u", uint32(opcode));
-        delete packetToQueue;
         return ReadDataHandlerResult::Error;
     }
 
@@ -628,7 +744,6 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     if (!handler || handler->Status == STATUS_UNHANDLED)
     {
         TC_LOG_ERROR("network.opcode", "No defined handler for opcode %s sent by %s", GetOpcodeNameForLogging(static_cast<OpcodeClient>(packet.GetOpcode())).c_str(), _worldSession->GetPlayerInfo().c_str());
-        delete packetToQueue;
         //return ReadDataHandlerResult::Error;
         return ReadDataHandlerResult::Ok;
     }
@@ -636,8 +751,7 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     // Our Idle timer will reset on any non PING opcodes on login screen, allowing us to catch people idling.
     _worldSession->ResetTimeOutTime(false);
 
-    // Copy the packet to the heap before enqueuing
-    _worldSession->QueuePacket(packetToQueue);
+    _worldSession->QueuePacket(pooledPacket.release());
    
     return ReadDataHandlerResult::Ok;
 
@@ -670,7 +784,18 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
 
-    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
+    _bufferQueue.Enqueue(new EncryptablePacket(std::make_shared<WorldPacket>(packet), _authCrypt.IsInitialized()));
+}
+
+void WorldSocket::SendPacket(std::shared_ptr<WorldPacket const> packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(*packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
+    _bufferQueue.Enqueue(new EncryptablePacket(std::move(packet), _authCrypt.IsInitialized()));
 }
 
 void WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
@@ -34,19 +34,22 @@ class EncryptablePacket;
 class WorldPacket;
 class WorldSession;
 
-class EncryptablePacket : public WorldPacket
+class EncryptablePacket
 {
 public:
-    EncryptablePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt)
+    EncryptablePacket(std::shared_ptr<WorldPacket const> packet, bool encrypt) : _packet(std::move(packet)), _encrypt(encrypt)
     {
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    WorldPacket const& GetPacket() const { return *_packet; }
+    std::shared_ptr<WorldPacket const> const& GetSharedPacket() const { return _packet; }
     bool NeedsEncryption() const { return _encrypt; }
 
     std::atomic<EncryptablePacket*> SocketQueueLink;
 
 private:
+    std::shared_ptr<WorldPacket const> _packet;
     bool _encrypt;
 };
 
@@ -88,6 +91,7 @@ class TC_GAME_API WorldSocket : public Socket<WorldSocket>
     static std::string const ServerConnectionInitialize;
     static std::string const ClientConnectionInitialize;
     static uint32 const MinSizeForCompression;
+    static uint32 const MinSizeForSharedPayload;
 
 public:
     WorldSocket(tcp::socket&& socket);
@@ -100,6 +104,7 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(std::shared_ptr<WorldPacket const> packet);
 
     void SetWorldSession(WorldSession* session);
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
@@ -128,8 +133,23 @@ private:
     /// sends and logs network.opcode without accessing WorldSession
     void SendPacketAndLogOpcode(WorldPacket const& packet);
     void WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer);
+    void WritePacketHeader(uint8* headerPos, uint32 packetSize, uint32 opcode, bool encrypt);
     uint32 CompressPacket(uint8* buffer, WorldPacket const& packet);
 
+    struct SerializedBuffer
+    {
+        SerializedBuffer(MessageBuffer&& buffer, std::shared_ptr<WorldPacket const> payload = nullptr) : Buffer(std::move(buffer)), Payload(std::move(payload)) { }
+
+        MessageBuffer Buffer;
+        std::shared_ptr<WorldPacket const> Payload;         // sent after Buffer without copying, if set
+    };
+
+    static bool NeedsCompression(EncryptablePacket const& packet);
+    /// writes headers and payloads (compressing if needed) of queued packets and deletes them
+    /// runs on a compression thread when PacketCompressionMgr is enabled, never concurrently for one socket
+    void SerializePackets(std::vector<EncryptablePacket*> const& packets, std::vector<SerializedBuffer>& buffers);
+    void QueueSerializedBuffers(std::vector<SerializedBuffer>& buffers);
+
 
 
     void HandleSendAuthSession();
@@ -158,6 +178,10 @@ private:
     std::size_t _sendBufferSize;
 
     z_stream* _compressionStream;
+    int32 _compressionLevel;
+
+    std::atomic<bool> _compressionJobActive;
+    std::vector<SerializedBuffer> _compressedBuffers;   // output of the last compression job, written by the job
 
     QueryCallbackProcessor _queryProcessor;
     std::string _ipCountry;
@@ -17,9 +17,11 @@
 
 #include "Config.h"
 #include "NetworkThread.h"
+#include "PacketCompressionMgr.h"
 #include "ScriptMgr.h"
 #include "WorldSocket.h"
 #include "WorldSocketMgr.h"
+#include "World.h"
 
 #include <boost/system/error_code.hpp>
 
@@ -74,6 +76,8 @@ bool WorldSocketMgr::StartWorldNetwork(Trinity::Asio::IoContext& ioContext, std:
     if (!BaseSocketMgr::StartNetwork(ioContext, bindIp, port, threadCount))
         return false;
 
+    sPacketCompressionMgr->Start(sWorld->getIntConfig(CONFIG_COMPRESSION_THREADS));
+
     _acceptor->AsyncAcceptWithCallback<&OnSocketAccept>();
 
     sScriptMgr->OnNetworkStart();
@@ -84,6 +88,8 @@ void WorldSocketMgr::StopNetwork()
 {
     BaseSocketMgr::StopNetwork();
 
+    sPacketCompressionMgr->Stop();
+
     sScriptMgr->OnNetworkStop();
 }
 
@@ -16,6 +16,7 @@
 */
 
 #include "WordFilterMgr.h"
+#include <queue>
 
 bool NormalizeWord(std::string& utf8String)
 {
@@ -71,8 +72,10 @@ bool FindWordInSequence(const std::string& str, const std::string& word, const s
 }
 */
 
-WordFilterMgr::WordFilterMgr() 
+WordFilterMgr::WordFilterMgr() : m_loading(false)
 {
+    for (uint32 i = 0; i < 256; ++i)
+        m_analogLetters[i] = uint8(i);
 }
 
 WordFilterMgr::~WordFilterMgr()
@@ -90,10 +93,13 @@ void WordFilterMgr::LoadLetterAnalogs()
     uint32 oldMSTime = getMSTime();
 
     m_letterAnalogs.clear();
+    for (uint32 i = 0; i < 256; ++i)
+        m_analogLetters[i] = uint8(i);
 
     QueryResult result = WorldDatabase.Query("SELECT letter, analogs FROM letter_analogs");
     if (!result)
     {
+        RebuildMatchers();
         TC_LOG_INFO("misc", ">> Loaded 0 letter analogs. DB table `letter_analogs` is empty!");
         return;
     }
@@ -112,6 +118,30 @@ void WordFilterMgr::LoadLetterAnalogs()
     }
     while (result->NextRow());
 
+    // fold the analogs into a byte table, the first letter listing an analog wins
+    for (LetterAnalogMap::const_reverse_iterator mit = m_letterAnalogs.rbegin(); mit != m_letterAnalogs.rend(); ++mit)
+        for (char analog : mit->second)
+            m_analogLetters[uint8(analog)] = uint8(mit->first);
+
+    // converted bad words depend on the analogs
+    BadWordMap badWords, badWordsMail;
+    std::swap(badWords, m_badWords);
+    std::swap(badWordsMail, m_badWordsMail);
+    for (BadWordMap::const_iterator it = badWords.begin(); it != badWords.end(); ++it)
+    {
+        std::string convertedBadWord = it->second;
+        ConvertLettersToAnalogs(convertedBadWord);
+        m_badWords.emplace(convertedBadWord, it->second);
+    }
+    for (BadWordMapMail::const_iterator it = badWordsMail.begin(); it != badWordsMail.end(); ++it)
+    {
+        std::string convertedBadWord = it->second;
+        ConvertLettersToAnalogs(convertedBadWord);
+        m_badWordsMail.emplace(convertedBadWord, it->second);
+    }
+
+    RebuildMatchers();
+
     TC_LOG_INFO("misc", ">> Loaded %u letter analogs in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -122,79 +152,177 @@ void WordFilterMgr::LoadBadWords()
 
     m_badWords.clear();
     m_badWordsMail.clear();
-
-    QueryResult result = WorldDatabase.Query("SELECT bad_word FROM bad_word");
-    if (!result)
-    {
-        TC_LOG_INFO("misc", ">> Loaded 0 bad words. DB table `bad_word` is empty!");
-        return;
-    }
+    m_loading = true;
 
     uint32 count = 0;
-    do
+    if (QueryResult result = WorldDatabase.Query("SELECT bad_word FROM bad_word"))
     {
-        Field* fields = result->Fetch();
-        std::string analog = fields[0].GetString();
+        do
+        {
+            Field* fields = result->Fetch();
+            std::string analog = fields[0].GetString();
 
-        AddBadWord(analog);
+            AddBadWord(analog);
 
-        ++count;
+            ++count;
+        }
+        while (result->NextRow());
     }
-    while (result->NextRow());
+    else
+        TC_LOG_INFO("misc", ">> Loaded 0 bad words. DB table `bad_word` is empty!");
 
-    result = WorldDatabase.Query("SELECT bad_word FROM bad_word_mail");
-    if (!result)
+    if (QueryResult result = WorldDatabase.Query("SELECT bad_word FROM bad_word_mail"))
     {
+        do
+        {
+            Field* fields = result->Fetch();
+            std::string analog = fields[0].GetString();
+
+            AddBadWordMail(analog);
+
+            ++count;
+        }
+        while (result->NextRow());
+    }
+    else
         TC_LOG_INFO("misc", ">> Loaded 0 bad words. DB table `bad_word_mail` is empty!");
+
+    m_loading = false;
+    RebuildMatchers();
+
+    TC_LOG_INFO("misc", ">> Loaded %u bad words in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
+}
+
+inline void WordFilterMgr::ConvertLettersToAnalogs(std::string& text)
+{
+    for (std::string::iterator sit = text.begin(); sit != text.end(); ++sit)
+        *sit = char(m_analogLetters[uint8(*sit)]);
+}
+
+uint32 WordFilterMgr::BadWordMatcher::GetNext(uint32 node, uint8 letter) const
+{
+    std::vector<std::pair<uint8, uint32>> const& next = Nodes[node].Next;
+    auto itr = std::lower_bound(next.begin(), next.end(), letter, [](std::pair<uint8, uint32> const& edge, uint8 l) { return edge.first < l; });
+    return itr != next.end() && itr->first == letter ? itr->second : 0;
+}
+
+void WordFilterMgr::BadWordMatcher::AddWord(std::string const& converted, std::string const& original)
+{
+    if (converted.empty())
         return;
+
+    Words.push_back(original);
+
+    uint32 node = 0;
+    for (char c : converted)
+    {
+        uint8 letter = uint8(c);
+        std::vector<std::pair<uint8, uint32>>& next = Nodes[node].Next;
+        auto itr = std::lower_bound(next.begin(), next.end(), letter, [](std::pair<uint8, uint32> const& edge, uint8 l) { return edge.first < l; });
+        if (itr != next.end() && itr->first == letter)
+        {
+            node = itr->second;
+            continue;
+        }
+
+        uint32 child = Nodes.size();
+        next.insert(itr, std::make_pair(letter, child));
+        Nodes.emplace_back();
+        node = child;
     }
 
-    do
+    // keep the word added first, it has the higher priority
+    if (!Nodes[node].Word)
+        Nodes[node].Word = Words.size();
+}
+
+void WordFilterMgr::BadWordMatcher::Build()
+{
+    // breadth first, so fail nodes (always shallower) are complete before their users
+    std::queue<uint32> queue;
+    for (auto const& edge : Nodes[0].Next)
+        queue.push(edge.second);
+
+    while (!queue.empty())
     {
-        Field* fields = result->Fetch();
-        std::string analog = fields[0].GetString();
+        uint32 node = queue.front();
+        queue.pop();
 
-        AddBadWordMail(analog);
+        for (auto const& edge : Nodes[node].Next)
+        {
+            uint32 fail = Nodes[node].Fail;
+            uint32 target = 0;
+            while (!(target = GetNext(fail, edge.first)) && fail)
+                fail = Nodes[fail].Fail;
+
+            Node& child = Nodes[edge.second];
+            child.Fail = target;
+            if (uint32 word = Nodes[target].Word)
+                if (!child.Word || word < child.Word)
+                    child.Word = word;
+
+            queue.push(edge.second);
+        }
+    }
+}
 
-        ++count;
+std::string const* WordFilterMgr::BadWordMatcher::Find(std::string const& text) const
+{
+    uint32 node = 0;
+    uint32 found = 0;
+    for (char c : text)
+    {
+        uint8 letter = Letters[uint8(c)];
+        uint32 next = 0;
+        while (!(next = GetNext(node, letter)) && node)
+            node = Nodes[node].Fail;
+        node = next;
+
+        if (uint32 word = Nodes[node].Word)
+        {
+            if (!found || word < found)
+                found = word;
+            // nothing can beat the first word
+            if (found == 1)
+                break;
+        }
     }
-    while (result->NextRow());
 
-    TC_LOG_INFO("misc", ">> Loaded %u bad words in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
+    return found ? &Words[found - 1] : nullptr;
 }
 
-inline void WordFilterMgr::ConvertLettersToAnalogs(std::string& text)
+void WordFilterMgr::RebuildMatchers()
 {
-    // todo: to change to STL algorithms (for optimize).
-    for (std::string::iterator sit = text.begin(); sit != text.end(); ++sit)
-        for (LetterAnalogMap::const_iterator mit = m_letterAnalogs.begin(); mit != m_letterAnalogs.end(); ++mit)
-            if (mit->second.find(*sit) != std::string::npos)
-            {
-                *sit = mit->first;
-                break;
-            }
+    std::shared_ptr<BadWordMatcher> matcher = std::make_shared<BadWordMatcher>();
+    std::copy(std::begin(m_analogLetters), std::end(m_analogLetters), std::begin(matcher->Letters));
+    matcher->Nodes.emplace_back();
+    for (BadWordMap::const_iterator it = m_badWords.begin(); it != m_badWords.end(); ++it)
+        matcher->AddWord(it->first, it->second);
+
+    // mail is checked against chat words first, so they keep the lower indexes
+    std::shared_ptr<BadWordMatcher> mailMatcher = std::make_shared<BadWordMatcher>(*matcher);
+    for (BadWordMapMail::const_iterator it = m_badWordsMail.begin(); it != m_badWordsMail.end(); ++it)
+        mailMatcher->AddWord(it->first, it->second);
+
+    matcher->Build();
+    mailMatcher->Build();
+
+    std::atomic_store(&m_matcher, std::shared_ptr<BadWordMatcher const>(std::move(matcher)));
+    std::atomic_store(&m_mailMatcher, std::shared_ptr<BadWordMatcher const>(std::move(mailMatcher)));
 }
 
 std::string WordFilterMgr::FindBadWord(const std::string& text, bool mail)
 {
-    std::string _text = text;
-    
-    if (_text.empty() || m_badWords.empty())
+    std::shared_ptr<BadWordMatcher const> matcher = std::atomic_load(mail ? &m_mailMatcher : &m_matcher);
+    if (text.empty() || !matcher || matcher->Words.empty())
         return "";
 
+    std::string _text = text;
     NormalizeWord(_text);
-    ConvertLettersToAnalogs(_text);
 
-    for (BadWordMap::const_iterator it = m_badWords.begin(); it != m_badWords.end(); ++it)
-        if (_text.find(it->first) != std::string::npos)
-            return it->second;
-
-    if(mail)
-    {
-        for (BadWordMapMail::const_iterator it = m_badWordsMail.begin(); it != m_badWordsMail.end(); ++it)
-            if (_text.find(it->first) != std::string::npos)
-                return it->second;
-    }
+    // one pass over the text, letter analogs are resolved by the matcher
+    if (std::string const* badWord = matcher->Find(_text))
+        return *badWord;
     /* 
     // At ~5 times slower.
     for (BadWordMap::const_iterator it = m_badWords.begin(); it != m_badWords.end(); ++it)
@@ -235,6 +363,9 @@ bool WordFilterMgr::AddBadWord(const std::string& badWord, bool toDB)
 
     m_badWords[convertedBadWord] = _badWord;
 
+    if (!m_loading)
+        RebuildMatchers();
+
     if (toDB)
         WorldDatabase.PQuery("REPLACE INTO bad_word VALUES ('%s')", _badWord.c_str()); 
 
@@ -256,6 +387,9 @@ bool WordFilterMgr::AddBadWordMail(const std::string& badWord, bool toDB)
 
     m_badWordsMail[convertedBadWord] = _badWord;
 
+    if (!m_loading)
+        RebuildMatchers();
+
     if (toDB)
         WorldDatabase.PQuery("REPLACE INTO bad_word_mail VALUES ('%s')", _badWord.c_str());
 
@@ -277,6 +411,7 @@ bool WordFilterMgr::RemoveBadWord(const std::string& badWord, bool fromDB)
         return false;
 
     m_badWords.erase(it);
+    RebuildMatchers();
 
     if (fromDB)
         WorldDatabase.PExecute("DELETE FROM bad_word WHERE `bad_word` = '%s'", _badWord.c_str()); 
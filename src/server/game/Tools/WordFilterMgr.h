@@ -18,8 +18,11 @@
 #ifndef TRINITYCORE_WORDFILTERMGR_H
 #define TRINITYCORE_WORDFILTERMGR_H
 
+#include "Define.h"
 #include <string>
 #include <map>
+#include <memory>
+#include <vector>
 
 class WordFilterMgr
 {
@@ -51,9 +54,37 @@ class WordFilterMgr
         BadWordMap GetBadWords() const { return m_badWords; }
 
     private:
+        // Aho-Corasick automaton over the converted bad words, text bytes are mapped to analog letters on the fly
+        struct BadWordMatcher
+        {
+            struct Node
+            {
+                std::vector<std::pair<uint8, uint32>> Next;     // [letter][node], sorted by letter
+                uint32 Fail = 0;
+                uint32 Word = 0;                                // 1-based index in Words of the first word ending here or at a fail node
+            };
+
+            uint8 Letters[256];                                 // [byte][letter], m_analogLetters at build time
+            std::vector<Node> Nodes;
+            std::vector<std::string> Words;                     // original words in match priority order
+
+            uint32 GetNext(uint32 node, uint8 letter) const;
+            void AddWord(std::string const& converted, std::string const& original);
+            void Build();
+            std::string const* Find(std::string const& text) const;
+        };
+
+        void RebuildMatchers();
+
         LetterAnalogMap m_letterAnalogs;
+        uint8 m_analogLetters[256];                             // [byte][letter], folded m_letterAnalogs
         BadWordMap m_badWords; 
         BadWordMapMail m_badWordsMail;
+
+        // Immutable once built, swapped atomically so chat can be filtered from map threads
+        std::shared_ptr<BadWordMatcher const> m_matcher;        // chat words
+        std::shared_ptr<BadWordMatcher const> m_mailMatcher;    // chat words, then mail words
+        bool m_loading;                                         // bulk load in progress, rebuild once at the end
 };
 
 #define sWordFilterMgr WordFilterMgr::instance()
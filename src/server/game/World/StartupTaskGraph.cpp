@@ -0,0 +1,132 @@
+/*
+* This file is part of the Legends of Azeroth MOP Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "StartupTaskGraph.h"
+#include "Errors.h"
+#include "Log.h"
+#include "ThreadPool.h"
+#include "Timer.h"
+#include <algorithm>
+
+void StartupTaskGraph::Add(std::string const& name, std::function<void()> load, std::vector<std::string> const& dependencies)
+{
+    ASSERT(_taskIndexes.find(name) == _taskIndexes.end(), "Startup loader %s added twice", name.c_str());
+
+    uint32 index = _tasks.size();
+    _tasks.emplace_back();
+    Task& task = _tasks.back();
+    task.Name = name;
+    task.Load = std::move(load);
+    task.Waiting = 0;
+    task.Start = 0;
+    task.Finish = 0;
+
+    for (std::string const& dependency : dependencies)
+    {
+        auto itr = _taskIndexes.find(dependency);
+        ASSERT(itr != _taskIndexes.end(), "Startup loader %s depends on %s, which is not added before it", name.c_str(), dependency.c_str());
+
+        task.Dependencies.push_back(itr->second);
+        _tasks[itr->second].Dependents.push_back(index);
+        ++task.Waiting;
+    }
+
+    _taskIndexes[name] = index;
+}
+
+void StartupTaskGraph::Run(uint32 threads)
+{
+    _begin = getMSTime();
+    _threads = threads;
+
+    if (!threads)
+    {
+        for (uint32 i = 0; i < _tasks.size(); ++i)
+            RunTask(i, nullptr);
+    }
+    else
+    {
+        Trinity::ThreadPool pool(threads);
+        for (uint32 i = 0; i < _tasks.size(); ++i)
+            if (!_tasks[i].Waiting)
+                pool.PostWork([this, i, &pool]() { RunTask(i, &pool); });
+
+        // loaders post their dependents when they finish, joining waits for those as well
+        pool.Join();
+    }
+
+    _time = GetMSTimeDiffToNow(_begin);
+}
+
+void StartupTaskGraph::RunTask(uint32 index, Trinity::ThreadPool* pool)
+{
+    Task& task = _tasks[index];
+    TC_LOG_INFO("server.loading", "Loading %s...", task.Name.c_str());
+
+    task.Start = GetMSTimeDiffToNow(_begin);
+    task.Load();
+    task.Finish = GetMSTimeDiffToNow(_begin);
+
+    if (!pool)
+        return;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    for (uint32 dependent : task.Dependents)
+        if (!--_tasks[dependent].Waiting)
+            pool->PostWork([this, dependent, pool]() { RunTask(dependent, pool); });
+}
+
+void StartupTaskGraph::LogReport() const
+{
+    if (_tasks.empty())
+        return;
+
+    uint32 loadTime = 0;
+    std::vector<Task const*> tasks;
+    for (Task const& task : _tasks)
+    {
+        loadTime += task.Finish - task.Start;
+        tasks.push_back(&task);
+    }
+
+    TC_LOG_INFO("server.loading", ">> %u startup loaders took %u ms on %u threads, %u ms of loading in total", uint32(_tasks.size()), _time, std::max(_threads, 1u), loadTime);
+
+    // the critical path ends at the loader finishing last and goes back through the dependency each loader waited for the longest
+    std::vector<Task const*> path;
+    Task const* task = *std::max_element(tasks.begin(), tasks.end(), [](Task const* left, Task const* right) { return left->Finish < right->Finish; });
+    while (task)
+    {
+        path.push_back(task);
+
+        Task const* waitedFor = nullptr;
+        for (uint32 dependency : task->Dependencies)
+            if (!waitedFor || _tasks[dependency].Finish > waitedFor->Finish)
+                waitedFor = &_tasks[dependency];
+
+        task = waitedFor;
+    }
+
+    TC_LOG_INFO("server.loading", ">> Critical path:");
+    for (auto itr = path.rbegin(); itr != path.rend(); ++itr)
+        TC_LOG_INFO("server.loading", "    %6u ms  %s", (*itr)->Finish - (*itr)->Start, (*itr)->Name.c_str());
+
+    std::stable_sort(tasks.begin(), tasks.end(), [](Task const* left, Task const* right) { return left->Finish - left->Start > right->Finish - right->Start; });
+
+    TC_LOG_INFO("server.loading", ">> Loaders by time:");
+    for (Task const* loader : tasks)
+        TC_LOG_INFO("server.loading", "    %6u ms  %s (%u ms - %u ms)", loader->Finish - loader->Start, loader->Name.c_str(), loader->Start, loader->Finish);
+}
@@ -0,0 +1,70 @@
+/*
+* This file is part of the Legends of Azeroth MOP Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __STARTUPTASKGRAPH_H
+#define __STARTUPTASKGRAPH_H
+
+#include "Define.h"
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Trinity
+{
+    class ThreadPool;
+}
+
+/// Startup loaders with the loaders they must run after, independent ones are run concurrently
+class TC_GAME_API StartupTaskGraph
+{
+public:
+    StartupTaskGraph() : _begin(0), _threads(0), _time(0) { }
+
+    /// Dependencies are names of loaders added before, so the adding order is always a valid loading order
+    void Add(std::string const& name, std::function<void()> load, std::vector<std::string> const& dependencies = {});
+
+    /// Runs loaders on up to threads workers, 0 runs them one after another in the order they were added
+    void Run(uint32 threads);
+
+    /// Logs the time of every loader and the chain of loaders the startup had to wait for
+    void LogReport() const;
+
+private:
+    struct Task
+    {
+        std::string Name;
+        std::function<void()> Load;
+        std::vector<uint32> Dependencies;
+        std::vector<uint32> Dependents;
+        uint32 Waiting;                                     // dependencies not finished yet
+        uint32 Start;                                       // ms since Run
+        uint32 Finish;
+    };
+
+    void RunTask(uint32 index, Trinity::ThreadPool* pool);
+
+    std::vector<Task> _tasks;
+    std::unordered_map<std::string, uint32> _taskIndexes;
+    std::mutex _lock;                                       // guards Task::Waiting
+    uint32 _begin;
+    uint32 _threads;
+    uint32 _time;
+};
+
+#endif
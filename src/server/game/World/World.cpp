@@ -20,6 +20,7 @@
 */
 #include "Common.h"
 #include "Memory.h"
+#include "Metrics.h"
 #include "DatabaseEnv.h"
 #include "QueryResult.h"
 #include "Transaction.h"
@@ -96,6 +97,8 @@
 #include "ServiceBoost.h"
 #include "ServiceMgr.h"
 #include "WordFilterMgr.h"
+#include "StartupTaskGraph.h"
+#include "CryptoHash.h"
 #include "Realm.h"
 #include "VMapFactory.h"
 #include "VMapManager2.h"
@@ -449,6 +452,8 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sLog->LoadFromConfig();
 
+    sMetrics->LoadFromConfig();
+
     m_defaultDbcLocale = LocaleConstant(sConfigMgr->GetIntDefault("DBC.Locale", 0));
 
     if (m_defaultDbcLocale >= TOTAL_LOCALES)
@@ -492,6 +497,8 @@ void World::LoadConfigSettings(bool reload)
         TC_LOG_ERROR("server.loading", "Compression level (%i) must be in range 1..9. Using default compression level (1).", m_int_configs[CONFIG_COMPRESSION]);
         m_int_configs[CONFIG_COMPRESSION] = 1;
     }
+    m_int_configs[CONFIG_COMPRESSION_THREADS] = sConfigMgr->GetIntDefault("Compression.Threads", 0);
+    m_int_configs[CONFIG_COMPRESSION_LARGE_PACKET_SIZE] = sConfigMgr->GetIntDefault("Compression.LargePacketSize", 0);
     m_bool_configs[CONFIG_ADDON_CHANNEL] = sConfigMgr->GetBoolDefault("AddonChannel", true);
     m_bool_configs[CONFIG_CLEAN_CHARACTER_DB] = sConfigMgr->GetBoolDefault("CleanCharacterDB", false);
     m_int_configs[CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS] = sConfigMgr->GetIntDefault("PersistentCharacterCleanFlags", 0);
@@ -505,9 +512,15 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_PRESERVE_CUSTOM_CHANNELS] = sConfigMgr->GetBoolDefault("PreserveCustomChannels", false);
     m_int_configs[CONFIG_PRESERVE_CUSTOM_CHANNEL_DURATION] = sConfigMgr->GetIntDefault("PreserveCustomChannelDuration", 14);
     m_bool_configs[CONFIG_GRID_UNLOAD] = sConfigMgr->GetBoolDefault("GridUnload", true);
+    m_bool_configs[CONFIG_GRID_MAP_MEMORY_MAPPED] = sConfigMgr->GetBoolDefault("GridMap.MemoryMapped", false);
+    m_int_configs[CONFIG_GRID_PRELOAD_THREADS] = sConfigMgr->GetIntDefault("GridPreload.Threads", 0);
+    m_int_configs[CONFIG_GRID_PRELOAD_LOOKAHEAD] = sConfigMgr->GetIntDefault("GridPreload.LookAhead", 20);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = sConfigMgr->GetIntDefault("Startup.LoaderThreads", 0);
     m_int_configs[CONFIG_INTERVAL_SAVE] = sConfigMgr->GetIntDefault("PlayerSaveInterval", 15 * MINUTE * IN_MILLISECONDS);
     m_int_configs[CONFIG_INTERVAL_DISCONNECT_TOLERANCE] = sConfigMgr->GetIntDefault("DisconnectToleranceInterval", 0);
     m_bool_configs[CONFIG_STATS_SAVE_ONLY_ON_LOGOUT] = sConfigMgr->GetBoolDefault("PlayerSave.Stats.SaveOnlyOnLogout", true);
+    m_bool_configs[CONFIG_PLAYER_SAVE_SKIP_UNCHANGED] = sConfigMgr->GetBoolDefault("PlayerSave.SkipUnchanged", true);
+    m_bool_configs[CONFIG_MOVEMENT_VALIDATE_CODECS] = sConfigMgr->GetBoolDefault("Movement.ValidateCodecs", false);
 
     m_int_configs[CONFIG_MIN_LEVEL_STAT_SAVE] = sConfigMgr->GetIntDefault("PlayerSave.Stats.MinLevel", 0);
     if (m_int_configs[CONFIG_MIN_LEVEL_STAT_SAVE] > MAX_LEVEL)
@@ -1248,6 +1261,8 @@ void World::LoadConfigSettings(bool reload)
     }
 
     m_bool_configs[CONFIG_ENABLE_MMAPS] = sConfigMgr->GetBoolDefault("mmap.enablePathFinding", false);
+    m_int_configs[CONFIG_PATHFINDING_ASYNC_THREADS] = sConfigMgr->GetIntDefault("mmap.AsyncPathFinding.Threads", 0);
+    m_bool_configs[CONFIG_PATHFINDING_ASYNC_SHARED_SEARCH] = sConfigMgr->GetBoolDefault("mmap.AsyncPathFinding.SharedSearch", true);
 
     TC_LOG_INFO("server.loading", "WORLD: MMap data directory is: %smmaps", m_dataPath.c_str());
 
@@ -1285,6 +1300,14 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfigMgr->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = sConfigMgr->GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_bool_configs[CONFIG_MAP_UPDATE_REGIONS] = sConfigMgr->GetBoolDefault("MapUpdate.Regions.Enable", false);
+    m_int_configs[CONFIG_MAP_UPDATE_REGIONS_MIN_PLAYERS] = sConfigMgr->GetIntDefault("MapUpdate.Regions.MinPlayers", 100);
+    m_int_configs[CONFIG_MAP_UPDATE_REGIONS_GRID_DISTANCE] = sConfigMgr->GetIntDefault("MapUpdate.Regions.GridDistance", 4);
+    if (m_int_configs[CONFIG_MAP_UPDATE_REGIONS_GRID_DISTANCE] < 3)
+    {
+        TC_LOG_ERROR("server.loading", "MapUpdate.Regions.GridDistance (%u) must be >= 3. Using 3 instead.", m_int_configs[CONFIG_MAP_UPDATE_REGIONS_GRID_DISTANCE]);
+        m_int_configs[CONFIG_MAP_UPDATE_REGIONS_GRID_DISTANCE] = 3;
+    }
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1483,6 +1506,8 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_AUCTIONHOUSE_FORCE_MAIN_THREAD]    = sConfigMgr->GetBoolDefault("AuctionHouse.ForceMainThread", false);
     m_int_configs[CONFIG_AUCTIONHOUSE_MIN_DIFF_FOR_LOG]      = sConfigMgr->GetIntDefault("AuctionHouse.MinDiffForLog", 25);
     m_int_configs[CONFIG_AUCTIONHOUSE_MIN_DIFF_FOR_THROTTLE] = sConfigMgr->GetIntDefault("AuctionHouse.MinDiffForThrottle", 25);
+    m_int_configs[CONFIG_AUCTIONHOUSE_SEARCH_THREADS]        = sConfigMgr->GetIntDefault("AuctionHouse.SearchThreads", 2);
+    m_int_configs[CONFIG_AUCTIONHOUSE_SEARCH_VIEW_MAX_AGE]   = sConfigMgr->GetIntDefault("AuctionHouse.SearchViewMaxAge", 1000);
 
     m_bool_configs[CONFIG_BATTLEGROUND_REWARDS_ENABLED] = sConfigMgr->GetBoolDefault("Battleground.Rewards.Enabled", true);
     m_int_configs[CONFIG_BATTLEGROUND_REWARD] = sConfigMgr->GetIntDefault("Battleground.Rewards.Item", 32546);
@@ -1506,6 +1531,7 @@ void World::LoadConfigSettings(bool reload)
 #ifdef ELUNA
 	//eluna
 	m_bool_configs[CONFIG_BOOL_ELUNA_ENABLED] = sConfigMgr->GetBoolDefault("Eluna.Enabled", true);
+	m_bool_configs[CONFIG_BOOL_ELUNA_PER_MAP_STATES] = sConfigMgr->GetBoolDefault("Eluna.PerMapStates", false);
 #endif    
     // Loading of Locales
     m_bool_configs[CONFIG_LOAD_LOCALES] = sConfigMgr->GetBoolDefault("Load.Locales", true);
@@ -1704,6 +1730,8 @@ void World::SetInitialWorldSettings()
     ///- Initialize Allowed Security Level
     LoadDBAllowedSecurityLevel();
 
+    OpenWorldDatabaseSnapshot();
+
     ///- Init highest guids before any table loading to prevent using not initialized guids in some code.
     sObjectMgr->SetHighestGuids();
 
@@ -1825,261 +1853,123 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Bad Words...");
     sWordFilterMgr->LoadBadWords();
 
-    TC_LOG_INFO("server.loading", "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
-
-    TC_LOG_INFO("server.loading", "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
-
-    TC_LOG_INFO("server.loading", "Loading Game Object template addons...");
-    sObjectMgr->LoadGameObjectTemplateAddons();
-
-    TC_LOG_INFO("server.loading", "Loading Transport templates...");
-    sTransportMgr->LoadTransportTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Rank Data...");
-    sSpellMgr->LoadSpellRanks();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
-
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Spells...");
-    sSpellMgr->LoadSpellLearnSpells();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Proc Event conditions...");
-    sSpellMgr->LoadSpellProcEvents();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonusess();
-
-    TC_LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Phase Dbc Info...");
-    sObjectMgr->LoadSpellPhaseInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Spell AreaTrigger templates...");
-    sObjectMgr->LoadSpellAreaTriggerTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
-
-    TC_LOG_INFO("server.loading", "Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
-
-    TC_LOG_INFO("server.loading", "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
-
-    TC_LOG_INFO("server.loading", "Loading Disables");                         // must be before loading quests and items
-    DisableMgr::LoadDisables();
-
-    TC_LOG_INFO("server.loading", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr->LoadItemTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading Item set names...");                // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemTemplateAddon();
-
-    TC_LOG_INFO("misc", "Loading Item Scripts...");                 // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemScriptNames();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Model Based Info Data...");
-    sObjectMgr->LoadCreatureModelInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Creature templates...");
-    sObjectMgr->LoadCreatureTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading Equipment templates...");           // must be after LoadCreatureTemplates
-    sObjectMgr->LoadEquipmentTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading creature difficulty moidifiers...");
-    sObjectMgr->LoadCreatureDifficultyModifiers();
-
-    TC_LOG_INFO("server.loading", "Loading Creature template addons...");
-    sObjectMgr->LoadCreatureTemplateAddons();
-
-    TC_LOG_INFO("server.loading", "Loading Pet scaling...");
-    sObjectMgr->LoadPetScaling();
-
-    TC_LOG_INFO("server.loading", "Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Reputation OnKill Data...");
-    sObjectMgr->LoadReputationOnKill();
-
-    TC_LOG_INFO("server.loading", "Loading Reputation Spillover Data...");
-    sObjectMgr->LoadReputationSpilloverTemplate();
-
-    TC_LOG_INFO("server.loading", "Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Data...");
-    sObjectMgr->LoadCreatures();
-
-    TC_LOG_INFO("server.loading", "Loading Temporary Summon Data...");
-    sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
-
-    TC_LOG_INFO("server.loading", "Loading pet levelup spells...");
-    sSpellMgr->LoadPetSpellMap();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Addon Data...");
-    sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
-
-    TC_LOG_INFO("server.loading", "Loading Gameobject Data...");
-    sObjectMgr->LoadGameobjects();
-
-    TC_LOG_INFO("server.loading", "Loading GameObject Addon Data...");
-    sObjectMgr->LoadGameObjectAddons();                          // must be after LoadGameObjectTemplate() and LoadGameobjects()
-
-    TC_LOG_INFO("server.loading", "Loading Creature Sparring Data...");
-    sObjectMgr->LoadCreatureSparringTemplate();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Linked Respawn...");
-    sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
-
-    TC_LOG_INFO("server.loading", "Loading Custom Object Visibility...");
-    sObjectMgr->LoadCustomVisibility();
-
-    TC_LOG_INFO("server.loading", "Loading Weather Data...");
-    WeatherMgr::LoadWeatherData();
-
-    TC_LOG_INFO("server.loading", "Loading Quests...");
-    sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
-
-    TC_LOG_INFO("server.loading", "Checking Quest Disables");
-    DisableMgr::CheckQuestDisables();                           // must be after loading quests
-
+    ///- Load world tables. Loaders declare the loaders they read data of, independent ones are loaded concurrently
+    StartupTaskGraph loaders;
+
+    loaders.Add("Page Texts", [] { sObjectMgr->LoadPageTexts(); });
+    loaders.Add("Game Object Templates", [] { sObjectMgr->LoadGameObjectTemplate(); }, { "Page Texts" });
+    loaders.Add("Game Object template addons", [] { sObjectMgr->LoadGameObjectTemplateAddons(); }, { "Game Object Templates" });
+    loaders.Add("Transport templates", [] { sTransportMgr->LoadTransportTemplates(); }, { "Game Object Templates" });
+
+    // spell loaders modify SpellInfo and read each others data, they are kept in one chain
+    loaders.Add("Spell Rank Data", [] { sSpellMgr->LoadSpellRanks(); });
+    loaders.Add("Spell Required Data", [] { sSpellMgr->LoadSpellRequired(); }, { "Spell Rank Data" });
+    loaders.Add("Spell Group types", [] { sSpellMgr->LoadSpellGroups(); }, { "Spell Required Data" });
+    loaders.Add("Spell Learn Skills", [] { sSpellMgr->LoadSpellLearnSkills(); }, { "Spell Group types" });
+    loaders.Add("Spell Learn Spells", [] { sSpellMgr->LoadSpellLearnSpells(); }, { "Spell Learn Skills" });
+    loaders.Add("Spell Proc Event conditions", [] { sSpellMgr->LoadSpellProcEvents(); }, { "Spell Learn Spells" });
+    loaders.Add("Spell Proc conditions and data", [] { sSpellMgr->LoadSpellProcs(); }, { "Spell Proc Event conditions" });
+    loaders.Add("Spell Bonus Data", [] { sSpellMgr->LoadSpellBonusess(); }, { "Spell Proc conditions and data" });
+    loaders.Add("Aggro Spells Definitions", [] { sSpellMgr->LoadSpellThreats(); }, { "Spell Bonus Data" });
+    loaders.Add("Spell Group Stack Rules", [] { sSpellMgr->LoadSpellGroupStackRules(); }, { "Aggro Spells Definitions" });
+    loaders.Add("Enchant Spells Proc datas", [] { sSpellMgr->LoadSpellEnchantProcData(); }, { "Spell Group Stack Rules" });
+    loaders.Add("pet levelup spells", [] { sSpellMgr->LoadPetSpellMap(); }, { "Enchant Spells Proc datas" });
+
+    loaders.Add("Spell Phase Dbc Info", [] { sObjectMgr->LoadSpellPhaseInfo(); });
+    loaders.Add("Spell AreaTrigger templates", [] { sObjectMgr->LoadSpellAreaTriggerTemplates(); });
+    loaders.Add("NPC Texts", [] { sObjectMgr->LoadGossipText(); });
+    loaders.Add("Item Random Enchantments Table", [] { LoadRandomEnchantmentsTable(); });
+    loaders.Add("Disables", [] { DisableMgr::LoadDisables(); });
+
+    // item loading marks spells of items as persistent, which the spell chain must not race with
+    loaders.Add("Items", [] { sObjectMgr->LoadItemTemplates(); }, { "Item Random Enchantments Table", "Page Texts", "Disables", "pet levelup spells" });
+    loaders.Add("Item set names", [] { sObjectMgr->LoadItemTemplateAddon(); }, { "Items" });
+    loaders.Add("Item Scripts", [] { sObjectMgr->LoadItemScriptNames(); }, { "Item set names" });
+
+    loaders.Add("Creature Model Based Info Data", [] { sObjectMgr->LoadCreatureModelInfo(); });
+    loaders.Add("Creature templates", [] { sObjectMgr->LoadCreatureTemplates(); }, { "Creature Model Based Info Data" });
+    loaders.Add("Equipment templates", [] { sObjectMgr->LoadEquipmentTemplates(); }, { "Creature templates" });
+    loaders.Add("creature difficulty moidifiers", [] { sObjectMgr->LoadCreatureDifficultyModifiers(); }, { "Creature templates" });
+    loaders.Add("Creature template addons", [] { sObjectMgr->LoadCreatureTemplateAddons(); }, { "Creature templates" });
+    loaders.Add("Pet scaling", [] { sObjectMgr->LoadPetScaling(); }, { "Creature templates" });
+    loaders.Add("Reputation Reward Rates", [] { sObjectMgr->LoadReputationRewardRate(); });
+    loaders.Add("Creature Reputation OnKill Data", [] { sObjectMgr->LoadReputationOnKill(); }, { "Creature templates" });
+    loaders.Add("Reputation Spillover Data", [] { sObjectMgr->LoadReputationSpilloverTemplate(); });
+    loaders.Add("Points Of Interest Data", [] { sObjectMgr->LoadPointsOfInterest(); });
+    loaders.Add("Creature Base Stats", [] { sObjectMgr->LoadCreatureClassLevelStats(); }, { "Creature templates" });
+    loaders.Add("Creature Data", [] { sObjectMgr->LoadCreatures(); },
+        { "Equipment templates", "creature difficulty moidifiers", "Creature template addons", "Creature Base Stats" });
+    loaders.Add("Temporary Summon Data", [] { sObjectMgr->LoadTempSummons(); }, { "Creature templates", "Game Object Templates" });
+    loaders.Add("Creature Addon Data", [] { sObjectMgr->LoadCreatureAddons(); }, { "Creature Data" });
+    // creatures and gameobjects share the per cell spawn lists
+    loaders.Add("Gameobject Data", [] { sObjectMgr->LoadGameobjects(); }, { "Game Object template addons", "Transport templates", "Creature Data" });
+    loaders.Add("GameObject Addon Data", [] { sObjectMgr->LoadGameObjectAddons(); }, { "Gameobject Data" });
+    loaders.Add("Creature Sparring Data", [] { sObjectMgr->LoadCreatureSparringTemplate(); }, { "Creature templates" });
+    loaders.Add("Creature Linked Respawn", [] { sObjectMgr->LoadLinkedRespawn(); }, { "Creature Addon Data", "GameObject Addon Data" });
+    loaders.Add("Custom Object Visibility", [] { sObjectMgr->LoadCustomVisibility(); });
+    loaders.Add("Weather Data", [] { WeatherMgr::LoadWeatherData(); });
+
+    loaders.Add("Quests", [] { sObjectMgr->LoadQuests(); }, { "Item Scripts", "Creature templates", "Game Object Templates", "Disables" });
+    loaders.Add("Quest Disables", [] { DisableMgr::CheckQuestDisables(); }, { "Quests" });
     if (m_bool_configs[CONFIG_LOAD_LOCALES])
-    {
-        TC_LOG_INFO("server.loading", "Loading Quest Objective Locales...");
-        sObjectMgr->LoadQuestObjectivesLocale();
-    }
-
-    TC_LOG_INFO("server.loading", "Loading Quest Objective Visual Effects...");
-    sObjectMgr->LoadQuestObjectiveVisualEffects();
-
-    TC_LOG_INFO("server.loading", "Loading Quest POI");
-    sObjectMgr->LoadQuestPOI();
-
-    TC_LOG_INFO("server.loading", "Loading Quests Starters and Enders...");
-    sObjectMgr->LoadQuestStartersAndEnders();                    // must be after quest load
-
-    TC_LOG_INFO("server.loading", "Loading Objects Pooling Data...");
-    sPoolMgr->LoadFromDB();
-
-    TC_LOG_INFO("server.loading", "Loading Quest Pooling Data...");
-    sQuestPoolMgr->LoadFromDB();
-
-    TC_LOG_INFO("server.loading", "Loading Game Event Data...");               // must be after loading pools fully
-    sGameEventMgr->LoadHolidayDates();                           // Must be after loading DBC
-    sGameEventMgr->LoadFromDB();                                 // Must be after loading holiday dates
-
-    TC_LOG_INFO("server.loading", "Loading UNIT_NPC_FLAG_SPELLCLICK Data..."); // must be after LoadQuests
-    sObjectMgr->LoadNPCSpellClickSpells();
-
-    TC_LOG_INFO("server.loading", "Loading Vehicle Template Accessories...");
-    sObjectMgr->LoadVehicleTemplateAccessories();                // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
-
-    TC_LOG_INFO("server.loading", "Loading Vehicle Accessories...");
-    sObjectMgr->LoadVehicleAccessories();                       // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
-
-    TC_LOG_INFO("server.loading", "Loading SpellArea Data...");                // must be after quest load
-    sSpellMgr->LoadSpellAreas();
-
-    TC_LOG_INFO("server.loading", "Loading AreaTrigger definitions...");
-    sObjectMgr->LoadAreaTriggerTeleports();
-
-    TC_LOG_INFO("server.loading", "Loading Access Requirements...");
-    sObjectMgr->LoadAccessRequirements();                        // must be after item template load
-
-    TC_LOG_INFO("server.loading", "Loading Quest Giver Area Triggers...");
-    sObjectMgr->LoadQuestGiverAreaTriggers();
-
-    TC_LOG_INFO("server.loading", "Loading Quest Area Triggers...");
-    sObjectMgr->LoadQuestAreaTriggers();                         // must be after LoadQuests
-
-    TC_LOG_INFO("server.loading", "Loading Tavern Area Triggers...");
-    sObjectMgr->LoadTavernAreaTriggers();
-
-    TC_LOG_INFO("server.loading", "Loading AreaTrigger script names...");
-    sObjectMgr->LoadAreaTriggerScripts();
-
-    TC_LOG_INFO("server.loading", "Loading LFG entrance positions..."); // Must be after areatriggers
-    sLFGMgr->LoadLFGDungeons();
-
-    TC_LOG_INFO("server.loading", "Loading Dungeon boss data...");
-    sObjectMgr->LoadInstanceEncounters();
-
-    TC_LOG_INFO("server.loading", "Loading LFG rewards...");
-    sLFGMgr->LoadRewards();
-
-    TC_LOG_INFO("server.loading", "Loading Graveyard-zone links...");
-    sObjectMgr->LoadGraveyardZones();
-
-    TC_LOG_INFO("server.loading", "Loading Graveyard Orientations...");
-    sObjectMgr->LoadGraveyardOrientations();
-
-    TC_LOG_INFO("server.loading", "Loading spell pet auras...");
-    sSpellMgr->LoadSpellPetAuras();
-
-    TC_LOG_INFO("server.loading", "Loading Spell target coordinates...");
-    sSpellMgr->LoadSpellTargetPositions();
-
-    TC_LOG_INFO("server.loading", "Loading enchant custom attributes...");
-    sSpellMgr->LoadEnchantCustomAttr();
-
-    TC_LOG_INFO("server.loading", "Loading linked spells...");
-    sSpellMgr->LoadSpellLinked();
-
-    TC_LOG_INFO("server.loading", "Loading Player Create Data...");
-    sObjectMgr->LoadPlayerInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Exploration BaseXP Data...");
-    sObjectMgr->LoadExplorationBaseXP();
-
-    TC_LOG_INFO("server.loading", "Loading Pet Name Parts...");
-    sObjectMgr->LoadPetNames();
+        loaders.Add("Quest Objective Locales", [] { sObjectMgr->LoadQuestObjectivesLocale(); }, { "Quests" });
+    loaders.Add("Quest Objective Visual Effects", [] { sObjectMgr->LoadQuestObjectiveVisualEffects(); }, { "Quests" });
+    loaders.Add("Quest POI", [] { sObjectMgr->LoadQuestPOI(); }, { "Quests" });
+    // both set quest flags, quest readers go after them
+    loaders.Add("Quest Giver Area Triggers", [] { sObjectMgr->LoadQuestGiverAreaTriggers(); }, { "Quest Disables" });
+    loaders.Add("Quest Area Triggers", [] { sObjectMgr->LoadQuestAreaTriggers(); }, { "Quest Giver Area Triggers" });
+    loaders.Add("Quests Starters and Enders", [] { sObjectMgr->LoadQuestStartersAndEnders(); }, { "Quest Area Triggers" });
+
+    loaders.Add("Objects Pooling Data", [] { sPoolMgr->LoadFromDB(); }, { "Creature Linked Respawn" });
+    loaders.Add("Quest Pooling Data", [] { sQuestPoolMgr->LoadFromDB(); }, { "Quest Area Triggers" });
+    loaders.Add("Game Event Data", []
+    {
+        sGameEventMgr->LoadHolidayDates();                       // Must be after loading DBC
+        sGameEventMgr->LoadFromDB();                             // Must be after loading holiday dates
+    }, { "Objects Pooling Data", "Quest Pooling Data", "Quests Starters and Enders" });
+
+    // sets npc flags of creature templates, everything reading them so far goes before it
+    loaders.Add("UNIT_NPC_FLAG_SPELLCLICK Data", [] { sObjectMgr->LoadNPCSpellClickSpells(); },
+        { "Pet scaling", "Creature Reputation OnKill Data", "Temporary Summon Data", "Creature Sparring Data", "Creature Linked Respawn", "Quests Starters and Enders" });
+    loaders.Add("Vehicle Template Accessories", [] { sObjectMgr->LoadVehicleTemplateAccessories(); }, { "UNIT_NPC_FLAG_SPELLCLICK Data" });
+    loaders.Add("Vehicle Accessories", [] { sObjectMgr->LoadVehicleAccessories(); }, { "UNIT_NPC_FLAG_SPELLCLICK Data" });
+
+    loaders.Add("SpellArea Data", [] { sSpellMgr->LoadSpellAreas(); }, { "pet levelup spells", "Quests Starters and Enders" });
+    loaders.Add("AreaTrigger definitions", [] { sObjectMgr->LoadAreaTriggerTeleports(); });
+    loaders.Add("Access Requirements", [] { sObjectMgr->LoadAccessRequirements(); }, { "Item Scripts", "Quest Area Triggers" });
+    loaders.Add("Tavern Area Triggers", [] { sObjectMgr->LoadTavernAreaTriggers(); });
+    loaders.Add("AreaTrigger script names", [] { sObjectMgr->LoadAreaTriggerScripts(); });
+    loaders.Add("LFG entrance positions", [] { sLFGMgr->LoadLFGDungeons(); }, { "AreaTrigger definitions" });
+    // marks boss creature templates
+    loaders.Add("Dungeon boss data", [] { sObjectMgr->LoadInstanceEncounters(); },
+        { "LFG entrance positions", "Vehicle Template Accessories", "Vehicle Accessories", "Game Event Data" });
+    loaders.Add("LFG rewards", [] { sLFGMgr->LoadRewards(); }, { "LFG entrance positions", "Quest Area Triggers" });
+    loaders.Add("Graveyard-zone links", [] { sObjectMgr->LoadGraveyardZones(); });
+    loaders.Add("Graveyard Orientations", [] { sObjectMgr->LoadGraveyardOrientations(); }, { "Graveyard-zone links" });
+
+    loaders.Add("spell pet auras", [] { sSpellMgr->LoadSpellPetAuras(); }, { "SpellArea Data" });
+    loaders.Add("Spell target coordinates", [] { sSpellMgr->LoadSpellTargetPositions(); }, { "spell pet auras" });
+    loaders.Add("enchant custom attributes", [] { sSpellMgr->LoadEnchantCustomAttr(); }, { "Spell target coordinates" });
+    loaders.Add("linked spells", [] { sSpellMgr->LoadSpellLinked(); }, { "enchant custom attributes" });
+
+    loaders.Add("Player Create Data", [] { sObjectMgr->LoadPlayerInfo(); }, { "Item Scripts" });
+    loaders.Add("Exploration BaseXP Data", [] { sObjectMgr->LoadExplorationBaseXP(); });
+    loaders.Add("Pet Name Parts", [] { sObjectMgr->LoadPetNames(); });
+    loaders.Add("the max pet number", [] { sObjectMgr->LoadPetNumber(); });
+    loaders.Add("pet level stats", [] { sObjectMgr->LoadPetLevelInfo(); }, { "Dungeon boss data" });
+    loaders.Add("Player level dependent mail rewards", [] { sObjectMgr->LoadMailLevelRewards(); }, { "Dungeon boss data" });
+    loaders.Add("Scenes Templates", [] { sObjectMgr->LoadSceneTemplates(); });
+
+    loaders.Add("Loot tables", [] { sLootMgr->LoadFromDB(); }, { "Item Scripts", "Dungeon boss data", "Game Object template addons", "Quest Area Triggers", "linked spells" });
+    loaders.Add("Skill Discovery Table", [] { LoadSkillDiscoveryTable(); }, { "linked spells" });
+    loaders.Add("Skill Extra Item Table", [] { LoadSkillExtraItemTable(); }, { "Item Scripts", "linked spells" });
+    loaders.Add("Skill Fishing base level requirements", [] { sObjectMgr->LoadFishingBaseSkillLevel(); });
+
+    loaders.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+    loaders.LogReport();
 
     CharacterDatabaseCleaner::CleanDatabase();
 
-    TC_LOG_INFO("server.loading", "Loading the max pet number...");
-    sObjectMgr->LoadPetNumber();
-
-    TC_LOG_INFO("server.loading", "Loading pet level stats...");
-    sObjectMgr->LoadPetLevelInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Player level dependent mail rewards...");
-    sObjectMgr->LoadMailLevelRewards();
-
-    TC_LOG_INFO("server.loading", "Loading Scenes Templates...");
-    sObjectMgr->LoadSceneTemplates();
-
-    // Loot tables
-    sLootMgr->LoadFromDB();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
     TC_LOG_INFO("server.loading", "Loading Achievements...");
     sAchievementMgr->LoadAchievementReferenceList();
     TC_LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
@@ -2102,6 +1992,7 @@ void World::SetInitialWorldSettings()
 
     TC_LOG_INFO("server.loading", "Loading Auctions...");
     sAuctionMgr->LoadAuctions();
+    sAuctionMgr->StartSearchWorkers(getIntConfig(CONFIG_AUCTIONHOUSE_SEARCH_THREADS));
 
     TC_LOG_INFO("server.loading", "Loading Guild XP for level...");
     sGuildMgr->LoadGuildXpForLevel();
@@ -2166,6 +2057,9 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Phase Area definitions...");
     sObjectMgr->LoadAreaPhases();
 
+    TC_LOG_INFO("server.loading", "Indexing phases...");
+    PhaseSet::LoadPhaseIndexes();
+
     TC_LOG_INFO("server.loading", "Loading Conditions...");
     sConditionMgr->LoadConditions();
 
@@ -2411,6 +2305,9 @@ void World::SetInitialWorldSettings()
 
     sServiceMgr->LoadFromDB();
 
+    // stores the results queried instead of read from the snapshot, reloads query the database again
+    WorldDatabaseSnapshot.Close();
+
     uint32 startupDuration = GetMSTimeDiffToNow(startupBegin);
 
 #ifdef ELUNA
@@ -2431,12 +2328,25 @@ void World::SetInitialWorldSettings()
 
 void World::RecordTimeDiff(const char *text, ...)
 {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
     if (!text)
     {
         m_currentTime = getMSTime();
+        m_currentPhaseStart = now;
         return;
     }
 
+    // the phase names are literals, one metric per call site
+    if (sMetrics->IsEnabled())
+    {
+        auto itr = m_phaseMetrics.find(text);
+        if (itr == m_phaseMetrics.end())
+            itr = m_phaseMetrics.emplace(text, sMetrics->Register(std::string("world_update,phase=") + text, METRIC_TIMER)).first;
+
+        sMetrics->Record(itr->second, std::chrono::duration_cast<std::chrono::microseconds>(now - m_currentPhaseStart).count());
+    }
+    m_currentPhaseStart = now;
+
     uint32 thisTime = getMSTime();
     uint32 diff = getMSTimeDiff(m_currentTime, thisTime);
 
@@ -2513,6 +2423,8 @@ void World::LoadAutobroadcasts()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    TC_METRIC_TIMER("world_update");
+
     m_updateTime = diff;
 
     ///- Update the different timers
@@ -3805,6 +3717,35 @@ void World::LoadDBVersion()
         m_DBVersion = "Unknown world database.";
 }
 
+/// Startup queries of world tables are read from the snapshot file while no database updates were applied since it was written
+void World::OpenWorldDatabaseSnapshot()
+{
+    std::string fileName = sConfigMgr->GetStringDefault("WorldDatabase.SnapshotFile", "");
+    if (fileName.empty())
+        return;
+
+    QueryResult result = WorldDatabase.Query("SELECT name, hash FROM updates ORDER BY name");
+    if (!result)
+    {
+        TC_LOG_ERROR("server.loading", "WorldDatabase.SnapshotFile is set but the world database has no applied updates to key the snapshot on, not using it.");
+        return;
+    }
+
+    Trinity::Crypto::SHA1 key;
+    key.UpdateData(m_DBVersion);
+    do
+    {
+        Field* fields = result->Fetch();
+        key.UpdateData(fields[0].GetString());
+        key.UpdateData(fields[1].GetString());
+    } while (result->NextRow());
+    key.Finalize();
+
+    WorldDatabaseSnapshot.Open(fileName, ByteArrayToHexStr(key.GetDigest()));
+    // rows changed during startup or at runtime (.npc add, .gobject delete, ...) are not in the stored results
+    WorldDatabase.ObserveNextWrite([] { WorldDatabaseSnapshot.Discard(); });
+}
+
 void World::ProcessStartEvent()
 {
     isEventKillStart = true;
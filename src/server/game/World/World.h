@@ -115,7 +115,11 @@ enum WorldBoolConfigs
     CONFIG_ALLOW_PLAYER_COMMANDS,
     CONFIG_CLEAN_CHARACTER_DB,
     CONFIG_GRID_UNLOAD,
+    CONFIG_GRID_MAP_MEMORY_MAPPED,
     CONFIG_STATS_SAVE_ONLY_ON_LOGOUT,
+    CONFIG_PLAYER_SAVE_SKIP_UNCHANGED,
+    CONFIG_MOVEMENT_VALIDATE_CODECS,
+    CONFIG_PATHFINDING_ASYNC_SHARED_SEARCH,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CALENDAR,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CHANNEL,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP,
@@ -251,8 +255,10 @@ enum WorldBoolConfigs
     CONFIG_DISABLE_RESTART,   
 #ifdef ELUNA
 	CONFIG_BOOL_ELUNA_ENABLED,
+	CONFIG_BOOL_ELUNA_PER_MAP_STATES,
 #endif 
     CONFIG_LOAD_LOCALES,
+    CONFIG_MAP_UPDATE_REGIONS,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -601,6 +607,8 @@ enum WorldIntConfigs
     CONFIG_AHBOT_UPDATE_INTERVAL,
     CONFIG_AUCTIONHOUSE_MIN_DIFF_FOR_LOG,
     CONFIG_AUCTIONHOUSE_MIN_DIFF_FOR_THROTTLE,
+    CONFIG_AUCTIONHOUSE_SEARCH_THREADS,
+    CONFIG_AUCTIONHOUSE_SEARCH_VIEW_MAX_AGE,
     CONFIG_BATTLEGROUND_REWARD,
     CONFIG_BATTLEGROUND_GAMES,
     CONFIG_ICORE_RICH_PVP_REWARD,
@@ -611,6 +619,14 @@ enum WorldIntConfigs
     CONFIG_PLAYED_TIME_REWARD,
     CONFIG_AUTO_SERVER_RESTART_HOUR,
     CONFIG_SOCKET_TIMEOUTTIME_ACTIVE,
+    CONFIG_MAP_UPDATE_REGIONS_MIN_PLAYERS,
+    CONFIG_MAP_UPDATE_REGIONS_GRID_DISTANCE,
+    CONFIG_COMPRESSION_THREADS,
+    CONFIG_COMPRESSION_LARGE_PACKET_SIZE,
+    CONFIG_GRID_PRELOAD_THREADS,
+    CONFIG_GRID_PRELOAD_LOOKAHEAD,
+    CONFIG_PATHFINDING_ASYNC_THREADS,
+    CONFIG_STARTUP_LOADER_THREADS,
     INT_CONFIG_VALUE_COUNT,
     CONFIG_RESPAWN_GUIDWARNLEVEL,
     CONFIG_RESPAWN_GUIDALERTLEVEL,
@@ -1112,6 +1128,7 @@ class TC_GAME_API World
         // used World DB version
         void LoadDBVersion();
         char const* GetDBVersion() const { return m_DBVersion.c_str(); }
+        void OpenWorldDatabaseSnapshot();
 
         void RecordTimeDiff(const char * text, ...);
         void RecordTimeDiff(uint32 diff, char const* text, ...);
@@ -1207,6 +1224,8 @@ class TC_GAME_API World
         time_t mail_timer_expires;
         uint32 m_updateTime, m_updateTimeSum;
         uint32 m_currentTime;
+        std::chrono::steady_clock::time_point m_currentPhaseStart;
+        std::unordered_map<char const*, uint32> m_phaseMetrics;     // RecordTimeDiff phase name -> metric
 
         SessionMap m_sessions;
         typedef std::unordered_map<uint32, time_t> DisconnectMap;
@@ -34,6 +34,7 @@ EndScriptData */
 #include "Transport.h"
 #include "Language.h"
 
+#include <chrono>
 #include <fstream>
 
 class debug_commandscript : public CommandScript
@@ -96,6 +97,9 @@ public:
             { "transport",      SEC_ADMINISTRATOR,  false,  &HandleDebugTransportCommand,           },
             { "phase",          SEC_ADMINISTRATOR,  false,  &HandleDebugPhaseCommand,               },
             { "casterror",      SEC_ADMINISTRATOR,  false,  &HandleDebugCastErrorCommand,           },
+            { "logbench",       SEC_ADMINISTRATOR,  true,   &HandleDebugLogBenchCommand,            },
+            { "auramemory",     SEC_ADMINISTRATOR,  false,  &HandleDebugAuraMemoryCommand,          },
+            { "valuesbench",    SEC_ADMINISTRATOR,  false,  &HandleDebugValuesBenchCommand,         },
             { "set",            SEC_ADMINISTRATOR,  false,  {
                 { "ap",         SEC_ADMINISTRATOR,  false,  &HandleDebugSetAttackPower              },
                 { "sp",         SEC_ADMINISTRATOR,  false,  &HandleDebugSetSpellPower               },
@@ -1714,6 +1718,120 @@ public:
 
         return true;
     }
+
+    // Time disabled log calls through the call site handle against a lookup by logger name
+    static bool HandleDebugLogBenchCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 count = 10000000;
+        if (*args)
+            count = std::max<uint32>(strtoul(args, nullptr, 10), 1);
+
+        if (sLog->ShouldLog("server", LOG_LEVEL_TRACE))
+        {
+            handler->PSendSysMessage("Logger 'server' writes trace messages, disable it first.");
+            return true;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < count; ++i)
+            TC_LOG_TRACE("server", "Log bench %u", i);
+        auto cached = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < count; ++i)
+            sLog->ShouldLog(std::string("server"), LOG_LEVEL_TRACE);
+        auto lookup = std::chrono::steady_clock::now() - start;
+
+        auto report = [handler, count](char const* name, std::chrono::steady_clock::duration time)
+        {
+            double ns = std::max(std::chrono::duration<double, std::nano>(time).count(), 1.0);
+            handler->PSendSysMessage("%s: %u calls in %.3f ms, %.2f ns/call, %.0f calls/sec", name, count, ns / 1000000.0, ns / count, count * 1000000000.0 / ns);
+        };
+        report("Call site handle", cached);
+        report("Logger lookup", lookup);
+        return true;
+    }
+
+    // Time the values update of the selected unit built for every viewer against the block shared by its visibility class
+    static bool HandleDebugValuesBenchCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 count = 100000;
+        if (*args)
+            count = std::max<uint32>(strtoul(args, nullptr, 10), 1);
+
+        Player* viewer = handler->GetSession()->GetPlayer();
+        Unit* target = handler->getSelectedUnit();
+        if (!target)
+            target = viewer;
+
+        // every field changed, the worst case of a flush (the target also sends them at the next one)
+        for (uint16 i = 0; i < target->GetValuesCount(); ++i)
+            target->ForceValuesUpdateAtIndex(i);
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < count; ++i)
+        {
+            UpdateDataMapType updates;
+            target->BuildFieldsUpdate(viewer, updates);
+        }
+        auto perViewer = std::chrono::steady_clock::now() - start;
+
+        // counted apart, .server stats only shows real flushes
+        ValuesUpdateCounters counters;
+        start = std::chrono::steady_clock::now();
+        SharedValuesUpdateMap sharedUpdates;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            UpdateDataMapType updates;
+            target->BuildFieldsUpdate(viewer, updates, sharedUpdates, counters);
+        }
+        auto shared = std::chrono::steady_clock::now() - start;
+
+        uint64 fields = uint64(count) * target->GetValuesCount();
+        auto report = [handler, count, fields](char const* name, std::chrono::steady_clock::duration time)
+        {
+            double seconds = std::max(std::chrono::duration<double>(time).count(), 1e-9);
+            handler->PSendSysMessage("%s: %u viewers in %.3f ms, %.0f fields/s", name, count, seconds * 1000.0, fields / seconds);
+        };
+        handler->PSendSysMessage("Values update of %s (%u fields):", target->GetName().c_str(), uint32(target->GetValuesCount()));
+        report("Built per viewer", perViewer);
+        report("Shared block", shared);
+        handler->PSendSysMessage("Shared blocks built: " UI64FMTD ", reused: " UI64FMTD, counters.Built.load(), counters.Shared.load());
+        return true;
+    }
+
+    // Memory of the aura type index of the creatures on the map, compared to one list per aura type
+    static bool HandleDebugAuraMemoryCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        Map* map = handler->GetSession()->GetPlayer()->GetMap();
+
+        std::size_t units = 0, bytes = 0, maxBytes = 0, types = 0;
+        for (auto&& itr : map->GetCreatureBySpawnIdStore())
+        {
+            AuraEffectIndex const& index = itr.second->GetAuraEffectIndex();
+            std::size_t size = index.GetMemoryUsage();
+            bytes += size;
+            maxBytes = std::max(maxBytes, size);
+            types += index.GetTypeCount();
+            ++units;
+        }
+
+        if (!units)
+        {
+            handler->PSendSysMessage("No creatures spawned on map %u.", map->GetId());
+            return true;
+        }
+
+        std::size_t fixedBytes = TOTAL_AURAS * sizeof(Unit::AuraEffectList);
+        handler->PSendSysMessage("Aura effect index of %u creatures on map %u:", uint32(units), map->GetId());
+        handler->PSendSysMessage("Before: %u bytes per unit (one list for each of %u aura types), %.2f MB in total", uint32(fixedBytes), uint32(TOTAL_AURAS), double(fixedBytes * units) / (1024 * 1024));
+        handler->PSendSysMessage("After: %.1f bytes per unit, %u at most, %.2f aura types per unit, %.2f MB in total", double(bytes) / units, uint32(maxBytes), double(types) / units, double(bytes) / (1024 * 1024));
+
+        if (Unit* target = handler->getSelectedUnit())
+            handler->PSendSysMessage("Selected unit: %u bytes, %u aura types", uint32(target->GetAuraEffectIndex().GetMemoryUsage()), uint32(target->GetAuraEffectIndex().GetTypeCount()));
+
+        return true;
+    }
 };
 
 void AddSC_debug_commandscript()
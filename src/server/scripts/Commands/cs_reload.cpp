@@ -924,6 +924,7 @@ public:
     {
         TC_LOG_INFO("misc", "Re-Loading Spell Proc Event conditions...");
         sSpellMgr->LoadSpellProcEvents();
+        Unit::InvalidateProcAuras();
         handler->SendGlobalGMSysMessage("DB table `spell_proc_event` (spell proc trigger requirements) reloaded.");
         return true;
     }
@@ -932,6 +933,7 @@ public:
     {
         TC_LOG_INFO("misc", "Re-Loading Spell Proc conditions and data...");
         sSpellMgr->LoadSpellProcs();
+        Unit::InvalidateProcAuras();
         handler->SendGlobalGMSysMessage("DB table `spell_proc` (spell proc conditions and data) reloaded.");
         return true;
     }
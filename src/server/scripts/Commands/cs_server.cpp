@@ -32,6 +32,12 @@ EndScriptData */
 #include "MapManager.h"
 #include "MapInstanced.h"
 #include "Group.h"
+#include "PacketCompressionMgr.h"
+#include "GridPreloader.h"
+#include "PathfindingService.h"
+#include "GameTime.h"
+#include "Metrics.h"
+#include "WorldPacketPool.h"
 
 class server_commandscript : public CommandScript
 {
@@ -76,6 +82,14 @@ public:
         static std::vector<ChatCommand> serverStatsCommandTable =
         {
             { "mapupdate",      SEC_ADMINISTRATOR,      true,   &HandleServerStatsMapUpdateCommand, },
+            { "compression",    SEC_ADMINISTRATOR,      true,   &HandleServerStatsCompressionCommand, },
+            { "gridpreload",    SEC_ADMINISTRATOR,      true,   &HandleServerStatsGridPreloadCommand, },
+            { "pathfinding",    SEC_ADMINISTRATOR,      true,   &HandleServerStatsPathfindingCommand, },
+            { "procs",          SEC_ADMINISTRATOR,      true,   &HandleServerStatsProcsCommand,     },
+            { "playersave",     SEC_ADMINISTRATOR,      true,   &HandleServerStatsPlayerSaveCommand, },
+            { "database",       SEC_ADMINISTRATOR,      true,   &HandleServerStatsDatabaseCommand,  },
+            { "metrics",        SEC_ADMINISTRATOR,      true,   &HandleServerStatsMetricsCommand,   },
+            { "packetpool",     SEC_ADMINISTRATOR,      true,   &HandleServerStatsPacketPoolCommand, },
         };
 
         static std::vector<ChatCommand> serverCommandTable =
@@ -465,6 +479,7 @@ public:
             uint32 UpdateTime;
             uint32 PlayerCount;
             uint32 InstanceCount;
+            uint32 RegionCount;
             std::list<InstanceInfo> Instances;
         };
 
@@ -482,7 +497,7 @@ public:
             if (!map)
                 continue;
 
-            MapInfo mapInfo = { mapId, map->GetMapName(), map->IsRaid(), 0, 0, 0 };
+            MapInfo mapInfo = { mapId, map->GetMapName(), map->IsRaid(), 0, 0, 0, 0 };
             if (map->Instanceable() && map->ToMapInstanced())
             {
                 MapInstanced* mapInstanced = map->ToMapInstanced();
@@ -514,6 +529,7 @@ public:
             {
                 mapInfo.PlayerCount = map->GetPlayersCountExceptGMs();
                 mapInfo.UpdateTime = map->GetUpdateTime();
+                mapInfo.RegionCount = map->GetUpdateRegionCount();
             }
 
             if (!mapInfo.UpdateTime) // Did not contribute to server performance
@@ -545,6 +561,8 @@ public:
                     for (auto& instance : map.Instances)
                         handler->PSendSysMessage("|cFFC0C0C0  - Instance |cFFFFFFFF%u|cFFE0E0E0 - |cFFFFFFFF%s|cFFC0C0C0: |cFFFFFFFF%u|cFFC0C0C0p %s %s[%ums]|r", instance.InstanceID, difficulty[instance.InstanceDifficulty], instance.PlayerCount, instance.GroupLeaderName.size() ? handler->playerLink(instance.GroupLeaderName).c_str() : "", instance.UpdateTime <= GOOD_DIFF_I ? GOOD_COLOR : instance.UpdateTime > BAD_DIFF_I ? BAD_COLOR : NORMAL_COLOR, instance.UpdateTime);
             }
+            else if (map.RegionCount > 1)
+                handler->PSendSysMessage("|cFFE0E0E0- Map |cFFFFFFFF%u|cFFE0E0E0 - |cFFFFFFFF%s|cFFE0E0E0: |cFFFFFFFF%u|cFFE0E0E0p |cFFFFFFFF%u|cFFE0E0E0r %s[%ums]|r", map.MapID, map.MapName, map.PlayerCount, map.RegionCount, map.UpdateTime <= GOOD_DIFF ? GOOD_COLOR : map.UpdateTime > BAD_DIFF ? BAD_COLOR : NORMAL_COLOR, map.UpdateTime);
             else
                 handler->PSendSysMessage("|cFFE0E0E0- Map |cFFFFFFFF%u|cFFE0E0E0 - |cFFFFFFFF%s|cFFE0E0E0: |cFFFFFFFF%u|cFFE0E0E0p %s[%ums]|r", map.MapID, map.MapName, map.PlayerCount, map.UpdateTime <= GOOD_DIFF ? GOOD_COLOR : map.UpdateTime > BAD_DIFF ? BAD_COLOR : NORMAL_COLOR, map.UpdateTime);
         }
@@ -552,6 +570,176 @@ public:
         handler->PSendSysMessage("Total time spent on map updates: %ums", mapDiff);
         handler->PSendSysMessage("Time spent on other updates: %ums", worldDiff >= mapDiff ? worldDiff - mapDiff : 0);
 
+        MapUpdater* updater = sMapMgr->GetMapUpdater();
+        if (updater->activated())
+        {
+            uint64 tickTime = updater->GetLastTickTime();
+            handler->PSendSysMessage("Map update threads, last tick took %.2fms:", tickTime / 1000.0f);
+
+            std::vector<MapUpdaterWorkerStats> workers = updater->GetWorkerStats();
+            for (size_t i = 0; i < workers.size(); ++i)
+                handler->PSendSysMessage("|cFFE0E0E0- Thread |cFFFFFFFF%u|cFFE0E0E0: |cFFFFFFFF%u|cFFE0E0E0 maps, |cFFFFFFFF%u|cFFE0E0E0 stolen, busy %.2fms (%u%%)|r",
+                    uint32(i), workers[i].Updates, workers[i].Steals, workers[i].BusyTime / 1000.0f, tickTime ? uint32(workers[i].BusyTime * 100 / tickTime) : 0);
+        }
+
+        ValuesUpdateCounters& valuesUpdates = Object::GetValuesUpdateCounters();
+        uint64 built = valuesUpdates.Built.load(std::memory_order_relaxed);
+        uint64 shared = valuesUpdates.Shared.load(std::memory_order_relaxed);
+        handler->PSendSysMessage("Values update blocks since startup: " UI64FMTD " serialized, " UI64FMTD " shared between viewers (%u%%)",
+            built, shared, built + shared ? uint32(shared * 100 / (built + shared)) : 0);
+
+        return true;
+    }
+
+    static bool HandleServerStatsCompressionCommand(ChatHandler* handler, const char* /*args*/)
+    {
+        PacketCompressionStats stats = sPacketCompressionMgr->GetStats();
+        if (stats.Threads)
+            handler->PSendSysMessage("Packet compression threads: %u, jobs waiting: %u", stats.Threads, stats.Backlog);
+        else
+            handler->PSendSysMessage("Packet compression runs on the network threads");
+
+        handler->PSendSysMessage("Compressed packets since startup: " UI64FMTD ", " UI64FMTD " bytes in, " UI64FMTD " bytes out (%.1f%%)",
+            stats.Packets, stats.BytesIn, stats.BytesOut, stats.BytesIn ? stats.BytesOut * 100.0f / stats.BytesIn : 0.0f);
+        handler->PSendSysMessage("Time spent compressing: %.2fms, %.1fus per packet",
+            stats.Time / 1000.0f, stats.Packets ? float(stats.Time) / stats.Packets : 0.0f);
+        return true;
+    }
+
+    static bool HandleServerStatsGridPreloadCommand(ChatHandler* handler, const char* /*args*/)
+    {
+        GridPreloadStats stats = sGridPreloader->GetStats();
+        if (stats.Threads)
+            handler->PSendSysMessage("Grid preload threads: %u, grids loading: %u, grids waiting for their map: %u", stats.Threads, stats.Pending, stats.Ready);
+        else
+            handler->PSendSysMessage("Grid preloading is disabled");
+
+        handler->PSendSysMessage("Grids requested: " UI64FMTD ", preloaded in time: " UI64FMTD ", loaded on the map thread: " UI64FMTD " (" UI64FMTD " still being preloaded), expired: " UI64FMTD,
+            stats.Requests, stats.Hits, stats.Misses, stats.Late, stats.Expired);
+        handler->PSendSysMessage("Grid loading moved off the map threads: " UI64FMTD "ms, left on the map threads: " UI64FMTD "ms",
+            stats.SavedTime, stats.StallTime);
+        return true;
+    }
+
+    static bool HandleServerStatsPathfindingCommand(ChatHandler* handler, const char* /*args*/)
+    {
+        PathfindingStats stats = sPathfindingMgr->GetStats();
+        if (stats.Threads)
+            handler->PSendSysMessage("Asynchronous pathfinding threads: %u, queries per second: %u", stats.Threads, stats.QueriesPerSecond);
+        else
+            handler->PSendSysMessage("Asynchronous pathfinding is disabled");
+
+        handler->PSendSysMessage("Paths requested: " UI64FMTD ", solved by the workers: " UI64FMTD " (" UI64FMTD " from the search of their target), left to the map thread: " UI64FMTD ", expired: " UI64FMTD,
+            stats.Requests, stats.Solved, stats.Shared, stats.Fallbacks, stats.Expired);
+
+        uint64 solves = stats.Solved + stats.Fallbacks;
+        handler->PSendSysMessage("Solve time: " UI64FMTD "us total, " UI64FMTD "us average, map threads waited " UI64FMTD "us for their batch",
+            stats.SolveTime, solves ? stats.SolveTime / solves : 0, stats.WaitTime);
+        return true;
+    }
+
+    static bool HandleServerStatsProcsCommand(ChatHandler* handler, const char* /*args*/)
+    {
+        if (!sMetrics->IsEnabled())
+            handler->SendSysMessage("Proc events are only counted while metrics are enabled (Metrics.Enable = 1).");
+
+        ProcDispatchStats stats = Unit::GetProcDispatchStats();
+        uint64 events = stats.Events;
+        uint64 registered = stats.Registered;
+        uint64 visited = stats.Visited;
+        uint64 triggered = stats.Triggered;
+
+        handler->PSendSysMessage("Proc events: " UI64FMTD ", proc auras of their phase: " UI64FMTD ", candidates visited: " UI64FMTD ", triggered: " UI64FMTD,
+            events, registered, visited, triggered);
+        if (events)
+            handler->PSendSysMessage("Per event: %.2f proc auras, %.2f visited, %.2f triggered",
+                double(registered) / events, double(visited) / events, double(triggered) / events);
+        return true;
+    }
+
+    static bool HandleServerStatsPlayerSaveCommand(ChatHandler* handler, const char* /*args*/)
+    {
+        PlayerSaveStats const& stats = Player::GetSaveStats();
+        uint64 saves = stats.Saves;
+        uint64 statements = stats.Statements;
+        uint64 bytes = stats.Bytes;
+        uint64 skippedSections = stats.SkippedSections;
+        uint64 skippedStatements = stats.SkippedStatements;
+
+        handler->PSendSysMessage("Player saves: " UI64FMTD ", statements: " UI64FMTD ", bytes: " UI64FMTD ", unchanged sections skipped: " UI64FMTD " (" UI64FMTD " statements)",
+            saves, statements, bytes, skippedSections, skippedStatements);
+        if (saves)
+            handler->PSendSysMessage("Per save: %.2f statements, %.2f bytes, %.2f statements skipped",
+                double(statements) / saves, double(bytes) / saves, double(skippedStatements) / saves);
+        return true;
+    }
+
+    template<class T>
+    static void SendDatabaseQueueStats(ChatHandler* handler, char const* name, DatabaseWorkerPool<T> const& pool)
+    {
+        static char const* const priorityNames[MAX_DATABASE_PRIORITY] = { "interactive", "gameplay", "background" };
+
+        for (uint8 i = 0; i < MAX_DATABASE_PRIORITY; ++i)
+        {
+            DatabaseQueueStats stats = pool.GetQueueStats(DatabasePriority(i));
+            handler->PSendSysMessage("%s %s: queued " SZFMTD ", posted " UI64FMTD ", executed " UI64FMTD ", batched " UI64FMTD ", wait p50 %u ms, p95 %u ms, p99 %u ms",
+                name, priorityNames[i], stats.Depth, stats.Posted, stats.Executed, stats.Batched, stats.WaitP50, stats.WaitP95, stats.WaitP99);
+        }
+    }
+
+    static bool HandleServerStatsDatabaseCommand(ChatHandler* handler, const char* /*args*/)
+    {
+        SendDatabaseQueueStats(handler, "Login", LoginDatabase);
+        SendDatabaseQueueStats(handler, "World", WorldDatabase);
+        SendDatabaseQueueStats(handler, "Character", CharacterDatabase);
+        return true;
+    }
+
+    static bool HandleServerStatsPacketPoolCommand(ChatHandler* handler, const char* /*args*/)
+    {
+        WorldPacketPoolStats stats = WorldPacketPool::GetStats();
+        uint64 saved = stats.ReusedPackets + stats.ReusedStorage;
+        uint32 uptime = std::max<uint32>(GameTime::GetUptime(), 1);
+
+        handler->PSendSysMessage("Received packets: " UI64FMTD ", reused packets: " UI64FMTD ", reused buffers: " UI64FMTD ", cached: " SZFMTD " in " SZFMTD " pools",
+            stats.Acquired, stats.ReusedPackets, stats.ReusedStorage, stats.Free, stats.Pools);
+        handler->PSendSysMessage("Allocations saved: " UI64FMTD " (%.1f per second)", saved, double(saved) / uptime);
+        return true;
+    }
+
+    // .server stats metrics [name prefix], the most expensive metrics first
+    static bool HandleServerStatsMetricsCommand(ChatHandler* handler, const char* args)
+    {
+        if (!sMetrics->IsEnabled())
+        {
+            handler->SendSysMessage("Metrics are disabled, set Metrics.Enable = 1 and reload the config.");
+            return true;
+        }
+
+        std::string prefix = args ? args : "";
+        std::vector<MetricValue> values = sMetrics->Snapshot();
+        values.erase(std::remove_if(values.begin(), values.end(), [&prefix](MetricValue const& value)
+        {
+            return !value.Count || value.Name.compare(0, prefix.size(), prefix) != 0;
+        }), values.end());
+
+        std::sort(values.begin(), values.end(), [](MetricValue const& left, MetricValue const& right) { return left.Sum > right.Sum; });
+
+        if (values.size() > 30)
+            values.resize(30);
+
+        for (MetricValue const& value : values)
+        {
+            if (value.Type == METRIC_COUNTER)
+                handler->PSendSysMessage("%s: count " UI64FMTD ", sum " UI64FMTD, value.Name.c_str(), value.Count, value.Sum);
+            else
+                handler->PSendSysMessage("%s: count " UI64FMTD ", total " UI64FMTD " ms, avg " UI64FMTD " us, p50 " UI64FMTD " us, p95 " UI64FMTD " us, p99 " UI64FMTD " us, max " UI64FMTD " us",
+                    value.Name.c_str(), value.Count, value.Sum / IN_MILLISECONDS, value.Sum / value.Count,
+                    value.GetPercentile(50), value.GetPercentile(95), value.GetPercentile(99), value.Max);
+        }
+
+        if (values.empty())
+            handler->SendSysMessage("No metrics recorded.");
         return true;
     }
 };
@@ -21,7 +21,7 @@
 #include "MessageBuffer.h"
 #include "Log.h"
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <type_traits>
@@ -103,7 +103,17 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.emplace_back(std::move(buffer));
+
+#ifdef TC_SOCKET_USE_IOCP
+        AsyncProcessQueue();
+#endif
+    }
+
+    /// Queues buffer followed by payload, payload is sent from its own storage which payloadOwner keeps alive until written
+    void QueuePacket(MessageBuffer&& buffer, std::shared_ptr<void const> payloadOwner, uint8 const* payload, std::size_t payloadSize)
+    {
+        _writeQueue.emplace_back(std::move(buffer), std::move(payloadOwner), payload, payloadSize);
 
 #ifdef TC_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -144,8 +154,8 @@ protected:
         _isWritingAsync = true;
 
 #ifdef TC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
+        GatherWriteBuffers();
+        _socket.async_write_some(_writeBuffers, std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T>::WriteHandlerWrapper,
@@ -165,6 +175,73 @@ protected:
     }
 
 private:
+    /// Queued bytes, either copied into Buffer or referenced through Payload
+    struct QueuedWrite
+    {
+        explicit QueuedWrite(MessageBuffer&& buffer) : Buffer(std::move(buffer)), Payload(nullptr), PayloadSize(0) { }
+
+        QueuedWrite(MessageBuffer&& buffer, std::shared_ptr<void const> payloadOwner, uint8 const* payload, std::size_t payloadSize)
+            : Buffer(std::move(buffer)), PayloadOwner(std::move(payloadOwner)), Payload(payload), PayloadSize(payloadSize) { }
+
+        std::size_t GetRemainingSize() const { return Buffer.GetActiveSize() + PayloadSize; }
+
+        /// Marks up to bytes as written, returns how many of them belonged to this entry
+        std::size_t Consume(std::size_t bytes)
+        {
+            std::size_t fromBuffer = std::min<std::size_t>(bytes, Buffer.GetActiveSize());
+            Buffer.ReadCompleted(fromBuffer);
+
+            std::size_t fromPayload = std::min(bytes - fromBuffer, PayloadSize);
+            Payload += fromPayload;
+            PayloadSize -= fromPayload;
+            if (!PayloadSize)
+                PayloadOwner.reset();
+
+            return fromBuffer + fromPayload;
+        }
+
+        MessageBuffer Buffer;
+        std::shared_ptr<void const> PayloadOwner;
+        uint8 const* Payload;
+        std::size_t PayloadSize;
+    };
+
+    /// Limits how many queued entries go into a single vectored write
+    static std::size_t const MaxWritesPerCall = 32;
+
+    /// Collects queued buffers and payloads for a vectored write, returns their total size
+    std::size_t GatherWriteBuffers()
+    {
+        _writeBuffers.clear();
+
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < _writeQueue.size() && i < MaxWritesPerCall; ++i)
+        {
+            QueuedWrite& queued = _writeQueue[i];
+            if (queued.Buffer.GetActiveSize())
+                _writeBuffers.emplace_back(queued.Buffer.GetReadPointer(), queued.Buffer.GetActiveSize());
+            if (queued.PayloadSize)
+                _writeBuffers.emplace_back(queued.Payload, queued.PayloadSize);
+
+            size += queued.GetRemainingSize();
+        }
+
+        return size;
+    }
+
+    /// Drops written bytes from the front of the queue
+    void ConsumeWriteQueue(std::size_t bytes)
+    {
+        while (!_writeQueue.empty())
+        {
+            bytes -= _writeQueue.front().Consume(bytes);
+            if (_writeQueue.front().GetRemainingSize())
+                break;
+
+            _writeQueue.pop_front();
+        }
+    }
+
     void ReadHandlerInternal(boost::system::error_code error, size_t transferredBytes)
     {
         if (error)
@@ -184,9 +261,7 @@ private:
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            ConsumeWriteQueue(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -210,37 +285,33 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        std::size_t bytesToSend = GatherWriteBuffers();
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(_writeBuffers, error);
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
-        else if (bytesSent < bytesToSend) // now n > 0
-        {
-            queuedMessage.ReadCompleted(bytesSent);
+
+        ConsumeWriteQueue(bytesSent);
+        if (bytesSent < bytesToSend) // now n > 0
             return AsyncProcessQueue();
-        }
 
-        _writeQueue.pop();
         if (_closing && _writeQueue.empty())
             CloseSocket();
         return !_writeQueue.empty();
@@ -254,7 +325,8 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<QueuedWrite> _writeQueue;
+    std::vector<boost::asio::const_buffer> _writeBuffers;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
@@ -44,6 +44,7 @@
 #include "Log.h"
 #include "MapManager.h"
 #include "Memory.h"
+#include "Metrics.h"
 #include "MySQLThreading.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvPMgr.h"
@@ -322,6 +323,8 @@ extern int main(int argc, char** argv)
 
     threadPool.reset();
 
+    sMetrics->Shutdown();
+
     sLog->SetSynchronous();
 
     sScriptMgr->OnShutdown();
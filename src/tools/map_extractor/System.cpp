@@ -98,6 +98,9 @@ float CONF_float_to_int16_limit = 2048.0f;   // Max accuracy = val/65536
 float CONF_flat_height_delta_limit = 0.005f; // If max - min less this value - surface is flat
 float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - liquid surface is flat
 
+// This option align map file sections to 4 bytes, so worldserver can read them from memory mapped files
+bool  CONF_align_sections = true;
+
 uint32 CONF_TargetBuild = 18273;              // 5.4.8 18273 -- current build is 18414, but Blizz didnt rename the MPQ files
 
 // List MPQ for extract maps from
@@ -174,6 +177,7 @@ void Usage(char const* prg)
         "-e extract only MAP(1)/DBC(2) - standard: both(3)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
         "-b target build (default %u)\n"\
+        "-a align map file sections for memory mapped loading, 1 by default\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, CONF_TargetBuild, prg);
     exit(1);
 }
@@ -188,6 +192,7 @@ void HandleArgs(int argc, char* arg[])
         // f - use float to int conversion
         // h - limit minimum height
         // b - target client build
+        // a - align map file sections
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -227,6 +232,12 @@ void HandleArgs(int argc, char* arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 'a':
+                if (c + 1 < argc)                            // all ok
+                    CONF_align_sections = atoi(arg[c++ + 1]) != 0;
+                else
+                    Usage(arg[0]);
+                break;
             default:
                 break;
         }
@@ -422,6 +433,24 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
+
+uint32 AlignSectionOffset(uint32 offset)
+{
+    if (!CONF_align_sections)
+        return offset;
+
+    return (offset + 3) & ~uint32(3);
+}
+
+// Sections are read by offset, the padding between them is never looked at
+void PadToSectionOffset(FILE* output, uint32 offset)
+{
+    static char const padding[4] = { };
+    long position = ftell(output);
+    if (position >= 0 && uint32(position) < offset)
+        fwrite(padding, 1, offset - uint32(position), output);
+}
+
 // Temporary grid data store
 uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
@@ -618,7 +647,7 @@ bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/,
         hasFlightBox = true;
     }
 
-    map.heightMapOffset = map.areaMapOffset + map.areaMapSize;
+    map.heightMapOffset = AlignSectionOffset(map.areaMapOffset + map.areaMapSize);
     map.heightMapSize = sizeof(map_heightHeader);
 
     map_heightHeader heightHeader;
@@ -877,7 +906,7 @@ bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/,
                 if (!liquid_show[y][x])
                     liquidHasHoles = true;
 
-        map.liquidMapOffset = map.heightMapOffset + map.heightMapSize;
+        map.liquidMapOffset = AlignSectionOffset(map.heightMapOffset + map.heightMapSize);
         map.liquidMapSize = sizeof(map_liquidHeader);
         liquidHeader.fourcc = *(uint32 const*)MAP_LIQUID_MAGIC;
         liquidHeader.flags = 0;
@@ -911,9 +940,9 @@ bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/,
     uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
     if (map.liquidMapOffset)
-        map.holesOffset = map.liquidMapOffset + map.liquidMapSize;
+        map.holesOffset = AlignSectionOffset(map.liquidMapOffset + map.liquidMapSize);
     else
-        map.holesOffset = map.heightMapOffset + map.heightMapSize;
+        map.holesOffset = AlignSectionOffset(map.heightMapOffset + map.heightMapSize);
 
     memset(holes, 0, sizeof(holes));
     bool hasHoles = false;
@@ -950,6 +979,7 @@ bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/,
         fwrite(reinterpret_cast<const char*>(area_ids), sizeof(area_ids), 1, output);
 
     // Store height data
+    PadToSectionOffset(output, map.heightMapOffset);
     fwrite(&heightHeader, sizeof(heightHeader), 1, output);
     if (!(heightHeader.flags & MAP_HEIGHT_NO_HEIGHT))
     {
@@ -979,6 +1009,7 @@ bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/,
     // Store liquid data if need
     if (map.liquidMapOffset)
     {
+        PadToSectionOffset(output, map.liquidMapOffset);
         fwrite(&liquidHeader, sizeof(liquidHeader), 1, output);
         if (!(liquidHeader.flags & MAP_LIQUID_NO_TYPE))
         {
@@ -995,7 +1026,10 @@ bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/,
 
     // store hole data
     if (hasHoles)
+    {
+        PadToSectionOffset(output, map.holesOffset);
         fwrite(holes, map.holesSize, 1, output);
+    }
 
     fclose(output);
 